@@ -0,0 +1,125 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Utilities/Any.hpp>
+#include <GameLibrary/Utilities/ArrayList.hpp>
+#include <GameLibrary/Utilities/Number.hpp>
+#include <vector>
+
+using namespace fgl;
+
+// too large to be stored inline, so that both storage paths get checked
+struct LargeAnyList
+{
+	std::vector<Any> values;
+	char padding[64];
+};
+
+static_assert(std::is_nothrow_move_constructible<Any>::value, "Any should be moved when a vector grows");
+static_assert(std::is_nothrow_move_assignable<Any>::value, "Any should be nothrow move assignable");
+
+// moves a value out of a container owned by the destination, which needs the source to be taken before the destination is destroyed
+bool AnyBenchmark_checkNestedMove()
+{
+	Any inlineOuter = std::vector<Any>{ Any(String("inline nested value")) };
+	inlineOuter = std::move(inlineOuter.as<std::vector<Any>>()[0]);
+	if(!inlineOuter.is<String>() || inlineOuter.as<String>()!="inline nested value")
+	{
+		return false;
+	}
+	LargeAnyList list;
+	list.values.push_back(Any(String("heap nested value")));
+	Any heapOuter = list;
+	heapOuter = std::move(heapOuter.as<LargeAnyList>().values[0]);
+	return (heapOuter.is<String>() && heapOuter.as<String>()=="heap nested value");
+}
+
+int main(int argc, char* argv[])
+{
+	if(!fglbench::check("any.nested_move_assign", AnyBenchmark_checkNestedMove()))
+	{
+		return 1;
+	}
+
+	Any numberValue = Number(42);
+	Any stringValue = String("short value");
+
+	// construct
+	fglbench::run("number.construct", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Number number = (long long)i;
+			fglbench::doNotOptimize(number);
+		}
+	});
+	fglbench::run("any.construct_number", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Any value = Number((long long)i);
+			fglbench::doNotOptimize(value);
+		}
+	});
+	fglbench::run("any.construct_string", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Any value = String("short value");
+			fglbench::doNotOptimize(value);
+		}
+	});
+
+	// copy and move
+	fglbench::run("any.copy_number", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Any value = numberValue;
+			fglbench::doNotOptimize(value);
+		}
+	});
+	fglbench::run("any.copy_string", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Any value = stringValue;
+			fglbench::doNotOptimize(value);
+		}
+	});
+	fglbench::run("any.move_string", 1000000, [&](size_t count) {
+		Any value = stringValue;
+		for(size_t i=0; i<count; i++)
+		{
+			Any moved = std::move(value);
+			value = std::move(moved);
+		}
+		fglbench::doNotOptimize(value);
+	});
+
+	// arithmetic with type promotion, like accumulating mixed plist values
+	fglbench::run("number.mixed_arithmetic", 1000000, [&](size_t count) {
+		Number total;
+		for(size_t i=0; i<count; i++)
+		{
+			total = (int)i;
+			total += 0.5;
+			total *= (unsigned char)2;
+		}
+		fglbench::doNotOptimize(total);
+	});
+
+	// filling an array, like parsing a plist array
+	fglbench::run("any.array_fill", 1000000, [&](size_t count) {
+		ArrayList<Any> values;
+		values.reserve(count);
+		for(size_t i=0; i<count; i++)
+		{
+			if((i % 2) == 0)
+			{
+				values.add(Number((long long)i));
+			}
+			else
+			{
+				values.add(String("value"));
+			}
+		}
+		fglbench::doNotOptimize(values);
+	});
+
+	return 0;
+}
@@ -0,0 +1,78 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Audio/AudioMixer.hpp>
+#include <SDL.h>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace fgl;
+
+// a second of a stereo tone, so that voices loop over real samples
+void createTone(Sound& sound, float frequency)
+{
+	size_t frameCount = AudioMixer::SAMPLE_RATE;
+	std::vector<float> samples(frameCount * AudioMixer::CHANNELS);
+	for(size_t i=0; i<frameCount; i++)
+	{
+		float value = 0.25f * std::sin(6.2831853f * frequency * (float)i / (float)AudioMixer::SAMPLE_RATE);
+		samples[i*2] = value;
+		samples[(i*2)+1] = value;
+	}
+	sound.create(samples.data(), frameCount);
+}
+
+int main(int argc, char* argv[])
+{
+	const size_t blockFrames = 512;
+	Sound tone;
+	createTone(tone, 440.0f);
+	std::vector<float> output(blockFrames * AudioMixer::CHANNELS);
+
+	std::srand(12345);
+	for(size_t voiceCount : { 16, 64, 256 })
+	{
+		AudioMixer mixer(voiceCount);
+		for(size_t i=0; i<voiceCount; i++)
+		{
+			float gain = (float)std::rand() / (float)RAND_MAX;
+			float pan = ((float)std::rand() / (float)RAND_MAX) * 2.0f - 1.0f;
+			mixer.play(&tone, gain, pan, true);
+		}
+		mixer.mix(output.data(), blockFrames);
+		// each operation is one callback's worth of mixing
+		auto result = fglbench::run("audio.mix."+std::to_string(voiceCount), 1000, [&](size_t blocks) {
+			for(size_t i=0; i<blocks; i++)
+			{
+				mixer.mix(output.data(), blockFrames);
+				fglbench::doNotOptimize(output[0]);
+			}
+		});
+		double voicesPerMillisecond = (double)voiceCount / (result.nanosecondsPerOperation / 1000000.0);
+		fglbench::reportValue("audio.mix."+std::to_string(voiceCount), "voices_per_ms", voicesPerMillisecond);
+	}
+
+	// the whole path through SDL's dummy driver, which calls the audio callback in real time without a sound card
+	#if !defined(_WIN32)
+		setenv("SDL_AUDIODRIVER", "dummy", 0);
+	#endif
+	AudioMixer mixer(64);
+	String error;
+	if(mixer.open(blockFrames, &error))
+	{
+		for(size_t i=0; i<64; i++)
+		{
+			mixer.play(&tone, 0.5f, 0.0f, true);
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		fglbench::reportValue("audio.device.dummy", "active_voices", (double)mixer.getActiveVoiceCount());
+		mixer.close();
+	}
+	else
+	{
+		std::fprintf(stderr, "unable to open audio device: %s\n", (const char*)error);
+	}
+	return 0;
+}
@@ -0,0 +1,90 @@
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace fglbench
+{
+	typedef std::chrono::steady_clock Clock;
+
+	/*! The timing of a benchmark, in nanoseconds per operation*/
+	struct Result
+	{
+		std::string name;
+		size_t operations;
+		double totalMilliseconds;
+		double nanosecondsPerOperation;
+		double operationsPerSecond;
+	};
+
+	inline double elapsedMilliseconds(Clock::time_point start, Clock::time_point end)
+	{
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	/*! Prints a result as a single line of JSON, so that results can be collected and compared by scripts*/
+	inline void report(const Result& result)
+	{
+		std::printf("{\"benchmark\":\"%s\",\"operations\":%zu,\"total_ms\":%.3f,\"ns_per_op\":%.3f,\"ops_per_sec\":%.1f}\n",
+			result.name.c_str(), result.operations, result.totalMilliseconds, result.nanosecondsPerOperation, result.operationsPerSecond);
+		std::fflush(stdout);
+	}
+
+	/*! Prints a named value as a single line of JSON*/
+	inline void reportValue(const std::string& name, const std::string& key, double value)
+	{
+		std::printf("{\"benchmark\":\"%s\",\"%s\":%.3f}\n", name.c_str(), key.c_str(), value);
+		std::fflush(stdout);
+	}
+
+	/*! Prints whether a correctness check passed as a single line of JSON, so that a benchmark can fail when its results would be meaningless
+		\returns the given condition*/
+	inline bool check(const std::string& name, bool passed)
+	{
+		std::printf("{\"check\":\"%s\",\"passed\":%s}\n", name.c_str(), passed ? "true" : "false");
+		std::fflush(stdout);
+		return passed;
+	}
+
+	/*! Runs a function that performs a given number of operations, after a warm-up run, and reports the fastest of several runs*/
+	inline Result run(const std::string& name, size_t operations, const std::function<void(size_t)>& func, size_t repeats=5)
+	{
+		func(std::max<size_t>(1, operations / 10));
+		double bestMilliseconds = -1;
+		for(size_t i=0; i<repeats; i++)
+		{
+			auto start = Clock::now();
+			func(operations);
+			double milliseconds = elapsedMilliseconds(start, Clock::now());
+			if(bestMilliseconds < 0 || milliseconds < bestMilliseconds)
+			{
+				bestMilliseconds = milliseconds;
+			}
+		}
+		Result result;
+		result.name = name;
+		result.operations = operations;
+		result.totalMilliseconds = bestMilliseconds;
+		result.nanosecondsPerOperation = (bestMilliseconds * 1000000.0) / (double)operations;
+		result.operationsPerSecond = (bestMilliseconds > 0) ? ((double)operations * 1000.0 / bestMilliseconds) : 0;
+		report(result);
+		return result;
+	}
+
+	/*! Keeps the compiler from optimizing away a value*/
+	template<typename T>
+	inline void doNotOptimize(const T& value)
+	{
+		#if defined(__GNUC__) || defined(__clang__)
+			asm volatile("" : : "g"(&value) : "memory");
+		#else
+			volatile const T* ptr = &value;
+			(void)ptr;
+		#endif
+	}
+}
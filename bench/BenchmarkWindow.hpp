@@ -0,0 +1,67 @@
+
+#pragma once
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Application/ApplicationData.hpp>
+#include <GameLibrary/Exception/InitializeLibraryException.hpp>
+#include <GameLibrary/Graphics/Graphics.hpp>
+#include <GameLibrary/Window/Window.hpp>
+#include <SDL.h>
+#include <cstdlib>
+
+namespace fglbench
+{
+	/*! A hidden window drawn by SDL's software renderer, so that benchmarks of Graphics, worlds and assets run the same on machines without a GPU or a display.
+		Unless SDL_VIDEODRIVER is already set, SDL's dummy video driver is used.*/
+	class HeadlessWindow
+	{
+	public:
+		HeadlessWindow(unsigned int width=640, unsigned int height=480)
+		{
+			#if !defined(_WIN32)
+				setenv("SDL_VIDEODRIVER", "dummy", 0);
+			#endif
+			SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+			if(!SDL_WasInit(SDL_INIT_VIDEO))
+			{
+				if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_EVENTS) != 0)
+				{
+					throw fgl::InitializeLibraryException("SDL", SDL_GetError());
+				}
+			}
+			window.create(fgl::WindowSettings(fgl::Vector2i(0, 0), fgl::Vector2u(width, height), "Benchmark", nullptr, fgl::Colors::WHITE, fgl::Window::STYLE_HIDDEN | fgl::Window::STYLE_SOFTWARE));
+		}
+
+		HeadlessWindow(const HeadlessWindow&) = delete;
+		HeadlessWindow& operator=(const HeadlessWindow&) = delete;
+
+		~HeadlessWindow()
+		{
+			window.destroy();
+		}
+
+		fgl::Window* getWindow()
+		{
+			return &window;
+		}
+
+		fgl::Graphics& getGraphics()
+		{
+			return *window.getGraphics();
+		}
+
+		fgl::AssetManager* getAssetManager()
+		{
+			return window.getAssetManager();
+		}
+
+		/*! Creates the data passed to each update, for one 60fps frame*/
+		fgl::ApplicationData createAppData()
+		{
+			return fgl::ApplicationData(nullptr, &window, window.getAssetManager(), fgl::TimeInterval(16), fgl::TransformD(), 1.0);
+		}
+
+	private:
+		fgl::Window window;
+	};
+}
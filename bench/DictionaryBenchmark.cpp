@@ -0,0 +1,110 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Utilities/Dictionary.hpp>
+#include <GameLibrary/Utilities/HashDictionary.hpp>
+#include <GameLibrary/Utilities/Number.hpp>
+#include <vector>
+
+using namespace fgl;
+
+int main(int argc, char* argv[])
+{
+	// keys like the ones in a typical animation or layout plist
+	std::vector<String> keys;
+	for(size_t i=0; i<32; i++)
+	{
+		keys.push_back(String("property_") + (int)i);
+	}
+	Dictionary dictionary;
+	HashDictionary hashDictionary;
+	for(size_t i=0; i<keys.size(); i++)
+	{
+		dictionary.set(keys[i], Number((long long)i));
+		hashDictionary.set(keys[i], Number((long long)i));
+	}
+
+	// lookups
+	fglbench::run("dictionary.get", 1000000, [&](size_t count) {
+		size_t found = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			found += dictionary.get(keys[i % keys.size()]).isEmpty() ? 0 : 1;
+		}
+		fglbench::doNotOptimize(found);
+	});
+	fglbench::run("hash_dictionary.get", 1000000, [&](size_t count) {
+		size_t found = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			found += hashDictionary.get(keys[i % keys.size()]).isEmpty() ? 0 : 1;
+		}
+		fglbench::doNotOptimize(found);
+	});
+	String missingKey = "missing_property";
+	fglbench::run("dictionary.has_missing", 1000000, [&](size_t count) {
+		size_t found = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			found += dictionary.has(missingKey) ? 1 : 0;
+		}
+		fglbench::doNotOptimize(found);
+	});
+	fglbench::run("hash_dictionary.has_missing", 1000000, [&](size_t count) {
+		size_t found = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			found += hashDictionary.has(missingKey) ? 1 : 0;
+		}
+		fglbench::doNotOptimize(found);
+	});
+
+	// building, like parsing a plist dict
+	fglbench::run("dictionary.build", 10000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Dictionary dict;
+			for(auto& key : keys)
+			{
+				dict.set(key, Number((long long)i));
+			}
+			fglbench::doNotOptimize(dict);
+		}
+	});
+	fglbench::run("hash_dictionary.build", 10000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			HashDictionary dict;
+			for(auto& key : keys)
+			{
+				dict.set(key, Number((long long)i));
+			}
+			fglbench::doNotOptimize(dict);
+		}
+	});
+
+	// iterating, like writing a plist
+	fglbench::run("dictionary.iterate", 100000, [&](size_t count) {
+		size_t total = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			for(auto& pair : dictionary)
+			{
+				total += pair.first.length();
+			}
+		}
+		fglbench::doNotOptimize(total);
+	});
+	fglbench::run("hash_dictionary.iterate", 100000, [&](size_t count) {
+		size_t total = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			for(auto& entry : hashDictionary)
+			{
+				total += entry.first.length();
+			}
+		}
+		fglbench::doNotOptimize(total);
+	});
+
+	return 0;
+}
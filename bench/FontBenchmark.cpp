@@ -0,0 +1,59 @@
+
+#include "BenchmarkWindow.hpp"
+#include <GameLibrary/Utilities/Font/Font.hpp>
+#include <cstdio>
+
+using namespace fgl;
+
+int main(int argc, char* argv[])
+{
+	fglbench::HeadlessWindow window;
+	Graphics& graphics = window.getGraphics();
+	Font* font = graphics.getFont();
+	if(font == nullptr || font->measureString("A").y == 0)
+	{
+		std::fprintf(stderr, "skipping font benchmarks: the default font could not be loaded\n");
+		return 0;
+	}
+
+	String label = "Score: 12345";
+	String paragraph = "The quick brown fox jumps over the lazy dog, while 0123456789 and some punctuation (!?;:) follow it around the screen.";
+	WideString wideParagraph = (WideString)paragraph;
+
+	Vector2u size;
+	fglbench::run("font.measure.label", 10000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			size = font->measureString(label);
+			fglbench::doNotOptimize(size);
+		}
+	});
+	fglbench::run("font.measure.paragraph", 1000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			size = font->measureString(paragraph);
+			fglbench::doNotOptimize(size);
+		}
+	});
+	fglbench::run("font.measure.paragraph_size_36", 1000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			size = font->measureString(paragraph, 36);
+			fglbench::doNotOptimize(size);
+		}
+	});
+	fglbench::run("font.draw.label", 1000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			graphics.drawString(label, 20, 40);
+		}
+	});
+	fglbench::run("font.draw.paragraph", 100, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			graphics.drawString(wideParagraph, 20, 80);
+		}
+	});
+
+	return 0;
+}
@@ -0,0 +1,83 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Application/FramePacer.hpp>
+#include <GameLibrary/Utilities/Thread.hpp>
+#include <GameLibrary/Utilities/Time/TimeInterval.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace fgl;
+
+// spins for a varying amount of time, like the update and draw of one frame
+void simulateFrameWork(Int64 minNanoseconds, Int64 maxNanoseconds)
+{
+	Int64 duration = minNanoseconds + (Int64)(std::rand() % (int)((maxNanoseconds - minNanoseconds) / 1000)) * 1000;
+	Int64 end = FramePacer::now() + duration;
+	while(FramePacer::now() < end)
+	{
+		//
+	}
+}
+
+void reportJitter(const std::string& name, const std::vector<Int64>& frameStarts, Int64 frameNanoseconds)
+{
+	double totalError = 0;
+	double maxError = 0;
+	for(size_t i=1; i<frameStarts.size(); i++)
+	{
+		double error = std::abs((double)(frameStarts[i] - frameStarts[i-1] - frameNanoseconds)) / 1000000.0;
+		totalError += error;
+		if(error > maxError)
+		{
+			maxError = error;
+		}
+	}
+	fglbench::reportValue(name, "mean_jitter_ms", totalError / (double)(frameStarts.size() - 1));
+	fglbench::reportValue(name, "max_jitter_ms", maxError);
+}
+
+int main(int argc, char* argv[])
+{
+	// paces 60 FPS frames with 2 to 10 ms of work, the way the main loop used to and with FramePacer
+	const size_t frames = 120;
+	const Int64 frameNanoseconds = 1000000000 / 60;
+	std::vector<Int64> frameStarts;
+	frameStarts.reserve(frames);
+
+	std::srand(1);
+	TimeInterval time;
+	time.start();
+	unsigned long long sleeptime = 1000 / 60;
+	for(size_t i=0; i<frames; i++)
+	{
+		long long startFrameTime = time.getMilliseconds();
+		frameStarts.push_back(FramePacer::now());
+		simulateFrameWork(2000000, 10000000);
+		unsigned long long totalFrameTime = (unsigned long long)(time.getMilliseconds() - startFrameTime);
+		if(totalFrameTime > sleeptime)
+		{
+			Thread::sleep(1);
+		}
+		else
+		{
+			Thread::sleep(sleeptime - totalFrameTime);
+		}
+	}
+	reportJitter("framepacer.millisecond_sleep", frameStarts, frameNanoseconds);
+
+	std::srand(1);
+	frameStarts.clear();
+	FramePacer pacer(60);
+	for(size_t i=0; i<frames; i++)
+	{
+		pacer.beginFrame();
+		frameStarts.push_back(FramePacer::now());
+		simulateFrameWork(2000000, 10000000);
+		pacer.waitForNextFrame();
+	}
+	reportJitter("framepacer.sleep_then_spin", frameStarts, frameNanoseconds);
+	fglbench::reportValue("framepacer.sleep_then_spin", "p99_frame_ms", (double)pacer.getHistogram().getPercentile(0.99) / 1000000.0);
+	fglbench::reportValue("framepacer.sleep_then_spin", "late_frames", (double)pacer.getLateFrameCount());
+	return 0;
+}
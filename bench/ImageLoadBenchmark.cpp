@@ -0,0 +1,126 @@
+
+#include "BenchmarkWindow.hpp"
+#include <GameLibrary/Application/BatchLoader.hpp>
+#include <GameLibrary/Graphics/TextureImage.hpp>
+#include <GameLibrary/IO/FileTools.hpp>
+#include <GameLibrary/Utilities/Data.hpp>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace fgl;
+
+// textures loaded by a BatchLoader have to be evicted to stay within the memory budget, the same as textures loaded by the asset manager
+bool ImageLoadBenchmark_checkBatchLoadEviction(AssetManager* assetManager, const Image& image, const String& basePath)
+{
+	const size_t textureCount = 3;
+	ArrayList<String> paths;
+	for(size_t i=0; i<textureCount; i++)
+	{
+		String path = FileTools::getAbsolutePath(basePath + "." + i + ".png");
+		if(!image.saveToPath(path))
+		{
+			return false;
+		}
+		paths.add(path);
+	}
+	size_t textureSize = image.getWidth() * image.getHeight() * 4;
+	assetManager->setMemoryBudget(textureSize + (textureSize / 2));
+	BatchLoader loader(assetManager);
+	for(auto& path : paths)
+	{
+		loader.addTexture(path);
+	}
+	loader.loadAll();
+	bool passed = (assetManager->getMemoryUsage() <= assetManager->getMemoryBudget()
+		&& assetManager->getTexture(paths[0]) == nullptr
+		&& assetManager->getTexture(paths[textureCount-1]) != nullptr
+		&& assetManager->loadTexture(paths[0]) != nullptr);
+	assetManager->unloadTextures();
+	assetManager->setMemoryBudget(0);
+	for(auto& path : paths)
+	{
+		std::remove(path);
+	}
+	return passed;
+}
+
+int main(int argc, char* argv[])
+{
+	fglbench::HeadlessWindow window;
+	Graphics& graphics = window.getGraphics();
+
+	// a sprite sheet with flat areas, gradients, noise and transparent gaps, so that it compresses like a real asset
+	const size_t width = 512;
+	const size_t height = 512;
+	std::srand(12345);
+	Image sheet;
+	sheet.create(width, height);
+	for(size_t y=0; y<height; y++)
+	{
+		for(size_t x=0; x<width; x++)
+		{
+			if(((x / 64) + (y / 64)) % 5 == 0)
+			{
+				continue;
+			}
+			Uint8 noise = (Uint8)(std::rand() % 16);
+			sheet.setPixel(x, y, Color((Uint8)(x / 2), (Uint8)(y / 2), (Uint8)(((x / 32) * 40) + noise), 255));
+		}
+	}
+	String path = String(argv[0]) + ".png";
+	String error;
+	if(!sheet.saveToPath(path, &error))
+	{
+		std::fprintf(stderr, "unable to save %s: %s\n", (const char*)path, (const char*)error);
+		return 1;
+	}
+	Data png;
+	bool loaded = png.loadFromPath(path, &error);
+	std::remove(path);
+	if(!loaded)
+	{
+		std::fprintf(stderr, "unable to load %s: %s\n", (const char*)path, (const char*)error);
+		return 1;
+	}
+	fglbench::reportValue("image.load.png_512", "bytes", (double)png.size());
+	if(!fglbench::check("asset_manager.batch_load_eviction", ImageLoadBenchmark_checkBatchLoadEviction(window.getAssetManager(), sheet, String(argv[0]))))
+	{
+		return 1;
+	}
+
+	fglbench::run("image.load.png_512", 20, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Image image;
+			if(!image.loadFromPointer(png.getData(), png.size()))
+			{
+				std::abort();
+			}
+			fglbench::doNotOptimize(image);
+		}
+	});
+	fglbench::run("texture.load.png_512", 20, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			TextureImage texture;
+			if(!texture.loadFromPointer(png.getData(), png.size(), graphics))
+			{
+				std::abort();
+			}
+			fglbench::doNotOptimize(texture);
+		}
+	});
+	fglbench::run("texture.load.image_512", 20, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			TextureImage texture;
+			if(!texture.loadFromImage(sheet, graphics))
+			{
+				std::abort();
+			}
+			fglbench::doNotOptimize(texture);
+		}
+	});
+
+	return 0;
+}
@@ -0,0 +1,146 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Graphics/PixelConverter.hpp>
+#include <GameLibrary/Graphics/PixelIterator.hpp>
+#include <cstdlib>
+#include <vector>
+
+using namespace fgl;
+
+// the loops that Image used before PixelConverter, for comparison
+void recolorPerPixel(std::vector<Color>& pixels, const ArrayList<std::pair<Color,Color>>& colorSwaps)
+{
+	size_t total = pixels.size();
+	size_t totalSwaps = colorSwaps.size();
+	for(size_t i=0; i<total; i++)
+	{
+		for(size_t j=0; j<totalSwaps; j++)
+		{
+			const std::pair<Color,Color>& colorSwap = colorSwaps.get(j);
+			if(pixels[i].equals(colorSwap.first))
+			{
+				pixels[i] = colorSwap.second;
+				break;
+			}
+		}
+	}
+}
+
+void compositePerPixel(std::vector<Color>& pixels, const std::vector<Color>& mask, size_t width, size_t height)
+{
+	RectangleD dstRect = RectangleD(0, 0, (double)width, (double)height);
+	PixelIterator pxlIter(Vector2u((unsigned int)width, (unsigned int)height), RectangleU(0, 0, (unsigned int)width, (unsigned int)height), dstRect, dstRect, 1, 1, false, false);
+	PixelIterator mask_pxlIter(Vector2u((unsigned int)width, (unsigned int)height), RectangleU(0, 0, (unsigned int)width, (unsigned int)height), dstRect, dstRect, 1, 1, false, false);
+	std::vector<bool> masked(pixels.size(), false);
+	while(pxlIter.nextPixelIndex() && mask_pxlIter.nextPixelIndex())
+	{
+		double pxlIndex = pxlIter.getCurrentPixelIndex();
+		double mask_pxlIndex = mask_pxlIter.getCurrentPixelIndex();
+		if(pxlIndex >= 0 && mask_pxlIndex >= 0)
+		{
+			size_t index = (size_t)pxlIndex;
+			if(!masked[index])
+			{
+				pixels[index] = pixels[index].composite(mask[(size_t)mask_pxlIndex]);
+				masked[index] = true;
+			}
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	// a character sheet drawn with a small palette, like the ones recolored by a customizer
+	const size_t width = 2048;
+	const size_t height = 2048;
+	std::srand(12345);
+	std::vector<Color> palette;
+	for(size_t i=0; i<48; i++)
+	{
+		palette.push_back(Color((Uint8)std::rand(), (Uint8)std::rand(), (Uint8)std::rand(), 255));
+	}
+	palette.push_back(Color(0, 0, 0, 0));
+	std::vector<Color> sheet(width*height);
+	for(size_t i=0; i<sheet.size(); i+=8)
+	{
+		// short runs of the same color
+		Color color = palette[std::rand() % palette.size()];
+		for(size_t j=i; j<(i+8); j++)
+		{
+			sheet[j] = color;
+		}
+	}
+	ArrayList<std::pair<Color,Color>> colorSwaps;
+	for(size_t i=0; i<32; i++)
+	{
+		colorSwaps.add(std::pair<Color,Color>(palette[i], Color((Uint8)std::rand(), (Uint8)std::rand(), (Uint8)std::rand(), 255)));
+	}
+	std::vector<Color> overlay(width*height);
+	for(size_t i=0; i<overlay.size(); i++)
+	{
+		overlay[i] = Color((Uint8)std::rand(), (Uint8)std::rand(), (Uint8)std::rand(), (Uint8)((i % 3 == 0) ? 0 : std::rand()));
+	}
+
+	struct InstructionSetCase
+	{
+		const char* name;
+		PixelConverter::InstructionSet instructionSet;
+	};
+	InstructionSetCase instructionSets[] = {
+		{ "scalar", PixelConverter::InstructionSet::SCALAR },
+		{ "sse2", PixelConverter::InstructionSet::SSE2 },
+		{ "avx2", PixelConverter::InstructionSet::AVX2 }
+	};
+
+	std::vector<Color> pixels;
+	fglbench::run("image.recolor.per_pixel", 1, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			pixels = sheet;
+			recolorPerPixel(pixels, colorSwaps);
+			fglbench::doNotOptimize(pixels);
+		}
+	});
+	fglbench::run("image.composite.per_pixel", 1, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			pixels = sheet;
+			compositePerPixel(pixels, overlay, width, height);
+			fglbench::doNotOptimize(pixels);
+		}
+	});
+	for(const InstructionSetCase& instructionSetCase : instructionSets)
+	{
+		if(instructionSetCase.instructionSet > PixelConverter::getInstructionSet())
+		{
+			continue;
+		}
+		std::string suffix = std::string(".") + instructionSetCase.name;
+		fglbench::run("image.recolor" + suffix, 1, [&](size_t count) {
+			for(size_t i=0; i<count; i++)
+			{
+				pixels = sheet;
+				PixelConverter::recolor(pixels.data(), pixels.size(), colorSwaps.getData(), colorSwaps.size(), instructionSetCase.instructionSet);
+				fglbench::doNotOptimize(pixels);
+			}
+		});
+		fglbench::run("image.composite" + suffix, 1, [&](size_t count) {
+			for(size_t i=0; i<count; i++)
+			{
+				pixels = sheet;
+				PixelConverter::composite(pixels.data(), overlay.data(), pixels.size(), instructionSetCase.instructionSet);
+				fglbench::doNotOptimize(pixels);
+			}
+		});
+		fglbench::run("image.blend_alpha" + suffix, 1, [&](size_t count) {
+			for(size_t i=0; i<count; i++)
+			{
+				pixels = sheet;
+				PixelConverter::blend(pixels.data(), overlay.data(), pixels.size(), Image::BlendMode::ALPHA, instructionSetCase.instructionSet);
+				fglbench::doNotOptimize(pixels);
+			}
+		});
+	}
+
+	return 0;
+}
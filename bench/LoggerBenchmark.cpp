@@ -0,0 +1,79 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/IO/Logger.hpp>
+#include <fstream>
+#include <string>
+
+using namespace fgl;
+
+// Console output has to be written exactly as it was given, even when it's repeated, filtered by level, or fills the thread buffer
+bool LoggerBenchmark_checkConsoleOutput()
+{
+	const char* path = "bin/bench/logger_console.log";
+	const size_t lineCount = Logger::THREAD_BUFFER_SIZE * 3;
+	if(!Logger::openFile(path))
+	{
+		return false;
+	}
+	size_t droppedCount = Logger::getDroppedCount();
+	Logger::setLevel(Logger::LEVEL_NONE);
+	for(size_t i=0; i<lineCount; i++)
+	{
+		Logger::logOutput(Logger::LEVEL_INFO, "console output", true);
+	}
+	Logger::setLevel(Logger::LEVEL_DEBUG);
+	Logger::closeFile();
+	std::ifstream file(path);
+	std::string line;
+	size_t writtenCount = 0;
+	while(std::getline(file, line))
+	{
+		if(line.find("console output") != std::string::npos)
+		{
+			writtenCount++;
+		}
+	}
+	return (writtenCount == lineCount && Logger::getDroppedCount() == droppedCount);
+}
+
+int main(int argc, char* argv[])
+{
+	// the cost of logging, with the output going to a file so the results stay readable
+	Logger::setConsoleEnabled(false);
+	if(!fglbench::check("logger.console_output", LoggerBenchmark_checkConsoleOutput()))
+	{
+		return 1;
+	}
+	Logger::openFile("bin/bench/logger.log");
+	const size_t operations = 100000;
+	fglbench::run("logger.log.filtered", operations, [&](size_t count) {
+		Logger::setLevel(Logger::LEVEL_WARNING);
+		for(size_t i=0; i<count; i++)
+		{
+			FGL_LOG_INFO((String)"filtered message " + i);
+		}
+		Logger::setLevel(Logger::LEVEL_DEBUG);
+	});
+	fglbench::run("logger.log", operations, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			FGL_LOG_INFO((String)"message " + i);
+			if((i % 512) == 511)
+			{
+				// wait for the writer before the thread buffer fills, so no messages are dropped and its cost is included
+				Logger::flush();
+			}
+		}
+		Logger::flush();
+	});
+	fglbench::run("logger.log.rate_limited", operations, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			FGL_LOG_RATE_LIMITED(Logger::LEVEL_ERROR, 100, (String)"rate limited message " + i);
+		}
+		Logger::flush();
+	});
+	fglbench::reportValue("logger.log", "dropped", (double)Logger::getDroppedCount());
+	Logger::closeFile();
+	return 0;
+}
@@ -0,0 +1,147 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Network/NetworkProtocol.hpp>
+#include <GameLibrary/Network/NetworkTransport.hpp>
+#include <GameLibrary/Network/ReplicationClient.hpp>
+#include <GameLibrary/Network/ReplicationServer.hpp>
+#include <GameLibrary/World/World.hpp>
+#include <GameLibrary/World/Aspects/Movement/Transform2DAspect.hpp>
+#include <GameLibrary/World/Aspects/Movement/Velocity2DAspect.hpp>
+#include <GameLibrary/World/Aspects/Network/ReplicatedAspect.hpp>
+#include <cstdlib>
+#include <vector>
+
+using namespace fgl;
+
+double randomValue(double range)
+{
+	return ((double)std::rand() / (double)RAND_MAX - 0.5) * range;
+}
+
+// moves every object by its velocity, and steers a few of them, like one frame of a game
+void stepObjects(const std::vector<WorldObject*>& objects, double seconds, size_t steerCount)
+{
+	for(auto object : objects)
+	{
+		auto transform = object->getAspect<Transform2DAspect>();
+		auto velocity = object->getAspect<Velocity2DAspect>();
+		transform->setPosition(transform->getPosition() + (velocity->getVelocity() * seconds));
+	}
+	for(size_t i=0; i<steerCount; i++)
+	{
+		auto velocity = objects[(size_t)std::rand() % objects.size()]->getAspect<Velocity2DAspect>();
+		velocity->setVelocity(Vector2d(randomValue(200.0), randomValue(200.0)));
+	}
+}
+
+NetworkProtocol::Snapshot createSnapshot(Uint32 sequence, size_t count, const NetworkProtocol::Snapshot* previous)
+{
+	NetworkProtocol::Snapshot snapshot;
+	snapshot.sequence = sequence;
+	snapshot.time = sequence * 33;
+	for(size_t i=0; i<count; i++)
+	{
+		NetworkProtocol::EntityState state;
+		if(previous != nullptr)
+		{
+			state = previous->entities[i];
+			state.x += state.velocityX * 33 / 1000;
+			state.y += state.velocityY * 33 / 1000;
+			if((std::rand() % 10) == 0)
+			{
+				state.velocityX = (Int32)randomValue(3200.0);
+			}
+		}
+		else
+		{
+			state = { (Uint32)(i + 1), (Int32)randomValue(16000.0), (Int32)randomValue(16000.0), (Int32)randomValue(3200.0), (Int32)randomValue(3200.0) };
+		}
+		snapshot.entities.push_back(state);
+	}
+	return snapshot;
+}
+
+int main(int argc, char* argv[])
+{
+	std::srand(12345);
+	NetworkProtocol::Settings settings;
+	// no packet limit, so that the whole delta is measured
+	settings.maxPacketSize = (size_t)-1;
+
+	for(size_t count : { 100, 500, 2000 })
+	{
+		NetworkProtocol::Snapshot baseline = createSnapshot(1, count, nullptr);
+		NetworkProtocol::Snapshot snapshot = createSnapshot(2, count, &baseline);
+		NetworkProtocol::Snapshot sent;
+		BitWriter writer;
+		fglbench::run("network.encode.full."+std::to_string(count), 1000, [&](size_t iterations) {
+			for(size_t i=0; i<iterations; i++)
+			{
+				writer.clear();
+				NetworkProtocol::encodeSnapshot(snapshot, nullptr, settings, nullptr, writer, &sent);
+			}
+		});
+		fglbench::reportValue("network.encode.full."+std::to_string(count), "bytes", (double)writer.getByteCount());
+		fglbench::run("network.encode.delta."+std::to_string(count), 1000, [&](size_t iterations) {
+			for(size_t i=0; i<iterations; i++)
+			{
+				writer.clear();
+				NetworkProtocol::encodeSnapshot(snapshot, &baseline, settings, nullptr, writer, &sent);
+			}
+		});
+		fglbench::reportValue("network.encode.delta."+std::to_string(count), "bytes", (double)writer.getByteCount());
+		NetworkProtocol::Snapshot decoded;
+		fglbench::run("network.decode.delta."+std::to_string(count), 1000, [&](size_t iterations) {
+			for(size_t i=0; i<iterations; i++)
+			{
+				BitReader reader(writer.getData(), writer.getByteCount());
+				NetworkProtocol::readPacketType(reader);
+				NetworkProtocol::decodeSnapshot(reader, [&](Uint32 sequence) { return &baseline; }, settings, &decoded);
+			}
+		});
+	}
+
+	// a server and a client world connected by a loopback transport, simulating 10 seconds at 60 frames per second and 30 snapshots per second
+	for(size_t count : { 100, 500 })
+	{
+		World serverWorld(nullptr);
+		World clientWorld(nullptr);
+		std::vector<WorldObject*> objects;
+		for(size_t i=0; i<count; i++)
+		{
+			auto object = new WorldObject();
+			object->addAspect(new Transform2DAspect(Vector2d(randomValue(1000.0), randomValue(1000.0))));
+			object->addAspect(new Velocity2DAspect(Vector2d(randomValue(200.0), randomValue(200.0)), 0.0, false));
+			object->addAspect(new ReplicatedAspect());
+			serverWorld.addObject(object);
+			objects.push_back(object);
+		}
+		LoopbackTransport serverTransport;
+		LoopbackTransport clientTransport;
+		LoopbackTransport::connect(&serverTransport, &clientTransport);
+		ReplicationServer server(&serverWorld, NetworkProtocol::Settings(), 30.0);
+		server.addConnection(&serverTransport);
+		ReplicationClient client(&clientWorld, &clientTransport, [](Uint32 networkID) {
+			auto object = new WorldObject();
+			object->addAspect(new Transform2DAspect());
+			object->addAspect(new Velocity2DAspect(Vector2d(0, 0), 0.0, false));
+			return object;
+		});
+		ApplicationData appData(nullptr, nullptr, nullptr, TimeInterval(16), TransformD(), 1.0/60.0);
+		const size_t frames = 600;
+		auto result = fglbench::run("network.replicate."+std::to_string(count), frames, [&](size_t iterations) {
+			for(size_t i=0; i<iterations; i++)
+			{
+				// a tenth of the objects change direction every second
+				stepObjects(objects, 1.0/60.0, (count / 600) + 1);
+				server.update(appData);
+				client.update(appData);
+			}
+		}, 1);
+		double seconds = server.getTime() / 1000.0;
+		fglbench::reportValue("network.replicate."+std::to_string(count), "bytes_per_second", (double)server.getBytesSent() / seconds);
+		fglbench::reportValue("network.replicate."+std::to_string(count), "bytes_per_snapshot", (double)server.getBytesSent() / (double)server.getSequence());
+		fglbench::doNotOptimize(result);
+	}
+	return 0;
+}
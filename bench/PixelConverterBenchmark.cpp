@@ -0,0 +1,160 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Graphics/PixelConverter.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace fgl;
+
+// the per pixel conversion that the image loaders used before PixelConverter, for comparison
+void convertPerPixel(const Uint8* src, size_t width, size_t height, size_t pitch, unsigned int bpp, const PixelConverter::Layout& layout, Color* dst, std::vector<bool>& mask)
+{
+	unsigned int rmask = 0xFFu << layout.rshift;
+	unsigned int gmask = 0xFFu << layout.gshift;
+	unsigned int bmask = 0xFFu << layout.bshift;
+	unsigned int amask = 0xFFu << layout.ashift;
+	mask.resize(width*height);
+	size_t counter = 0;
+	size_t pitchDif = pitch - (width*bpp);
+	size_t i = 0;
+	for(size_t y=0; y<height; y++)
+	{
+		for(size_t x=0; x<width; x++)
+		{
+			Color& px = dst[i];
+			switch(bpp)
+			{
+				case 1:
+				px = layout.palette[src[counter]];
+				break;
+
+				case 3:
+				case 4:
+				{
+					Uint32 color = 0;
+					std::memcpy(&color, &src[counter], bpp);
+					px.r = (Uint8)((color & rmask) >> layout.rshift);
+					px.g = (Uint8)((color & gmask) >> layout.gshift);
+					px.b = (Uint8)((color & bmask) >> layout.bshift);
+					px.a = (bpp == 4) ? (Uint8)((color & amask) >> layout.ashift) : 255;
+				}
+				break;
+			}
+			mask[i] = (px.a > 0);
+			i++;
+			counter += bpp;
+		}
+		counter += pitchDif;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	// a large sprite sheet, where about half of each frame is transparent
+	const size_t width = 4096;
+	const size_t height = 4096;
+	std::vector<Uint8> sheet(width*height*4);
+	std::srand(12345);
+	for(size_t y=0; y<height; y++)
+	{
+		for(size_t x=0; x<width; x++)
+		{
+			Uint8* pixel = &sheet[((y*width)+x)*4];
+			bool inFrame = ((x % 64) > 16 && (x % 64) < 48) || ((y % 64) > 16 && (y % 64) < 48);
+			for(size_t i=0; i<3; i++)
+			{
+				pixel[i] = (Uint8)std::rand();
+			}
+			pixel[3] = inFrame ? 255 : 0;
+		}
+	}
+	std::vector<Uint8> indexedSheet(width*height);
+	for(size_t i=0; i<indexedSheet.size(); i++)
+	{
+		indexedSheet[i] = sheet[(i*4)+3] == 0 ? 0 : (Uint8)(1 + (std::rand() % 255));
+	}
+	Color palette[256];
+	palette[0] = Color(0, 0, 0, 0);
+	for(size_t i=1; i<256; i++)
+	{
+		palette[i] = Color((Uint8)i, (Uint8)(255-i), (Uint8)(i*7), 255);
+	}
+
+	std::vector<Color> pixels(width*height);
+	std::vector<bool> boolMask;
+	PixelMask mask;
+
+	fglbench::reportValue("pixels.instruction_set", "value", (double)PixelConverter::getInstructionSet());
+
+	struct Case
+	{
+		const char* name;
+		PixelConverter::Format format;
+		const Uint8* data;
+	};
+	Case cases[] = {
+		{ "abgr8888", PixelConverter::Format::ABGR8888, sheet.data() },
+		{ "argb8888", PixelConverter::Format::ARGB8888, sheet.data() },
+		{ "rgb24", PixelConverter::Format::RGB24, sheet.data() },
+		{ "index8", PixelConverter::Format::INDEX8, indexedSheet.data() }
+	};
+	struct InstructionSetCase
+	{
+		const char* name;
+		PixelConverter::InstructionSet instructionSet;
+	};
+	InstructionSetCase instructionSets[] = {
+		{ "scalar", PixelConverter::InstructionSet::SCALAR },
+		{ "sse2", PixelConverter::InstructionSet::SSE2 },
+		{ "avx2", PixelConverter::InstructionSet::AVX2 }
+	};
+
+	for(const Case& testCase : cases)
+	{
+		PixelConverter::Layout layout = PixelConverter::getLayout(testCase.format, palette);
+		size_t pitch = width * layout.bytesPerPixel;
+		std::string prefix = std::string("pixels.") + testCase.name;
+		fglbench::run(prefix + ".per_pixel", 1, [&](size_t count) {
+			for(size_t i=0; i<count; i++)
+			{
+				convertPerPixel(testCase.data, width, height, pitch, layout.bytesPerPixel, layout, pixels.data(), boolMask);
+				fglbench::doNotOptimize(pixels);
+				fglbench::doNotOptimize(boolMask);
+			}
+		});
+		for(const InstructionSetCase& instructionSetCase : instructionSets)
+		{
+			if(instructionSetCase.instructionSet > PixelConverter::getInstructionSet())
+			{
+				continue;
+			}
+			fglbench::run(prefix + "." + instructionSetCase.name, 1, [&](size_t count) {
+				for(size_t i=0; i<count; i++)
+				{
+					PixelConverter::convert(layout, testCase.data, width, height, pitch, pixels.data(), width*sizeof(Color), &mask, instructionSetCase.instructionSet);
+					fglbench::doNotOptimize(pixels);
+					fglbench::doNotOptimize(mask);
+				}
+			});
+		}
+	}
+
+	// building the mask of an already decoded Image, like BatchLoader does on its workers
+	for(const InstructionSetCase& instructionSetCase : instructionSets)
+	{
+		if(instructionSetCase.instructionSet > PixelConverter::getInstructionSet())
+		{
+			continue;
+		}
+		fglbench::run(std::string("pixels.create_mask.") + instructionSetCase.name, 1, [&](size_t count) {
+			for(size_t i=0; i<count; i++)
+			{
+				PixelConverter::createMask(pixels.data(), pixels.size(), &mask, instructionSetCase.instructionSet);
+				fglbench::doNotOptimize(mask);
+			}
+		});
+	}
+
+	return 0;
+}
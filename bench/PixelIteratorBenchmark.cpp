@@ -0,0 +1,189 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Graphics/PixelIterator.hpp>
+#include <GameLibrary/Graphics/PixelMask.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace fgl;
+
+// gets the index of every sample from the spans of an iterator, or -1 for samples outside of the source rectangle
+std::vector<long long> PixelIteratorBenchmark_getSpanIndexes(PixelIterator& iterator, size_t width, size_t columns)
+{
+	std::vector<long long> indexes;
+	PixelIterator::Span span;
+	while(iterator.nextPixelSpan(&span))
+	{
+		size_t rowStart = indexes.size();
+		indexes.resize(rowStart + columns, -1);
+		for(size_t j=0; j<span.count; j++)
+		{
+			indexes[rowStart + span.sample + j] = (long long)((width*span.row) + span.getColumn(j));
+		}
+	}
+	return indexes;
+}
+
+// gets the index of every sample by stepping the iterator one sample at a time
+std::vector<long long> PixelIteratorBenchmark_getSampleIndexes(PixelIterator& iterator)
+{
+	std::vector<long long> indexes;
+	while(iterator.nextPixelIndex())
+	{
+		double index = iterator.getCurrentPixelIndex();
+		indexes.push_back((index >= 0) ? (long long)index : -1);
+	}
+	return indexes;
+}
+
+// spans have to land on the same pixels as the per-sample path, with or without mirroring, so collisions don't depend on which path is taken
+bool PixelIteratorBenchmark_checkSpansMatchSamples()
+{
+	const unsigned int width = 64;
+	const unsigned int height = 64;
+	RectangleU srcRects[] = { RectangleU(0, 0, 16, 16), RectangleU(5, 9, 16, 12) };
+	double scales[] = { 1, 2, 0.5 };
+	double increments[] = { 1, 0.5, 2, 3 };
+	for(const RectangleU& srcRect : srcRects)
+	{
+		for(double scale : scales)
+		{
+			RectangleD dstRect(10, 20, srcRect.width*scale, srcRect.height*scale);
+			RectangleD loopRects[] = { dstRect, RectangleD(dstRect.x+scale, dstRect.y+(2*scale), dstRect.width-(3*scale), dstRect.height-(2*scale)) };
+			for(const RectangleD& loopRect : loopRects)
+			{
+				for(double increment : increments)
+				{
+					for(int mirror=0; mirror<4; mirror++)
+					{
+						bool mirrorHorizontal = (mirror & 1) != 0;
+						bool mirrorVertical = (mirror & 2) != 0;
+						PixelIterator spanIterator(Vector2u(width, height), srcRect, dstRect, loopRect, increment, increment, mirrorHorizontal, mirrorVertical);
+						PixelIterator sampleIterator(Vector2u(width, height), srcRect, dstRect, loopRect, increment, increment, mirrorHorizontal, mirrorVertical);
+						PixelIterator transformIterator(Vector2u(width, height), srcRect, dstRect, loopRect, increment, increment, TransformD(), Vector2d(1.0/scale, 1.0/scale), mirrorHorizontal, mirrorVertical);
+						size_t columns = (size_t)Math::ceil(loopRect.width/increment);
+						auto spanIndexes = PixelIteratorBenchmark_getSpanIndexes(spanIterator, width, columns);
+						if(spanIndexes != PixelIteratorBenchmark_getSampleIndexes(sampleIterator)
+							|| spanIndexes != PixelIteratorBenchmark_getSampleIndexes(transformIterator))
+						{
+							std::fprintf(stderr, "spans differ from samples: src (%u,%u) scale %g loop (%g,%g) increment %g mirror %d\n", srcRect.x, srcRect.y, scale, loopRect.x, loopRect.y, increment, mirror);
+							return false;
+						}
+						if(scale == 1 && increment == 1 && loopRect == dstRect)
+						{
+							// at 1:1 the first and last samples of a row are the edge columns of the source rectangle
+							long long firstColumn = spanIndexes.front() % width;
+							long long lastColumn = spanIndexes[columns-1] % width;
+							long long leftColumn = srcRect.x;
+							long long rightColumn = srcRect.x + srcRect.width - 1;
+							if(firstColumn != (mirrorHorizontal ? rightColumn : leftColumn) || lastColumn != (mirrorHorizontal ? leftColumn : rightColumn))
+							{
+								std::fprintf(stderr, "edge columns are wrong: src (%u,%u) mirror %d\n", srcRect.x, srcRect.y, mirror);
+								return false;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	if(!fglbench::check("pixel_iterator.spans_match_samples", PixelIteratorBenchmark_checkSpansMatchSamples()))
+	{
+		return 1;
+	}
+
+	// a mostly transparent sprite sheet, checked the way a pixel collision rect checks against a filled rect
+	const unsigned int width = 1024;
+	const unsigned int height = 1024;
+	std::srand(12345);
+	PixelMask mask(width*height);
+	for(unsigned int y=0; y<height; y++)
+	{
+		for(unsigned int x=0; x<width; x++)
+		{
+			if((x % 128) == 100 && (y % 128) == 100)
+			{
+				mask.set((y*width)+x, true);
+			}
+		}
+	}
+	RectangleU srcRect(128, 128, 256, 256);
+	RectangleD dstRect(0, 0, 512, 512);
+	struct Case
+	{
+		const char* name;
+		bool mirrorHorizontal;
+		double increment;
+	};
+	Case cases[] = {
+		{ "scaled", false, 2 },
+		{ "mirrored", true, 2 },
+		{ "sparse", false, 6 }
+	};
+
+	for(const Case& testCase : cases)
+	{
+		// the hidden pixel sits in the bottom right corner of the area, so most of the area is checked
+		RectangleD loopRect(0, 0, 400, 400);
+		std::string prefix = std::string("pixel_iterator.") + testCase.name;
+		fglbench::run(prefix + ".per_sample", 1, [&](size_t count) {
+			for(size_t i=0; i<count; i++)
+			{
+				PixelIterator iterator(Vector2u(width, height), srcRect, dstRect, loopRect, testCase.increment, testCase.increment, testCase.mirrorHorizontal, false);
+				size_t hits = 0;
+				while(iterator.nextPixelIndex())
+				{
+					double index = iterator.getCurrentPixelIndex();
+					if(index >= 0 && mask.get((size_t)index))
+					{
+						hits++;
+					}
+				}
+				fglbench::doNotOptimize(hits);
+			}
+		});
+		fglbench::run(prefix + ".spans", 1, [&](size_t count) {
+			for(size_t i=0; i<count; i++)
+			{
+				PixelIterator iterator(Vector2u(width, height), srcRect, dstRect, loopRect, testCase.increment, testCase.increment, testCase.mirrorHorizontal, false);
+				PixelIterator::Span span;
+				size_t hits = 0;
+				while(iterator.nextPixelSpan(&span))
+				{
+					if(span.count == 0)
+					{
+						continue;
+					}
+					size_t rowIndex = width*span.row;
+					if(span.step <= ((Int64)1 << PixelIterator::Span::FIXED_SHIFT) && span.step >= -((Int64)1 << PixelIterator::Span::FIXED_SHIFT))
+					{
+						if(mask.any(rowIndex+span.srcStart, rowIndex+span.srcEnd))
+						{
+							hits++;
+						}
+					}
+					else
+					{
+						for(size_t j=0; j<span.count; j++)
+						{
+							if(mask.get(rowIndex+span.getColumn(j)))
+							{
+								hits++;
+								break;
+							}
+						}
+					}
+				}
+				fglbench::doNotOptimize(hits);
+			}
+		});
+	}
+
+	return 0;
+}
@@ -0,0 +1,131 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Utilities/Plist.hpp>
+
+using namespace fgl;
+
+bool PlistBenchmark_equals(const Any& left, const Any& right);
+
+bool PlistBenchmark_equals(const Plist::hash_dict& left, const Plist::hash_dict& right)
+{
+	if(left.size() != right.size())
+	{
+		return false;
+	}
+	for(auto& pair : left)
+	{
+		if(!right.has(pair.first) || !PlistBenchmark_equals(pair.second, right.get(pair.first)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool PlistBenchmark_equals(const Any& left, const Any& right)
+{
+	if(left.is<Plist::hash_dict>() && right.is<Plist::hash_dict>())
+	{
+		return PlistBenchmark_equals(left.as<Plist::hash_dict>(), right.as<Plist::hash_dict>());
+	}
+	else if(left.is<Plist::array>() && right.is<Plist::array>())
+	{
+		const Plist::array& leftArray = left.as<Plist::array>();
+		const Plist::array& rightArray = right.as<Plist::array>();
+		if(leftArray.size() != rightArray.size())
+		{
+			return false;
+		}
+		for(size_t i=0; i<leftArray.size(); i++)
+		{
+			if(!PlistBenchmark_equals(leftArray[i], rightArray[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	else if(left.is<Plist::string>() && right.is<Plist::string>())
+	{
+		return left.as<Plist::string>() == right.as<Plist::string>();
+	}
+	else if(left.is<Number>() && right.is<Number>())
+	{
+		return left.as<Number>() == right.as<Number>();
+	}
+	return false;
+}
+
+int main(int argc, char* argv[])
+{
+	// a save file like plist, with many entities that share the same keys
+	HashDictionary save;
+	Plist::array entities;
+	for(size_t i=0; i<20000; i++)
+	{
+		Plist::hash_dict entity;
+		entity.set("name", String("entity_") + (int)i);
+		entity.set("x", Number((double)i * 1.5));
+		entity.set("y", Number((double)i * -0.5));
+		entity.set("health", Number((long long)(i % 100)));
+		entity.set("active", Number((i % 2) == 0));
+		entity.set("tag", String("enemy"));
+		entities.add(std::move(entity));
+	}
+	save.set("entities", std::move(entities));
+	save.set("version", Number(3));
+
+	Data xmlData;
+	Data binaryData;
+	Plist::saveToData(save, &xmlData, Plist::Format::XML);
+	Plist::saveToData(save, &binaryData, Plist::Format::BINARY);
+	fglbench::reportValue("plist.xml_size", "bytes", (double)xmlData.size());
+	fglbench::reportValue("plist.binary_size", "bytes", (double)binaryData.size());
+
+	// the loaded plists have to match the saved one, or the timings below measure the wrong thing
+	HashDictionary xmlLoaded;
+	HashDictionary binaryLoaded;
+	bool xmlMatches = Plist::loadFromData(&xmlLoaded, xmlData) && PlistBenchmark_equals(save, xmlLoaded);
+	bool binaryMatches = Plist::loadFromData(&binaryLoaded, binaryData) && PlistBenchmark_equals(save, binaryLoaded);
+	fglbench::check("plist.xml_round_trip", xmlMatches);
+	fglbench::check("plist.binary_round_trip", binaryMatches);
+	if(!xmlMatches || !binaryMatches)
+	{
+		return 1;
+	}
+
+	fglbench::run("plist.load_xml", 1, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			HashDictionary dict;
+			Plist::loadFromData(&dict, xmlData);
+			fglbench::doNotOptimize(dict);
+		}
+	});
+	fglbench::run("plist.load_binary", 1, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			HashDictionary dict;
+			Plist::loadFromData(&dict, binaryData);
+			fglbench::doNotOptimize(dict);
+		}
+	});
+	fglbench::run("plist.save_xml", 1, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Data data;
+			Plist::saveToData(save, &data, Plist::Format::XML);
+			fglbench::doNotOptimize(data);
+		}
+	});
+	fglbench::run("plist.save_binary", 1, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Data data;
+			Plist::saveToData(save, &data, Plist::Format::BINARY);
+			fglbench::doNotOptimize(data);
+		}
+	});
+
+	return 0;
+}
@@ -0,0 +1,40 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Utilities/Profiler.hpp>
+
+using namespace fgl;
+
+void profiledCall(size_t& counter)
+{
+	FGL_PROFILE_ZONE("bench")
+	counter++;
+}
+
+int main(int argc, char* argv[])
+{
+	// the cost of a single zone, with the profiler off and on
+	const size_t operations = 1000000;
+	size_t counter = 0;
+	fglbench::run("profiler.zone.disabled", operations, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			profiledCall(counter);
+		}
+		fglbench::doNotOptimize(counter);
+	});
+	Profiler::setEnabled(true);
+	fglbench::run("profiler.zone.enabled", operations, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			profiledCall(counter);
+			if((i % 4096) == 4095)
+			{
+				Profiler::endFrame();
+			}
+		}
+		Profiler::endFrame();
+		fglbench::doNotOptimize(counter);
+	});
+	Profiler::setEnabled(false);
+	return 0;
+}
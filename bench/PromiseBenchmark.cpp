@@ -0,0 +1,77 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Utilities/Promise.hpp>
+#include <future>
+
+using namespace fgl;
+
+int main(int argc, char* argv[])
+{
+	size_t sink = 0;
+
+	// a resolved promise with a single continuation, the most common case while loading assets
+	fglbench::run("promise.resolve_then", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Promise<size_t>::resolve(i).then([&](size_t value) {
+				sink += value;
+			});
+		}
+	});
+
+	// continuations added before the promise is resolved
+	fglbench::run("promise.pending_then", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Promise<size_t>::Resolver resolver;
+			Promise<size_t> promise([&](auto resolve, auto reject) {
+				resolver = resolve;
+			});
+			promise.then([&](size_t value) {
+				sink += value;
+			});
+			resolver(i);
+		}
+	});
+
+	// a chain of promises, each returning the next one
+	fglbench::run("promise.chain", 200000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Promise<size_t>::resolve(i).then<size_t>([](size_t value) {
+				return Promise<size_t>::resolve(value + 1);
+			}).then<size_t>([](size_t value) {
+				return Promise<size_t>::resolve(value * 2);
+			}).then([&](size_t value) {
+				sink += value;
+			});
+		}
+	});
+
+	// gathering the results of many promises
+	fglbench::run("promise.all", 1000000, [&](size_t count) {
+		ArrayList<Promise<size_t>> promises;
+		promises.reserve(count);
+		for(size_t i=0; i<count; i++)
+		{
+			promises.add(Promise<size_t>::resolve(i));
+		}
+		Promise<size_t>::all(promises).then([&](ArrayList<size_t> results) {
+			sink += results.size();
+		});
+	}, 3);
+
+	// std::promise and std::shared_future, which the promise core used to be built on
+	fglbench::run("std_promise.set_get", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			std::promise<size_t> promise;
+			std::shared_future<size_t> future = promise.get_future().share();
+			promise.set_value(i);
+			sink += future.get();
+		}
+	});
+
+	fglbench::doNotOptimize(sink);
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include "Benchmark.hpp"
+#include <GameLibrary/Screen/ScreenElement.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace fgl;
+
+// a cell of an inventory grid, which handles every touch event that reaches it
+class InventoryCell : public ScreenElement
+{
+public:
+	InventoryCell(const RectangleD& frame, ScreenElement** handledElement, size_t* visitCount)
+		: ScreenElement(frame),
+		handledElement(handledElement),
+		visitCount(visitCount)
+	{
+		//
+	}
+
+protected:
+	virtual bool handleTouchEvent(const TouchEvent& touchEvent) override
+	{
+		(*visitCount)++;
+		*handledElement = this;
+		return true;
+	}
+
+private:
+	ScreenElement** handledElement;
+	size_t* visitCount;
+};
+
+// finds the element a touch should go to by checking every child element from the top down
+ScreenElement* ScreenElementBenchmark_findTopElement(ScreenElement* root, const Vector2d& point)
+{
+	const ArrayList<ScreenElement*>& elements = root->getChildElements();
+	for(size_t i=elements.size()-1; i!=(size_t)-1; i--)
+	{
+		if(elements[i]->getFrame().contains(point))
+		{
+			return elements[i];
+		}
+	}
+	return nullptr;
+}
+
+Vector2d ScreenElementBenchmark_randomPoint(const RectangleD& area)
+{
+	double x = area.x + (area.width * ((double)std::rand() / (double)RAND_MAX));
+	double y = area.y + (area.height * ((double)std::rand() / (double)RAND_MAX));
+	return Vector2d(x, y);
+}
+
+int main(int argc, char* argv[])
+{
+	// an inventory screen with 2,000 cells, which overlap slightly so that the order of the cells matters
+	const size_t columns = 50;
+	const size_t rows = 40;
+	const double pitch = 40;
+	const double cellSize = 44;
+	ScreenElement* handledElement = nullptr;
+	size_t visitCount = 0;
+	RectangleD area(0, 0, (columns*pitch)+cellSize, (rows*pitch)+cellSize);
+	ScreenElement root(area);
+	for(size_t row=0; row<rows; row++)
+	{
+		for(size_t column=0; column<columns; column++)
+		{
+			root.addChildElement(new InventoryCell(RectangleD(column*pitch, row*pitch, cellSize, cellSize), &handledElement, &visitCount));
+		}
+	}
+	ApplicationData appData(nullptr, nullptr, nullptr, TimeInterval(16), TransformD(), 1.0);
+	auto sendMove = [&](const Vector2d& point) -> ScreenElement* {
+		handledElement = nullptr;
+		root.sendTouchEvent(ScreenElement::TouchEvent(ScreenElement::TouchEvent::EVENTTYPE_TOUCHMOVE, 0, appData, point, true));
+		return handledElement;
+	};
+
+	// the element that handles each event has to be the top element under the touch, including points outside of every cell
+	std::srand(12345);
+	RectangleD checkArea(area.x-20, area.y-20, area.width+40, area.height+40);
+	size_t mismatchCount = 0;
+	for(size_t i=0; i<5000; i++)
+	{
+		Vector2d point = ScreenElementBenchmark_randomPoint(checkArea);
+		if(sendMove(point) != ScreenElementBenchmark_findTopElement(&root, point))
+		{
+			mismatchCount++;
+		}
+	}
+	if(!fglbench::check("screen_element.touch_routing_matches_linear", mismatchCount == 0))
+	{
+		std::fprintf(stderr, "%zu of 5000 touch events went to the wrong element\n", mismatchCount);
+		return 1;
+	}
+
+	const size_t eventCount = 100000;
+	std::vector<Vector2d> points;
+	points.reserve(eventCount);
+	for(size_t i=0; i<eventCount; i++)
+	{
+		points.push_back(ScreenElementBenchmark_randomPoint(area));
+	}
+	fglbench::run("screen_element.touch_move.2000", eventCount, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			fglbench::doNotOptimize(sendMove(points[i % eventCount]));
+		}
+	});
+	visitCount = 0;
+	for(size_t i=0; i<eventCount; i++)
+	{
+		sendMove(points[i]);
+	}
+	fglbench::reportValue("screen_element.touch_move.2000", "cells_visited_per_event", (double)visitCount / (double)eventCount);
+	fglbench::run("screen_element.linear_hit_test.2000", eventCount, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			fglbench::doNotOptimize(ScreenElementBenchmark_findTopElement(&root, points[i % eventCount]));
+		}
+	});
+
+	return 0;
+}
@@ -0,0 +1,190 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Utilities/Atom.hpp>
+#include <GameLibrary/Utilities/String.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace fgl;
+
+int main(int argc, char* argv[])
+{
+	const char* shortText = "hitbox";
+	const char* longText = "this string is too long to fit in the inline buffer";
+	String shortString = shortText;
+	String longString = longText;
+	std::string shortStdString = shortText;
+	std::string longStdString = longText;
+
+	// construct
+	fglbench::run("string.construct_short", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			String str = shortText;
+			fglbench::doNotOptimize(str);
+		}
+	});
+	fglbench::run("std_string.construct_short", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			std::string str = shortText;
+			fglbench::doNotOptimize(str);
+		}
+	});
+	fglbench::run("string.construct_long", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			String str = longText;
+			fglbench::doNotOptimize(str);
+		}
+	});
+	fglbench::run("std_string.construct_long", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			std::string str = longText;
+			fglbench::doNotOptimize(str);
+		}
+	});
+
+	// copy
+	fglbench::run("string.copy_short", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			String str = shortString;
+			fglbench::doNotOptimize(str);
+		}
+	});
+	fglbench::run("std_string.copy_short", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			std::string str = shortStdString;
+			fglbench::doNotOptimize(str);
+		}
+	});
+	fglbench::run("string.copy_long", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			String str = longString;
+			fglbench::doNotOptimize(str);
+		}
+	});
+
+	// compare
+	String otherLongString = longText;
+	std::string otherLongStdString = longText;
+	fglbench::run("string.compare_equal", 1000000, [&](size_t count) {
+		size_t matches = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			fglbench::doNotOptimize(otherLongString);
+			matches += (longString == otherLongString) ? 1 : 0;
+		}
+		fglbench::doNotOptimize(matches);
+	});
+	fglbench::run("std_string.compare_equal", 1000000, [&](size_t count) {
+		size_t matches = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			fglbench::doNotOptimize(otherLongStdString);
+			matches += (longStdString == otherLongStdString) ? 1 : 0;
+		}
+		fglbench::doNotOptimize(matches);
+	});
+	Atom longAtom = longString;
+	Atom otherLongAtom = otherLongString;
+	fglbench::run("atom.compare_equal", 1000000, [&](size_t count) {
+		size_t matches = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			fglbench::doNotOptimize(otherLongAtom);
+			matches += (longAtom == otherLongAtom) ? 1 : 0;
+		}
+		fglbench::doNotOptimize(matches);
+	});
+
+	// concat
+	fglbench::run("string.concat", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			String str = shortString + "_" + shortString;
+			fglbench::doNotOptimize(str);
+		}
+	});
+	fglbench::run("std_string.concat", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			std::string str = shortStdString + "_" + shortStdString;
+			fglbench::doNotOptimize(str);
+		}
+	});
+	fglbench::run("string.append_loop", 100000, [&](size_t count) {
+		String str;
+		for(size_t i=0; i<count; i++)
+		{
+			str += 'a';
+		}
+		fglbench::doNotOptimize(str);
+	});
+	fglbench::run("std_string.append_loop", 100000, [&](size_t count) {
+		std::string str;
+		for(size_t i=0; i<count; i++)
+		{
+			str += 'a';
+		}
+		fglbench::doNotOptimize(str);
+	});
+
+	// hash lookups, like asset or tag tables
+	std::vector<String> keys;
+	std::vector<std::string> stdKeys;
+	for(size_t i=0; i<1024; i++)
+	{
+		keys.push_back(String("assets/images/sprite_") + (int)i + ".png");
+		stdKeys.push_back("assets/images/sprite_" + std::to_string(i) + ".png");
+	}
+	std::unordered_map<String, size_t> stringMap;
+	std::unordered_map<std::string, size_t> stdStringMap;
+	std::unordered_map<Atom, size_t> atomMap;
+	std::vector<Atom> atomKeys;
+	for(size_t i=0; i<keys.size(); i++)
+	{
+		stringMap[keys[i]] = i;
+		stdStringMap[stdKeys[i]] = i;
+		atomKeys.push_back(keys[i]);
+		atomMap[atomKeys[i]] = i;
+	}
+	fglbench::run("string.hash_lookup", 1000000, [&](size_t count) {
+		size_t sum = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			sum += stringMap.find(keys[i % keys.size()])->second;
+		}
+		fglbench::doNotOptimize(sum);
+	});
+	fglbench::run("std_string.hash_lookup", 1000000, [&](size_t count) {
+		size_t sum = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			sum += stdStringMap.find(stdKeys[i % stdKeys.size()])->second;
+		}
+		fglbench::doNotOptimize(sum);
+	});
+	fglbench::run("atom.hash_lookup", 1000000, [&](size_t count) {
+		size_t sum = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			sum += atomMap.find(atomKeys[i % atomKeys.size()])->second;
+		}
+		fglbench::doNotOptimize(sum);
+	});
+	fglbench::run("atom.intern_existing", 1000000, [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			Atom atom = keys[i % keys.size()];
+			fglbench::doNotOptimize(atom);
+		}
+	});
+
+	return 0;
+}
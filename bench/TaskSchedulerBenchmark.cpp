@@ -0,0 +1,132 @@
+
+#include "Benchmark.hpp"
+#include <GameLibrary/Utilities/TaskScheduler.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace fgl;
+
+// waits until a counter reaches a target
+class Latch
+{
+public:
+	explicit Latch(size_t count) : count(count) {}
+
+	void countDown()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		count--;
+		if(count == 0)
+		{
+			condition.notify_all();
+		}
+	}
+
+	void wait()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [&]() {
+			return count == 0;
+		});
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable condition;
+	size_t count;
+};
+
+// the previous Thread::runOnThread implementation, which started a detached thread for each task
+void runOnNewThread(const std::function<void()>& func)
+{
+	std::thread th(func);
+	th.detach();
+}
+
+void smallWork(std::atomic<size_t>& sink)
+{
+	size_t value = 0;
+	for(size_t i=0; i<64; i++)
+	{
+		value += i * i;
+	}
+	sink.fetch_add(value, std::memory_order_relaxed);
+}
+
+int main(int argc, char* argv[])
+{
+	TaskScheduler scheduler;
+	std::atomic<size_t> sink(0);
+
+	// throughput: schedule many small tasks and wait for all of them
+	fglbench::run("thread_per_task.throughput", 2000, [&](size_t count) {
+		Latch latch(count);
+		for(size_t i=0; i<count; i++)
+		{
+			runOnNewThread([&]() {
+				smallWork(sink);
+				latch.countDown();
+			});
+		}
+		latch.wait();
+	}, 3);
+	fglbench::run("task_scheduler.throughput", 200000, [&](size_t count) {
+		Latch latch(count);
+		for(size_t i=0; i<count; i++)
+		{
+			scheduler.schedule([&]() {
+				smallWork(sink);
+				latch.countDown();
+			});
+		}
+		latch.wait();
+	});
+
+	// latency: time from scheduling a task until it starts running, one task at a time
+	auto measureLatency = [&](const char* name, size_t count, const std::function<void(const std::function<void()>&)>& runTask) {
+		double totalMicroseconds = 0;
+		double maxMicroseconds = 0;
+		for(size_t i=0; i<count; i++)
+		{
+			Latch latch(1);
+			fglbench::Clock::time_point started;
+			auto scheduled = fglbench::Clock::now();
+			runTask([&]() {
+				started = fglbench::Clock::now();
+				latch.countDown();
+			});
+			latch.wait();
+			double microseconds = std::chrono::duration<double, std::micro>(started - scheduled).count();
+			totalMicroseconds += microseconds;
+			maxMicroseconds = std::max(maxMicroseconds, microseconds);
+		}
+		fglbench::reportValue(name, "avg_latency_us", totalMicroseconds / (double)count);
+		fglbench::reportValue(name, "max_latency_us", maxMicroseconds);
+	};
+	measureLatency("thread_per_task.latency", 500, [&](const std::function<void()>& task) {
+		runOnNewThread(task);
+	});
+	measureLatency("task_scheduler.latency", 5000, [&](const std::function<void()>& task) {
+		scheduler.schedule(task);
+	});
+
+	// parallelFor over a large range
+	std::vector<float> values(1 << 20, 1.0f);
+	fglbench::run("task_scheduler.parallel_for", values.size(), [&](size_t count) {
+		scheduler.parallelFor(0, count, [&](size_t i) {
+			values[i] = (values[i] * 0.5f) + 1.0f;
+		});
+	});
+	fglbench::run("serial_for", values.size(), [&](size_t count) {
+		for(size_t i=0; i<count; i++)
+		{
+			values[i] = (values[i] * 0.5f) + 1.0f;
+		}
+		fglbench::doNotOptimize(values[0]);
+	});
+
+	fglbench::doNotOptimize(sink);
+	return 0;
+}
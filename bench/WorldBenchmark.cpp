@@ -0,0 +1,164 @@
+
+#include "BenchmarkWindow.hpp"
+#include <GameLibrary/Animation/Animation.hpp>
+#include <GameLibrary/Graphics/TextureImage.hpp>
+#include <GameLibrary/Physics/CollisionRects/PixelCollisionRect.hpp>
+#include <GameLibrary/World/World.hpp>
+#include <GameLibrary/World/Aspects/Drawing/SpriteAspect.hpp>
+#include <GameLibrary/World/Aspects/Movement/Transform2DAspect.hpp>
+#include <GameLibrary/World/Aspects/Physics/BoxCollidable2DAspect.hpp>
+#include <GameLibrary/World/Aspects/Physics/PolygonCollidable2DAspect.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace fgl;
+
+// a collidable that collides using the visible pixels of a texture, centered on its transform
+class PixelCollidable2DAspect : public Collidable2DAspect
+{
+public:
+	explicit PixelCollidable2DAspect(TextureImage* image)
+		: image(image)
+	{
+		//
+	}
+
+protected:
+	virtual ArrayList<const CollisionRect*> createCollisionRects() const override
+	{
+		double width = (double)image->getWidth();
+		double height = (double)image->getHeight();
+		RectangleD rect = RectangleD(-width/2.0, -height/2.0, width, height);
+		RectangleU srcRect = RectangleU(0, 0, (unsigned int)image->getWidth(), (unsigned int)image->getHeight());
+		return { new PixelCollisionRect("pixels", rect, rect, srcRect, image, false, false) };
+	}
+
+private:
+	TextureImage* image;
+};
+
+// a world of objects scattered so that many of them overlap, which can be put back to where it started
+class ScatteredWorld
+{
+public:
+	ScatteredWorld(AssetManager* assetManager, size_t count, double spread, const std::function<void(WorldObject*)>& addAspects)
+		: world(assetManager)
+	{
+		std::srand(12345);
+		for(size_t i=0; i<count; i++)
+		{
+			Vector2d position = Vector2d(((double)std::rand()/(double)RAND_MAX - 0.5) * spread, ((double)std::rand()/(double)RAND_MAX - 0.5) * spread);
+			auto object = new WorldObject();
+			auto transform = new Transform2DAspect(position);
+			object->addAspect(transform);
+			addAspects(object);
+			world.addObject(object);
+			transforms.push_back(transform);
+			positions.push_back(position);
+		}
+	}
+
+	void reset()
+	{
+		for(size_t i=0; i<transforms.size(); i++)
+		{
+			transforms[i]->setPosition(positions[i]);
+		}
+	}
+
+	World world;
+	std::vector<Transform2DAspect*> transforms;
+	std::vector<Vector2d> positions;
+};
+
+TextureImage* createCircleTexture(Graphics& graphics, size_t size)
+{
+	Image image;
+	image.create(size, size);
+	double radius = (double)size / 2.0;
+	for(size_t y=0; y<size; y++)
+	{
+		for(size_t x=0; x<size; x++)
+		{
+			double dx = ((double)x + 0.5) - radius;
+			double dy = ((double)y + 0.5) - radius;
+			if((dx*dx + dy*dy) <= (radius*radius))
+			{
+				image.setPixel(x, y, Color((Uint8)(x * 8), (Uint8)(y * 8), 128, 255));
+			}
+		}
+	}
+	auto texture = new TextureImage();
+	String error;
+	if(!texture->loadFromImage(image, graphics, &error))
+	{
+		throw Exception(error);
+	}
+	return texture;
+}
+
+void benchmarkCollisions(fglbench::HeadlessWindow& window, const std::string& name, size_t count, const std::function<void(WorldObject*)>& addAspects)
+{
+	// about 4 objects overlap each object
+	ScatteredWorld scattered(window.getAssetManager(), count, 16.0 * std::sqrt((double)count), addAspects);
+	ApplicationData appData = window.createAppData();
+	auto collisionManager = scattered.world.getCollisionManager();
+	fglbench::run("collision."+name+"."+std::to_string(count), 10, [&](size_t frames) {
+		for(size_t i=0; i<frames; i++)
+		{
+			scattered.reset();
+			collisionManager->update(appData);
+		}
+	});
+}
+
+int main(int argc, char* argv[])
+{
+	fglbench::HeadlessWindow window;
+	Graphics& graphics = window.getGraphics();
+	TextureImage* circle = createCircleTexture(graphics, 32);
+
+	for(size_t count : { 100, 500 })
+	{
+		benchmarkCollisions(window, "boxes", count, [](WorldObject* object) {
+			object->addAspect(new BoxCollidable2DAspect(RectangleD(-16, -16, 32, 32)));
+		});
+		benchmarkCollisions(window, "polygons", count, [](WorldObject* object) {
+			PolygonD polygon = { {0,-16}, {15,-5}, {9,13}, {-9,13}, {-15,-5} };
+			object->addAspect(new PolygonCollidable2DAspect(polygon));
+		});
+		benchmarkCollisions(window, "pixels", count, [=](WorldObject* object) {
+			object->addAspect(new PixelCollidable2DAspect(circle));
+		});
+	}
+
+	Animation animation(1, circle);
+	for(size_t count : { 100, 1000 })
+	{
+		ScatteredWorld scattered(window.getAssetManager(), count, 400.0, [&](WorldObject* object) {
+			object->addAspect(new SpriteAspect(&animation));
+			object->addAspect(new BoxCollidable2DAspect(RectangleD(-16, -16, 32, 32)));
+		});
+		ApplicationData appData = window.createAppData();
+		auto drawManager = scattered.world.getDrawManager();
+		drawManager->update(appData);
+		fglbench::run("draw.sprites."+std::to_string(count), 10, [&](size_t frames) {
+			for(size_t i=0; i<frames; i++)
+			{
+				drawManager->draw(DrawContext(&appData, nullptr, drawManager), graphics);
+			}
+		});
+		// a whole headless frame, including the collision and draw managers
+		fglbench::run("world.frame."+std::to_string(count), 10, [&](size_t frames) {
+			for(size_t i=0; i<frames; i++)
+			{
+				scattered.world.update(appData);
+				scattered.world.draw(appData, graphics);
+			}
+		});
+	}
+
+	delete circle;
+	return 0;
+}
@@ -77,11 +77,11 @@ namespace fgl
 		
 		/*! Updates certain properties of the Actor, such as mouse state, and calls Actor events.
 			\param appData specifies information about the Application updating the Actor, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData*/
-		virtual void update(ApplicationData appData);
+		virtual void update(const ApplicationData& appData);
 		/*! Draws the Actor to the screen using the specified Graphics object
 			\param appData specifies information about the Application drawing the Actor, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData
 			\param graphics the Graphics object used to draw the Actor*/
-		virtual void draw(ApplicationData appData, Graphics graphics) const;
+		virtual void draw(const ApplicationData& appData, Graphics graphics) const;
 		
 		
 		/*! Gets the actual bounding box of the Actor. The bounding box resizes based on rotation, scaling, and other transformations.
@@ -300,8 +300,8 @@ namespace fgl
 		MouseTouchData* getTouchData(unsigned int touchID);
 		ArrayList<unsigned int> getDifTouchData(const ArrayList<unsigned int>&touchIDs);
 		
-		void updateMouse(ApplicationData& appData);
-		void updateTouch(ApplicationData& appData);
-		void callMouseEvents(ApplicationData& appData, const ArrayList<ActorMouseEvent>& eventCallData);
+		void updateMouse(const ApplicationData& appData);
+		void updateTouch(const ApplicationData& appData);
+		void callMouseEvents(const ApplicationData& appData, const ArrayList<ActorMouseEvent>& eventCallData);
 	};
 }
@@ -27,9 +27,9 @@ namespace fgl
 		
 		
 		/*! \copydoc fgl::Actor::update(ApplicationData)*/
-		virtual void update(ApplicationData appData) override;
+		virtual void update(const ApplicationData& appData) override;
 		/*! \copydoc fgl::Actor::draw(ApplicationData,Graphics)const*/
-		virtual void draw(ApplicationData appData, Graphics graphics) const override;
+		virtual void draw(const ApplicationData& appData, Graphics graphics) const override;
 		
 		
 		/*! \copydoc fgl::Actor::getFrame()const*/
@@ -73,7 +73,7 @@ namespace fgl
 			\param x the x coordinate
 			\param y the y coordinate
 			\param scale the ratio to size the WireframeActor from its default size*/
-		virtual void drawActor(ApplicationData& appData, Graphics& graphics, double x, double y, double scale) const;
+		virtual void drawActor(const ApplicationData& appData, Graphics& graphics, double x, double y, double scale) const;
 		
 	private:
 		bool filled;
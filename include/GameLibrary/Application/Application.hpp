@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <GameLibrary/Graphics/Graphics.hpp>
 #include <GameLibrary/Utilities/ArrayList.hpp>
@@ -8,6 +9,8 @@
 #include <GameLibrary/Utilities/Time/TimeInterval.hpp>
 #include <GameLibrary/Window/Window.hpp>
 #include "ApplicationData.hpp"
+#include "FramePacer.hpp"
+#include <GameLibrary/Graphics/RenderCommandList.hpp>
 
 namespace fgl
 {
@@ -72,11 +75,14 @@ namespace fgl
 		virtual void unloadContent(AssetManager*assetManager);
 		/*! Called once every frame. Use this function to update or change any values during the frame.
 			\param appData specifies information about the Application, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData*/
-		virtual void update(ApplicationData appData);
+		virtual void update(const ApplicationData& appData);
 		/*! Called once every frame. Use this function to draw to the Window.
 			\param appData specifies information about the Application, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData
 			\param graphics the Graphics object used to draw to the Window*/
-		virtual void draw(ApplicationData appData, Graphics graphics) const;
+		virtual void draw(const ApplicationData& appData, Graphics graphics) const;
+		/*! Called after each frame while idle waiting is enabled, to tell whether anything on screen is changing on its own. Override this to check the Application's Screens and Worlds, such as by returning screenManager->isAnimating() || world->isAnimating().
+			\returns true to keep running frames at the set FPS, or false to wait for input. The default implementation returns false.*/
+		virtual bool isAnimating() const;
 		
 
 		/*! Runs the Application. This should only be called once by a single Application object, and not called again until the Application loop ends.
@@ -93,11 +99,33 @@ namespace fgl
 		
 		
 		/*! Sets the refresh rate of the Application in frames per second. This specifies how often update and draw are called.
-			\param fps the frame rate of the Application in frames per second*/
+			\param fps the frame rate of the Application in frames per second, or 0 to run frames without waiting between them*/
 		void setFPS(unsigned int fps);
 		/*! Gets the refresh rate of the Application in frames per second. This specifies how often update and draw are called.
 			\returns the frame rate of the Application in frames per second*/
 		unsigned int getFPS() const;
+		/*! Sets whether update and draw run on a separate simulation thread while the main thread draws the previous frame. In pipelined mode, draw records its drawing operations to a RenderCommandList, and the main thread draws that list while the next frame is updated, so a frame is shown one frame after it's drawn.
+		Anything that uses SDL directly, such as loading assets or creating and updating TextureImages, must happen in loadContent or be passed to Thread::runOnMainThread while pipelined. Fonts, TextureImages, and other resources that are drawn must not be deleted until the frame after they were last drawn. This setting takes effect the next time the Application runs.
+			\param pipelined true to run update and draw on a separate thread, or false to run them on the main thread*/
+		void setPipelinedRendering(bool pipelined);
+		/*! Tells whether update and draw run on a separate simulation thread while the main thread draws the previous frame.
+			\returns true if rendering is pipelined, or false if otherwise*/
+		bool isPipelinedRendering() const;
+		/*! Sets whether the refresh loop stops running frames while the Application is idle. While idle waiting is enabled and isAnimating returns false, the loop waits until input arrives, a task is passed to Thread::runOnMainThread, or a frame requested with requestFrame is due, instead of drawing frames that would look the same. Idle waiting is never used while input is being recorded or replayed.
+			\param enabled true to wait while idle, or false to always run frames at the set FPS*/
+		void setIdleWaitEnabled(bool enabled);
+		/*! Tells whether the refresh loop stops running frames while the Application is idle.
+			\returns true if idle waiting is enabled, or false if otherwise*/
+		bool isIdleWaitEnabled() const;
+		/*! Makes sure a frame runs after a delay, even if the Application is idle, such as for a timer. If an earlier frame has already been requested, the earlier request is kept. This function can be called from any thread.
+			\param delayMilliseconds the time until the frame should run, in milliseconds*/
+		void requestFrame(long long delayMilliseconds=0);
+		/*! Gets the FramePacer that keeps the refresh loop at the target frame rate, which can be used to adjust how it waits, or to read its frame time measurements.
+			\returns a reference to the FramePacer*/
+		FramePacer& getFramePacer();
+		/*! Gets the FramePacer that keeps the refresh loop at the target frame rate.
+			\returns a const reference to the FramePacer*/
+		const FramePacer& getFramePacer() const;
 		/*! Gets the current Window being used by the Application.
 			\returns a pointer to the Window object being used by the Application.*/
 		Window* getWindow() const;
@@ -122,6 +150,12 @@ namespace fgl
 
 		unsigned int fps;
 		unsigned long long sleeptime;
+		FramePacer framePacer;
+		RenderCommandList commandLists[2];
+		bool pipelinedRendering;
+		bool idleWaitEnabled;
+		// the FramePacer::now time of the earliest requested frame, or 0 if no frame has been requested
+		std::atomic<Int64> requestedFrameTime;
 
 		int exitcode;
 
@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <memory>
+#include <GameLibrary/Application/FramePacer.hpp>
+#include <GameLibrary/Utilities/HashDictionary.hpp>
 #include <GameLibrary/Utilities/Geometry/Transform.hpp>
 #include <GameLibrary/Utilities/Time/TimeInterval.hpp>
 #include <GameLibrary/Window/Window.hpp>
@@ -22,10 +25,6 @@ namespace fgl
 			\param transform the view transform of the Application
 			\param framespeedMult the frame speed multiplier of the Application*/
 		ApplicationData(Application*application, Window*window, AssetManager*assetManager, const TimeInterval&timeInterval, const TransformD&transform, double framespeedMult);
-
-
-		//! Optional additional data to be passed down to draw and update functions
-		Dictionary additionalData;
 		
 		
 		/*! Gets the Application being used.
@@ -49,9 +48,21 @@ namespace fgl
 		/*! Gets the Viewport Transform of the Window
 			\returns a const Transform reference*/
 		const TransformD& getTransform() const;
-		/*! Gets the frame speed multiplier of the Application
+		/*! Gets the frame speed multiplier of the Application. This is the target frame time in seconds, so it stays the same from frame to frame.
 			\returns a double value*/
 		double getFrameSpeedMultiplier() const;
+		/*! Gets the measured time between the start of the previous frame and the start of this one. While input is being recorded or replayed, this is the target frame time, so replays run the same way as their recordings.
+			\returns the frame delta in seconds*/
+		double getFrameDelta() const;
+		/*! Gets an average of the recent frame deltas, which is less noisy than getFrameDelta.
+			\returns the smoothed frame delta in seconds*/
+		double getSmoothedFrameDelta() const;
+		/*! Gets the histogram of the Application's measured frame deltas.
+			\returns a const FramePacer::Histogram reference, which is empty if no histogram was set*/
+		const FramePacer::Histogram& getFrameTimeHistogram() const;
+		/*! Gets the optional additional data passed down to draw and update functions. Copies of an ApplicationData share the same additional data until one of them changes it.
+			\returns a const HashDictionary reference*/
+		const HashDictionary& getAdditionalData() const;
 		
 		
 		/*! Sets the current Application.
@@ -69,6 +80,20 @@ namespace fgl
 		/*! Sets the current Viewport Transform
 			\param transform a const Transform reference*/
 		void setTransform(const TransformD&transform);
+		/*! Sets the measured frame deltas. Both default to the frame speed multiplier.
+			\param frameDelta the time since the previous frame, in seconds
+			\param smoothedFrameDelta an average of the recent frame deltas, in seconds*/
+		void setFrameDelta(double frameDelta, double smoothedFrameDelta);
+		/*! Sets the histogram of frame deltas. The histogram is not copied, so it must stay valid while this ApplicationData is used.
+			\param histogram a FramePacer::Histogram pointer, or null for an empty histogram*/
+		void setFrameTimeHistogram(const FramePacer::Histogram* histogram);
+		/*! Sets a value in the additional data. If the additional data is shared with other copies of this ApplicationData, it's copied first, so the other copies don't see the change.
+			\param key the key of the value
+			\param value the value to set*/
+		void setAdditionalData(const HashDictionary::Key& key, Any value);
+		/*! Removes a value from the additional data.
+			\param key the key of the value to remove*/
+		void removeAdditionalData(const HashDictionary::Key& key);
 		
 	private:
 		Application* application;
@@ -77,5 +102,9 @@ namespace fgl
 		TimeInterval timeInterval;
 		TransformD transform;
 		double framespeedMult;
+		double frameDelta;
+		double smoothedFrameDelta;
+		const FramePacer::Histogram* frameTimeHistogram;
+		std::shared_ptr<HashDictionary> additionalData;
 	};
 }
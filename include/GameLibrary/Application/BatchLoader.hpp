@@ -1,9 +1,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <GameLibrary/Types.hpp>
+#include <GameLibrary/Graphics/Image.hpp>
+#include <GameLibrary/Graphics/PixelMask.hpp>
 #include <GameLibrary/Utilities/ArrayList.hpp>
+#include <GameLibrary/Utilities/Data.hpp>
 #include <GameLibrary/Utilities/Time/TimeInterval.hpp>
 
 namespace fgl
@@ -18,7 +27,8 @@ namespace fgl
 		\tThis returns true on success, or false on failure*/
 	typedef bool(*BatchLoaderFunction)(AssetManager*, String*);
 
-	/*! Stores and loads a list of assets.*/
+	/*! Stores and loads a list of assets.\n
+		Textures and fonts are read from disk and decoded on a set of worker threads, and are then uploaded on the main thread in the order they were added.*/
 	class BatchLoader
 	{
 	public:
@@ -68,12 +78,30 @@ namespace fgl
 		unsigned int getLoadTotal();
 		
 		
-		/*! Loads all of the queued assets.*/
+		/*! Sets the number of worker threads used to read and decode textures and fonts. A value of 0 loads everything on the calling thread.
+			\param workerCount the number of worker threads to use. The default is the number of hardware threads*/
+		void setWorkerCount(unsigned int workerCount);
+		/*! Gets the number of worker threads used to read and decode textures and fonts.
+			\returns the number of worker threads*/
+		unsigned int getWorkerCount() const;
+		
+		
+		/*! Loads all of the queued assets, blocking until they have finished loading. This must be called on the main thread.*/
 		void loadAll();
-		/*! Loads the next queued asset.*/
+		/*! Starts decoding all of the queued assets on the worker threads and returns immediately. The decoded assets are uploaded by calling BatchLoader::update on the main thread.
+			\note assets should not be added to the BatchLoader while a load is in progress*/
+		void loadAllAsync();
+		/*! Uploads decoded assets on the calling thread, in the order they were added, until the time budget has been used. This must be called on the main thread.
+			\param timeBudget the maximum time to spend uploading assets, in milliseconds. A negative value waits for and uploads every remaining asset
+			\returns true if there are still assets left to load, or false if the load has finished or was stopped*/
+		bool update(double timeBudget);
+		/*! Loads the next queued asset on the calling thread.*/
 		void loadNext();
-		/*! Stops the current load, if loadAll has been called.*/
+		/*! Stops the current load, if loadAll or loadAllAsync has been called.*/
 		void stopLoad();
+		/*! Tells whether a load is currently in progress.
+			\returns true if loadAll or loadAllAsync has been called and has not finished or been stopped*/
+		bool isLoading() const;
 		
 		
 		/*! Removes all the queued assets.*/
@@ -94,6 +122,27 @@ namespace fgl
 			unsigned int value;
 			std::function<bool(AssetManager*,String*)> func;
 		} LoadInfo;
+		
+		// the output of a worker thread for a single queued asset
+		struct DecodeResult
+		{
+			bool needsDecode = false;
+			bool finished = false;
+			bool success = false;
+			std::unique_ptr<Image> image;
+			PixelMask pixelMask;
+			Data fontData;
+			String error;
+		};
+		
+		void startWorkers();
+		void stopWorkers();
+		void runWorker();
+		void decode(const LoadInfo& info, DecodeResult& result) const;
+		bool uploadNext(bool wait);
+		void finishLoad();
+		
+		void callLoadListeners(const LoadInfo& info, bool success, const String& error);
 
 		AssetManager*assetManager;
 
@@ -106,6 +155,14 @@ namespace fgl
 		ArrayList<BatchLoaderEventListener*> eventListeners;
 
 		bool loading;
+		
+		unsigned int workerCount;
+		std::vector<std::thread> workers;
+		std::vector<DecodeResult> decodeResults;
+		std::atomic<size_t> decodeindex;
+		std::atomic<bool> decoding;
+		std::mutex decodeMutex;
+		std::condition_variable decodeCondition;
 	};
 	
 	
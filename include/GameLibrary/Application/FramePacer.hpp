@@ -0,0 +1,106 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+
+namespace fgl
+{
+	/*! Keeps a loop running at a steady frame rate, and measures how long each frame actually took.
+		Frame deadlines are spaced exactly one frame apart on the steady clock, so a frame that finishes late makes the following wait shorter instead of pushing every later frame back. If the loop falls more than a frame behind, the deadlines are moved up to the current time rather than running frames back to back to catch up.
+		Waiting sleeps until shortly before the deadline, and then spins for the rest, since sleeping can oversleep by about a millisecond.*/
+	class FramePacer
+	{
+	public:
+		/*! Counts frame times in buckets of a fixed width.*/
+		class Histogram
+		{
+		public:
+			/*! the width of each bucket, in nanoseconds*/
+			static constexpr Int64 BUCKET_NANOSECONDS = 250000;
+			/*! the number of buckets. The last bucket also counts every frame time longer than it.*/
+			static constexpr size_t BUCKET_COUNT = 128;
+
+			/*! default constructor*/
+			Histogram();
+
+			/*! Adds a frame time.
+				\param nanoseconds the frame time*/
+			void add(Int64 nanoseconds);
+			/*! Removes every frame time.*/
+			void clear();
+
+			/*! Gets the number of frame times in a bucket.
+				\param index the index of the bucket. A bucket holds times from index*BUCKET_NANOSECONDS up to the next bucket.
+				\returns the number of frame times in the bucket*/
+			size_t getCount(size_t index) const;
+			/*! Gets the number of frame times that have been added.
+				\returns the total number of frame times*/
+			size_t getTotalCount() const;
+			/*! Gets the frame time that a fraction of frames were shorter than, such as 0.99 for the 99th percentile.
+				\param fraction the fraction of frames, from 0 to 1
+				\returns the upper edge of the bucket containing the percentile, in nanoseconds, or 0 if the histogram is empty*/
+			Int64 getPercentile(double fraction) const;
+
+		private:
+			size_t counts[BUCKET_COUNT];
+			size_t totalCount;
+		};
+
+		/*! the default time before a deadline when waiting stops sleeping and starts spinning*/
+		static constexpr Int64 DEFAULT_SPIN_NANOSECONDS = 2000000;
+
+		/*! Constructs a frame pacer.
+			\param fps the target frame rate, or 0 to not wait between frames*/
+		explicit FramePacer(double fps);
+
+		/*! Sets the target frame rate. The next deadline is moved to one frame after the current frame began.
+			\param fps the target frame rate, or 0 to not wait between frames*/
+		void setTargetFPS(double fps);
+		/*! Gets the target frame rate.
+			\returns the target frame rate, or 0 if the pacer doesn't wait*/
+		double getTargetFPS() const;
+		/*! Sets how long before a deadline waiting switches from sleeping to spinning. Longer times are more accurate but use more CPU.
+			\param nanoseconds the spin time, in nanoseconds*/
+		void setSpinTime(Int64 nanoseconds);
+		/*! Gets how long before a deadline waiting switches from sleeping to spinning.
+			\returns the spin time, in nanoseconds*/
+		Int64 getSpinTime() const;
+
+		/*! Clears the measurements and the frame deadline, so the next call to beginFrame starts over.*/
+		void reset();
+		/*! Marks the start of a frame, and measures the time since the previous frame started.*/
+		void beginFrame();
+		/*! Waits until the next frame should begin.*/
+		void waitForNextFrame();
+		/*! Starts timing over after the loop waited for longer than a frame, such as while idle, so the wait isn't measured as a frame delta. The measurements are kept.*/
+		void resume();
+
+		/*! Gets the time between the start of the previous frame and the start of the current frame.
+			\returns the frame delta in seconds, or the target frame time on the first frame*/
+		double getFrameDelta() const;
+		/*! Gets an average of the recent frame deltas, which is less noisy than a single frame delta.
+			\returns the smoothed frame delta in seconds*/
+		double getSmoothedFrameDelta() const;
+		/*! Gets the histogram of every frame delta measured since the last reset.
+			\returns a const Histogram reference*/
+		const Histogram& getHistogram() const;
+		/*! Gets the number of frames that were still running when the next frame should have begun, since the last reset.
+			\returns the number of late frames*/
+		size_t getLateFrameCount() const;
+
+		/*! Gets the current time of the steady clock the pacer uses.
+			\returns the time in nanoseconds*/
+		static Int64 now();
+
+	private:
+		double fps;
+		Int64 frameNanoseconds;
+		Int64 spinNanoseconds;
+		Int64 frameStartTime;
+		Int64 deadline;
+		Int64 frameDelta;
+		double smoothedFrameDelta;
+		Histogram histogram;
+		size_t lateFrameCount;
+	};
+}
@@ -0,0 +1,134 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <GameLibrary/Audio/Music.hpp>
+#include <GameLibrary/Audio/Sound.hpp>
+#include <GameLibrary/Utilities/MPSCQueue.hpp>
+#include <GameLibrary/Utilities/String.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace fgl
+{
+	struct AudioMixerCommand;
+	struct AudioMixerVoice;
+	struct AudioMixerStream;
+
+	/*! Mixes playing Sound effects and a streamed Music track into an SDL audio device.
+		Functions that change what is playing don't touch the mixer's state directly. They push a command onto a lock-free queue, which the audio callback applies at the start of its next block, so the game thread never waits for the audio thread and the audio thread never locks or allocates. Gain and pan changes are ramped across a block to avoid clicks.
+		Music is read from disk and converted in chunks on a background thread, into a ring buffer that the audio callback reads from.
+		Samples are mixed as interleaved 32 bit float stereo at AudioMixer::SAMPLE_RATE. The mixer can be tested without a sound card by setting SDL_AUDIODRIVER to "dummy" or "disk", or by calling mix directly without opening a device.*/
+	class AudioMixer
+	{
+	public:
+		/*! the number of frames per second that are mixed*/
+		static const unsigned int SAMPLE_RATE;
+		/*! the number of interleaved channels that are mixed*/
+		static const unsigned int CHANNELS;
+
+		/*! Constructs a mixer.
+			\param maxVoices the maximum number of sounds that can play at once*/
+		explicit AudioMixer(size_t maxVoices=64);
+		AudioMixer(const AudioMixer&) = delete;
+		AudioMixer& operator=(const AudioMixer&) = delete;
+		/*! destructor*/
+		~AudioMixer();
+
+		/*! Opens the default audio device, and starts mixing into it. The SDL audio subsystem is initialized if needed.
+			\param bufferFrames the number of frames mixed in each audio callback
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the device was opened, or false if an error occurred*/
+		bool open(unsigned int bufferFrames=1024, String* error=nullptr);
+		/*! Stops mixing and closes the audio device. Voices that are playing are kept, and continue if the mixer is opened again.*/
+		void close();
+		/*! Tells whether the mixer is mixing into an audio device.
+			\returns true if an audio device is open, or false if otherwise*/
+		bool isOpen() const;
+
+		/*! Starts playing a sound. If every voice is busy when the command is applied, the sound is not played.
+			\param sound the sound to play, which must stay loaded while it is playing
+			\param gain the volume of the sound, where 1 is the volume it was recorded at
+			\param pan the position of the sound, from -1 (left) to 1 (right)
+			\param loop true to repeat the sound until it is stopped, or false to play it once
+			\returns an ID that identifies the voice playing the sound
+			\throws fgl::IllegalArgumentException if sound is null*/
+		Uint32 play(const Sound* sound, float gain=1.0f, float pan=0.0f, bool loop=false);
+		/*! Stops a voice. The voice fades out over one block.
+			\param voiceID the ID returned from play*/
+		void stop(Uint32 voiceID);
+		/*! Changes the volume of a voice.
+			\param voiceID the ID returned from play
+			\param gain the volume of the sound, where 1 is the volume it was recorded at*/
+		void setGain(Uint32 voiceID, float gain);
+		/*! Changes the position of a voice.
+			\param voiceID the ID returned from play
+			\param pan the position of the sound, from -1 (left) to 1 (right)*/
+		void setPan(Uint32 voiceID, float pan);
+		/*! Stops every voice. Music keeps playing.*/
+		void stopAll();
+
+		/*! Starts streaming a music track, replacing the current track. The start of the track is read before returning, so that playback starts at the next block.
+			\param music the music track to play
+			\param gain the volume of the track, where 1 is the volume it was recorded at
+			\param loop true to repeat the track until it is stopped, or false to play it once
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the track was opened, or false if an error occurred
+			\throws fgl::IllegalArgumentException if music is null or not open*/
+		bool playMusic(const Music* music, float gain=1.0f, bool loop=true, String* error=nullptr);
+		/*! Stops the current music track.*/
+		void stopMusic();
+		/*! Changes the volume of the current and future music tracks.
+			\param gain the volume of the music, where 1 is the volume it was recorded at*/
+		void setMusicGain(float gain);
+		/*! Changes the volume of the whole mix.
+			\param gain the volume that every voice and the music is scaled by*/
+		void setMasterGain(float gain);
+
+		/*! Applies the queued commands, and mixes the next block of audio. This is called from the audio callback while the mixer is open, and must only be called directly while the mixer is closed, such as when testing or benchmarking the mixer.
+			\param output the buffer to write interleaved stereo samples into
+			\param frames the number of frames to mix*/
+		void mix(float* output, size_t frames);
+
+		/*! Gets the number of voices that were playing in the last mixed block.
+			\returns the number of active voices*/
+		size_t getActiveVoiceCount() const;
+		/*! Gets the maximum number of voices that can play at once.
+			\returns the number of voices*/
+		size_t getMaxVoices() const;
+
+	private:
+		void pushCommand(AudioMixerCommand* command);
+		void applyCommand(AudioMixerCommand* command);
+		AudioMixerVoice* findVoice(Uint32 voiceID);
+		void releaseMusic();
+		void runStreamer();
+
+		Uint32 device;
+
+		// only touched by the audio thread while the mixer is open
+		AudioMixerVoice* voices;
+		size_t maxVoices;
+		AudioMixerStream* music;
+		float musicGain;
+		float musicTargetGain;
+		float masterGain;
+
+		std::atomic<Uint32> nextVoiceID;
+		std::atomic<size_t> activeVoiceCount;
+
+		// commands go from the game thread to the audio thread, and back to be freed by the game thread
+		MPSCQueue<AudioMixerCommand> commands;
+		MPSCQueue<AudioMixerCommand> retiredCommands;
+		std::mutex retiredMutex;
+
+		std::thread streamerThread;
+		std::mutex streamerMutex;
+		std::condition_variable streamerCondition;
+		std::list<AudioMixerStream*> streams;
+		bool streamerRunning;
+	};
+}
@@ -0,0 +1,58 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <GameLibrary/Utilities/String.hpp>
+
+namespace fgl
+{
+	/*! A music track that is streamed from disk while it plays, so that large tracks are never fully decoded into memory. Opening a track only reads its header. AudioMixer reads and converts the track in chunks on a background thread.
+		Music is streamed from WAV files with 8, 16 or 32 bit integer samples, or 32 bit float samples.*/
+	class Music
+	{
+	public:
+		/*! The layout of the samples in a music file*/
+		struct Format
+		{
+			/*! the SDL_AudioFormat of the samples*/
+			Uint16 sampleFormat;
+			/*! the number of channels*/
+			unsigned int channels;
+			/*! the number of frames per second*/
+			unsigned int sampleRate;
+			/*! the offset of the first sample from the start of the file, in bytes*/
+			Uint64 dataOffset;
+			/*! the size of the samples, in bytes*/
+			Uint64 dataSize;
+		};
+
+		/*! default constructor*/
+		Music();
+
+		/*! Opens a music file, and reads its header.
+			\param path the path to the music file
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the file is a supported music file, or false if an error occurs*/
+		bool openFromPath(const String& path, String* error=nullptr);
+		/*! Closes the music file. Streams that are already playing are not affected.*/
+		void close();
+		/*! Tells whether a music file has been opened.
+			\returns true if a music file is open, or false if otherwise*/
+		bool isOpen() const;
+
+		/*! Gets the path of the music file.
+			\returns the path that the music file was opened from*/
+		const String& getPath() const;
+		/*! Gets the layout of the samples in the music file.
+			\returns the sample format of the music file*/
+		const Format& getFormat() const;
+		/*! Gets the length of the track.
+			\returns the duration of the track, in seconds*/
+		double getDuration() const;
+
+	private:
+		String path;
+		Format format;
+		bool opened;
+	};
+}
@@ -0,0 +1,55 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <GameLibrary/Utilities/String.hpp>
+#include <cstdio>
+#include <vector>
+
+namespace fgl
+{
+	/*! A short sound effect, decoded once into PCM samples in the format that AudioMixer mixes, so that playing it never needs to decode. Longer tracks should be streamed with Music instead.
+		Sounds are loaded from WAV data. A Sound must stay loaded while an AudioMixer is playing it.*/
+	class Sound
+	{
+	public:
+		/*! default constructor*/
+		Sound();
+
+		/*! Loads and decodes a sound from a pointer.
+			\param pointer the memory address of the sound file data
+			\param length the length of the sound file data, in bytes
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the load succeeds, or false if an error occurs*/
+		bool loadFromPointer(const void* pointer, size_t length, String* error=nullptr);
+		/*! Loads and decodes a sound from a file path.
+			\param path the path to the sound file
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the load succeeds, or false if an error occurs*/
+		bool loadFromPath(const String& path, String* error=nullptr);
+		/*! Loads and decodes a sound from a FILE pointer.
+			\param file the FILE pointer to load from
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the load succeeds, or false if an error occurs*/
+		bool loadFromFile(FILE* file, String* error=nullptr);
+		/*! Creates the sound from samples that are already in the mixing format.
+			\param samples interleaved left and right samples at AudioMixer::SAMPLE_RATE, from -1 to 1
+			\param frameCount the number of frames, each of which is a left and a right sample*/
+		void create(const float* samples, size_t frameCount);
+		/*! Unloads the samples of the sound.*/
+		void clear();
+
+		/*! Gets the decoded samples of the sound.
+			\returns interleaved left and right samples at AudioMixer::SAMPLE_RATE, or null if the sound is not loaded*/
+		const float* getSamples() const;
+		/*! Gets the number of frames in the sound.
+			\returns the number of left and right sample pairs*/
+		size_t getFrameCount() const;
+		/*! Gets the length of the sound.
+			\returns the duration of the sound, in seconds*/
+		double getDuration() const;
+
+	private:
+		std::vector<float> samples;
+	};
+}
@@ -16,7 +16,7 @@ namespace fgl
 	public:
 		DrawManager();
 		
-		void update(ApplicationData appData);
+		void update(const ApplicationData& appData);
 		virtual void draw(DrawContext context, Graphics graphics) const;
 		
 		virtual void addDrawable(Drawable* drawable, std::function<void(Graphics&)> filter=nullptr);
@@ -31,7 +31,7 @@ namespace fgl
 		bool shouldDraw(Drawable* drawable) const;
 		
 	protected:
-		virtual void updateDrawables(ApplicationData appData);
+		virtual void updateDrawables(const ApplicationData& appData);
 		
 	private:
 		class DrawableNode
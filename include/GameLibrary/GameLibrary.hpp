@@ -13,7 +13,9 @@
 #include "Application/Application.hpp"
 #include "Application/ApplicationData.hpp"
 #include "Application/BatchLoader.hpp"
+#include "Application/FramePacer.hpp"
 
+#include "Audio/AudioMixer.hpp"
 #include "Audio/Music.hpp"
 #include "Audio/Sound.hpp"
 
@@ -47,17 +49,27 @@
 #include "Graphics/Color.hpp"
 #include "Graphics/Graphics.hpp"
 #include "Graphics/Image.hpp"
+#include "Graphics/PixelConverter.hpp"
 #include "Graphics/PixelIterator.hpp"
+#include "Graphics/PixelMask.hpp"
+#include "Graphics/RenderCommandList.hpp"
 #include "Graphics/TextureImage.hpp"
 
+#include "Input/InputRecorder.hpp"
 #include "Input/Keyboard.hpp"
 #include "Input/Mouse.hpp"
 #include "Input/Multitouch.hpp"
 
+#include "IO/AssetPack.hpp"
 #include "IO/Console.hpp"
+#include "IO/Logger.hpp"
 #include "IO/FileTools.hpp"
 
+#include "Network/BitStream.hpp"
 #include "Network/NetworkProtocol.hpp"
+#include "Network/NetworkTransport.hpp"
+#include "Network/ReplicationClient.hpp"
+#include "Network/ReplicationServer.hpp"
 
 #include "Physics/Collidable.hpp"
 #include "Physics/CollisionEvent.hpp"
@@ -97,17 +109,22 @@
 #include "Utilities/Any.hpp"
 #include "Utilities/ArrayList.hpp"
 #include "Utilities/Aspectable.hpp"
+#include "Utilities/Atom.hpp"
 #include "Utilities/Data.hpp"
 #include "Utilities/Dictionary.hpp"
+#include "Utilities/HashDictionary.hpp"
 #include "Utilities/Math.hpp"
+#include "Utilities/MPSCQueue.hpp"
 #include "Utilities/Number.hpp"
 #include "Utilities/PerformanceMacros.hpp"
 #include "Utilities/PlatformChecks.hpp"
 #include "Utilities/Plist.hpp"
+#include "Utilities/Profiler.hpp"
 #include "Utilities/Promise.hpp"
 #include "Utilities/Range.hpp"
 #include "Utilities/Retainable.hpp"
 #include "Utilities/String.hpp"
+#include "Utilities/TaskScheduler.hpp"
 #include "Utilities/Thread.hpp"
 #include "Utilities/Tools.hpp"
 #include "Utilities/Direction/OctalDirection.hpp"
@@ -143,6 +160,8 @@
 #include "World/Aspects/Movement/Transform3DAspect.hpp"
 #include "World/Aspects/Movement/Velocity2DAspect.hpp"
 
+#include "World/Aspects/Network/ReplicatedAspect.hpp"
+
 #include "World/Aspects/Physics/Collidable2DAspect.hpp"
 #include "World/Aspects/Physics/BoxCollidable2DAspect.hpp"
 #include "World/Aspects/Physics/PolygonCollidable2DAspect.hpp"
@@ -8,7 +8,7 @@
 
 namespace fgl
 {
-	/*! Handles drawing to a Window object*/
+	/*! Handles drawing to a Window object. When an Application renders in pipelined mode, the Graphics object passed to draw records its drawing operations to a RenderCommandList, which the main thread draws while the next frame is updated.*/
 	class Graphics
 	{
 		friend class Application;
@@ -267,6 +267,17 @@ namespace fgl
 		void drawTextureRaw(void* texture, double dx1, double dy1, double dx2, double dy2, unsigned int sx1, unsigned int sy1, unsigned int sx2, unsigned int sy2, double rotation, const Color& colormod);
 		//! Draws an image without calling beginDraw or endDraw or transforming coordinates
 		void drawImageRaw(TextureImage* img, double dx1, double dy1, double dx2, double dy2, unsigned int sx1, unsigned int sy1, unsigned int sx2, unsigned int sy2, double rotation, const Color& colormod);
+		//! Draws the glyphs of a string at the given positions without calling beginDraw or endDraw or transforming coordinates
+		void drawGlyphsRaw(Font* font, unsigned int size, int style, const Uint16* text, const Vector2d* positions, size_t count, double scaleRatio, bool flipX, bool flipY, double rotation, const Color& colormod);
+		//! Gets the color used by drawing operations, with the tint color and alpha applied
+		Color getDrawColor() const;
+
+		/*! Tells whether drawing operations are being recorded to a RenderCommandList to be drawn later, rather than drawn right away. Custom drawing operations that use the renderer directly should not draw while recording.
+			\returns true if drawing operations are being recorded, or false if otherwise*/
+		bool isRecording() const;
+		/*! Draws every command in a RenderCommandList. This must be called on the main thread, with a Graphics object that is not recording.
+			\param commands the commands to draw*/
+		void executeCommands(const RenderCommandList& commands);
 
 	private:
 		Window*window;
@@ -293,6 +304,8 @@ namespace fgl
 		
 		TransformD transform;
 
+		RenderCommandList* commandList;
+
 		bool derived;
 	};
 }
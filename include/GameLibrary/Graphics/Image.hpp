@@ -12,6 +12,19 @@ namespace fgl
 	class Image
 	{
 	public:
+		/*! How pixels are combined with the pixels under them*/
+		enum class BlendMode
+		{
+			/*! the new pixels replace the pixels under them*/
+			REPLACE,
+			/*! alpha blending. dstRGB = srcRGB*srcA + dstRGB*(1-srcA), dstA = srcA + dstA*(1-srcA), the same as SDL_BLENDMODE_BLEND*/
+			ALPHA,
+			/*! additive blending. dstRGB = srcRGB*srcA + dstRGB, dstA = dstA, the same as SDL_BLENDMODE_ADD*/
+			ADD,
+			/*! color modulation. dstRGB = srcRGB*dstRGB, dstA = dstA, the same as SDL_BLENDMODE_MOD*/
+			MULTIPLY
+		};
+		
 		/*! default constructor*/
 		Image();
 		/*! copy constructor*/
@@ -85,10 +98,22 @@ namespace fgl
 		
 		
 		/*! Replaces specified pixels in the image.
-			\param colorSwaps an ArrayList containing pairs of Color values, the first in the pair being the original pixel Color, and the second being the replacement*/
+			\param colorSwaps an ArrayList containing pairs of Color values, the first in the pair being the original pixel Color, and the second being the replacement. If an original Color appears more than once, the first pair is used.*/
 		void recolor(const ArrayList<std::pair<Color,Color>>& colorSwaps);
-		/*! Applies a composite mask to the image. \see fgl::Color::composite(const Color&)const*/
+		/*! Applies a composite mask to the image. If the mask is a different size than the image, it is stretched to fit. \see fgl::Color::composite(const Color&)const*/
 		void applyCompositeMask(const Image& mask);
+		/*! Draws an area of another image onto this image. Any part of the area that lands outside of this image is skipped.
+			\param image the image to draw
+			\param srcRect the area of the image to draw
+			\param position the position in this image to draw the top left corner of the area
+			\param blendMode how the drawn pixels are combined with the pixels under them
+			\throws fgl::IllegalArgumentException if srcRect is not within the bounds of the image*/
+		void blit(const Image& image, const RectangleU& srcRect, const Vector2i& position, BlendMode blendMode = BlendMode::ALPHA);
+		/*! Draws another image onto this image. Any part of the image that lands outside of this image is skipped.
+			\param image the image to draw
+			\param position the position in this image to draw the top left corner of the image
+			\param blendMode how the drawn pixels are combined with the pixels under them*/
+		void blit(const Image& image, const Vector2i& position, BlendMode blendMode = BlendMode::ALPHA);
 		
 		
 		/*! Gets the total length of the image data (width * height).
@@ -0,0 +1,124 @@
+
+#pragma once
+
+#include "Color.hpp"
+#include "Image.hpp"
+#include "PixelMask.hpp"
+#include <GameLibrary/Types.hpp>
+#include <utility>
+
+namespace fgl
+{
+	/*! Converts pixels from other formats into Color pixels, building the pixel visibility mask in the same pass, and combines rows of Color pixels.
+		The conversions use AVX2 or SSE2 when the CPU supports them, and fall back to plain C++ otherwise. Every instruction set gives exactly the same results.*/
+	class PixelConverter
+	{
+	public:
+		/*! A common pixel format*/
+		enum class Format
+		{
+			/*! 32 bit packed pixel, 0xRRGGBBAA*/
+			RGBA8888,
+			/*! 32 bit packed pixel, 0xAARRGGBB*/
+			ARGB8888,
+			/*! 32 bit packed pixel, 0xAABBGGRR*/
+			ABGR8888,
+			/*! 32 bit packed pixel, 0xBBGGRRAA*/
+			BGRA8888,
+			/*! 32 bit packed pixel without alpha, 0x00RRGGBB*/
+			RGB888,
+			/*! 32 bit packed pixel without alpha, 0x00BBGGRR*/
+			BGR888,
+			/*! 24 bit pixel stored as the bytes R, G, B*/
+			RGB24,
+			/*! 24 bit pixel stored as the bytes B, G, R*/
+			BGR24,
+			/*! 8 bit index into a palette of 256 colors*/
+			INDEX8
+		};
+
+		/*! A set of CPU instructions that can be used for a conversion*/
+		enum class InstructionSet
+		{
+			SCALAR,
+			SSE2,
+			AVX2
+		};
+
+		/*! Describes where the channels of a source pixel are stored. Every channel must be 8 bits.
+			Packed pixels are read as native endian integers of bytesPerPixel bytes, and each channel is the low 8 bits after shifting the pixel right by the channel's shift, the same as SDL_PixelFormat.*/
+		struct Layout
+		{
+			/*! the number of bytes in each pixel. Must be 1 for palette pixels, or 3 or 4 for packed pixels.*/
+			unsigned int bytesPerPixel;
+			/*! the bit offset of the red channel. Must be a multiple of 8.*/
+			unsigned int rshift;
+			/*! the bit offset of the green channel. Must be a multiple of 8.*/
+			unsigned int gshift;
+			/*! the bit offset of the blue channel. Must be a multiple of 8.*/
+			unsigned int bshift;
+			/*! the bit offset of the alpha channel. Must be a multiple of 8. Ignored if hasAlpha is false.*/
+			unsigned int ashift;
+			/*! whether the pixels have an alpha channel. Pixels without alpha are fully opaque.*/
+			bool hasAlpha;
+			/*! the 256 colors of the palette, for 1 byte pixels*/
+			const Color* palette;
+		};
+
+		PixelConverter() = delete;
+
+		/*! Gets the layout of a common pixel format.
+			\param format the pixel format
+			\param palette the 256 colors of the palette, if the format is INDEX8
+			\returns a Layout describing the format*/
+		static Layout getLayout(Format format, const Color* palette=nullptr);
+		/*! Checks if a layout can be converted.
+			\param layout the layout to check
+			\returns true if the pixels can be converted, or false if they need to be converted some other way first*/
+		static bool isLayoutSupported(const Layout& layout);
+
+		/*! Gets the fastest set of instructions supported by the CPU. This is checked once and cached.
+			\returns the instruction set used for conversions by default*/
+		static InstructionSet getInstructionSet();
+
+		/*! Converts an image into Color pixels, and builds its visibility mask.
+			\param layout the layout of the source pixels
+			\param src the first row of source pixels
+			\param width the width of the image, in pixels
+			\param height the height of the image, in pixels
+			\param srcPitch the distance between rows of source pixels, in bytes
+			\param dst the first row of the converted pixels
+			\param dstPitch the distance between rows of converted pixels, in bytes
+			\param mask an optional mask to build, or null to skip building a mask. The mask is resized to width*height.
+			\param instructionSet the instruction set to convert with. Sets that the CPU does not support fall back to the fastest supported set.
+			\throws fgl::IllegalArgumentException if the layout is not supported*/
+		static void convert(const Layout& layout, const void* src, size_t width, size_t height, size_t srcPitch, Color* dst, size_t dstPitch, PixelMask* mask, InstructionSet instructionSet=getInstructionSet());
+		/*! Builds the visibility mask of a set of Color pixels.
+			\param pixels the pixels to check
+			\param count the number of pixels
+			\param mask the mask to build. The mask is resized to count.
+			\param instructionSet the instruction set to use. Sets that the CPU does not support fall back to the fastest supported set.*/
+		static void createMask(const Color* pixels, size_t count, PixelMask* mask, InstructionSet instructionSet=getInstructionSet());
+
+		/*! Replaces colors in a set of pixels, using a hash table of the swaps.
+			\param pixels the pixels to recolor
+			\param count the number of pixels
+			\param colorSwaps pairs of Color values, the first in the pair being the original pixel Color, and the second being the replacement. If an original Color appears more than once, the first pair is used.
+			\param swapCount the number of pairs in colorSwaps
+			\param instructionSet the instruction set to use. Sets that the CPU does not support fall back to the fastest supported set.*/
+		static void recolor(Color* pixels, size_t count, const std::pair<Color,Color>* colorSwaps, size_t swapCount, InstructionSet instructionSet=getInstructionSet());
+		/*! Composites each pixel with the matching pixel of a mask. \see fgl::Color::composite(const Color&)const
+			\param pixels the pixels to composite
+			\param mask the pixels to composite on top of each pixel
+			\param count the number of pixels
+			\param instructionSet the instruction set to use. Sets that the CPU does not support fall back to the fastest supported set.*/
+		static void composite(Color* pixels, const Color* mask, size_t count, InstructionSet instructionSet=getInstructionSet());
+		/*! Blends a row of pixels onto another row of pixels.
+			\param dst the pixels to blend onto
+			\param src the pixels to blend
+			\param count the number of pixels
+			\param blendMode how the pixels are combined
+			\param instructionSet the instruction set to use. Sets that the CPU does not support fall back to the fastest supported set.*/
+		static void blend(Color* dst, const Color* src, size_t count, Image::BlendMode blendMode, InstructionSet instructionSet=getInstructionSet());
+	};
+}
@@ -3,6 +3,7 @@
 
 #include <GameLibrary/Utilities/Geometry/Rectangle.hpp>
 #include <GameLibrary/Utilities/Geometry/Transform.hpp>
+#include <GameLibrary/Types.hpp>
 
 namespace fgl
 {
@@ -10,6 +11,53 @@ namespace fgl
 	class PixelIterator
 	{
 	public:
+		/*! A run of samples within one row of the source rectangle, produced by fgl::PixelIterator::nextPixelSpan.
+			Sample positions are stored in 16.16 fixed point, so sample k of the span is in column ((start + k*step) >> 16) of the image.*/
+		struct Span
+		{
+			/*! the number of fractional bits in start and step*/
+			static constexpr unsigned int FIXED_SHIFT = 16;
+			
+			/*! the row of the image that every sample in the span is in*/
+			unsigned int row;
+			/*! the first column of the image touched by the samples*/
+			unsigned int srcStart;
+			/*! the column after the last column of the image touched by the samples*/
+			unsigned int srcEnd;
+			/*! the x coordinate of the first sample, in 16.16 fixed point source pixels*/
+			Int64 start;
+			/*! the distance between samples, in 16.16 fixed point source pixels. This is negative if the iterator is mirrored horizontally*/
+			Int64 step;
+			/*! the index of the first sample within its row of samples. This is the same for every iterator walking an area of the same size with the same increment*/
+			size_t sample;
+			/*! the number of samples in the span. This is 0 if none of the samples in the row are within the source rectangle*/
+			size_t count;
+			/*! the real x and y coordinates of sample 0 of the row, which is not necessarily the first sample of the span*/
+			Vector2d point;
+			/*! the real distance between the x coordinates of samples*/
+			double pointStep;
+			
+			/*! Gets the column of the image of a sample in the span.
+				\param index the index of the sample, relative to the start of the span
+				\returns the column of the sample*/
+			inline unsigned int getColumn(size_t index) const
+			{
+				return (unsigned int)((start + ((Int64)index*step)) >> FIXED_SHIFT);
+			}
+			/*! Gets the real coordinates of a sample in the row of samples.
+				\param sampleIndex the index of the sample within its row, as in fgl::PixelIterator::Span::sample
+				\returns the real x and y coordinates of the sample*/
+			inline Vector2d getPoint(size_t sampleIndex) const
+			{
+				return Vector2d(point.x + (((double)sampleIndex)*pointStep), point.y);
+			}
+			/*! Creates a span of the samples of this span that are within a range of sample indexes.
+				\param startSample the index of the first sample to keep, within the row of samples
+				\param endSample the index after the last sample to keep, within the row of samples
+				\returns a span containing only the samples in the range, which may be empty*/
+			Span slice(size_t startSample, size_t endSample) const;
+		};
+		
 		/*! Constructs a PixelIterator to loop through a given area.
 			\param dimensions the actual size of the image or canvas, in pixels
 			\param srcRect the source rectangle of the area being checked
@@ -49,9 +97,21 @@ namespace fgl
 			\returns a Vector2d representing the current coordinates of the iterator*/
 		Vector2d getCurrentPoint() const;
 		
+		/*! Iterates to the next row of samples, and gets the samples in that row that land inside the source rectangle as a single span.
+			Rows are stepped with 16.16 fixed point math instead of calculating every sample, so whole spans can be checked against a fgl::PixelMask at once.
+			If the iterator has a transform, a row of samples does not follow a row of the image, so each sample is returned as its own span instead.
+			This does not affect the position of nextPixelIndex.
+			\param span a Span to store the samples in. Its count is 0 if none of the samples are within the source rectangle.
+			\returns true if a span was stored, or false if the iterator has run out of samples and has returned to the starting point*/
+		bool nextPixelSpan(Span* span);
+		/*! Tells whether the iterator was constructed with a transform, in which case nextPixelSpan returns a span for each sample.
+			\returns true if the iterator has a transform, or false if otherwise*/
+		bool hasTransform() const;
+		
 		Vector2d calculatePixelPoint(const Vector2d& point);
 	private:
 		double calculatePixelIndex(const Vector2d& pixelPoint);
+		void initializeSpans();
 		
 		Vector2d dimensions;
 		
@@ -77,5 +137,18 @@ namespace fgl
 		Vector2d incr;
 		Vector2d incrpxl;
 		Vector2d ratio; // ratio of srcSize/dstSize
+		
+		size_t spanRows;
+		size_t spanColumns;
+		size_t spanRow;
+		size_t spanSample;
+		Int64 spanStartX; //16.16 fixed point
+		Int64 spanStepX;
+		Int64 spanStartY;
+		Int64 spanStepY;
+		Int64 srcLeftFixed;
+		Int64 srcRightFixed;
+		Int64 srcTopFixed;
+		Int64 srcBottomFixed;
 	};
 }
@@ -0,0 +1,145 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace fgl
+{
+	/*! A packed bit array storing the visibility of each pixel in an image, with 32 pixels per word.
+		Pixel i is stored in bit (i % 32) of word (i / 32), and any bits past the end of the mask are always 0.*/
+	class PixelMask
+	{
+	public:
+		/*! the number of pixels stored in each word of the mask*/
+		static constexpr size_t BITS_PER_WORD = 32;
+
+		PixelMask()
+			: length(0) {
+			//
+		}
+
+		/*! Constructs a mask with a given number of pixels.
+			\param size the number of pixels in the mask
+			\param value the visibility of every pixel*/
+		explicit PixelMask(size_t size, bool value=false)
+			: length(0) {
+			resize(size, value);
+		}
+
+		bool operator[](size_t index) const {
+			return get(index);
+		}
+
+		/*! Gets the visibility of a pixel. This does not check bounds.
+			\param index the index of the pixel
+			\returns true if the pixel is visible, or false if it is fully transparent*/
+		bool get(size_t index) const {
+			return ((words[index / BITS_PER_WORD] >> (index % BITS_PER_WORD)) & 1) != 0;
+		}
+
+		/*! Sets the visibility of a pixel. This does not check bounds.
+			\param index the index of the pixel
+			\param value true if the pixel is visible, or false if it is fully transparent*/
+		void set(size_t index, bool value) {
+			Uint32 bit = (Uint32)1 << (index % BITS_PER_WORD);
+			if(value) {
+				words[index / BITS_PER_WORD] |= bit;
+			}
+			else {
+				words[index / BITS_PER_WORD] &= ~bit;
+			}
+		}
+
+		/*! Checks a range of pixels a word at a time.
+			\param startIndex the index of the first pixel to check
+			\param endIndex the index after the last pixel to check
+			\returns true if any of the pixels in the range are visible, or false if they are all transparent*/
+		bool any(size_t startIndex, size_t endIndex) const {
+			if(startIndex >= endIndex) {
+				return false;
+			}
+			size_t startWord = startIndex / BITS_PER_WORD;
+			size_t endWord = (endIndex - 1) / BITS_PER_WORD;
+			Uint32 startBits = ~(Uint32)0 << (startIndex % BITS_PER_WORD);
+			Uint32 endBits = ~(Uint32)0 >> ((BITS_PER_WORD - 1) - ((endIndex - 1) % BITS_PER_WORD));
+			if(startWord == endWord) {
+				return (words[startWord] & startBits & endBits) != 0;
+			}
+			if((words[startWord] & startBits) != 0) {
+				return true;
+			}
+			for(size_t i=(startWord+1); i<endWord; i++) {
+				if(words[i] != 0) {
+					return true;
+				}
+			}
+			return (words[endWord] & endBits) != 0;
+		}
+
+		/*! Gets the number of pixels in the mask.
+			\returns the number of pixels in the mask*/
+		size_t size() const {
+			return length;
+		}
+
+		/*! Changes the number of pixels in the mask.
+			\param size the new number of pixels
+			\param value the visibility of any pixels added to the mask*/
+		void resize(size_t size, bool value=false) {
+			if(value && size > length) {
+				// fill the unused bits of the last word before growing
+				size_t lastBits = length % BITS_PER_WORD;
+				if(lastBits != 0) {
+					words[length / BITS_PER_WORD] |= ~(Uint32)0 << lastBits;
+				}
+			}
+			words.resize((size + BITS_PER_WORD - 1) / BITS_PER_WORD, value ? ~(Uint32)0 : 0);
+			length = size;
+			clearUnusedBits();
+		}
+
+		/*! Sets the visibility of every pixel.
+			\param value true to make every pixel visible, or false to make every pixel transparent*/
+		void fill(bool value) {
+			std::fill(words.begin(), words.end(), value ? ~(Uint32)0 : 0);
+			clearUnusedBits();
+		}
+
+		/*! Removes all the pixels from the mask and frees its memory.*/
+		void clear() {
+			words.clear();
+			words.shrink_to_fit();
+			length = 0;
+		}
+
+		/*! Gets the words storing the mask bits. The bits past the end of the mask must be left as 0.
+			\returns a pointer to the first word of the mask*/
+		Uint32* getData() {
+			return words.data();
+		}
+
+		/*! \copydoc fgl::PixelMask::getData()*/
+		const Uint32* getData() const {
+			return words.data();
+		}
+
+		/*! Gets the number of words storing the mask bits.
+			\returns the number of words in the mask*/
+		size_t getWordCount() const {
+			return words.size();
+		}
+
+	private:
+		void clearUnusedBits() {
+			size_t lastBits = length % BITS_PER_WORD;
+			if(lastBits != 0) {
+				words[length / BITS_PER_WORD] &= ~(~(Uint32)0 << lastBits);
+			}
+		}
+
+		std::vector<Uint32> words;
+		size_t length;
+	};
+}
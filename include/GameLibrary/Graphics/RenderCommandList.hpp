@@ -0,0 +1,59 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <vector>
+
+namespace fgl
+{
+	/*! A compact list of drawing commands, recorded by a Graphics object and drawn later on the thread that owns the renderer.
+		Commands are stored back to back in one buffer, which keeps its memory when the list is cleared, so recording a frame doesn't allocate once the buffer has grown to fit a typical frame.*/
+	class RenderCommandList
+	{
+	public:
+		/*! A command read from the list*/
+		struct Command
+		{
+			/*! the type of the command, as given to add*/
+			Uint32 type;
+			/*! the data of the command*/
+			const void* data;
+			/*! the size of the data, in bytes*/
+			size_t size;
+			/*! the extra data stored after the command*/
+			const void* extra;
+			/*! the size of the extra data, in bytes*/
+			size_t extraSize;
+		};
+
+		/*! default constructor*/
+		RenderCommandList();
+
+		/*! Removes every command, keeping the memory for the next frame.*/
+		void clear();
+		/*! Appends a command.
+			\param type the type of the command, which is up to the caller
+			\param data the data of the command, which is copied into the list
+			\param size the size of the data, in bytes
+			\param extraSize the size of any variable length data that follows the command, in bytes
+			\returns a pointer to extraSize bytes of memory, aligned to 8 bytes, to fill in with the extra data. The pointer is only valid until the next command is added.*/
+		void* add(Uint32 type, const void* data, size_t size, size_t extraSize=0);
+		/*! Reads a command.
+			\param offset the byte offset of the command to read, starting at 0. The offset is moved to the next command.
+			\param command stores the command that was read
+			\returns true if a command was read, or false if the offset is at the end of the list*/
+		bool read(size_t* offset, Command* command) const;
+
+		/*! Gets the number of commands in the list.
+			\returns the number of commands*/
+		size_t getCommandCount() const;
+		/*! Gets the number of bytes used by the commands in the list.
+			\returns the size of the recorded commands, in bytes*/
+		size_t getByteSize() const;
+
+	private:
+		std::vector<byte> buffer;
+		size_t length;
+		size_t commandCount;
+	};
+}
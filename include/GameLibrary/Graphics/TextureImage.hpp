@@ -1,9 +1,10 @@
 
 #pragma once
 
-#include <vector>
 #include "Image.hpp"
 #include "Graphics.hpp"
+#include "PixelIterator.hpp"
+#include "PixelMask.hpp"
 #include <GameLibrary/Utilities/Geometry/Polygon.hpp>
 
 namespace fgl
@@ -63,6 +64,19 @@ namespace fgl
 			\param error an optional String pointer to store the error message if the function fails
 			\returns true if the load succeeds, or false if an error occurs */
 		bool loadFromImage(const Image& image, Graphics& graphics, String* error=nullptr);
+		/*! Loads the image data from an Image object, using an already computed pixel visibility mask, and writes it to the video card memory.
+			This allows the mask to be built on a background thread, leaving only the upload to be done on the main thread.
+			\param image the Image to load from
+			\param pixelMask the visibility of each pixel in the image, true for visible and false for fully transparent. \see fgl::TextureImage::createPixelMask(const Image&)
+			\param graphics the graphics object to create the texture on the video card memory
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the load succeeds, or false if an error occurs
+			\throws fgl::IllegalArgumentException if the size of the mask does not match the size of the image */
+		bool loadFromImage(const Image& image, PixelMask&& pixelMask, Graphics& graphics, String* error=nullptr);
+		/*! Builds the pixel visibility mask for an Image. This function does not touch the video card, so it is safe to call from any thread.
+			\param image the Image to build the mask from
+			\returns a PixelMask storing each pixel's transparency state, true for visible and false for transparent*/
+		static PixelMask createPixelMask(const Image& image);
 		//Image copyToImage() const;
 		
 		
@@ -75,9 +89,17 @@ namespace fgl
 			\param y the y coordinate of the pixel
 			\returns true if the pixel is visible, and false if the pixel is fully transparent*/
 		bool checkPixel(size_t x, size_t y) const;
-		/*! Gets a bit vector storing each pixel's transparency state, true for visible and false for transparent.
-			\returns a const std::vector<bool> reference containing all the pixel visibility states*/
-		const std::vector<bool>& getPixelBools() const;
+		/*! Checks a span of samples from a fgl::PixelIterator to see if any of them land on a visible pixel.
+			Spans that do not skip any columns are checked against the mask a word at a time.
+			\param span the span of samples to check
+			\param firstSample an optional pointer to store the index of the first visible sample within its row of samples
+			\param lastSample an optional pointer to store the index of the last visible sample within its row of samples
+			\returns true if any of the samples are visible, and false if every sample is fully transparent
+			\throws fgl::ImageOutOfBoundsException if the span is not within the bounds of the texture*/
+		bool checkPixelSpan(const PixelIterator::Span& span, size_t* firstSample=nullptr, size_t* lastSample=nullptr) const;
+		/*! Gets a packed bit array storing each pixel's transparency state, true for visible and false for transparent.
+			\returns a const PixelMask reference containing all the pixel visibility states*/
+		const PixelMask& getPixelMask() const;
 		
 		
 		/*! Gets the total length of the texture (width * height).
@@ -102,7 +124,7 @@ namespace fgl
 		
 	private:
 		void* texture;
-		std::vector<bool> pixels;
+		PixelMask pixels;
 		size_t width;
 		size_t height;
 	};
@@ -0,0 +1,128 @@
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <GameLibrary/Utilities/String.hpp>
+#include <GameLibrary/Utilities/ArrayList.hpp>
+
+namespace fgl
+{
+	/*! A read-only archive of asset files, stored in a single pack file. The pack file is memory-mapped when it's opened, so the contents of a packed file can be handed to decoders directly without being copied or read from disk.
+		A pack file starts with a header, followed by an index of entries sorted by path, a table of the entry paths, and the contents of each file, aligned to AssetPack::ALIGNMENT bytes. All integers are stored little-endian.*/
+	class AssetPack
+	{
+	public:
+		/*! The contents of a file stored in an asset pack*/
+		struct Entry
+		{
+			/*! a pointer to the memory-mapped contents of the file*/
+			const void* data;
+			/*! the size of the file, in bytes*/
+			size_t size;
+		};
+
+		/*! The header at the start of a pack file*/
+		struct Header
+		{
+			/*! the pack file identifier. \see AssetPack::MAGIC*/
+			char magic[8];
+			/*! the version of the pack file format. \see AssetPack::VERSION*/
+			uint32_t version;
+			/*! the number of entries in the index*/
+			uint32_t entryCount;
+			/*! the offset of the path table, from the start of the pack file*/
+			uint64_t pathsOffset;
+			/*! the size of the path table, in bytes*/
+			uint64_t pathsSize;
+		};
+
+		/*! An entry in the index of a pack file*/
+		struct IndexEntry
+		{
+			/*! the offset of the entry's path, from the start of the path table*/
+			uint64_t pathOffset;
+			/*! the length of the entry's path*/
+			uint32_t pathLength;
+			/*! reserved for future use. Always 0*/
+			uint32_t flags;
+			/*! the offset of the entry's contents, from the start of the pack file*/
+			uint64_t dataOffset;
+			/*! the size of the entry's contents, in bytes*/
+			uint64_t dataSize;
+		};
+
+		/*! The identifier at the start of every pack file*/
+		static const char MAGIC[8];
+		/*! The version of the pack file format written by AssetPack::build*/
+		static const uint32_t VERSION;
+		/*! The alignment of each file's contents within a pack file, in bytes*/
+		static const size_t ALIGNMENT;
+
+
+		/*! default constructor*/
+		AssetPack();
+		/*! deleted copy constructor*/
+		AssetPack(const AssetPack&) = delete;
+		/*! destructor. Closes the pack file if it's open*/
+		~AssetPack();
+
+		/*! deleted assignment operator*/
+		AssetPack& operator=(const AssetPack&) = delete;
+
+
+		/*! Opens and memory-maps a pack file. If a pack file is already open, it is closed first.
+			\param path the path to the pack file
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the pack file was opened, or false if an error occurred*/
+		bool loadFromPath(const String& path, String* error=nullptr);
+		/*! Closes the pack file. Any Entry data pointers given by this pack become invalid.*/
+		void close();
+
+		/*! Tells whether a pack file is open.
+			\returns true if a pack file is open, or false if otherwise*/
+		bool isOpen() const;
+		/*! Gets the path that the pack file was opened from.
+			\returns the path to the pack file, or an empty String if no pack is open*/
+		const String& getPath() const;
+
+
+		/*! Finds a file in the pack.
+			\param path the path of the file, relative to the root of the pack. \see AssetPack::normalizePath(const String&)
+			\param entry an optional pointer to store the contents of the file
+			\returns true if the file was found, or false if the pack doesn't contain the file*/
+		bool find(const String& path, Entry* entry=nullptr) const;
+		/*! Gets the number of files in the pack.
+			\returns the number of files stored in the pack*/
+		size_t getEntryCount() const;
+		/*! Gets the path of a file in the pack. Paths are sorted in ascending byte order.
+			\param index the index of the file
+			\returns the path of the file, relative to the root of the pack
+			\throws fgl::OutOfBoundsException if the index is out of bounds*/
+		String getEntryPath(size_t index) const;
+
+
+		/*! Writes a pack file from a list of files.
+			\param path the path to write the pack file
+			\param files a list of pairs, each holding the path to store a file under in the pack, and the path to read the file from
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the pack file was written, or false if an error occurred*/
+		static bool build(const String& path, const ArrayList<std::pair<String, String>>& files, String* error=nullptr);
+
+		/*! Normalizes a relative path to the form stored in pack files, with forward slashes as separators and no leading "./" or "/".
+			\param path the path to normalize
+			\returns the normalized path*/
+		static String normalizePath(const String& path);
+
+	private:
+		const IndexEntry* getIndex() const;
+
+		String path;
+		const unsigned char* mappedData;
+		size_t mappedSize;
+		#ifdef _WIN32
+		void* fileHandle;
+		void* mappingHandle;
+		#endif
+	};
+}
@@ -5,7 +5,7 @@
 
 namespace fgl
 {
-	/*! Used to log output or error information to the console*/
+	/*! Used to log output or error information to the console. Output goes through Logger, so it is written asynchronously; call Logger::flush to wait for it.*/
 	class Console
 	{
 	public:
@@ -0,0 +1,149 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <GameLibrary/Utilities/String.hpp>
+#include <atomic>
+
+/*! The lowest Logger::Level that the FGL_LOG macros are compiled in for. 0 is debug, 1 is info, 2 is warning, 3 is error, and 4 removes every log macro.*/
+#ifndef GAMELIBRARY_LOG_LEVEL
+	#define GAMELIBRARY_LOG_LEVEL 0
+#endif
+
+/*! Logs a message at a level. The message is not evaluated if the level is filtered out.
+	\param level a Logger::Level
+	\param message the message to log, which can be anything that converts to a String*/
+#define FGL_LOG(level, message) \
+	do { \
+		if((int)(level) >= GAMELIBRARY_LOG_LEVEL && fgl::Logger::isEnabled(level)) { \
+			fgl::Logger::log(level, message); \
+		} \
+	} while(0)
+
+/*! Logs a message at most once per interval from the same line, for messages that could be logged every frame. The next message that gets through says how many were suppressed.
+	\param level a Logger::Level
+	\param intervalMilliseconds the shortest time between messages from this line
+	\param message the message to log, which is only evaluated if it will be logged*/
+#define FGL_LOG_RATE_LIMITED(level, intervalMilliseconds, message) \
+	do { \
+		if((int)(level) >= GAMELIBRARY_LOG_LEVEL && fgl::Logger::isEnabled(level)) { \
+			static fgl::Logger::RateLimit fgl_logRateLimit(intervalMilliseconds); \
+			size_t fgl_logSuppressed = 0; \
+			if(fgl_logRateLimit.allow(&fgl_logSuppressed)) { \
+				fgl::Logger::log(level, message, fgl_logSuppressed); \
+			} \
+		} \
+	} while(0)
+
+#if GAMELIBRARY_LOG_LEVEL <= 0
+	#define FGL_LOG_DEBUG(message) FGL_LOG(fgl::Logger::LEVEL_DEBUG, message)
+#else
+	#define FGL_LOG_DEBUG(message) do {} while(0)
+#endif
+#if GAMELIBRARY_LOG_LEVEL <= 1
+	#define FGL_LOG_INFO(message) FGL_LOG(fgl::Logger::LEVEL_INFO, message)
+#else
+	#define FGL_LOG_INFO(message) do {} while(0)
+#endif
+#if GAMELIBRARY_LOG_LEVEL <= 2
+	#define FGL_LOG_WARNING(message) FGL_LOG(fgl::Logger::LEVEL_WARNING, message)
+#else
+	#define FGL_LOG_WARNING(message) do {} while(0)
+#endif
+#if GAMELIBRARY_LOG_LEVEL <= 3
+	#define FGL_LOG_ERROR(message) FGL_LOG(fgl::Logger::LEVEL_ERROR, message)
+#else
+	#define FGL_LOG_ERROR(message) do {} while(0)
+#endif
+
+namespace fgl
+{
+	struct LoggerThreadBuffer;
+
+	/*! Writes log messages to the console and an optional file without making the logging thread wait for I/O.
+		Each thread appends its messages to its own lock-free ring buffer. A background writer thread drains every buffer a few times per frame, orders the messages by time, and writes them out. If a thread logs faster than the writer can keep up, its newest messages are dropped and counted, rather than making the thread wait.
+		Identical consecutive lines are written once, followed by how many times they repeated. Console sends its output through the logger, so existing Console calls are asynchronous too. Console output is never dropped, collapsed, or filtered by level; if its thread's buffer is full, the thread writes out the waiting messages itself.*/
+	class Logger
+	{
+	public:
+		/*! The severity of a message*/
+		enum Level : Uint8
+		{
+			LEVEL_DEBUG = 0,
+			LEVEL_INFO = 1,
+			LEVEL_WARNING = 2,
+			LEVEL_ERROR = 3,
+			/*! filters out every message*/
+			LEVEL_NONE = 4
+		};
+
+		/*! the number of messages each thread can have waiting to be written before log messages are dropped*/
+		static constexpr size_t THREAD_BUFFER_SIZE = 1024;
+
+		/*! Limits how often a message is logged. Declared as a static by FGL_LOG_RATE_LIMITED.*/
+		class RateLimit
+		{
+		public:
+			/*! Constructs a rate limit.
+				\param intervalMilliseconds the shortest time between allowed messages*/
+			explicit RateLimit(long long intervalMilliseconds);
+			RateLimit(const RateLimit&) = delete;
+			RateLimit& operator=(const RateLimit&) = delete;
+
+			/*! Tells whether a message is allowed now, and counts it as suppressed if it isn't.
+				\param suppressedCount stores the number of messages that were suppressed since the last allowed message
+				\returns true if the message should be logged, or false if otherwise*/
+			bool allow(size_t* suppressedCount);
+
+		private:
+			Int64 interval;
+			std::atomic<Int64> nextTime;
+			std::atomic<size_t> suppressed;
+		};
+
+		Logger() = delete;
+
+		/*! Logs a message, if its level is enabled.
+			\param level the severity of the message
+			\param message the message to log
+			\param suppressedCount the number of similar messages that were suppressed before this one by a rate limit*/
+		static void log(Level level, const String& message, size_t suppressedCount=0);
+		/*! Logs output from Console, which is written to the console as it was given, without a level prefix. The output is written regardless of the logging level.
+			\param level the severity of the output. Warnings and errors go to stderr.
+			\param output the text to write
+			\param newLine true to end the output with a new line*/
+		static void logOutput(Level level, const String& output, bool newLine);
+
+		/*! Sets the lowest level of messages that are logged. Levels below GAMELIBRARY_LOG_LEVEL are always filtered out by the FGL_LOG macros.
+			\param level the lowest level to log*/
+		static void setLevel(Level level);
+		/*! Gets the lowest level of messages that are logged.
+			\returns the lowest level that is logged*/
+		static Level getLevel();
+		/*! Tells whether messages at a level are logged.
+			\param level the level to check
+			\returns true if the level is logged, or false if it is filtered out*/
+		static bool isEnabled(Level level);
+
+		/*! Sets whether messages are written to stdout and stderr.
+			\param enabled true to write to the console, or false to only write to the log file*/
+		static void setConsoleEnabled(bool enabled);
+		/*! Starts writing messages to a file, with the time and level of each message, replacing any previous log file.
+			\param path the path of the log file
+			\param append true to add to the end of an existing file, or false to replace it
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the file was opened, or false if an error occurred*/
+		static bool openFile(const String& path, bool append=false, String* error=nullptr);
+		/*! Stops writing messages to the log file, after writing every message logged so far.*/
+		static void closeFile();
+
+		/*! Waits until every message logged so far, on any thread, has been written.*/
+		static void flush();
+		/*! Gets the number of messages that were dropped because a thread's buffer was full.
+			\returns the number of dropped messages*/
+		static size_t getDroppedCount();
+
+	private:
+		static std::atomic<Uint8> level;
+	};
+}
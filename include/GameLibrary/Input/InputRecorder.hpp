@@ -0,0 +1,124 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <GameLibrary/Utilities/Data.hpp>
+#include <GameLibrary/Utilities/String.hpp>
+#include <vector>
+
+namespace fgl
+{
+	/*! Records the keyboard, mouse and touch events received each frame into a compact binary log, and replays a log by sending its events through the same paths as live input, so that a gameplay session can be reproduced exactly.
+		A frame is one call to EventManager::update from the Application loop. While recording or replaying, the Application uses a fixed timestep, and while replaying, live input is ignored and frames are not delayed, so a replay can be run as a benchmark.
+		A log starts with InputRecorder::MAGIC and InputRecorder::VERSION, followed by a record for each event. Each record stores the number of frames since the previous record, the event type, and the event's values. Integers are stored as little-endian base 128 varints.
+		These functions should only be called from the main thread.*/
+	class InputRecorder
+	{
+		friend class EventManager;
+	public:
+		/*! the identifier at the start of an input log*/
+		static const char MAGIC[8];
+		/*! the version of the input log format*/
+		static const Uint32 VERSION;
+
+		InputRecorder() = delete;
+
+		/*! Starts recording input events, discarding any previous recording.
+			\throws fgl::IllegalStateException if a log is being replayed*/
+		static void startRecording();
+		/*! Stops recording input events, keeping the events recorded so far.*/
+		static void stopRecording();
+		/*! Tells whether input events are being recorded.
+			\returns true if input is being recorded, or false if otherwise*/
+		static bool isRecording();
+		/*! Gets the log of the current or last recording.
+			\returns the contents of the input log*/
+		static Data getRecording();
+		/*! Saves the log of the current or last recording to a file.
+			\param path the path of the file to write
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the file was written, or false if an error occurred*/
+		static bool saveRecording(const String& path, String* error=nullptr);
+
+		/*! Starts replaying an input log, starting from the next frame.
+			\param data the contents of the input log
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the log is valid and the replay has started, or false if an error occurred
+			\throws fgl::IllegalStateException if input is being recorded*/
+		static bool startReplay(const Data& data, String* error=nullptr);
+		/*! Starts replaying an input log file, starting from the next frame.
+			\param path the path of the input log file
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the log is valid and the replay has started, or false if an error occurred
+			\throws fgl::IllegalStateException if input is being recorded*/
+		static bool startReplay(const String& path, String* error=nullptr);
+		/*! Stops replaying, and goes back to handling live input.*/
+		static void stopReplay();
+		/*! Tells whether an input log is being replayed. A replay keeps running after its last frame, until it is stopped.
+			\returns true if a log is being replayed, or false if otherwise*/
+		static bool isReplaying();
+		/*! Tells whether every frame of the replayed log has been replayed. A benchmark can close the Application once this is true.
+			\returns true if a log is being replayed and has no frames left, or false if otherwise*/
+		static bool isReplayFinished();
+		/*! Gets the number of frames in the replayed log.
+			\returns the total number of frames in the log, or 0 if a log is not being replayed*/
+		static size_t getReplayFrameCount();
+
+		/*! Gets the number of frames since recording or replaying started.
+			\returns the current frame number*/
+		static size_t getFrameNumber();
+
+	private:
+		enum class EventType : Uint8
+		{
+			END = 0,
+			KEY_PRESS,
+			KEY_RELEASE,
+			TEXT_INPUT,
+			MOUSE_MOVE,
+			MOUSE_PRESS,
+			MOUSE_RELEASE,
+			TOUCH_DOWN,
+			TOUCH_MOVE,
+			TOUCH_UP
+		};
+
+		/*! An input event as sent from EventManager*/
+		struct Event
+		{
+			Event(EventType type=EventType::END, Int32 window=-1, Uint32 index=0, Int64 code=0, float x=0, float y=0, float dx=0, float dy=0)
+				: type(type), window(window), index(index), code(code), x(x), y(y), dx(dx), dy(dy) {
+				//
+			}
+
+			EventType type;
+			/*! the index of the window in EventManager's windows, or -1 if there is no window*/
+			Int32 window;
+			/*! the mouse index*/
+			Uint32 index;
+			/*! the key, mouse button, or touch ID*/
+			Int64 code;
+			/*! the position of the mouse in pixels, or the position of the touch relative to the window size*/
+			float x;
+			float y;
+			/*! the movement of the mouse or touch, in the same units as the position*/
+			float dx;
+			float dy;
+			/*! the text of a text input event*/
+			String text;
+		};
+
+		friend void InputRecorder_writeEvent(std::vector<Uint8>& bytes, const Event& event);
+		friend bool InputRecorder_readEvent(const Uint8* bytes, size_t size, size_t& offset, Event* event);
+
+		/*! Records an event from EventManager into the current frame, if input is being recorded.
+			\param event the event to record*/
+		static void recordEvent(const Event& event);
+		/*! Reads the next replayed event of the current frame.
+			\param event the event to read into
+			\returns true if an event was read, or false if the current frame has no more events*/
+		static bool nextReplayEvent(Event* event);
+		/*! Moves to the next frame. Called once per frame by EventManager.*/
+		static void endFrame();
+	};
+}
@@ -0,0 +1,93 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <vector>
+
+namespace fgl
+{
+	/*! Packs values into a buffer using only as many bits as each value needs. Bits are written starting from the least significant bit of each byte.*/
+	class BitWriter
+	{
+	public:
+		/*! default constructor*/
+		BitWriter();
+
+		/*! Writes the low bits of a value.
+			\param value the value to write
+			\param bitCount the number of bits to write, from 0 to 32*/
+		void writeBits(Uint32 value, unsigned int bitCount);
+		/*! Writes a single bit.
+			\param value the value to write*/
+		void writeBool(bool value);
+		/*! Writes an unsigned value in 5, 10, 19 or 35 bits, depending on its size.
+			\param value the value to write*/
+		void writeVarUint(Uint32 value);
+		/*! Writes a signed value in 5, 10, 19 or 35 bits, depending on its distance from 0.
+			\param value the value to write*/
+		void writeVarInt(Int32 value);
+		/*! Replaces bits that were already written, such as a count that wasn't known when it was reserved.
+			\param bitPosition the position of the first bit to replace
+			\param value the value to write
+			\param bitCount the number of bits to replace, from 0 to 32*/
+		void overwriteBits(size_t bitPosition, Uint32 value, unsigned int bitCount);
+		/*! Removes every bit after a given position.
+			\param bitPosition the number of bits to keep*/
+		void truncate(size_t bitPosition);
+		/*! Removes every bit, keeping the allocated buffer.*/
+		void clear();
+
+		/*! Gets the written bytes. The unused bits of the last byte are 0.
+			\returns a pointer to the written bytes*/
+		const Uint8* getData() const;
+		/*! Gets the number of bits written.
+			\returns the number of bits*/
+		size_t getBitCount() const;
+		/*! Gets the number of bytes needed to hold the written bits.
+			\returns the number of bytes*/
+		size_t getByteCount() const;
+
+	private:
+		std::vector<Uint8> bytes;
+		size_t bitCount;
+	};
+
+
+
+	/*! Reads values written by a BitWriter. Reading past the end of the buffer returns zeros and sets an overflow flag, so a decoder can check for a truncated buffer once, instead of after every value.*/
+	class BitReader
+	{
+	public:
+		/*! Constructs a reader for a buffer, which must stay alive while the reader is used.
+			\param data the bytes to read
+			\param size the number of bytes*/
+		BitReader(const void* data, size_t size);
+
+		/*! Reads a value from the given number of bits.
+			\param bitCount the number of bits to read, from 0 to 32
+			\returns the value that was read*/
+		Uint32 readBits(unsigned int bitCount);
+		/*! Reads a single bit.
+			\returns the value that was read*/
+		bool readBool();
+		/*! Reads a value written by BitWriter::writeVarUint.
+			\returns the value that was read*/
+		Uint32 readVarUint();
+		/*! Reads a value written by BitWriter::writeVarInt.
+			\returns the value that was read*/
+		Int32 readVarInt();
+
+		/*! Tells whether a read went past the end of the buffer.
+			\returns true if the buffer was too short, or false if every read was in bounds*/
+		bool hasOverflowed() const;
+		/*! Gets the number of bits that have been read.
+			\returns the number of bits*/
+		size_t getBitPosition() const;
+
+	private:
+		const Uint8* bytes;
+		size_t bitSize;
+		size_t bitPosition;
+		bool overflowed;
+	};
+}
@@ -0,0 +1,113 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <GameLibrary/Network/BitStream.hpp>
+#include <GameLibrary/Utilities/String.hpp>
+#include <functional>
+#include <vector>
+
+namespace fgl
+{
+	/*! The wire format used to replicate the state of a World from a ReplicationServer to ReplicationClients.
+		A snapshot holds the quantized position and velocity of every replicated object. Each snapshot is sent as a delta against a baseline, which is the last snapshot that the client acknowledged. Only objects that were removed, added, or that moved differently than their baseline velocity predicts are written, and each changed value is written as a variable length difference from its prediction, so objects moving at a steady velocity cost a few bits each.
+		If a snapshot would be larger than NetworkProtocol::Settings::maxPacketSize, the objects that don't fit are left out and keep their baseline state, so that they are sent in a later snapshot.*/
+	class NetworkProtocol
+	{
+	public:
+		/*! The type of a packet, stored in its first bits*/
+		enum PacketType : Uint8
+		{
+			/*! a snapshot, sent from the server to a client*/
+			PACKET_SNAPSHOT = 1,
+			/*! the acknowledgement of a snapshot, sent from a client to the server*/
+			PACKET_ACK = 2
+		};
+
+		/*! Settings that must match on both ends of a connection*/
+		struct Settings
+		{
+			/*! the number of steps per world unit that positions are rounded to*/
+			unsigned int positionPrecision = 16;
+			/*! the number of steps per world unit per second that velocities are rounded to*/
+			unsigned int velocityPrecision = 16;
+			/*! the largest snapshot packet to send, in bytes*/
+			size_t maxPacketSize = 1200;
+		};
+
+		/*! The quantized state of a replicated object*/
+		struct EntityState
+		{
+			/*! the network ID of the object*/
+			Uint32 id;
+			/*! the position, in steps of 1/positionPrecision*/
+			Int32 x;
+			Int32 y;
+			/*! the velocity, in steps of 1/velocityPrecision*/
+			Int32 velocityX;
+			Int32 velocityY;
+		};
+
+		/*! The state of every replicated object at a point in time*/
+		struct Snapshot
+		{
+			/*! the sequence number of the snapshot, which starts at 1*/
+			Uint32 sequence = 0;
+			/*! the time of the snapshot on the server, in milliseconds*/
+			Uint32 time = 0;
+			/*! the state of each object, sorted by ID*/
+			std::vector<EntityState> entities;
+
+			/*! Finds the state of an object.
+				\param id the network ID of the object
+				\returns a pointer to the object's state, or null if the object is not in the snapshot*/
+			const EntityState* find(Uint32 id) const;
+		};
+
+		NetworkProtocol() = delete;
+
+		/*! Rounds a value to a whole number of steps.
+			\param value the value to round
+			\param precision the number of steps per unit
+			\returns the number of steps*/
+		static Int32 quantize(double value, unsigned int precision);
+		/*! Converts a number of steps back to a value.
+			\param value the number of steps
+			\param precision the number of steps per unit
+			\returns the value*/
+		static double dequantize(Int32 value, unsigned int precision);
+
+		/*! Reads the type of a packet.
+			\param reader the reader positioned at the start of the packet
+			\returns the type of the packet, or 0 if the packet is empty*/
+		static Uint8 readPacketType(BitReader& reader);
+
+		/*! Writes a snapshot packet.
+			\param snapshot the snapshot to send
+			\param baseline the last snapshot that the receiver acknowledged, or null to send every object
+			\param settings the settings of the connection
+			\param firstEntity an optional pointer to the index of the first changed object to write, which is updated to where the next snapshot should start. Passing the same index to each snapshot makes sure that every object is eventually sent when there are more changes than fit in a packet.
+			\param writer the writer to write the packet to
+			\param sent stores the snapshot as the receiver will decode it, which is the baseline state for objects that didn't fit in the packet. This should be stored as a possible baseline, instead of snapshot.
+			\returns the number of changed objects that didn't fit in the packet*/
+		static size_t encodeSnapshot(const Snapshot& snapshot, const Snapshot* baseline, const Settings& settings, size_t* firstEntity, BitWriter& writer, Snapshot* sent);
+		/*! Reads a snapshot packet, after its type has been read.
+			\param reader the reader positioned after the packet type
+			\param findBaseline a function that returns the previously received snapshot with the given sequence number, or null if it isn't available
+			\param settings the settings of the connection
+			\param snapshot stores the decoded snapshot
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the snapshot was decoded, or false if the packet is invalid or its baseline isn't available*/
+		static bool decodeSnapshot(BitReader& reader, const std::function<const Snapshot*(Uint32)>& findBaseline, const Settings& settings, Snapshot* snapshot, String* error=nullptr);
+
+		/*! Writes an acknowledgement packet.
+			\param sequence the sequence number of the received snapshot
+			\param writer the writer to write the packet to*/
+		static void encodeAck(Uint32 sequence, BitWriter& writer);
+		/*! Reads an acknowledgement packet, after its type has been read.
+			\param reader the reader positioned after the packet type
+			\param sequence stores the sequence number of the received snapshot
+			\returns true if the packet was read, or false if it is invalid*/
+		static bool decodeAck(BitReader& reader, Uint32* sequence);
+	};
+}
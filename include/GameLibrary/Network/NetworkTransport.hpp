@@ -0,0 +1,74 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <GameLibrary/Utilities/Data.hpp>
+#include <deque>
+#include <mutex>
+#include <random>
+
+namespace fgl
+{
+	/*! Sends and receives packets for one side of a connection. Packets may be lost, but are expected to arrive whole. Subclass this to send replication packets over a socket or a platform's networking service.*/
+	class NetworkTransport
+	{
+	public:
+		/*! virtual destructor*/
+		virtual ~NetworkTransport() = default;
+
+		/*! Sends a packet to the other side of the connection.
+			\param data the contents of the packet
+			\param size the size of the packet, in bytes*/
+		virtual void send(const void* data, size_t size) = 0;
+		/*! Receives the next packet that has arrived, without waiting.
+			\param packet the Data to store the contents of the packet in
+			\returns true if a packet was received, or false if no packets are waiting*/
+		virtual bool receive(Data* packet) = 0;
+	};
+
+
+
+	/*! A transport that delivers packets to another LoopbackTransport in the same process, for testing and benchmarking replication without a network. Packets can be dropped at a fixed rate to simulate a lossy connection.
+		Both ends of a connection can be used from different threads.*/
+	class LoopbackTransport : public NetworkTransport
+	{
+	public:
+		/*! default constructor*/
+		LoopbackTransport();
+		LoopbackTransport(const LoopbackTransport&) = delete;
+		LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+		/*! destructor*/
+		virtual ~LoopbackTransport();
+
+		/*! Connects two transports to each other, disconnecting them from any previous peers.
+			\param transport1 one end of the connection
+			\param transport2 the other end of the connection*/
+		static void connect(LoopbackTransport* transport1, LoopbackTransport* transport2);
+		/*! Disconnects from the other end of the connection. Packets that have already arrived can still be received.*/
+		void disconnect();
+
+		virtual void send(const void* data, size_t size) override;
+		virtual bool receive(Data* packet) override;
+
+		/*! Sets the chance that a sent packet is dropped.
+			\param lossRate the fraction of packets to drop, from 0 to 1
+			\param seed the seed of the random numbers that decide which packets are dropped*/
+		void setPacketLoss(double lossRate, unsigned int seed=0);
+
+		/*! Gets the number of packets that were sent, including ones that were dropped.
+			\returns the number of packets*/
+		size_t getPacketsSent() const;
+		/*! Gets the number of bytes that were sent, including packets that were dropped.
+			\returns the number of bytes*/
+		size_t getBytesSent() const;
+
+	private:
+		LoopbackTransport* peer;
+		std::deque<Data> incoming;
+		mutable std::mutex mutex;
+		double lossRate;
+		std::minstd_rand random;
+		size_t packetsSent;
+		size_t bytesSent;
+	};
+}
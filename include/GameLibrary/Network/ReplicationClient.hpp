@@ -0,0 +1,81 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <GameLibrary/Application/ApplicationData.hpp>
+#include <GameLibrary/Network/NetworkProtocol.hpp>
+#include <GameLibrary/Network/NetworkTransport.hpp>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+
+namespace fgl
+{
+	class World;
+	class WorldObject;
+
+	/*! Receives snapshots from a ReplicationServer, acknowledges them, and mirrors the replicated objects into a local World.
+		Received snapshots are kept in an interpolation buffer. Objects are shown a fixed delay behind the newest snapshot, with their positions and velocities interpolated between the two snapshots around that time, so that objects move smoothly even though snapshots arrive at a lower rate than frames, and with jitter.*/
+	class ReplicationClient
+	{
+	public:
+		/*! Creates the local object for a replicated object that appeared. The client adds the object to the world, and gives it a ReplicatedAspect if it doesn't have one.*/
+		typedef std::function<WorldObject*(Uint32 networkID)> ObjectFactory;
+
+		/*! the number of received snapshots kept for interpolation and as baselines*/
+		static const size_t HISTORY_SIZE;
+
+		/*! Constructs a client for a world.
+			\param world the world to mirror the replicated objects into
+			\param transport the transport of the connection to the server, which must stay alive while the client is used
+			\param factory the function that creates objects as they appear
+			\param settings the settings of the protocol, which must match the server's settings*/
+		ReplicationClient(World* world, NetworkTransport* transport, const ObjectFactory& factory, const NetworkProtocol::Settings& settings=NetworkProtocol::Settings());
+		ReplicationClient(const ReplicationClient&) = delete;
+		ReplicationClient& operator=(const ReplicationClient&) = delete;
+
+		/*! Receives snapshots, and moves the replicated objects to their interpolated state. Call this after updating the world, so that the interpolated state is what gets drawn.
+			\param appData the data of the frame, whose frame speed multiplier is used as the elapsed time*/
+		void update(const ApplicationData& appData);
+		/*! Receives and acknowledges every snapshot that has arrived.*/
+		void receive();
+
+		/*! Sets how far behind the newest snapshot objects are shown. This should be a bit more than two snapshot intervals, so that one lost packet doesn't leave nothing to interpolate towards.
+			\param delay the delay, in milliseconds*/
+		void setInterpolationDelay(double delay);
+		/*! Gets how far behind the newest snapshot objects are shown.
+			\returns the delay, in milliseconds*/
+		double getInterpolationDelay() const;
+		/*! Gets the server time that objects are currently shown at.
+			\returns the time, in milliseconds*/
+		double getRenderTime() const;
+
+		/*! Gets the local object of a replicated object.
+			\param networkID the ID of the object
+			\returns the local object, or null if the object doesn't exist on the client*/
+		WorldObject* getObject(Uint32 networkID) const;
+		/*! Gets the newest snapshot that was received.
+			\returns a pointer to the snapshot, or null if no snapshot has been received*/
+		const NetworkProtocol::Snapshot* getLatestSnapshot() const;
+
+	private:
+		const NetworkProtocol::Snapshot* findSnapshot(Uint32 sequence) const;
+		void applySnapshots();
+
+		World* world;
+		NetworkTransport* transport;
+		ObjectFactory factory;
+		NetworkProtocol::Settings settings;
+		double interpolationDelay;
+		double renderTime;
+		bool started;
+
+		// received snapshots, oldest first
+		std::deque<NetworkProtocol::Snapshot> snapshots;
+		std::unordered_map<Uint32, WorldObject*> objects;
+
+		NetworkProtocol::Snapshot decoded;
+		BitWriter writer;
+		Data packet;
+	};
+}
@@ -0,0 +1,83 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <GameLibrary/Application/ApplicationData.hpp>
+#include <GameLibrary/Network/NetworkProtocol.hpp>
+#include <GameLibrary/Network/NetworkTransport.hpp>
+#include <list>
+
+namespace fgl
+{
+	class World;
+
+	/*! Sends snapshots of the objects in a World that have a ReplicatedAspect to any number of connections, at a fixed rate.
+		Each connection gets deltas against the last snapshot it acknowledged, so a lost packet only makes the next one bigger. Until a connection has acknowledged a snapshot, it is sent every object.*/
+	class ReplicationServer
+	{
+	public:
+		/*! the number of sent snapshots that each connection keeps as possible baselines*/
+		static const size_t HISTORY_SIZE;
+
+		/*! Constructs a server for a world.
+			\param world the world to replicate
+			\param settings the settings of the protocol, which must match the clients' settings
+			\param sendRate the number of snapshots to send per second*/
+		ReplicationServer(World* world, const NetworkProtocol::Settings& settings=NetworkProtocol::Settings(), double sendRate=30.0);
+		ReplicationServer(const ReplicationServer&) = delete;
+		ReplicationServer& operator=(const ReplicationServer&) = delete;
+
+		/*! Adds a connection to send snapshots to.
+			\param transport the transport of the connection, which must stay alive until it is removed*/
+		void addConnection(NetworkTransport* transport);
+		/*! Stops sending snapshots to a connection.
+			\param transport the transport of the connection*/
+		void removeConnection(NetworkTransport* transport);
+
+		/*! Receives acknowledgements, and sends a snapshot when one is due.
+			\param appData the data of the frame, whose frame speed multiplier is used as the elapsed time*/
+		void update(const ApplicationData& appData);
+		/*! Receives acknowledgements from every connection.*/
+		void receive();
+		/*! Captures the world, and sends a snapshot to every connection now.*/
+		void sendSnapshot();
+
+		/*! Gets the sequence number of the last snapshot that was sent.
+			\returns the sequence number, or 0 if no snapshot has been sent*/
+		Uint32 getSequence() const;
+		/*! Gets the time used for snapshots, which is the time that has passed in update calls.
+			\returns the time, in milliseconds*/
+		double getTime() const;
+		/*! Gets the number of bytes in every snapshot sent so far.
+			\returns the number of bytes*/
+		size_t getBytesSent() const;
+		/*! Gets the settings of the protocol.
+			\returns a const NetworkProtocol::Settings reference*/
+		const NetworkProtocol::Settings& getSettings() const;
+
+	private:
+		struct Connection
+		{
+			NetworkTransport* transport;
+			Uint32 ackedSequence;
+			size_t firstEntity;
+			std::vector<NetworkProtocol::Snapshot> history;
+		};
+
+		void captureSnapshot();
+
+		World* world;
+		NetworkProtocol::Settings settings;
+		double sendInterval;
+		double time;
+		double nextSendTime;
+		Uint32 sequence;
+		Uint32 nextNetworkID;
+		size_t bytesSent;
+		std::list<Connection> connections;
+
+		NetworkProtocol::Snapshot snapshot;
+		BitWriter writer;
+		Data packet;
+	};
+}
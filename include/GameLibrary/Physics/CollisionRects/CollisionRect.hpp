@@ -2,6 +2,7 @@
 #pragma once
 
 #include <GameLibrary/Graphics/PixelIterator.hpp>
+#include <GameLibrary/Utilities/Atom.hpp>
 #include <GameLibrary/Utilities/String.hpp>
 #include <GameLibrary/Utilities/Geometry/Rectangle.hpp>
 #include <GameLibrary/Utilities/Geometry/Vector2.hpp>
@@ -18,11 +19,13 @@ namespace fgl
 		virtual ~CollisionRect();
 
 		const String& getTag() const;
+		const Atom& getTagAtom() const;
 		virtual RectangleD getRect() const = 0;
 		virtual RectangleD getPreviousRect() const = 0;
 		virtual bool isFilled() const = 0;
 		virtual PixelIterator createPixelIterator(const RectangleD& loopRect, const Vector2d& increment) const = 0;
 		virtual bool check(const PixelIterator& iterator) const = 0;
+		virtual bool checkSpan(const PixelIterator::Span& span, size_t* firstSample, size_t* lastSample) const = 0;
 		virtual bool check(const Vector2d& point) const = 0;
 		
 		virtual Vector2d getPreferredIncrement() const = 0;
@@ -42,6 +45,6 @@ namespace fgl
 		static bool checkPixelOnFilledCollision(const Collidable* collidable1, const CollisionRect* pixelRect, const RectangleD& filledRect);
 		static bool checkPixelCollision(const Collidable* collidable1, const CollisionRect* collisionRect1, const Collidable* collidable2, const CollisionRect* collisionRect2);
 
-		String tag;
+		Atom tag;
 	};
 }
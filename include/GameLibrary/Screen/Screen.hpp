@@ -34,11 +34,15 @@ namespace fgl
 		/*! Updates the properties of the Screen. This should NOT be overridden except for creating a custom Screen container.
 		If overridden, the overriding function should first call the base class's update function, and then check if the Screen contains a child Screen before updating.
 			\param appData specifies information about the Application updating the Screen, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData*/
-		virtual void update(ApplicationData appData);
+		virtual void update(const ApplicationData& appData);
 		/*! Draws the Screen and all of its children.
 			\param appData specifies information about the Application drawing the Screen, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData
 			\param graphics the Graphics object used to draw the Screen*/
-		virtual void draw(ApplicationData appData, Graphics graphics) const final;
+		virtual void draw(const ApplicationData& appData, Graphics graphics) const final;
+		/*! Tells whether the Screen needs to keep being updated and drawn even if there's no input, because a transition is animating, or an element or a visible child screen is animating.
+		Override this to also return true while the Screen animates anything itself in onUpdate.
+			\returns true if the Screen is animating, or false if otherwise*/
+		virtual bool isAnimating() const;
 		
 		
 		/*! Gets the size of the Screen inside the Window.
@@ -257,12 +261,12 @@ namespace fgl
 		static void TransitionData_clear(TransitionData& data);
 		static void TransitionData_begin(TransitionData& data, Screen* screen, Screen* transitionScreen, TransitionAction action, const Transition* transition, long long duration, const std::function<void()>& completion=nullptr);
 		/*Makes sure the TransitionData is initialized, if it requires it.*/
-		static void TransitionData_checkInitialization(ApplicationData& appData, TransitionData& data);
+		static void TransitionData_checkInitialization(const ApplicationData& appData, TransitionData& data);
 		/*Applies any new progress to the transition.
 		If the transition finishes, a constant representing the finished transition is returned. Otherwise, 0 is returned.*/
-		static bool TransitionData_applyProgress(ApplicationData& appData, TransitionData& data);
+		static bool TransitionData_applyProgress(const ApplicationData& appData, TransitionData& data);
 		/*Checks if the transition is finished by calling TransitionData_applyProgress, and stores the objects that need calling if so.*/
-		static std::function<void()> TransitionData_checkFinished(ApplicationData& appData, TransitionData& data);
+		static std::function<void()> TransitionData_checkFinished(const ApplicationData& appData, TransitionData& data);
 
 		void handleFirstShowing();
 		
@@ -307,7 +311,7 @@ namespace fgl
 		static size_t getTouchDataIndex(ArrayList<MouseTouchData>& touches, unsigned int touchID);
 		static ArrayList<unsigned int> getUnlistedTouchIDs(ArrayList<MouseTouchData>& touches, ArrayList<unsigned int>& touchIDs);
 		
-		void updateElementMouse(ApplicationData appData);
-		void updateElementTouch(ApplicationData appData);
+		void updateElementMouse(const ApplicationData& appData);
+		void updateElementTouch(const ApplicationData& appData);
 	};
 }
@@ -34,11 +34,14 @@ namespace fgl
 		
 		/*! Updates any properties of the element, and updates all the child elements.
 			\param appData specifies information about the Application updating the element, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData*/
-		virtual void update(ApplicationData appData);
+		virtual void update(const ApplicationData& appData);
+		/*! Tells whether the element or any of its child elements changes on its own over time, and needs to keep being updated and drawn even if there's no input.
+			\returns true if a visible child element is animating, or false if otherwise*/
+		virtual bool isAnimating() const;
 		/*! Draws the element and all of its child elements. This function calls drawBackground, drawMain, and drawElements respectively.
 			\param appData specifies information about the Application drawing the element, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData
 			\param graphics the Graphics object used to draw the element*/
-		virtual void draw(ApplicationData appData, Graphics graphics) const;
+		virtual void draw(const ApplicationData& appData, Graphics graphics) const;
 		
 		
 		/*! Called to layout child elements inside this element. */
@@ -197,10 +200,16 @@ namespace fgl
 			bool isMouseEvent() const;
 			
 			fgl::String toString() const;
+			
+			/*! Constructs a touch event. Screen creates these from mouse and touch input, but they can also be created to simulate input.
+				\param eventType the type of event
+				\param touchID the ID of the touch or the index of the mouse
+				\param appData the application data of the element receiving the event, whose transform converts the position into the element's coordinates
+				\param realPosition the position of the touch, before being transformed
+				\param isMouse true if the event came from a mouse, or false if it came from a touch*/
+			TouchEvent(const EventType& eventType, unsigned int touchID, const ApplicationData& appData, const Vector2d& realPosition, bool isMouse);
 
 		private:
-			TouchEvent(const EventType& eventType, unsigned int touchID, ApplicationData appData, const Vector2d& realPosition, bool isMouse);
-			
 			EventType eventType;
 			unsigned int touchID;
 			ApplicationData appData;
@@ -209,34 +218,39 @@ namespace fgl
 			bool mouse;
 		};
 		
+		/*! Sends a touch event to this element, and then to the child elements under the touch from the top down until one of them handles it. The rest of the child elements under the touch are told that it was handled. Screen calls this for each mouse and touch event.
+			\param touchEvent the event to send
+			\returns true if this element or one of its child elements handled the event, or false if otherwise*/
+		bool sendTouchEvent(const TouchEvent& touchEvent);
+		
 	protected:
 		/*! Lays out child elements in parent frame */
 		virtual void onLayoutChildElements();
 		/*! Updates all the child elements of this element. This function is automatically called from ScreenElement::update.
 			\param appData specifies information about the Application drawing the element, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData*/
-		virtual void updateElements(ApplicationData appData);
+		virtual void updateElements(const ApplicationData& appData);
 		/*! Draws the background color of the element. This function is automatically called from ScreenElement::draw.
 			\param appData specifies information about the Application drawing the element, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData
 			\param graphics the Graphics object used to draw the element*/
-		virtual void drawBackground(ApplicationData appData, Graphics graphics) const;
+		virtual void drawBackground(const ApplicationData& appData, Graphics graphics) const;
 		/*! Draws the main content of the element. This does nothing by default, and is intended to be overridden. This function is automatically called from ScreenElement::draw.
 			\param appData specifies information about the Application drawing the element, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData
 			\param graphics the Graphics object used to draw the element*/
-		virtual void drawMain(ApplicationData appData, Graphics graphics) const;
+		virtual void drawMain(const ApplicationData& appData, Graphics graphics) const;
 		/*! Draws the border on top of the element. This function is called from ScreenElement::draw.
 			\param appData specifies information about the Application drawing the element, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData
 			\param graphics the Graphics object used to draw the element*/
-		virtual void drawBorder(ApplicationData appData, Graphics graphics) const;
+		virtual void drawBorder(const ApplicationData& appData, Graphics graphics) const;
 		/*! Draws all the child elements of this element. This function is automatically called from ScreenElement::draw.
 			\param appData specifies information about the Application drawing the element, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData
 			\param graphics the Graphics object used to draw the element*/
-		virtual void drawElements(ApplicationData appData, Graphics graphics) const;
+		virtual void drawElements(const ApplicationData& appData, Graphics graphics) const;
 		
 		
 		/*! Called to apply any necessary changes to the ApplicationData before it's passed to the child elements
-			\param appData the ApplicationData object to change
-			\returns the modified ApplicationData */
-		virtual ApplicationData getChildrenApplicationData(ApplicationData appData) const;
+			\param appData the ApplicationData object passed to this element
+			\returns a copy of the ApplicationData with the changes applied */
+		virtual ApplicationData getChildrenApplicationData(const ApplicationData& appData) const;
 		/*! Called to apply any necessary changes to the Graphics before it's passed to the child elements
 			\param graphics the Graphics object to change
 			\returns the modified Graphics */
@@ -263,13 +277,29 @@ namespace fgl
 			\param touchEvent the event that occured
 			\returns true if the element handles the event, false if the element ignores the event */
 		virtual bool handleTouchEvent(const TouchEvent& touchEvent);
-		/*! Called when a sibling higher in the element stack or a parent of this element handles a touch event.
+		/*! Called when a sibling higher in the element stack or a parent of this element handles a touch event. This is only called if the touch is inside this element's touch bounds, or if needsAllTouchEvents returns true for this element or one of its child elements.
 			\param touchEvent the event that occured */
 		virtual void otherElementHandledTouchEvent(const TouchEvent& touchEvent);
+		/*! Tells whether this element needs touch events that are outside of its touch bounds, such as while it's tracking a touch that started inside of it. Touch events are only sent to the elements whose touch bounds contain the touch, and to the elements that return true from this function. Call updateNeedsAllTouchEvents whenever the value this returns might have changed.
+			\returns true if the element needs every touch event, or false if it only needs touch events inside its touch bounds. The default implementation returns false.*/
+		virtual bool needsAllTouchEvents() const;
+		/*! Checks needsAllTouchEvents again, so that touch events are routed to this element if it now needs them.*/
+		void updateNeedsAllTouchEvents();
+		/*! Calculates the area that a touch needs to be inside of for its events to be sent to this element and its child elements, in the same coordinates as the frame. This is only recalculated when the frame or the child elements change.
+		Override this if getChildrenApplicationData moves the child elements somewhere other than relative to the frame, or if the element responds to touches outside of its frame.
+			\returns the touch bounds. The default implementation combines the frame with the touch bounds of the child elements.*/
+		virtual RectangleD calculateTouchBounds() const;
 		
 	private:
-		bool sendTouchEvent(const TouchEvent& touchEvent);
+		struct TouchGrid;
+		
 		void sendHandledTouchEvent(const TouchEvent& touchEvent);
+		/*Recalculates the touch bounds and the touch grid of this element and any child elements whose frames or children changed.*/
+		void updateTouchIndex();
+		/*Marks the touch bounds of this element and its parent elements as needing to be recalculated.*/
+		void invalidateTouchIndex();
+		/*Gets the child elements that a touch event at a point should be sent to, with the top element first. These are the elements whose touch bounds contain the point, and the elements that need every touch event.*/
+		ArrayList<ScreenElement*> getTouchEventChildElements(const Vector2d& point) const;
 		
 		void handleAddToWindow(Window* window);
 		void handleRemoveFromWindow(Window* window);
@@ -290,5 +320,15 @@ namespace fgl
 		bool visible;
 		bool clipsToFrame;
 		bool needsLayout;
+		
+		// touch bounds in the parent element's coordinates, and the combined touch bounds of the child elements in this element's child coordinates
+		RectangleD touchBounds;
+		RectangleD childTouchBounds;
+		// buckets the child elements by their touch bounds, if there are enough child elements to need it
+		TouchGrid* touchGrid;
+		// the number of elements in this element's subtree, including itself, that need every touch event
+		size_t allTouchEventsCount;
+		bool touchIndexValid;
+		bool needsAllTouchEventsCached;
 	};
 }
@@ -17,7 +17,7 @@ namespace fgl
 		virtual ~FadeZoomTransition();
 		
 		/*! \copydoc fgl::Transition::draw(ApplicationData,Graphics,double,Screen*,Screen*)const*/
-		virtual void draw(ApplicationData appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const override;
+		virtual void draw(const ApplicationData& appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const override;
 		
 	protected:
 		/*! the zoom ratio at the beginning of the transition*/
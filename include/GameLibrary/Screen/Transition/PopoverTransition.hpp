@@ -30,7 +30,7 @@ namespace fgl
 		virtual ~PopoverTransition();
 		
 		/*! \copydoc fgl::Transition::draw(ApplicationData,Graphics,double,Screen*,Screen*)const*/
-		virtual void draw(ApplicationData appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const override;
+		virtual void draw(const ApplicationData& appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const override;
 		
 	protected:
 		/*! the direction of the popover*/
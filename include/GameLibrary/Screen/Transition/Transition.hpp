@@ -26,6 +26,6 @@ namespace fgl
 			\param progress the current Transition progress, from 0 to 1; Making this a value other than 0 through 1 causes undefined behavior
 			\param screen1 the first Screen being transitioned
 			\param screen2 the second Screen being transitioned*/
-		virtual void draw(ApplicationData appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const = 0;
+		virtual void draw(const ApplicationData& appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const = 0;
 	};
 }
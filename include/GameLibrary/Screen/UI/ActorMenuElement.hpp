@@ -24,7 +24,7 @@ namespace fgl
 		
 		
 		/*! \copydoc fgl::ScreenElement::update(ApplicationData)*/
-		virtual void update(ApplicationData appData) override;
+		virtual void update(const ApplicationData& appData) override;
 		
 		
 		/*! Adds an actor to the menu.
@@ -138,12 +138,12 @@ namespace fgl
 		virtual void onLayoutChildElements() override;
 		
 		/*! \copydoc fgl::ScreenElement::drawMain(ApplicationData)const*/
-		virtual void drawMain(ApplicationData appData, Graphics graphics) const override;
+		virtual void drawMain(const ApplicationData& appData, Graphics graphics) const override;
 		/*! Called to draw an Actor in the menu. This function can be overridden to add custom drawing behavior.
 			\param appData specifies information about the Application drawing the Actor, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData
 			\param graphics the Graphics object used to draw the Actor
 			\param actor the Actor from the menu being drawn*/
-		virtual void drawActor(ApplicationData appData, Graphics graphics, Actor*actor) const;
+		virtual void drawActor(const ApplicationData& appData, Graphics graphics, Actor*actor) const;
 		
 	private:
 		ArrayList<Actor*> actors;
@@ -26,7 +26,10 @@ namespace fgl
 		
 		
 		/*! \copydoc fgl::ScreenElement::update(fgl::ApplicationData)*/
-		virtual void update(ApplicationData appData) override;
+		virtual void update(const ApplicationData& appData) override;
+		/*! Tells whether the element is playing an Animation with more than one frame, or if a child element is animating.
+			\returns true if the element is animating, or false if otherwise*/
+		virtual bool isAnimating() const override;
 		
 		
 		/*! Sets the Animation for the element to display.
@@ -25,7 +25,7 @@ namespace fgl
 		ButtonElement(const RectangleD& frame);
 		ButtonElement(const RectangleD& frame, const String& title, const std::function<void()>& tapHandler);
 		
-		virtual void draw(ApplicationData appData, Graphics graphics) const override;
+		virtual void draw(const ApplicationData& appData, Graphics graphics) const override;
 		
 		void setTapHandler(const std::function<void()>& tapHandler);
 		const std::function<void()>& getTapHandler() const;
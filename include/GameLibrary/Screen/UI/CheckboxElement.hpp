@@ -12,7 +12,7 @@ namespace fgl
 		CheckboxElement();
 		CheckboxElement(const RectangleD& frame);
 		
-		virtual void drawMain(ApplicationData appData, Graphics graphics) const override;
+		virtual void drawMain(const ApplicationData& appData, Graphics graphics) const override;
 		
 		void setToggle(bool toggle);
 		bool getToggle() const;
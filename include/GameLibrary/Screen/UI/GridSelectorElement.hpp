@@ -14,7 +14,7 @@ namespace fgl
 		GridSelectorElement();
 		explicit GridSelectorElement(const fgl::RectangleD& frame);
 		
-		virtual void update(fgl::ApplicationData appData) override;
+		virtual void update(const fgl::ApplicationData& appData) override;
 		
 		void setItems(const fgl::ArrayList<fgl::ButtonElement*>& items);
 		const fgl::ArrayList<fgl::ButtonElement*>& getItems() const;
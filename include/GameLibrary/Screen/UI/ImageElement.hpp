@@ -86,7 +86,7 @@ namespace fgl
 		
 	protected:
 		/*! \copydoc fgl::ScreenElement::drawMain(fgl::ApplicationData,fgl::Graphics)const*/
-		virtual void drawMain(ApplicationData appData, Graphics graphics) const override;
+		virtual void drawMain(const ApplicationData& appData, Graphics graphics) const override;
 		
 	private:
 		TextureImage* image;
@@ -186,7 +186,7 @@ namespace fgl
 			\param appData specifies information about the Application drawing the Actor, such as the Window object, the Viewport transform, etc. \see fgl::ApplicationData
 			\param graphics the Graphics object used to draw the Actor
 			\param item the Actor from the menu being drawn*/
-		virtual void drawItem(ApplicationData appData, Graphics graphics, Actor* item) const;
+		virtual void drawItem(const ApplicationData& appData, Graphics graphics, Actor* item) const;
 		
 	private:
 		class MainElement : public ActorMenuElement
@@ -195,7 +195,7 @@ namespace fgl
 			MenuScreen*menuScreen;
 			
 		protected:
-			virtual void drawActor(ApplicationData appData, Graphics graphics, Actor* actor) const override;
+			virtual void drawActor(const ApplicationData& appData, Graphics graphics, Actor* actor) const override;
 			
 		public:
 			MainElement(MenuScreen* menuScreen, const RectangleD& frame);
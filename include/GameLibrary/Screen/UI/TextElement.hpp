@@ -32,7 +32,7 @@ namespace fgl
 			Color color = Colors::BLACK,
 			const RectangleD& frame = fgl::RectangleD(0,0,0,0));
 
-		virtual void drawMain(ApplicationData appData, Graphics graphics) const override;
+		virtual void drawMain(const ApplicationData& appData, Graphics graphics) const override;
 
 		void setText(const String& text);
 		const String& getText() const;
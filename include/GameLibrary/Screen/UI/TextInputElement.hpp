@@ -16,7 +16,7 @@ namespace fgl
 		explicit TextInputElement(const RectangleD&frame);
 		
 		/*! \copydoc fgl::TouchElement::update(fgl::ApplicationData)*/
-		virtual void update(ApplicationData appData) override;
+		virtual void update(const ApplicationData& appData) override;
 		
 		virtual bool becomeTextInputResponder();
 		virtual void resignTextInputResponder();
@@ -45,6 +45,7 @@ namespace fgl
 
 		virtual bool handleTouchEvent(const TouchEvent& touchEvent) override;
 		virtual void otherElementHandledTouchEvent(const TouchEvent& touchEvent) override;
+		virtual bool needsAllTouchEvents() const override;
 		
 		virtual void onRemoveFromScreenElement(ScreenElement* parent) override;
 		
@@ -13,7 +13,7 @@ namespace fgl
 		/*! \copydoc fgl::ScreenElement::ScreenElement(const RectangleD&frame)*/
 		explicit TouchElement(const RectangleD&frame);
 		
-		virtual void update(ApplicationData appData) override;
+		virtual void update(const ApplicationData& appData) override;
 		
 		void setTouchEnabled(bool toggle);
 		bool isTouchEnabled() const;
@@ -34,6 +34,7 @@ namespace fgl
 		
 		virtual bool handleTouchEvent(const TouchEvent& touchEvent) override;
 		virtual void otherElementHandledTouchEvent(const TouchEvent& touchEvent) override;
+		virtual bool needsAllTouchEvents() const override;
 
 		virtual bool isPointInside(const Vector2d& point) const;
 		
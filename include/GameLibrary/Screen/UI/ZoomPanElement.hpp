@@ -22,22 +22,31 @@ namespace fgl
 		
 		void zoomOnPoint(const Vector2d& point, double zoomScale);
 		void zoomOnPointInFrame(const Vector2d& point, double zoomScale);
+		
+		/*! Tells whether the scrollbars are showing and still need to fade out, or if a child element is animating.
+			\returns true if the element is animating, or false if otherwise*/
+		virtual bool isAnimating() const override;
 
 		//TODO implement private touch event handling functions, and pass transformed appData to child elements
 		
 	protected:
 		/*! \copydoc fgl::ScreenElement::drawElements(fgl::ApplicationData,fgl::Graphics)const*/
-		virtual void drawElements(ApplicationData appData, Graphics graphics) const override;
+		virtual void drawElements(const ApplicationData& appData, Graphics graphics) const override;
 		
-		virtual void drawScrollbars(ApplicationData appData, Graphics graphics) const;
+		virtual void drawScrollbars(const ApplicationData& appData, Graphics graphics) const;
 		
 		/*! \copydoc fgl::ScreenElement::handleTouchEvent(const fgl::ScreenElement::TouchEvent&)*/
 		virtual bool handleTouchEvent(const TouchEvent& touchEvent) override;
 		/*! \copydoc fgl::ScreenElement::otherElementHandledTouchEvent(const fgl::ScreenElement::TouchEvent&)*/
 		virtual void otherElementHandledTouchEvent(const TouchEvent& touchEvent) override;
+		/*! \copydoc fgl::ScreenElement::needsAllTouchEvents()const*/
+		virtual bool needsAllTouchEvents() const override;
+		/*! Calculates the touch bounds of the element, which is only its frame, since the child elements are scrolled and clipped to the frame.
+			\returns the frame of the element*/
+		virtual RectangleD calculateTouchBounds() const override;
 		
 		/*! \copydoc fgl::ScreenElement::getChildrenApplicationData(fgl::ApplicationData)*/
-		virtual ApplicationData getChildrenApplicationData(ApplicationData appData) const override;
+		virtual ApplicationData getChildrenApplicationData(const ApplicationData& appData) const override;
 		/*! \copydoc fgl::ScreenElement::getChildrenGraphics(fgl::Graphics)*/
 		virtual Graphics getChildrenGraphics(Graphics graphics) const override;
 		
@@ -51,6 +60,8 @@ namespace fgl
 		double zoomScale;
 		
 		long long lastScrollbarFocusMillis;
+		// set when the scrollbars are drawn, since fading them out depends on the time
+		mutable bool scrollbarsShowing;
 		
 		unsigned int horizontalScrollbarTouchID;
 		Vector2d horizontalScrollbarTouchOffset;
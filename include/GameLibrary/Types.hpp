@@ -23,10 +23,12 @@ namespace fgl
 	//Application
 	class Application;
 	class ApplicationData;
+	class FramePacer;
 	class BatchLoader;
 	class EventManager;
 	
 	//Audio
+	class AudioMixer;
 	class Music;
 	class Sound;
 	
@@ -61,19 +63,30 @@ namespace fgl
 	class Graphics;
 	class Color;
 	class Image;
+	class PixelConverter;
+	class PixelMask;
+	class RenderCommandList;
 	class TextureImage;
 	
 	//Input
+	class InputRecorder;
 	class Keyboard;
 	class Mouse;
 	class Multitouch;
 	
 	//IO
 	class Console;
+	class Logger;
 	class FileTools;
 	
 	//Network
+	class BitReader;
+	class BitWriter;
+	class LoopbackTransport;
 	class NetworkProtocol;
+	class NetworkTransport;
+	class ReplicationClient;
+	class ReplicationServer;
 	
 	//Physics
 	class Collidable;
@@ -135,6 +148,7 @@ namespace fgl
 	class Math;
 	class Number;
 	class Plist;
+	class Profiler;
 	template<typename T>
 	class Promise;
 	template<typename T>
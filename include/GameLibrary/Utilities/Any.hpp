@@ -1,7 +1,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <new>
+#include <type_traits>
 #include <typeinfo>
+#include <utility>
 #include <GameLibrary/Exception/Utilities/BadAnyCastException.hpp>
 #include "String.hpp"
 
@@ -14,12 +18,23 @@ namespace fgl
 		{
 		public:
 			virtual ~Base() {}
-			virtual Base* clone() const = 0;
+			virtual Base* clone(void* memory) const = 0;
+			virtual Base* moveTo(void* memory) = 0;
 			virtual void* getPtr() const = 0;
 			virtual String toString() const = 0;
 			virtual const std::type_info& getTypeInfo() const = 0;
 		};
 		
+		// small values are stored inline, so that numbers, pointers, and short strings don't need their own allocation
+		typedef std::aligned_storage<48, alignof(std::max_align_t)>::type Storage;
+		
+		template<typename T>
+		class Derived;
+		
+		template<typename T>
+		using IsInline = std::integral_constant<bool, (sizeof(Derived<T>) <= sizeof(Storage) && alignof(Derived<T>) <= alignof(Storage)
+			&& std::is_nothrow_move_constructible<T>::value)>;
+		
 		template<typename T>
 		class Derived : public Base
 		{
@@ -27,22 +42,70 @@ namespace fgl
 			T value;
 			
 			Derived(const T& val) : value(val) {}
-			Derived(T&& val) : value(val) {}
-			virtual Base* clone() const override { return new Derived<T>(value); }
+			Derived(T&& val) : value(std::move(val)) {}
+			virtual Base* clone(void* memory) const override { return create<const T&>(memory, value, IsInline<T>()); }
+			virtual Base* moveTo(void* memory) override { return create<T&&>(memory, std::move(value), IsInline<T>()); }
 			virtual void* getPtr() const override { return (void*)(&value); }
 			virtual String toString() const override { return fgl::stringify<T>(value); }
 			virtual const std::type_info& getTypeInfo() const override { return typeid(T); }
+			
+			template<typename U>
+			static Base* create(void* memory, U&& value, std::true_type) { return new(memory) Derived<T>(std::forward<U>(value)); }
+			template<typename U>
+			static Base* create(void*, U&& value, std::false_type) { return new Derived<T>(std::forward<U>(value)); }
 		};
 		
-		Base* cloneBase() const
+		template<typename T, typename U>
+		Base* createBase(U&& value)
 		{
-			if(ptr!=nullptr)
+			return Derived<T>::create(&storage, std::forward<U>(value), IsInline<T>());
+		}
+		
+		Base* cloneBase(const Any& any)
+		{
+			if(any.ptr!=nullptr)
 			{
-				return ptr->clone();
+				return any.ptr->clone(&storage);
 			}
 			return nullptr;
 		}
 		
+		Base* takeBase(Any& any)
+		{
+			Base* base = any.ptr;
+			if(base!=nullptr && any.isInline())
+			{
+				// inline values have to be moved into this storage, while heap values can just be taken
+				base = base->moveTo(&storage);
+				any.destroy();
+			}
+			any.ptr = nullptr;
+			return base;
+		}
+		
+		bool isInline() const
+		{
+			return (ptr==reinterpret_cast<const Base*>(&storage));
+		}
+		
+		void destroy()
+		{
+			if(ptr==nullptr)
+			{
+				return;
+			}
+			if(isInline())
+			{
+				ptr->~Base();
+			}
+			else
+			{
+				delete ptr;
+			}
+			ptr = nullptr;
+		}
+		
+		Storage storage;
 		Base* ptr;
 		
 	public:
@@ -56,80 +119,66 @@ namespace fgl
 			//
 		}
 		
-		Any(Any& any) : ptr(any.cloneBase())
+		Any(Any& any) : ptr(cloneBase(any))
 		{
 			//
 		}
 		
-		Any(Any&& any) : ptr(any.ptr)
+		Any(Any&& any) noexcept : ptr(takeBase(any))
 		{
-			any.ptr = nullptr;
+			//
 		}
 		
-		Any(const Any& any) : ptr(any.cloneBase())
+		Any(const Any& any) : ptr(cloneBase(any))
 		{
 			//
 		}
 		
-		Any(const Any&& any) : ptr(any.cloneBase())
+		Any(const Any&& any) : ptr(cloneBase(any))
 		{
 			//
 		}
 		
 		template<typename U>
-		Any(U&& value) : ptr(new Derived<typename std::decay<U>::type>(value))
+		Any(U&& value) : ptr(createBase<typename std::decay<U>::type>(std::forward<U>(value)))
 		{
 			//
 		}
 		
 		~Any()
 		{
-			if(ptr!=nullptr)
-			{
-				delete ptr;
-			}
+			destroy();
 		}
 		
 		Any& operator=(std::nullptr_t)
 		{
-			Base* old_ptr = ptr;
-			ptr = nullptr;
-			if(old_ptr!=nullptr)
-			{
-				delete old_ptr;
-			}
+			destroy();
 			return *this;
 		}
 		
 		Any& operator=(const Any& any)
 		{
-			if(ptr==any.ptr)
+			if(&any==this)
 			{
 				return *this;
 			}
-			Base* old_ptr = ptr;
-			ptr = any.cloneBase();
-			if(old_ptr!=nullptr)
-			{
-				delete old_ptr;
-			}
+			// copy before destroying, in case the other value is owned by this one
+			Any copy(any);
+			destroy();
+			ptr = takeBase(copy);
 			return *this;
 		}
 		
-		Any& operator=(Any&& any)
+		Any& operator=(Any&& any) noexcept
 		{
-			if(ptr==any.ptr)
+			if(&any==this)
 			{
 				return *this;
 			}
-			Base* old_ptr = ptr;
-			Base* new_ptr = any.ptr;
-			any.ptr = nullptr;
-			ptr = new_ptr;
-			if(old_ptr!=nullptr)
-			{
-				delete old_ptr;
-			}
+			// take the other value before destroying, in case it's owned by this one
+			Any taken(std::move(any));
+			destroy();
+			ptr = takeBase(taken);
 			return *this;
 		}
 		
@@ -58,9 +58,10 @@ namespace fgl
 				}
 				objects.reserve(numBlocks*prealloc_count);
 			}
-			else
+			else if(objects_size > objects.capacity())
 			{
-				objects.reserve(objects_size);
+				//grow geometrically, so that adding one object at a time doesn't reallocate on every add
+				objects.reserve(std::max(objects_size, objects.capacity()*2));
 			}
 		}
 		
@@ -348,7 +349,7 @@ namespace fgl
 		void add(T&& obj)
 		{
 			updatePreallocation(objects.size()+1);
-			objects.push_back(obj);
+			objects.push_back(std::move(obj));
 		}
 		
 		void add(size_t index, const T& obj)
@@ -376,7 +377,7 @@ namespace fgl
 				#endif
 			}
 			updatePreallocation(objects.size()+1);
-			objects.insert(objects.begin()+index, obj);
+			objects.insert(objects.begin()+index, std::move(obj));
 		}
 		
 		template<typename U, size_t _PREALLOC_COUNT,
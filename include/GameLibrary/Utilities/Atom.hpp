@@ -0,0 +1,86 @@
+
+#pragma once
+
+#include <functional>
+#include "String.hpp"
+
+namespace fgl
+{
+	/*! An interned string. Atoms made from equal strings share the same storage, so comparing, hashing, and copying atoms only touches a pointer.
+		Interned strings are kept until the program exits, so atoms are meant for a limited set of names, like tags and keys, rather than arbitrary text.*/
+	class Atom
+	{
+	public:
+		/*! Constructs an atom for the empty string.*/
+		Atom();
+		/*! Constructs an atom for a string, interning the string if an equal string hasn't been interned yet.
+			\param str the string to intern*/
+		Atom(const String& str);
+		/*! Constructs an atom for a string, interning the string if an equal string hasn't been interned yet.
+			\param str the string to intern*/
+		Atom(const char* str);
+
+		/*! Finds the atom for a string without interning it, for looking up atoms with strings that may not have been interned.
+			\param str the string to find
+			\returns the atom for the string, or the empty atom if an equal string hasn't been interned*/
+		static Atom find(const String& str);
+
+		/*! Gets the interned string.
+			\returns a const String reference, which stays valid for the rest of the program*/
+		const String& toString() const {
+			return *string;
+		}
+
+		/*! Gets the interned string.
+			\returns a const String reference, which stays valid for the rest of the program*/
+		operator const String&() const {
+			return *string;
+		}
+
+		/*! Gets the characters of the interned string.
+			\returns a const char pointer to the null-terminated characters*/
+		const char* getData() const {
+			return string->getData();
+		}
+
+		/*! Gets the length of the interned string.
+			\returns the number of characters in the string*/
+		size_t length() const {
+			return string->length();
+		}
+
+		/*! Gets a hash of the atom. Equal atoms always have equal hashes, but the hash may differ between runs of the program.
+			\returns a hash value*/
+		size_t hash() const {
+			return std::hash<const String*>()(string);
+		}
+
+		bool operator==(const Atom& atom) const {
+			return string == atom.string;
+		}
+
+		bool operator!=(const Atom& atom) const {
+			return string != atom.string;
+		}
+
+		/*! Orders atoms by their storage, not alphabetically. The order is consistent for the rest of the program, so atoms can be used as keys of ordered containers.*/
+		bool operator<(const Atom& atom) const {
+			return string < atom.string;
+		}
+
+	private:
+		const String* string;
+	};
+}
+
+namespace std
+{
+	template<>
+	struct hash<fgl::Atom>
+	{
+		size_t operator()(const fgl::Atom& atom) const
+		{
+			return atom.hash();
+		}
+	};
+}
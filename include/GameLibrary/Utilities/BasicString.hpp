@@ -359,7 +359,7 @@ namespace fgl
 		BasicString(const CHAR_TYPE* str, size_t length);
 		BasicString(const CHAR_TYPE* str);
 		BasicString(const BasicString<CHAR_TYPE>& str);
-		BasicString(BasicString<CHAR_TYPE>&& str);
+		BasicString(BasicString<CHAR_TYPE>&& str) noexcept;
 		BasicString(const std::basic_string<CHAR_TYPE>& str);
 		
 		#ifdef __OBJC__
@@ -456,7 +456,7 @@ namespace fgl
 		
 		BasicString<CHAR_TYPE>& operator=(const CHAR_TYPE* str);
 		BasicString<CHAR_TYPE>& operator=(const BasicString<CHAR_TYPE>& str);
-		BasicString<CHAR_TYPE>& operator=(BasicString<CHAR_TYPE>&& str);
+		BasicString<CHAR_TYPE>& operator=(BasicString<CHAR_TYPE>&& str) noexcept;
 		BasicString<CHAR_TYPE>& operator=(const std::basic_string<CHAR_TYPE>& str);
 		
 		#ifdef __OBJC__
@@ -580,6 +580,9 @@ namespace fgl
 		bool equals(const CHAR_TYPE* str) const;
 		bool equals(const BasicString<CHAR_TYPE>& str) const;
 		
+		size_t hash() const;
+		static size_t hash(const CHAR_TYPE* str, size_t length);
+		
 		
 		
 		size_t length() const;
@@ -645,8 +648,19 @@ namespace fgl
 		NUM_TYPE toArithmeticValue(const std::locale& locale = std::locale()) const;
 		
 	private:
+		// the number of characters, including the null terminator, that fit without a heap allocation
+		static constexpr size_t INLINE_CAPACITY = (24 / sizeof(CHAR_TYPE));
+		
 		CHAR_TYPE* characters;
 		size_t size;
+		union
+		{
+			CHAR_TYPE inlineCharacters[INLINE_CAPACITY];
+			size_t heapCapacity;
+		};
+		
+		CHAR_TYPE* reallocate_characters(size_t capacity);
+		void take_characters(BasicString<CHAR_TYPE>& str) noexcept;
 		
 		
 		template<typename T, size_t T_SIZE=sizeof(T)>
@@ -815,4 +829,16 @@ namespace fgl
 
 #ifndef STRING_STANDALONE
 }
+
+namespace std
+{
+	template<typename CHAR_TYPE>
+	struct hash<fgl::BasicString<CHAR_TYPE>>
+	{
+		size_t operator()(const fgl::BasicString<CHAR_TYPE>& str) const
+		{
+			return str.hash();
+		}
+	};
+}
 #endif
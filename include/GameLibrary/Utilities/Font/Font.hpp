@@ -52,6 +52,16 @@ namespace fgl
 			\param error an optional String pointer to store the error message if the function fails
 			\returns true if the load succeeds, or false if an error occurs */
 		bool loadFromFile(FILE* file, String* error=nullptr);
+		/*! Loads the Font from the contents of a font file that has already been read into memory.
+			\param data the contents of the font file
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the load succeeds, or false if an error occurs */
+		bool loadFromData(const Data& data, String* error=nullptr);
+		/*! Loads the Font from the contents of a font file that has already been read into memory, taking ownership of the data.
+			\param data the contents of the font file
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the load succeeds, or false if an error occurs */
+		bool loadFromData(Data&& data, String* error=nullptr);
 		
 		
 		/*! Estimates the display size of a given string of text.
@@ -102,6 +112,9 @@ namespace fgl
 		/*! Tells whether smoothing is enabled for glyph rendering.
 			\returns true if smoothing is enabled, or false if otherwise*/
 		bool getAntialiasing();
+		/*! Gets the size of the loaded font file data.
+			\returns the size of the font file in bytes, or 0 if no font is loaded*/
+		size_t getDataSize() const;
 		
 	private:
 		typedef ArrayList<std::pair<unsigned int, void*> > FontSizeList;
@@ -117,6 +130,7 @@ namespace fgl
 		mutable std::mutex mlock;
 		
 		void* loadFontSize(unsigned int size);
+		bool loadFromDataPacket(Data* fontDataPacket, String* error);
 		void* getFontPtr(unsigned int size);
 		int getAscent(unsigned int size);
 		int getDescent(unsigned int size);
@@ -0,0 +1,166 @@
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include "Any.hpp"
+#include "ArrayList.hpp"
+#include "Dictionary.hpp"
+#include "String.hpp"
+#include <GameLibrary/Types.hpp>
+#include <GameLibrary/Exception/Utilities/DictionaryKeyNotFoundException.hpp>
+
+#ifdef __OBJC__
+	#import <Foundation/Foundation.h>
+#endif
+
+namespace fgl
+{
+	/*! A dictionary backed by an open addressing hash table, with the same interface as BasicDictionary.
+		Entries are stored contiguously in insertion order, so iterating is a linear walk over memory and the iteration order is stable (eg, for writing plists).
+		Adding entries may invalidate iterators and references to values, the same as adding to an ArrayList.
+		Keys must not be modified through an iterator.*/
+	template<typename KEY_TYPE, typename VALUE_TYPE, typename HASH_TYPE = std::hash<KEY_TYPE>>
+	class BasicHashDictionary
+	{
+	public:
+		typedef KEY_TYPE Key;
+		typedef VALUE_TYPE Value;
+		typedef std::pair<KEY_TYPE, VALUE_TYPE> Entry;
+
+		typedef typename std::vector<Entry>::iterator iterator;
+		typedef typename std::vector<Entry>::const_iterator const_iterator;
+		typedef typename std::vector<Entry>::reverse_iterator reverse_iterator;
+		typedef typename std::vector<Entry>::const_reverse_iterator const_reverse_iterator;
+
+		class ValueProxy
+		{
+			friend class BasicHashDictionary<KEY_TYPE, VALUE_TYPE, HASH_TYPE>;
+		public:
+			ValueProxy() = delete;
+			ValueProxy(const ValueProxy&) = delete;
+			ValueProxy& operator=(const ValueProxy&) = delete;
+
+			VALUE_TYPE& operator=(const VALUE_TYPE&);
+			VALUE_TYPE& operator=(VALUE_TYPE&&);
+
+			operator VALUE_TYPE&();
+
+		private:
+			KEY_TYPE key;
+			BasicHashDictionary<KEY_TYPE, VALUE_TYPE, HASH_TYPE>& dictionary;
+
+			ValueProxy(ValueProxy&&);
+			ValueProxy(const KEY_TYPE& key, BasicHashDictionary<KEY_TYPE, VALUE_TYPE, HASH_TYPE>& dictionary);
+		};
+
+		BasicHashDictionary();
+		BasicHashDictionary(std::initializer_list<Entry> list);
+		BasicHashDictionary(const ArrayList<KEY_TYPE>& keys, const ArrayList<VALUE_TYPE>& values);
+		BasicHashDictionary(const ArrayList<Entry>& contents);
+		BasicHashDictionary(ArrayList<Entry>&& contents);
+		BasicHashDictionary(const BasicDictionary<KEY_TYPE, VALUE_TYPE>& dictionary);
+
+		iterator begin();
+		const_iterator begin() const;
+		const_iterator cbegin() const;
+		iterator end();
+		const_iterator end() const;
+		const_iterator cend() const;
+		reverse_iterator rbegin();
+		const_reverse_iterator rbegin() const;
+		const_reverse_iterator crbegin() const;
+		reverse_iterator rend();
+		const_reverse_iterator rend() const;
+		const_reverse_iterator crend() const;
+
+		bool has(const KEY_TYPE& key) const;
+
+		/*! Finds the entry for a key.
+			\param key the key to look for
+			\returns an iterator to the entry, or end() if the key is not set*/
+		iterator find(const KEY_TYPE& key);
+		/*! \copydoc fgl::BasicHashDictionary::find(const KEY_TYPE&)*/
+		const_iterator find(const KEY_TYPE& key) const;
+
+		/*! Sets the value for a key. New keys are added after all the existing entries.
+			\param key the key to set
+			\param value the value to set for the key
+			\returns an iterator to the entry for the key*/
+		iterator set(const KEY_TYPE& key, const VALUE_TYPE& value);
+		/*! \copydoc fgl::BasicHashDictionary::set(const KEY_TYPE&,const VALUE_TYPE&)*/
+		iterator set(const KEY_TYPE& key, VALUE_TYPE&& value);
+
+		VALUE_TYPE& get(const KEY_TYPE& key);
+		const VALUE_TYPE& get(const KEY_TYPE& key) const;
+		VALUE_TYPE& get(const KEY_TYPE& key, VALUE_TYPE& defaultValue);
+		const VALUE_TYPE& get(const KEY_TYPE& key, const VALUE_TYPE& defaultValue) const;
+
+		/*! Removes the entry for a key, keeping the order of the remaining entries. This shifts every entry after the removed one.
+			\param key the key to remove*/
+		void remove(const KEY_TYPE& key);
+		/*! Removes the entry for a key in constant time, by moving the last entry into its place.
+			\param key the key to remove*/
+		void removeUnordered(const KEY_TYPE& key);
+
+		ValueProxy operator[](const KEY_TYPE& key);
+
+		ArrayList<KEY_TYPE> getKeys() const;
+		ArrayList<VALUE_TYPE> getValues() const;
+
+		size_t size() const;
+		/*! Allocates enough space to hold a number of entries without resizing the table.
+			\param capacity the number of entries to make space for*/
+		void reserve(size_t capacity);
+		void clear();
+
+		bool isEmpty() const;
+
+		BasicHashDictionary<KEY_TYPE, VALUE_TYPE, HASH_TYPE> where(const std::function<bool(const KEY_TYPE& key, const VALUE_TYPE& value)>& func) const;
+		#ifdef __OBJC__
+		BasicHashDictionary<KEY_TYPE, VALUE_TYPE, HASH_TYPE> where(BOOL(^func)(const KEY_TYPE& key, const VALUE_TYPE& value)) const;
+		#endif
+
+		void forEach(const std::function<void(const KEY_TYPE& key, VALUE_TYPE& value)>& func);
+		void forEach(const std::function<void(const KEY_TYPE& key, const VALUE_TYPE& value)>& func) const;
+		#ifdef __OBJC__
+		void forEach(void(^func)(const KEY_TYPE& key, VALUE_TYPE& value));
+		void forEach(void(^func)(const KEY_TYPE& key, const VALUE_TYPE& value)) const;
+		#endif
+
+		/*! Copies the entries into a BasicDictionary.
+			\returns a BasicDictionary with the same entries, ordered by key*/
+		BasicDictionary<KEY_TYPE, VALUE_TYPE> toDictionary() const;
+
+		String toString() const;
+
+	private:
+		// a slot of the hash table. index is 1 more than the index of the entry, or 0 if the slot is empty.
+		// the hash is kept so that probing and resizing don't need to hash or compare keys
+		struct Slot
+		{
+			Uint32 index;
+			Uint32 hash;
+		};
+
+		static Uint32 hashKey(const KEY_TYPE& key);
+		size_t findSlot(const KEY_TYPE& key, Uint32 hash) const;
+		size_t findSlotForIndex(size_t index, Uint32 hash) const;
+		void insertSlot(size_t index, Uint32 hash);
+		void eraseSlot(size_t slotIndex);
+		void rehash(size_t slotCount);
+		void growSlots(size_t capacity);
+		template<typename VALUE_ARG>
+		iterator setValue(const KEY_TYPE& key, VALUE_ARG&& value);
+
+		std::vector<Entry> entries;
+		std::vector<Slot> slots;
+	};
+
+
+
+	typedef BasicHashDictionary<String, Any> HashDictionary;
+}
+
+#include "HashDictionary.impl"
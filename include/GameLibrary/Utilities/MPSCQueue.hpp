@@ -0,0 +1,90 @@
+
+#pragma once
+
+#include <atomic>
+
+namespace fgl
+{
+	/*! A node that can be linked into an MPSCQueue. Types stored in an MPSCQueue must derive from this.*/
+	struct MPSCQueueNode
+	{
+		std::atomic<MPSCQueueNode*> next;
+
+		MPSCQueueNode() : next(nullptr) {}
+	};
+
+
+
+	/*! An intrusive, unbounded, lock-free queue with any number of producers and a single consumer. Pushing never blocks or allocates, since the nodes are owned by the caller.
+		A node must stay alive until it has been popped, and can't be pushed again until then.
+		\tparam NODE_TYPE the type of node stored in the queue, which must derive from MPSCQueueNode*/
+	template<typename NODE_TYPE>
+	class MPSCQueue
+	{
+	public:
+		MPSCQueue()
+			: head(&stub),
+			tail(&stub) {
+			//
+		}
+
+		MPSCQueue(const MPSCQueue&) = delete;
+		MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+
+		/*! Adds a node to the end of the queue. This can be called from any thread.
+			\param node the node to add*/
+		void push(NODE_TYPE* node) {
+			pushNode(static_cast<MPSCQueueNode*>(node));
+		}
+
+		/*! Removes the node at the front of the queue. This can only be called from the consumer thread.
+			\returns the node at the front of the queue, or null if the queue is empty, or if the next node is still being pushed*/
+		NODE_TYPE* pop() {
+			MPSCQueueNode* first = tail;
+			MPSCQueueNode* next = first->next.load(std::memory_order_acquire);
+			if(first == &stub) {
+				if(next == nullptr) {
+					return nullptr;
+				}
+				// skip over the stub node
+				tail = next;
+				first = next;
+				next = next->next.load(std::memory_order_acquire);
+			}
+			if(next != nullptr) {
+				tail = next;
+				return static_cast<NODE_TYPE*>(first);
+			}
+			if(first != head.load(std::memory_order_acquire)) {
+				// a producer has swapped the head but hasn't linked its node yet
+				return nullptr;
+			}
+			// the first node is the last node, so push the stub behind it to be able to unlink it
+			pushNode(&stub);
+			next = first->next.load(std::memory_order_acquire);
+			if(next != nullptr) {
+				tail = next;
+				return static_cast<NODE_TYPE*>(first);
+			}
+			return nullptr;
+		}
+
+		/*! Tells if the queue appears to be empty. This can only be called from the consumer thread.
+			\returns true if there are no nodes waiting in the queue*/
+		bool empty() const {
+			return (tail == &stub && stub.next.load(std::memory_order_acquire) == nullptr);
+		}
+
+	private:
+		void pushNode(MPSCQueueNode* node) {
+			node->next.store(nullptr, std::memory_order_relaxed);
+			MPSCQueueNode* prev = head.exchange(node, std::memory_order_acq_rel);
+			prev->next.store(node, std::memory_order_release);
+		}
+
+		std::atomic<MPSCQueueNode*> head;
+		MPSCQueueNode* tail;
+		MPSCQueueNode stub;
+	};
+}
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <new>
 #include <type_traits>
 #include <GameLibrary/Types.hpp>
 #include <GameLibrary/Exception/Utilities/BadNumberCastException.hpp>
@@ -18,13 +19,13 @@ namespace fgl
 	public:
 		Number();
 		Number(const Number&);
-		Number(Number&&);
+		Number(Number&&) noexcept;
 		template<typename T, typename std::enable_if<std::is_arithmetic<T>::value, std::nullptr_t>::type = nullptr>
 		Number(const T&);
 		~Number();
 		
 		Number& operator=(const Number&);
-		Number& operator=(Number&&);
+		Number& operator=(Number&&) noexcept;
 		template<typename T, typename std::enable_if<std::is_arithmetic<T>::value, std::nullptr_t>::type = nullptr>
 		Number& operator=(const T&);
 		Number& operator+=(const Number&);
@@ -84,8 +85,8 @@ namespace fgl
 			virtual void increment() = 0;
 			virtual void decrement() = 0;
 			virtual void neg() = 0;
-			virtual Base* toSigned() const = 0;
-			virtual Base* clone() const = 0;
+			virtual void toSigned(void* memory) const = 0;
+			virtual void clone(void* memory) const = 0;
 			
 			virtual bool isNegative() const = 0;
 			virtual int compare(Base* base) const = 0;
@@ -122,8 +123,8 @@ namespace fgl
 			virtual void increment() override;
 			virtual void decrement() override;
 			virtual void neg() override;
-			virtual Base* toSigned() const override;
-			virtual Base* clone() const override;
+			virtual void toSigned(void* memory) const override;
+			virtual void clone(void* memory) const override;
 			
 			virtual bool isNegative() const override;
 			virtual int compare(Base* base) const override;
@@ -199,9 +200,9 @@ namespace fgl
 			void impl_neg();
 			
 			template<typename U=T, typename std::enable_if<(std::is_signed<U>::value), std::nullptr_t>::type = nullptr>
-			Base* impl_toSigned() const;
+			void impl_toSigned(void* memory) const;
 			template<typename U=T, typename std::enable_if<(std::is_unsigned<U>::value), std::nullptr_t>::type = nullptr>
-			Base* impl_toSigned() const;
+			void impl_toSigned(void* memory) const;
 			
 			template<typename U=T, typename std::enable_if<std::is_same<U,bool>::value, std::nullptr_t>::type = nullptr>
 			bool impl_isNegative() const;
@@ -216,9 +217,18 @@ namespace fgl
 			int impl_compare(Base* base) const;
 		};
 		
-		Base* ptr;
+		template<typename T>
+		void setValue(const T& value);
+		
+		// every Derived type is constructed in place in the storage, so numbers never allocate
+		typedef std::aligned_storage<sizeof(Derived<long double>), alignof(Derived<long double>)>::type Storage;
+		
+		Base* base() const
+		{
+			return reinterpret_cast<Base*>(const_cast<Storage*>(&storage));
+		}
 		
-		Number(Base*);
+		Storage storage;
 	};
 	
 	Number operator+(const Number& left, const Number& right);
@@ -5,6 +5,8 @@
 #include "Math.hpp"
 #include <GameLibrary/IO/Console.hpp>
 
+// These print each timing as soon as it finishes. FGL_PROFILE_ZONE from Profiler.hpp aggregates timings per frame instead, and can be turned on without rebuilding.
+
 namespace fgl
 {
 	#define START_PERFORMANCE_TIMING(timerName) \
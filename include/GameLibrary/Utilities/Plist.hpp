@@ -6,6 +6,7 @@
 #include "ArrayList.hpp"
 #include "Data.hpp"
 #include "Dictionary.hpp"
+#include "HashDictionary.hpp"
 #include "Number.hpp"
 #include "String.hpp"
 #include "Time/DateTime.hpp"
@@ -20,6 +21,7 @@ namespace fgl
 	public:
 		typedef String key;
 		typedef BasicDictionary<Plist::key, Any> dict;
+		typedef BasicHashDictionary<Plist::key, Any> hash_dict;
 		typedef ArrayList<Any> array;
 		typedef String string;
 		typedef Data data;
@@ -28,6 +30,16 @@ namespace fgl
 		typedef Number real;
 		typedef Number boolean;
 		
+		/*! The format to save a plist in.*/
+		enum class Format
+		{
+			/*! An XML plist, readable and diffable*/
+			XML,
+			/*! An Apple binary (bplist00) plist, which is smaller and faster to load*/
+			BINARY
+		};
+		
+		/*! XML and binary plists are both loaded, based on the header of the contents. XML plists are parsed directly into the destination, without building a document tree.*/
 		static bool loadFromPath(Dictionary* dst, const String& path, String* error=nullptr);
 		static bool loadFromFile(Dictionary* dst, FILE* file, String* error=nullptr);
 		static bool loadFromData(Dictionary* dst, const Data& data, String* error=nullptr);
@@ -35,7 +47,22 @@ namespace fgl
 		static bool loadFromPointer(Dictionary* dst, const void* pointer, size_t length, String* error=nullptr);
 		
 		static bool saveToFile(const Dictionary& src, const String& path, String* error=nullptr);
+		static bool saveToFile(const Dictionary& src, const String& path, Format format, String* error=nullptr);
+		static bool saveToData(const Dictionary& src, Data* dst, Format format=Format::XML, String* error=nullptr);
+		
+		/*! Loading into a HashDictionary gives faster lookups, and keeps the entries (and any nested dictionaries, which are also loaded as Plist::hash_dict) in the order they appear in the plist.*/
+		static bool loadFromPath(HashDictionary* dst, const String& path, String* error=nullptr);
+		static bool loadFromFile(HashDictionary* dst, FILE* file, String* error=nullptr);
+		static bool loadFromData(HashDictionary* dst, const Data& data, String* error=nullptr);
+		static bool loadFromString(HashDictionary* dst, const String& string, String* error=nullptr);
+		static bool loadFromPointer(HashDictionary* dst, const void* pointer, size_t length, String* error=nullptr);
+		
+		/*! Saving a HashDictionary writes the entries in insertion order, so loading and saving a plist keeps its key order.*/
+		static bool saveToFile(const HashDictionary& src, const String& path, String* error=nullptr);
+		static bool saveToFile(const HashDictionary& src, const String& path, Format format, String* error=nullptr);
+		static bool saveToData(const HashDictionary& src, Data* dst, Format format=Format::XML, String* error=nullptr);
 	};
 	
 	Number extractNumber(const Dictionary& dict, const Dictionary::Key& key, const Number& defaultValue);
+	Number extractNumber(const HashDictionary& dict, const HashDictionary::Key& key, const Number& defaultValue);
 }
@@ -0,0 +1,166 @@
+
+#pragma once
+
+#include <GameLibrary/Types.hpp>
+#include <GameLibrary/Utilities/ArrayList.hpp>
+#include <GameLibrary/Utilities/String.hpp>
+#include <atomic>
+
+#define FGL_PROFILER_CONCAT_INNER(a, b) a##b
+#define FGL_PROFILER_CONCAT(a, b) FGL_PROFILER_CONCAT_INNER(a, b)
+
+#ifdef GAMELIBRARY_DISABLE_PROFILER
+	#define FGL_PROFILE_ZONE(zoneName)
+#else
+	/*! Times the rest of the enclosing scope as a profiler zone. While the profiler is disabled, a zone only costs a single flag check, and defining GAMELIBRARY_DISABLE_PROFILER removes zones entirely.
+		\param zoneName a string literal naming the zone. Zones with the same name are combined in the statistics.*/
+	#define FGL_PROFILE_ZONE(zoneName) \
+		static fgl::Profiler::Zone FGL_PROFILER_CONCAT(fgl_profilerZone_, __LINE__)(zoneName); \
+		fgl::Profiler::Scope FGL_PROFILER_CONCAT(fgl_profilerScope_, __LINE__)(FGL_PROFILER_CONCAT(fgl_profilerZone_, __LINE__));
+#endif
+
+namespace fgl
+{
+	struct ProfilerThreadBuffer;
+
+	/*! Records how long zones of code take, on any thread, and aggregates them per frame. Zones are marked with FGL_PROFILE_ZONE and nest, so each zone also knows its parent zone and its time excluding child zones.
+		Each thread records into its own lock-free ring buffer, which is drained by endFrame. Recorded zones can also be captured into a trace, which can be opened in chrome://tracing or Perfetto.*/
+	class Profiler
+	{
+	public:
+		/*! the number of frames that zone statistics are calculated over*/
+		static constexpr size_t HISTORY_SIZE = 300;
+		/*! the number of zones each thread can record between calls to endFrame before zones are dropped*/
+		static constexpr size_t THREAD_BUFFER_SIZE = 8192;
+
+		/*! A named section of code. Declared as a static by FGL_PROFILE_ZONE.*/
+		class Zone
+		{
+		public:
+			/*! Constructs a zone.
+				\param name the name of the zone, which must stay valid for the lifetime of the program*/
+			explicit Zone(const char* name);
+			/*! deleted copy constructor*/
+			Zone(const Zone&) = delete;
+			/*! deleted assignment operator*/
+			Zone& operator=(const Zone&) = delete;
+
+			/*! Gets the name of the zone.
+				\returns the name of the zone*/
+			const char* getName() const;
+
+		private:
+			friend class Profiler;
+
+			const char* name;
+			Uint32 index;
+		};
+
+		/*! Times a zone from construction until destruction. Declared by FGL_PROFILE_ZONE.*/
+		class Scope
+		{
+		public:
+			/*! Starts timing a zone, if the profiler is enabled.
+				\param zone the zone to time*/
+			explicit Scope(Zone& zone)
+				: zone(nullptr) {
+				if(Profiler::enabled.load(std::memory_order_relaxed)) {
+					begin(zone);
+				}
+			}
+			/*! deleted copy constructor*/
+			Scope(const Scope&) = delete;
+			/*! Finishes timing the zone and records it.*/
+			~Scope() {
+				if(zone != nullptr) {
+					end();
+				}
+			}
+
+			/*! deleted assignment operator*/
+			Scope& operator=(const Scope&) = delete;
+
+		private:
+			void begin(Zone& zone);
+			void end();
+
+			Zone* zone;
+			Scope* parent;
+			ProfilerThreadBuffer* buffer;
+			Int64 startTime;
+			Int64 childTime;
+		};
+
+		/*! Statistics of a zone over the recent frames that the zone ran in*/
+		struct ZoneStats
+		{
+			/*! the name of the zone*/
+			String name;
+			/*! the name of the zone that the zone last ran inside of, or an empty string if it wasn't inside another zone*/
+			String parentName;
+			/*! the number of frames that the statistics are calculated from*/
+			size_t frames;
+			/*! the average number of times the zone ran in each frame*/
+			double averageCalls;
+			/*! the shortest total time of the zone in a frame, in milliseconds*/
+			double minMilliseconds;
+			/*! the average total time of the zone in a frame, in milliseconds*/
+			double averageMilliseconds;
+			/*! the 99th percentile total time of the zone in a frame, in milliseconds*/
+			double p99Milliseconds;
+			/*! the longest total time of the zone in a frame, in milliseconds*/
+			double maxMilliseconds;
+			/*! the average total time of the zone in a frame excluding the zones inside it, in milliseconds*/
+			double averageSelfMilliseconds;
+		};
+
+		Profiler() = delete;
+
+		/*! Enables or disables recording zones. The profiler starts disabled.
+			\param enabled true to record zones, or false to ignore them*/
+		static void setEnabled(bool enabled);
+		/*! Tells whether zones are being recorded.
+			\returns true if the profiler is enabled, or false if otherwise*/
+		static bool isEnabled();
+
+		/*! Sets the name of the calling thread, used in traces.
+			\param name the name of the thread*/
+		static void setThreadName(const String& name);
+
+		/*! Drains the zones recorded by every thread since the last call, and adds them to the statistics of the current frame. Application calls this once at the end of every frame.
+			This should only be called from one thread at a time, and does nothing while the profiler is disabled.*/
+		static void endFrame();
+		/*! Gets the number of frames ended while the profiler was enabled.
+			\returns the number of frames*/
+		static size_t getFrameCount();
+
+		/*! Gets the statistics of every zone that has run within the last HISTORY_SIZE frames.
+			\returns a list of zone statistics, ordered by when the zones were first declared*/
+		static ArrayList<ZoneStats> getZoneStats();
+		/*! Formats the statistics of every zone as a table, for writing to the console.
+			\returns a string with a line for each zone*/
+		static String getStatsReport();
+		/*! Clears the statistics of every zone.*/
+		static void resetStats();
+		/*! Gets the number of zones that were dropped because a thread's ring buffer was full.
+			\returns the total number of dropped zones*/
+		static size_t getDroppedZoneCount();
+
+		/*! Starts capturing every recorded zone into a trace, discarding any previous trace.
+			\param maxZones the most zones to keep in the trace. Zones past this are not captured.*/
+		static void startTrace(size_t maxZones=1000000);
+		/*! Stops capturing zones into the trace, keeping the zones captured so far.*/
+		static void stopTrace();
+		/*! Tells whether zones are being captured into a trace.
+			\returns true if a trace is being captured, or false if otherwise*/
+		static bool isTracing();
+		/*! Writes the captured trace as Chrome trace event JSON.
+			\param path the path of the file to write
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the file was written, or false if an error occurred*/
+		static bool writeTrace(const String& path, String* error=nullptr);
+
+	private:
+		static std::atomic<bool> enabled;
+	};
+}
@@ -4,12 +4,23 @@
 #include <GameLibrary/Exception/Exception.hpp>
 #include <GameLibrary/Exception/ExceptionPtr.hpp>
 #include "ArrayList.hpp"
+#include "TaskScheduler.hpp"
+#include "Thread.hpp"
 #include "Tools.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
-#include <future>
-#include <list>
 #include <memory>
 #include <mutex>
+#include <type_traits>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+	#include <coroutine>
+	#define GAMELIBRARY_PROMISE_COROUTINES
+#endif
 
 namespace fgl
 {
@@ -18,29 +29,106 @@ namespace fgl
 	{
 		using Func = std::function<RETURN(ARG)>;
 	};
-	
+
 	template<typename RETURN>
 	struct PromiseHelperTypes<void, RETURN>
 	{
 		using Func = std::function<RETURN()>;
 	};
-	
-	
-	
+
+
+
+	/*! Decides where the continuations of a promise run. The default executor runs a continuation right away, on the thread that settles the promise, or on the thread that adds the continuation if the promise has already been settled.*/
+	class PromiseExecutor
+	{
+	public:
+		typedef std::function<void(std::function<void()>)> Dispatcher;
+
+		/*! Constructs an executor that runs continuations right away.*/
+		PromiseExecutor() {
+			//
+		}
+
+		/*! Constructs an executor that hands continuations to a dispatch function.
+			\param dispatcher a function that runs the continuation it's given, now or later, on any thread*/
+		explicit PromiseExecutor(Dispatcher dispatcher)
+			: dispatcher(std::move(dispatcher)) {
+			//
+		}
+
+
+		/*! Creates an executor that runs continuations on the main thread. Continuations that become ready on the main thread run right away, and the rest run during the next Thread::update.
+			\param priority the priority of the main thread tasks
+			\returns an executor for the main thread*/
+		static PromiseExecutor mainThread(TaskScheduler::Priority priority=TaskScheduler::Priority::NORMAL) {
+			return PromiseExecutor([=](std::function<void()> func) {
+				if(Thread::isMainThread()) {
+					func();
+				}
+				else {
+					TaskScheduler::scheduleOnMainThread(std::move(func), priority);
+				}
+			});
+		}
+
+		/*! Creates an executor that runs continuations as tasks on a TaskScheduler.
+			\param scheduler the scheduler to run continuations on
+			\param priority the priority of the scheduled tasks
+			\returns an executor for the scheduler*/
+		static PromiseExecutor scheduler(TaskScheduler& scheduler, TaskScheduler::Priority priority=TaskScheduler::Priority::NORMAL) {
+			TaskScheduler* schedulerPtr = &scheduler;
+			return PromiseExecutor([=](std::function<void()> func) {
+				schedulerPtr->schedule(std::move(func), priority);
+			});
+		}
+
+		/*! Creates an executor that runs continuations as tasks on the default TaskScheduler.
+			\param priority the priority of the scheduled tasks
+			\returns an executor for the default scheduler*/
+		static PromiseExecutor scheduler(TaskScheduler::Priority priority=TaskScheduler::Priority::NORMAL) {
+			return scheduler(TaskScheduler::getDefault(), priority);
+		}
+
+
+		/*! Tells if continuations are run right away, rather than being dispatched.
+			\returns true if this executor has no dispatch function*/
+		bool isImmediate() const {
+			return !dispatcher;
+		}
+
+		/*! Runs a continuation, or hands it to the dispatch function.
+			\param func the continuation to run*/
+		void execute(std::function<void()> func) const {
+			if(dispatcher) {
+				dispatcher(std::move(func));
+			}
+			else {
+				func();
+			}
+		}
+
+	private:
+		Dispatcher dispatcher;
+	};
+
+
+
 	template<typename RESULT>
 	class Promise
 	{
+		template<typename> friend class Promise;
+		template<typename _RESULT> friend _RESULT await(Promise<_RESULT> promise);
 	public:
 		typedef RESULT Result;
-		
+
 		using Resolver = typename PromiseHelperTypes<RESULT,void>::Func;
 		using Rejecter = std::function<void(ExceptionPtr)>;
 		template<typename RETURN>
 		using Then = typename PromiseHelperTypes<RESULT,RETURN>::Func;
 		template<typename ERROR, typename RETURN>
 		using Catch = std::function<RETURN(ERROR)>;
-		
-		
+
+
 		explicit Promise(const std::function<void(Resolver, Rejecter)>& executor)
 			: continuer(std::make_shared<Continuer>()) {
 			ASSERT(executor != nullptr, "promise executor cannot be null");
@@ -49,147 +137,131 @@ namespace fgl
 				executor([=]() {
 					_continuer->resolve();
 				}, [=](ExceptionPtr error) {
-					_continuer->reject(error);
+					_continuer->reject(error.ptr());
 				});
 			}
 			else {
 				executor([=](RESULT result) {
-					_continuer->resolve(result);
+					_continuer->resolve(std::move(result));
 				}, [=](ExceptionPtr error) {
-					_continuer->reject(error);
+					_continuer->reject(error.ptr());
 				});
 			}
 		}
-		
-		
-		Promise<void> then(Then<void> onresolve, Catch<std::exception_ptr,void> onreject) {
-			return continuer->handle(onresolve, onreject);
+
+
+		Promise<void> then(Then<void> onresolve, Catch<std::exception_ptr,void> onreject, PromiseExecutor executor=PromiseExecutor()) {
+			return chain<void>(std::move(executor), [=](Continuer& settled, auto& next) {
+				if(onresolve) {
+					settled.invoke(onresolve);
+				}
+				next.resolve();
+			}, [=](Continuer& settled, auto& next) {
+				if(onreject) {
+					onreject(settled.getError());
+					next.resolve();
+				}
+				else {
+					next.reject(settled.getError());
+				}
+			});
 		}
-		
-		
+
+
 		template<typename NEXT_RESULT>
-		Promise<NEXT_RESULT> then(Then<Promise<NEXT_RESULT>> onresolve, Catch<std::exception_ptr,Promise<NEXT_RESULT>> onreject) {
-			return continuer->template handle<NEXT_RESULT>(onresolve, onreject);
+		Promise<NEXT_RESULT> then(Then<Promise<NEXT_RESULT>> onresolve, Catch<std::exception_ptr,Promise<NEXT_RESULT>> onreject, PromiseExecutor executor=PromiseExecutor()) {
+			ASSERT(onresolve != nullptr, "onresolve cannot be null");
+			return chain<NEXT_RESULT>(std::move(executor), [=](Continuer& settled, auto& next) {
+				Promise<NEXT_RESULT>::settleFrom(next, settled.invoke(onresolve));
+			}, [=](Continuer& settled, auto& next) {
+				if(onreject) {
+					Promise<NEXT_RESULT>::settleFrom(next, onreject(settled.getError()));
+				}
+				else {
+					next.reject(settled.getError());
+				}
+			});
 		}
-		
-		
-		Promise<void> then(Then<void> onresolve) {
-			return continuer->handle(onresolve, nullptr);
+
+
+		Promise<void> then(Then<void> onresolve, PromiseExecutor executor=PromiseExecutor()) {
+			return then(std::move(onresolve), nullptr, std::move(executor));
 		}
-		
-		
+
+
 		template<typename NEXT_RESULT>
-		Promise<NEXT_RESULT> then(Then<Promise<NEXT_RESULT>> onresolve) {
-			return continuer->template handle<NEXT_RESULT>(onresolve, nullptr);
+		Promise<NEXT_RESULT> then(Then<Promise<NEXT_RESULT>> onresolve, PromiseExecutor executor=PromiseExecutor()) {
+			return then<NEXT_RESULT>(std::move(onresolve), nullptr, std::move(executor));
 		}
-		
-		
+
+
 		template<typename ERROR>
-		Promise<RESULT> fail(Catch<ERROR,void> onreject) {
-			Then<Promise<RESULT>> resultForwarder = nullptr;
-			if constexpr(std::is_same<RESULT,void>::value) {
-				resultForwarder = [=]() -> Promise<RESULT> {
-					return Promise<RESULT>::resolve();
-				};
-			}
-			else {
-				resultForwarder = [=](RESULT result) -> Promise<RESULT> {
-					return Promise<RESULT>::resolve(result);
-				};
-			}
-			return continuer->template handle<RESULT>(resultForwarder, [=](std::exception_ptr exceptionPtr) -> Promise<RESULT> {
+		Promise<RESULT> fail(Catch<ERROR,void> onreject, PromiseExecutor executor=PromiseExecutor()) {
+			return chain<RESULT>(std::move(executor), [](Continuer& settled, auto& next) {
+				settled.copyTo(next);
+			}, [=](Continuer& settled, auto& next) {
+				// a handled error leaves the returned promise unsettled, since there's no result to give it
 				if constexpr(std::is_same<std::exception_ptr,ERROR>::value) {
-					onreject(exceptionPtr);
-					return Promise<RESULT>::nothing();
+					onreject(settled.getError());
 				}
 				else {
 					try {
-						std::rethrow_exception(exceptionPtr);
+						std::rethrow_exception(settled.getError());
 					}
 					catch(const ERROR& error) {
 						onreject(error);
-						return Promise<RESULT>::nothing();
+						return;
 					}
 					catch(...) {
-						return Promise<RESULT>::reject(exceptionPtr);
+						next.reject(settled.getError());
 					}
 				}
 			});
 		}
-		
-		
+
+
 		template<typename ERROR>
-		Promise<RESULT> fail(Catch<ERROR,Promise<RESULT>> onreject) {
-			Then<Promise<RESULT>> resultForwarder = nullptr;
-			if constexpr(std::is_same<RESULT,void>::value) {
-				resultForwarder = [=]() -> Promise<RESULT> {
-					return Promise<RESULT>::resolve();
-				};
-			}
-			else {
-				resultForwarder = [=](RESULT result) -> Promise<RESULT> {
-					return Promise<RESULT>::resolve(result);
-				};
-			}
-			return continuer->template handle<RESULT>(resultForwarder, [=](std::exception_ptr exceptionPtr) {
+		Promise<RESULT> fail(Catch<ERROR,Promise<RESULT>> onreject, PromiseExecutor executor=PromiseExecutor()) {
+			return chain<RESULT>(std::move(executor), [](Continuer& settled, auto& next) {
+				settled.copyTo(next);
+			}, [=](Continuer& settled, auto& next) {
 				if constexpr(std::is_same<std::exception_ptr,ERROR>::value) {
-					return onreject(exceptionPtr);
+					settleFrom(next, onreject(settled.getError()));
 				}
 				else {
 					try {
-						std::rethrow_exception(exceptionPtr);
+						std::rethrow_exception(settled.getError());
 					}
 					catch(const ERROR& error) {
-						return onreject(error);
+						settleFrom(next, onreject(error));
+						return;
 					}
 					catch(...) {
-						return Promise<RESULT>::reject(exceptionPtr);
+						next.reject(settled.getError());
 					}
 				}
 			});
 		}
-		
-		
-		Promise<void> finally(std::function<void()> onfinish) {
-			Then<Promise<void>> thenFinally = nullptr;
-			if constexpr(std::is_same<RESULT,void>::value) {
-				thenFinally = [=]() -> Promise<void> {
-					onfinish();
-					return Promise<void>::resolve();
-				};
-			}
-			else {
-				thenFinally = [=](RESULT result) -> Promise<void> {
-					onfinish();
-					return Promise<void>::resolve();
-				};
-			}
-			return continuer->template handle<void>(thenFinally, [=](std::exception_ptr exceptionPtr) {
+
+
+		Promise<void> finally(std::function<void()> onfinish, PromiseExecutor executor=PromiseExecutor()) {
+			auto finish = [=](Continuer&, auto& next) {
 				onfinish();
-				return Promise<void>::resolve();
-			});
+				next.resolve();
+			};
+			return chain<void>(std::move(executor), finish, finish);
 		}
-		
-		
+
+
 		template<typename NEXT_RESULT>
-		Promise<NEXT_RESULT> finally(std::function<Promise<NEXT_RESULT>()> onfinish) {
-			Then<Promise<NEXT_RESULT>> thenFinally = nullptr;
-			if constexpr(std::is_same<RESULT,void>::value) {
-				thenFinally = [=]() -> Promise<NEXT_RESULT> {
-					return onfinish();
-				};
-			}
-			else {
-				thenFinally = [=](RESULT result) -> Promise<NEXT_RESULT> {
-					return onfinish();
-				};
-			}
-			return continuer->template handle<void>(thenFinally, [=](std::exception_ptr exceptionPtr) {
-				return onfinish();
-			});
+		Promise<NEXT_RESULT> finally(std::function<Promise<NEXT_RESULT>()> onfinish, PromiseExecutor executor=PromiseExecutor()) {
+			auto finish = [=](Continuer&, auto& next) {
+				Promise<NEXT_RESULT>::settleFrom(next, onfinish());
+			};
+			return chain<NEXT_RESULT>(std::move(executor), finish, finish);
 		}
-		
-		
+
+
 		template<typename T,
 			typename _RESULT=RESULT,
 			typename std::enable_if<(
@@ -197,628 +269,588 @@ namespace fgl
 				&& !std::is_same<T,void>::value
 				&& std::is_convertible<_RESULT,T>::value), std::nullptr_t>::type = nullptr>
 		Promise<T> as() {
-			return Promise<T>([&](auto resolve, auto reject) {
-				then([=](auto result) {
-					resolve(static_cast<T>(result));
-				}, [=](std::exception_ptr error) {
-					reject(error);
-				});
+			return chain<T>(PromiseExecutor(), [](Continuer& settled, auto& next) {
+				next.resolve(static_cast<T>(settled.getResult()));
+			}, [](Continuer& settled, auto& next) {
+				next.reject(settled.getError());
 			});
 		}
-		
-		
+
+
+		/*! Creates a promise that settles the same way as this promise, but on the given executor. This is mostly useful with co_await, to choose the thread that a coroutine continues on.
+			\param executor the executor to settle the returned promise on
+			\returns a new promise*/
+		Promise<RESULT> via(PromiseExecutor executor) {
+			auto copy = [](Continuer& settled, auto& next) {
+				settled.copyTo(next);
+			};
+			return chain<RESULT>(std::move(executor), copy, copy);
+		}
+
+
 		template<typename _RESULT=RESULT,
 			typename std::enable_if<!std::is_same<_RESULT,void>::value, std::nullptr_t>::type = nullptr>
 		static Promise<_RESULT> resolve(_RESULT result) {
-			return Promise<_RESULT>([&](auto resolve, auto reject) {
-				resolve(result);
-			});
+			auto continuer = std::make_shared<Continuer>();
+			continuer->resolve(std::move(result));
+			return Promise<_RESULT>(std::move(continuer));
 		}
-		
-		
+
+
 		template<typename _RESULT=RESULT,
 			typename std::enable_if<std::is_same<_RESULT,void>::value, std::nullptr_t>::type = nullptr>
 		static Promise<_RESULT> resolve() {
-			return Promise<_RESULT>([&](auto resolve, auto reject) {
-				resolve();
-			});
+			auto continuer = std::make_shared<Continuer>();
+			continuer->resolve();
+			return Promise<_RESULT>(std::move(continuer));
 		}
-		
-		
+
+
 		static Promise<RESULT> reject(ExceptionPtr error) {
-			return Promise<RESULT>([&](auto resolve, auto reject) {
-				reject(error);
-			});
+			auto continuer = std::make_shared<Continuer>();
+			continuer->reject(error.ptr());
+			return Promise<RESULT>(std::move(continuer));
 		}
-		
-		
+
+
 		static Promise<RESULT> nothing() {
-			return Promise<RESULT>([](auto resolve, auto reject) {
-				// do nothing
-			});
+			return Promise<RESULT>(std::make_shared<Continuer>());
 		}
-		
-		
+
+
 		template<typename _RESULT=RESULT,
 			typename std::enable_if<!std::is_same<_RESULT,void>::value, std::nullptr_t>::type = nullptr>
 		static Promise<ArrayList<_RESULT>> all(ArrayList<Promise<_RESULT>> promises) {
-			return Promise<ArrayList<_RESULT>>([&](auto resolve, auto reject) {
-				size_t promiseCount = promises.size();
-				if(promiseCount == 0) {
-					resolve({});
-					return;
-				}
-				
-				struct SharedInfo {
-					std::mutex mutex;
-					bool rejected = false;
-					ArrayList<RESULT> results;
-					ArrayList<size_t> addIndexes;
-				};
-				
-				auto sharedInfoPtr = std::make_shared<SharedInfo>();
-				sharedInfoPtr->results.reserve(promiseCount);
-				sharedInfoPtr->addIndexes.resize(promiseCount, 0);
-				
-				auto resolveIndex = [=](size_t index, _RESULT result) {
-					auto& sharedInfo = *sharedInfoPtr;
-					std::unique_lock<std::mutex> lock(sharedInfo.mutex);
-					if(sharedInfo.rejected) {
+			typedef typename Promise<ArrayList<_RESULT>>::Continuer NextContinuer;
+			auto next = std::make_shared<NextContinuer>();
+			size_t promiseCount = promises.size();
+			if(promiseCount == 0) {
+				next->resolve();
+				return Promise<ArrayList<_RESULT>>(std::move(next));
+			}
+
+			struct SharedInfo {
+				// filled in as the promises resolve, so that the results only need to be copied once
+				std::vector<std::shared_ptr<Continuer>> resolved;
+				std::atomic<size_t> remaining;
+			};
+
+			auto sharedInfoPtr = std::make_shared<SharedInfo>();
+			sharedInfoPtr->resolved.resize(promiseCount);
+			sharedInfoPtr->remaining.store(promiseCount, std::memory_order_relaxed);
+
+			for(size_t i=0; i<promiseCount; i++) {
+				promises[i].continuer->addContinuation([=](Continuer& settled) {
+					if(settled.isRejected()) {
+						next->tryReject(settled.getError());
 						return;
 					}
-					size_t addIndex = sharedInfo.addIndexes[index];
-					for(size_t i=(index+1); i<promiseCount; i++) {
-						sharedInfo.addIndexes[i] += 1;
-					}
-					sharedInfo.results.add(addIndex, result);
-					bool finished = (sharedInfo.results.size() == promiseCount);
-					lock.unlock();
-					if(finished) {
-						resolve(std::move(sharedInfo.results));
-					}
-				};
-				
-				auto rejectAll = [=](std::exception_ptr error) {
 					auto& sharedInfo = *sharedInfoPtr;
-					std::unique_lock<std::mutex> lock(sharedInfo.mutex);
-					if(sharedInfo.rejected) {
-						return;
+					sharedInfo.resolved[i] = settled.shared_from_this();
+					if(sharedInfo.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+						std::vector<_RESULT> results;
+						results.reserve(promiseCount);
+						for(auto& resolved : sharedInfo.resolved) {
+							results.push_back(resolved->getResult());
+						}
+						sharedInfo.resolved.clear();
+						next->tryResolve(ArrayList<_RESULT>(std::move(results)));
 					}
-					sharedInfo.rejected = true;
-					lock.unlock();
-					reject(error);
-				};
-				
-				for(size_t i=0; i<promiseCount; i++) {
-					auto& promise = promises[i];
-					promise.then([=](_RESULT result) {
-						resolveIndex(i, result);
-					}, [=](std::exception_ptr error) {
-						rejectAll(error);
-					});
-				}
-			});
+				});
+			}
+			return Promise<ArrayList<_RESULT>>(std::move(next));
 		}
-		
-		
+
+
 		template<typename _RESULT=RESULT,
 			typename std::enable_if<std::is_same<_RESULT,void>::value, std::nullptr_t>::type = nullptr>
 		static Promise<void> all(ArrayList<Promise<_RESULT>> promises) {
-			return Promise<void>([&](auto resolve, auto reject) {
-				size_t promiseCount = promises.size();
-				if(promiseCount == 0) {
-					resolve();
-					return;
-				}
-				
-				struct SharedInfo {
-					std::mutex mutex;
-					bool rejected = false;
-					size_t counter = 0;
-				};
-				
-				auto sharedInfoPtr = std::make_shared<SharedInfo>();
-				
-				auto resolveIndex = [=](size_t index) {
-					auto& sharedInfo = *sharedInfoPtr;
-					std::unique_lock<std::mutex> lock(sharedInfo.mutex);
-					if(sharedInfo.rejected) {
-						return;
+			auto next = std::make_shared<Continuer>();
+			size_t promiseCount = promises.size();
+			if(promiseCount == 0) {
+				next->resolve();
+				return Promise<void>(std::move(next));
+			}
+
+			auto remaining = std::make_shared<std::atomic<size_t>>(promiseCount);
+			for(size_t i=0; i<promiseCount; i++) {
+				promises[i].continuer->addContinuation([=](Continuer& settled) {
+					if(settled.isRejected()) {
+						next->tryReject(settled.getError());
 					}
-					sharedInfo.counter += 1;
-					bool finished = (sharedInfo.counter == promiseCount);
-					lock.unlock();
-					if(finished) {
-						resolve();
+					else if(remaining->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+						next->tryResolve();
 					}
-				};
-				
-				auto rejectAll = [=](std::exception_ptr error) {
-					auto& sharedInfo = *sharedInfoPtr;
-					std::unique_lock<std::mutex> lock(sharedInfo.mutex);
-					if(sharedInfo.rejected) {
-						return;
-					}
-					sharedInfo.rejected = true;
-					lock.unlock();
-					reject(error);
-				};
-				
-				for(size_t i=0; i<promiseCount; i++) {
-					auto& promise = promises[i];
-					promise.then([=]() {
-						resolveIndex(i);
-					}, [=](std::exception_ptr error) {
-						rejectAll(error);
-					});
-				}
-			});
+				});
+			}
+			return Promise<void>(std::move(next));
 		}
-		
-		
-		template<typename _RESULT=RESULT,
-			typename std::enable_if<!std::is_same<_RESULT,void>::value, std::nullptr_t>::type = nullptr>
-		static Promise<_RESULT> race(ArrayList<Promise<_RESULT>> promises) {
-			return Promise<_RESULT>([&](auto resolve, auto reject) {
-				size_t promiseCount = promises.size();
-				
-				struct SharedInfo {
-					std::mutex mutex;
-					bool finished;
-				};
-				
-				auto sharedInfoPtr = std::make_shared<SharedInfo>();
-				
-				auto resolveIndex = [=](size_t index, auto result) {
-					auto& sharedInfo = *sharedInfoPtr;
-					std::unique_lock<std::mutex> lock(sharedInfo.mutex);
-					if(sharedInfo.finished) {
-						return;
-					}
-					sharedInfo.finished = true;
-					lock.unlock();
-					resolve(result);
-				};
-				
-				auto rejectAll = [=](std::exception_ptr error) {
-					auto& sharedInfo = *sharedInfoPtr;
-					std::unique_lock<std::mutex> lock(sharedInfo.mutex);
-					if(sharedInfo.finished) {
-						return;
+
+
+		static Promise<RESULT> race(ArrayList<Promise<RESULT>> promises) {
+			auto next = std::make_shared<Continuer>();
+			size_t promiseCount = promises.size();
+			for(size_t i=0; i<promiseCount; i++) {
+				promises[i].continuer->addContinuation([=](Continuer& settled) {
+					if(settled.isRejected()) {
+						next->tryReject(settled.getError());
 					}
-					sharedInfo.finished = true;
-					lock.unlock();
-					reject(error);
-				};
-				
-				for(size_t i=0; i<promiseCount; i++) {
-					auto& promise = promises[i];
-					promise.then([=](auto result) {
-						resolveIndex(i, result);
-					}, [=](std::exception_ptr error) {
-						rejectAll(error);
-					});
-				}
-			});
-		}
-		
-		
-		template<typename _RESULT=RESULT,
-			typename std::enable_if<std::is_same<_RESULT,void>::value, std::nullptr_t>::type = nullptr>
-		static Promise<void> race(ArrayList<Promise<_RESULT>> promises) {
-			return Promise<void>([&](auto resolve, auto reject) {
-				size_t promiseCount = promises.size();
-				
-				struct SharedInfo {
-					std::mutex mutex;
-					bool finished;
-				};
-				
-				auto sharedInfoPtr = std::make_shared<SharedInfo>();
-				
-				auto resolveIndex = [=](size_t index) {
-					auto& sharedInfo = *sharedInfoPtr;
-					std::unique_lock<std::mutex> lock(sharedInfo.mutex);
-					if(sharedInfo.finished) {
-						return;
+					else if constexpr(std::is_same<RESULT,void>::value) {
+						next->tryResolve();
 					}
-					sharedInfo.finished = true;
-					lock.unlock();
-					resolve();
-				};
-				
-				auto rejectAll = [=](std::exception_ptr error) {
-					auto& sharedInfo = *sharedInfoPtr;
-					std::unique_lock<std::mutex> lock(sharedInfo.mutex);
-					if(sharedInfo.finished) {
-						return;
+					else {
+						next->tryResolve(settled.getResult());
 					}
-					sharedInfo.finished = true;
-					lock.unlock();
-					reject(error);
-				};
-				
-				for(size_t i=0; i<promiseCount; i++) {
-					auto& promise = promises[i];
-					promise.then([=]() {
-						resolveIndex(i);
-					}, [=](std::exception_ptr error) {
-						rejectAll(error);
-					});
-				}
+				});
+			}
+			return Promise<RESULT>(std::move(next));
+		}
+
+
+		#ifdef GAMELIBRARY_PROMISE_COROUTINES
+		bool await_ready() const noexcept {
+			return continuer->isSettled();
+		}
+
+		void await_suspend(std::coroutine_handle<> handle) {
+			continuer->addContinuation([=](Continuer&) {
+				handle.resume();
 			});
 		}
-		
-		
+
+		RESULT await_resume() {
+			return takeResult();
+		}
+		#endif
+
+
 	private:
 		enum class State
 		{
 			EXECUTING = 0,
-			RESOLVED = 1,
-			REJECTED = 2
+			SETTLING = 1,
+			RESOLVED = 2,
+			REJECTED = 3
 		};
-		
-		
-		class Continuer
+
+		// the stored result of a promise. void promises store a placeholder, so that every promise has the same layout
+		typedef typename std::conditional<std::is_same<RESULT,void>::value, bool, RESULT>::type StoredResult;
+
+
+		// the shared state of a promise, allocated as a single block. Continuations are kept in a lock-free stack,
+		// and the first one is stored inline, since most promises only ever get one
+		class Continuer : public std::enable_shared_from_this<Continuer>
 		{
 		public:
+			typedef std::function<void(Continuer&)> Callback;
+
 			Continuer()
-				: future(promise.get_future().share()),
-				state(State::EXECUTING) {
+				: state(State::EXECUTING),
+				continuations(nullptr),
+				inlineContinuationUsed(false),
+				rejected(false),
+				hasResult(false) {
 				//
 			}
-			
-			
-			template<typename _RESULT=RESULT,
-				typename std::enable_if<!std::is_same<_RESULT,void>::value, std::nullptr_t>::type = nullptr>
-			void resolve(_RESULT result) {
-				std::unique_lock<std::mutex> lock(sync);
-				ASSERT(state == State::EXECUTING, "Cannot resolve or reject a promise multiple times");
-				promise.set_value(result);
-				state = State::RESOLVED;
-				auto callbacks = std::list<Resolver>();
-				callbacks.swap(resolvers);
-				resolvers.clear();
-				rejecters.clear();
-				lock.unlock();
-				for(auto& callback : callbacks) {
-					callback(result);
-				}
-			}
-			
-			
-			template<typename _RESULT=RESULT,
-				typename std::enable_if<std::is_same<_RESULT,void>::value, std::nullptr_t>::type = nullptr>
-			void resolve() {
-				std::unique_lock<std::mutex> lock(sync);
-				ASSERT(state == State::EXECUTING, "Cannot resolve or reject a promise multiple times");
-				promise.set_value();
-				state = State::RESOLVED;
-				auto callbacks = std::list<Resolver>();
-				callbacks.swap(resolvers);
-				resolvers.clear();
-				rejecters.clear();
-				lock.unlock();
-				for(auto& callback : callbacks) {
-					callback();
-				}
-			}
-			
-			
-			void reject(ExceptionPtr error) {
-				std::unique_lock<std::mutex> lock(sync);
-				ASSERT(state == State::EXECUTING, "Cannot resolve or reject a promise multiple times");
-				promise.set_exception(error.ptr());
-				state = State::REJECTED;
-				auto callbacks = std::list<Rejecter>();
-				callbacks.swap(rejecters);
-				resolvers.clear();
-				rejecters.clear();
-				lock.unlock();
-				for(auto& callback : callbacks) {
-					callback(error);
-				}
-			}
-			
-			
-			Promise<void> handle(Then<void> onresolve, Catch<std::exception_ptr,void> onreject) {
-				return Promise<void>([&](auto resolve, auto reject) {
-					std::unique_lock<std::mutex> lock(sync);
-					switch(state) {
-						case State::EXECUTING: {
-							if constexpr(std::is_same<RESULT,void>::value) {
-								resolvers.push_back([=]() {
-									// TODO wrap this in a DispatchQueue call
-									if(onresolve) {
-										onresolve();
-									}
-									resolve();
-								});
-							}
-							else {
-								resolvers.push_back([=](auto result) {
-									// TODO wrap this in a DispatchQueue call
-									if(onresolve) {
-										onresolve(result);
-									}
-									resolve();
-								});
-							}
-							rejecters.push_back([=](auto exceptionPtr) {
-								// TODO wrap this in a DispatchQueue call
-								if(onreject) {
-									onreject(exceptionPtr.ptr());
-								}
-								else {
-									reject(exceptionPtr);
-								}
-							});
-						}
-						break;
-						
-						case State::RESOLVED: {
-							lock.unlock();
-							// TODO wrap this in a DispatchQueue call
-							if(onresolve) {
-								if constexpr(std::is_same<RESULT,void>::value) {
-									future.get();
-									onresolve();
-								}
-								else {
-									onresolve(future.get());
-								}
-							}
-							resolve();
-						}
-						break;
-						
-						case State::REJECTED: {
-							lock.unlock();
-							// TODO wrap this in a DispatchQueue call
-							if(onreject) {
-								try {
-									future.get();
-								}
-								catch(...) {
-									onreject(std::current_exception());
-								}
-							}
-							else {
-								try {
-									future.get();
-								}
-								catch(...) {
-									reject(std::current_exception());
-								}
-							}
-						}
-						break;
-					}
-				});
+
+			Continuer(const Continuer&) = delete;
+			Continuer& operator=(const Continuer&) = delete;
+
+			~Continuer() {
+				// continuations are only left over if the promise was never settled
+				Continuation* continuation = continuations.load(std::memory_order_acquire);
+				while(continuation != nullptr && continuation != sealed()) {
+					Continuation* nextContinuation = continuation->next;
+					releaseContinuation(continuation);
+					continuation = nextContinuation;
+				}
+				if(hasResult) {
+					getResult().~StoredResult();
+				}
 			}
-			
-			
-			template<typename NEXT_RESULT>
-			Promise<NEXT_RESULT> handle(Then<Promise<NEXT_RESULT>> onresolve, Catch<std::exception_ptr,Promise<NEXT_RESULT>> onreject) {
-				ASSERT(onresolve != nullptr, "onresolve cannot be null");
-				return Promise<NEXT_RESULT>([&](auto resolve, auto reject) {
-					std::unique_lock<std::mutex> lock(sync);
-					switch(state) {
-						case State::EXECUTING: {
-							if constexpr(std::is_same<RESULT,void>::value) {
-								resolvers.push_back([=]() {
-									// TODO wrap this in a DispatchQueue call
-									auto nextPromise = onresolve();
-									if constexpr(std::is_same<NEXT_RESULT,void>::value) {
-										nextPromise.then([=]() {
-											resolve();
-										},[=](std::exception_ptr error) {
-											reject(error);
-										});
-									}
-									else {
-										nextPromise.then([=](auto nextResult) {
-											resolve(nextResult);
-										},[=](std::exception_ptr error) {
-											reject(error);
-										});
-									}
-								});
-							}
-							else {
-								resolvers.push_back([=](auto result) {
-									// TODO wrap this in a DispatchQueue call
-									auto nextPromise = onresolve(result);
-									if constexpr(std::is_same<NEXT_RESULT,void>::value) {
-										nextPromise.then([=]() {
-											resolve();
-										},[=](std::exception_ptr error) {
-											reject(error);
-										});
-									}
-									else {
-										nextPromise.then([=](auto nextResult) {
-											resolve(nextResult);
-										},[=](std::exception_ptr error) {
-											reject(error);
-										});
-									}
-								});
-							}
-							rejecters.push_back([=](auto exceptionPtr) {
-								// TODO wrap this in a DispatchQueue call
-								if(onreject) {
-									auto nextPromise = onreject(exceptionPtr.ptr());
-									if constexpr(std::is_same<NEXT_RESULT,void>::value) {
-										nextPromise.then([=]() {
-											resolve();
-										}, [=](std::exception_ptr error) {
-											reject(error);
-										});
-									}
-									else {
-										nextPromise.then([=](auto nextResult) {
-											resolve(nextResult);
-										}, [=](std::exception_ptr error) {
-											reject(error);
-										});
-									}
-								}
-								else {
-									reject(exceptionPtr);
-								}
-							});
-						}
-						break;
-						
-						case State::RESOLVED: {
-							lock.unlock();
-							// TODO wrap this in a DispatchQueue call
-							if constexpr(std::is_same<RESULT,void>::value) {
-								future.get();
-								auto nextPromise = onresolve();
-								if constexpr(std::is_same<NEXT_RESULT,void>::value) {
-									nextPromise.then([=]() {
-										resolve();
-									}, [=](std::exception_ptr error) {
-										reject(error);
-									});
-								}
-								else {
-									nextPromise.then([=](auto nextResult) {
-										resolve(nextResult);
-									}, [=](std::exception_ptr error) {
-										reject(error);
-									});
-								}
-							}
-							else {
-								auto nextPromise = onresolve(future.get());
-								if constexpr(std::is_same<NEXT_RESULT,void>::value) {
-									nextPromise.then([=]() {
-										resolve();
-									}, [=](std::exception_ptr error) {
-										reject(error);
-									});
-								}
-								else {
-									nextPromise.then([=](auto nextResult) {
-										resolve(nextResult);
-									}, [=](std::exception_ptr error) {
-										reject(error);
-									});
-								}
-							}
-						}
-						break;
-						
-						case State::REJECTED: {
-							lock.unlock();
-							// TODO wrap this in a DispatchQueue call
-							if(onreject) {
-								try {
-									future.get();
-								}
-								catch(...) {
-									auto nextPromise = onreject(std::current_exception());
-									if constexpr(std::is_same<NEXT_RESULT,void>::value) {
-										nextPromise.then([=]() {
-											resolve();
-										}, [=](std::exception_ptr error) {
-											reject(error);
-										});
-									}
-									else {
-										nextPromise.then([=](auto nextResult) {
-											resolve(nextResult);
-										}, [=](std::exception_ptr error) {
-											reject(error);
-										});
-									}
-								}
-							}
-							else {
-								try {
-									future.get();
-								}
-								catch(...) {
-									reject(std::current_exception());
-								}
-							}
-						}
-						break;
+
+
+			template<typename... ARGS>
+			void resolve(ARGS&&... args) {
+				bool settling = beginSettling();
+				ASSERT(settling, "Cannot resolve or reject a promise multiple times");
+				storeResult(std::forward<ARGS>(args)...);
+				finishSettling(State::RESOLVED);
+			}
+
+			void reject(std::exception_ptr error) {
+				bool settling = beginSettling();
+				ASSERT(settling, "Cannot resolve or reject a promise multiple times");
+				this->error = std::move(error);
+				rejected = true;
+				finishSettling(State::REJECTED);
+			}
+
+			template<typename... ARGS>
+			bool tryResolve(ARGS&&... args) {
+				if(!beginSettling()) {
+					return false;
+				}
+				storeResult(std::forward<ARGS>(args)...);
+				finishSettling(State::RESOLVED);
+				return true;
+			}
+
+			bool tryReject(std::exception_ptr error) {
+				if(!beginSettling()) {
+					return false;
+				}
+				this->error = std::move(error);
+				rejected = true;
+				finishSettling(State::REJECTED);
+				return true;
+			}
+
+
+			// tells if the promise has been settled and all of its continuations have run
+			bool isSettled() const {
+				return (state.load(std::memory_order_acquire) >= State::RESOLVED);
+			}
+
+			// only valid once the promise has been settled
+			bool isRejected() const {
+				return rejected;
+			}
+
+			StoredResult& getResult() {
+				return *reinterpret_cast<StoredResult*>(&resultStorage);
+			}
+
+			const std::exception_ptr& getError() const {
+				return error;
+			}
+
+			template<typename FUNC>
+			auto invoke(const FUNC& func) {
+				if constexpr(std::is_same<RESULT,void>::value) {
+					return func();
+				}
+				else {
+					return func(getResult());
+				}
+			}
+
+			// settles another promise the same way as this one, copying the result
+			void copyTo(Continuer& target) {
+				if(rejected) {
+					target.reject(error);
+				}
+				else if constexpr(std::is_same<RESULT,void>::value) {
+					target.resolve();
+				}
+				else {
+					target.resolve(getResult());
+				}
+			}
+
+			// settles another promise the same way as this one, moving the result
+			void moveTo(Continuer& target) {
+				if(rejected) {
+					target.reject(error);
+				}
+				else if constexpr(std::is_same<RESULT,void>::value) {
+					target.resolve();
+				}
+				else {
+					target.resolve(std::move(getResult()));
+				}
+			}
+
+
+			// runs a callback once the promise is settled, or right away if it already has been
+			void addContinuation(Callback callback) {
+				Continuation* head = continuations.load(std::memory_order_acquire);
+				if(head == sealed()) {
+					callback(*this);
+					return;
+				}
+				Continuation* continuation = nullptr;
+				if(!inlineContinuationUsed.exchange(true, std::memory_order_relaxed)) {
+					continuation = &inlineContinuation;
+				}
+				else {
+					continuation = new Continuation();
+				}
+				continuation->callback = std::move(callback);
+				do {
+					if(head == sealed()) {
+						// the promise was settled while the continuation was being set up
+						Callback settledCallback = std::move(continuation->callback);
+						releaseContinuation(continuation);
+						settledCallback(*this);
+						return;
 					}
-				});
+					continuation->next = head;
+				} while(!continuations.compare_exchange_weak(head, continuation, std::memory_order_release, std::memory_order_acquire));
 			}
-			
-			
+
 		private:
-			std::promise<Result> promise;
-			std::shared_future<Result> future;
-			std::list<Resolver> resolvers;
-			std::list<Rejecter> rejecters;
-			std::mutex sync;
-			State state;
+			struct Continuation
+			{
+				Callback callback;
+				Continuation* next = nullptr;
+			};
+
+			// marks the continuation stack once the promise has been settled. It's never dereferenced
+			static Continuation* sealed() {
+				return reinterpret_cast<Continuation*>(static_cast<uintptr_t>(1));
+			}
+
+			void releaseContinuation(Continuation* continuation) {
+				if(continuation == &inlineContinuation) {
+					continuation->callback = nullptr;
+				}
+				else {
+					delete continuation;
+				}
+			}
+
+			template<typename... ARGS>
+			void storeResult(ARGS&&... args) {
+				new (&resultStorage) StoredResult(std::forward<ARGS>(args)...);
+				hasResult = true;
+			}
+
+			bool beginSettling() {
+				State expected = State::EXECUTING;
+				return state.compare_exchange_strong(expected, State::SETTLING, std::memory_order_acquire, std::memory_order_relaxed);
+			}
+
+			void finishSettling(State settledState) {
+				Continuation* continuation = continuations.exchange(sealed(), std::memory_order_acq_rel);
+				// continuations are pushed onto the front of the stack, so reverse it to run them in the order they were added
+				Continuation* ordered = nullptr;
+				while(continuation != nullptr) {
+					Continuation* nextContinuation = continuation->next;
+					continuation->next = ordered;
+					ordered = continuation;
+					continuation = nextContinuation;
+				}
+				while(ordered != nullptr) {
+					Continuation* nextContinuation = ordered->next;
+					ordered->callback(*this);
+					releaseContinuation(ordered);
+					ordered = nextContinuation;
+				}
+				// only mark the promise as settled once nothing else will read the result, so that a sole owner can take it
+				state.store(settledState, std::memory_order_release);
+			}
+
+			std::atomic<State> state;
+			std::atomic<Continuation*> continuations;
+			std::atomic<bool> inlineContinuationUsed;
+			Continuation inlineContinuation;
+			bool rejected;
+			bool hasResult;
+			typename std::aligned_storage<sizeof(StoredResult), alignof(StoredResult)>::type resultStorage;
+			std::exception_ptr error;
 		};
-		
+
+
+		explicit Promise(std::shared_ptr<Continuer> continuer)
+			: continuer(std::move(continuer)) {
+			//
+		}
+
+
+		// adds a continuation that runs on the given executor
+		template<typename FUNC>
+		void addContinuation(PromiseExecutor executor, FUNC func) {
+			if(executor.isImmediate()) {
+				continuer->addContinuation(std::move(func));
+			}
+			else {
+				continuer->addContinuation([=](Continuer& settled) {
+					// keep the settled promise alive until the executor gets around to the continuation
+					auto settledPtr = settled.shared_from_this();
+					executor.execute([=]() {
+						func(*settledPtr);
+					});
+				});
+			}
+		}
+
+
+		// creates a promise that is settled by onresolve or onreject once this promise settles. If either throws, the new promise is rejected
+		template<typename NEXT_RESULT, typename ONRESOLVE, typename ONREJECT>
+		Promise<NEXT_RESULT> chain(PromiseExecutor executor, ONRESOLVE onresolve, ONREJECT onreject) {
+			typedef typename Promise<NEXT_RESULT>::Continuer NextContinuer;
+			auto next = std::make_shared<NextContinuer>();
+			addContinuation(std::move(executor), [=](Continuer& settled) {
+				try {
+					if(settled.isRejected()) {
+						onreject(settled, *next);
+					}
+					else {
+						onresolve(settled, *next);
+					}
+				}
+				catch(...) {
+					next->tryReject(std::current_exception());
+				}
+			});
+			return Promise<NEXT_RESULT>(std::move(next));
+		}
+
+
+		// settles a promise the same way as another promise
+		static void settleFrom(Continuer& target, Promise<RESULT> source) {
+			auto& sourceContinuer = source.continuer;
+			if(sourceContinuer.use_count() == 1 && sourceContinuer->isSettled()) {
+				// nothing else can see the source promise, so its result can be moved instead of copied
+				sourceContinuer->moveTo(target);
+				return;
+			}
+			auto targetPtr = target.shared_from_this();
+			sourceContinuer->addContinuation([=](Continuer& settled) {
+				settled.copyTo(*targetPtr);
+			});
+		}
+
+
+		// gets the result of a settled promise, or throws its error
+		RESULT takeResult() {
+			if(continuer->isRejected()) {
+				std::rethrow_exception(continuer->getError());
+			}
+			if constexpr(!std::is_same<RESULT,void>::value) {
+				if(continuer.use_count() == 1 && continuer->isSettled()) {
+					// this is the last reference to the promise, so the result can be moved
+					return std::move(continuer->getResult());
+				}
+				return continuer->getResult();
+			}
+		}
+
+
 		std::shared_ptr<Continuer> continuer;
+
+
+	public:
+		#ifdef GAMELIBRARY_PROMISE_COROUTINES
+		class CoroutineValueReturn
+		{
+		public:
+			template<typename VALUE>
+			void return_value(VALUE&& value) {
+				continuer->resolve(std::forward<VALUE>(value));
+			}
+
+		protected:
+			std::shared_ptr<Continuer> continuer = std::make_shared<Continuer>();
+		};
+
+		class CoroutineVoidReturn
+		{
+		public:
+			void return_void() {
+				continuer->resolve();
+			}
+
+		protected:
+			std::shared_ptr<Continuer> continuer = std::make_shared<Continuer>();
+		};
+
+		/*! Lets a coroutine return a Promise. The promise resolves with the value given to co_return, or is rejected with any exception that leaves the coroutine.*/
+		class promise_type : public std::conditional<std::is_same<RESULT,void>::value, CoroutineVoidReturn, CoroutineValueReturn>::type
+		{
+		public:
+			Promise<RESULT> get_return_object() {
+				return Promise<RESULT>(this->continuer);
+			}
+
+			std::suspend_never initial_suspend() noexcept {
+				return {};
+			}
+
+			std::suspend_never final_suspend() noexcept {
+				return {};
+			}
+
+			void unhandled_exception() {
+				this->continuer->reject(std::current_exception());
+			}
+		};
+		#endif
 	};
-	
-	
-	
-	
+
+
+
+
+	/*! Blocks until a promise is settled. While waiting on the main thread, main thread tasks keep running, and while waiting on a worker thread of the default TaskScheduler, the worker keeps running scheduled tasks, so that the promise can still be settled by them.
+		\param promise the promise to wait for
+		\returns the result of the promise
+		\throws the error that the promise was rejected with*/
 	template<typename RESULT>
 	RESULT await(Promise<RESULT> promise) {
-		std::condition_variable cv;
-		std::mutex mutex;
-		std::unique_lock<std::mutex> lock(mutex);
-		
-		bool resolved = false;
-		bool rejected = false;
-		std::unique_ptr<RESULT> result_ptr = nullptr;
-		std::exception_ptr error_ptr = nullptr;
-		
-		promise.then([&](RESULT result) {
-			result_ptr = std::make_unique<RESULT>(result);
-			resolved = true;
-			cv.notify_one();
-		}, [&](std::exception_ptr error) {
-			error_ptr = error;
-			rejected = true;
-			cv.notify_one();
-		});
-		
-		cv.wait(lock, [&]() {
-			return rejected || resolved;
-		});
-		
-		if(rejected) {
-			std::rethrow_exception(error_ptr);
+		auto& continuer = *promise.continuer;
+		if(!continuer.isSettled()) {
+			std::mutex mutex;
+			std::condition_variable cv;
+			bool finished = false;
+			continuer.addContinuation([&](auto&) {
+				// notify while holding the lock, so the waiting thread can't return and destroy the condition variable first
+				std::lock_guard<std::mutex> lock(mutex);
+				finished = true;
+				cv.notify_one();
+			});
+
+			bool mainThread = Thread::isMainThread();
+			TaskScheduler& scheduler = TaskScheduler::getDefault();
+			bool workerThread = !mainThread && scheduler.isWorkerThread();
+			auto isFinished = [&]() {
+				return finished;
+			};
+			while(true) {
+				// only return once the lock is taken, since the continuation still uses the mutex and condition variable until it releases the lock
+				std::unique_lock<std::mutex> lock(mutex);
+				if(finished) {
+					break;
+				}
+				if(mainThread || workerThread) {
+					lock.unlock();
+					if(mainThread) {
+						TaskScheduler::runMainThreadTasks();
+					}
+					else if(scheduler.runPendingTask()) {
+						continue;
+					}
+					lock.lock();
+					cv.wait_for(lock, std::chrono::milliseconds(1), isFinished);
+				}
+				else {
+					cv.wait(lock, isFinished);
+				}
+			}
 		}
-		return std::move(*result_ptr.get());
+		return promise.takeResult();
 	}
-	
-	
-	
-	
+
+
+
+
 	template<typename RESULT>
-	Promise<RESULT> async(std::function<RESULT()> func) {
-		return Promise<RESULT>([=](auto resolve, auto reject) {
-			std::thread([=](){
+	Promise<RESULT> async(std::function<RESULT()> func, TaskScheduler::Priority priority=TaskScheduler::Priority::NORMAL) {
+		return Promise<RESULT>([&](auto resolve, auto reject) {
+			TaskScheduler::getDefault().schedule([=]() {
 				try {
 					if constexpr(std::is_same<RESULT,void>::value) {
 						func();
 						resolve();
 					}
 					else {
-						auto result = func();
-						resolve(result);
+						resolve(func());
 					}
 				}
 				catch(...) {
 					reject(std::current_exception());
 				}
-			});
+			}, priority);
 		});
 	}
 }
@@ -0,0 +1,137 @@
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fgl
+{
+	/*! Runs tasks on a fixed number of worker threads. Each worker has its own task queues, and idle workers steal tasks from the other workers' queues, so that short tasks don't need a new thread each.
+		Tasks scheduled from a worker thread are run in last-in-first-out order by that worker, while tasks stolen by other workers are taken in first-in-first-out order.*/
+	class TaskScheduler
+	{
+	public:
+		/*! The priority of a task. Higher priority tasks are run before lower priority tasks, if both are waiting.*/
+		enum class Priority
+		{
+			/*! Tasks that should run as soon as possible*/
+			HIGH = 0,
+			/*! The default priority*/
+			NORMAL = 1,
+			/*! Background tasks that can wait for other tasks*/
+			LOW = 2
+		};
+
+		/*! Constructs a TaskScheduler and starts its worker threads.
+			\param workerCount the number of worker threads to start, or 0 to use one less than the number of hardware threads (but at least 1)*/
+		explicit TaskScheduler(size_t workerCount=0);
+		/*! deleted copy constructor*/
+		TaskScheduler(const TaskScheduler&) = delete;
+		/*! Finishes running all scheduled tasks, and then stops the worker threads.*/
+		~TaskScheduler();
+
+		/*! deleted assignment operator*/
+		TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+
+		/*! Gets the shared TaskScheduler, which is created the first time it's needed. Thread::runOnThread and async use this scheduler.
+			\returns a reference to the shared TaskScheduler*/
+		static TaskScheduler& getDefault();
+
+
+		/*! Schedules a task to run on one of the worker threads.
+			\param task the function to run. Any exception thrown by the task is logged and ignored
+			\param priority the priority of the task*/
+		void schedule(std::function<void()> task, Priority priority=Priority::NORMAL);
+		/*! Schedules a task to run on the main thread the next time Thread::update is called.
+			\param task the function to run
+			\param priority the priority of the task*/
+		static void scheduleOnMainThread(std::function<void()> task, Priority priority=Priority::NORMAL);
+		/*! Runs a task on the main thread during the next call to Thread::update, and waits for it to finish. If called from the main thread, the task runs immediately.
+			\param task the function to run
+			\param priority the priority of the task*/
+		static void runOnMainThreadAndWait(const std::function<void()>& task, Priority priority=Priority::NORMAL);
+
+
+		/*! Runs a function over a range of indexes, splitting the range into chunks that are run on the worker threads. The calling thread runs chunks as well, and the function returns once every chunk has finished.
+			\param begin the first index of the range
+			\param end the index after the last index of the range
+			\param func the function to call for each chunk, with the first index and the index after the last index of the chunk
+			\param grainSize the number of indexes in each chunk, or 0 to choose a size based on the number of worker threads
+			\throws the first exception thrown by func, after all chunks have finished*/
+		void parallelForRange(size_t begin, size_t end, const std::function<void(size_t,size_t)>& func, size_t grainSize=0);
+		/*! Runs a function for each index in a range, splitting the range into chunks that are run on the worker threads. The calling thread runs chunks as well, and the function returns once every index has been run.
+			\param begin the first index of the range
+			\param end the index after the last index of the range
+			\param func the function to call for each index
+			\param grainSize the number of indexes in each chunk, or 0 to choose a size based on the number of worker threads
+			\throws the first exception thrown by func, after all chunks have finished*/
+		template<typename FUNC>
+		void parallelFor(size_t begin, size_t end, FUNC func, size_t grainSize=0) {
+			parallelForRange(begin, end, [&](size_t rangeBegin, size_t rangeEnd) {
+				for(size_t i=rangeBegin; i<rangeEnd; i++) {
+					func(i);
+				}
+			}, grainSize);
+		}
+
+
+		/*! Runs a single waiting task on the calling thread, if there is one. This lets a thread help with scheduled work while it waits for a result.
+			\returns true if a task was run, or false if there were no waiting tasks*/
+		bool runPendingTask();
+
+		/*! Gets the number of worker threads.
+			\returns the number of worker threads*/
+		size_t getWorkerCount() const;
+		/*! Tells if the calling thread is one of this scheduler's worker threads.
+			\returns true if the calling thread is a worker thread of this scheduler*/
+		bool isWorkerThread() const;
+
+		/*! Runs the tasks scheduled on the main thread, highest priority first, until they've all run or the main thread time budget runs out. Tasks scheduled while this is running wait for the next call.
+			This is called by Thread::update, and does nothing if it isn't called from the main thread.*/
+		static void runMainThreadTasks();
+		/*! Sets how long each call to runMainThreadTasks can spend running tasks. At least one task is run on each call, and any tasks left over are run on the next call.
+			\param milliseconds the time budget in milliseconds, or a negative value to run every waiting task on each call*/
+		static void setMainThreadTimeBudget(double milliseconds);
+		/*! Gets how long each call to runMainThreadTasks can spend running tasks.
+			\returns the time budget in milliseconds, or a negative value if there is no budget*/
+		static double getMainThreadTimeBudget();
+		/*! Tells whether any tasks are waiting to run on the main thread.
+			\returns true if runMainThreadTasks has tasks to run, or false if otherwise*/
+		static bool hasMainThreadTasks();
+		/*! Sets a function to call whenever a task is scheduled on the main thread, so that a main thread waiting for events can wake up and run it. The function can be called from any thread.
+			\param wakeFunction the function to call, or null to not call anything*/
+		static void setMainThreadWakeFunction(void(*wakeFunction)());
+
+	private:
+		typedef std::function<void()> Task;
+
+		static constexpr size_t PRIORITY_COUNT = 3;
+
+		struct Worker
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks[PRIORITY_COUNT];
+			std::thread thread;
+		};
+
+		void runWorker(size_t workerIndex);
+		bool takeTask(size_t workerIndex, Task& task);
+		bool popTask(size_t workerIndex, size_t priority, Task& task);
+		bool stealTask(size_t thiefIndex, size_t priority, Task& task);
+		void runTask(Task& task);
+
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::atomic<size_t> pendingCount;
+		std::atomic<size_t> nextWorker;
+		std::mutex sleepMutex;
+		std::condition_variable sleepCondition;
+		bool stopping;
+	};
+}
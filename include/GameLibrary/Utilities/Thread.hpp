@@ -36,7 +36,7 @@ namespace fgl
 			\param func the function to run on the main thread
 			\param wait true to wait until the function finishes, or false to continue */
 		static void runOnMainThread(const std::function<void()>& func, bool wait=false);
-		/*! Runs a given function in a new thread.
+		/*! Runs a given function on one of the worker threads of the shared TaskScheduler. Functions that block for a long time should use their own Thread instead, so they don't hold up other tasks.
 			\param func the function to run */
 		static void runOnThread(const std::function<void()>& func);
 		/*! Tells if the current thread is the main thread
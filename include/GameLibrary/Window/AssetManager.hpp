@@ -1,18 +1,30 @@
 
 #pragma once
 
+#include <list>
+#include <memory>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 #include <GameLibrary/Graphics/TextureImage.hpp>
+#include <GameLibrary/IO/AssetPack.hpp>
 #include <GameLibrary/Utilities/Font/Font.hpp>
 #include <GameLibrary/Utilities/ArrayList.hpp>
+#include <GameLibrary/Utilities/Profiler.hpp>
 
 namespace fgl
 {
 	class Window;
+	class BatchLoader;
+	template<typename ASSET_TYPE>
+	class AssetHandle;
 	
 	/*! Manages various Application resources, such as TextureImage or Font objects.*/
 	class AssetManager
 	{
+		template<typename ASSET_TYPE>
+		friend class AssetHandle;
+		friend class BatchLoader;
 	public:
 		struct LoadInfo {
 			AssetManager* assetManager;
@@ -27,6 +39,8 @@ namespace fgl
 		using LoaderFunc = std::function<ASSET_TYPE*(LoadInfo)>;
 		template<typename ASSET_TYPE>
 		using UnloaderFunc = std::function<void(ASSET_TYPE*)>;
+		template<typename ASSET_TYPE>
+		using SizeFunc = std::function<size_t(const ASSET_TYPE*)>;
 		
 		
 		/*! Constructs an AssetManager for the specified Window, in the specified root folder and secondary root folders.
@@ -58,15 +72,38 @@ namespace fgl
 		FILE* openFile(const String& path, const char* mode, String* resolvedPath=nullptr) const;
 		
 		
+		/*! Mounts an asset pack. When an asset is loaded, the mounted packs are searched in the order they were mounted before falling back to loose files in the root directory.
+			Asset paths are looked up in a pack relative to the root directory.
+			\param path the path to the pack file, relative to the root directory
+			\param error an optional String pointer to store the error message if the function fails
+			\returns true if the pack was mounted, or false if an error occurred*/
+		bool mountPack(const String& path, String* error=nullptr);
+		/*! Unmounts all mounted asset packs. This should not be called while assets are being loaded on another thread.*/
+		void unmountPacks();
+		/*! Gets the mounted asset packs.
+			\returns an ArrayList of asset packs, in the order they are searched*/
+		const ArrayList<AssetPack*>& getPacks() const;
+		/*! Finds the contents of a file in the mounted asset packs.
+			\param path the path of the file
+			\param entry an optional pointer to store the memory-mapped contents of the file. The contents stay valid until the pack is unmounted
+			\returns true if the file was found in a mounted pack, or false if it should be loaded as a loose file*/
+		bool findPackedFile(const String& path, AssetPack::Entry* entry=nullptr) const;
+		
+		
 		/*! Adds an asset type
 			\param loader the function to load the asset from a given path
-			\param unloader the function to unload a loaded asset*/
+			\param unloader the function to unload a loaded asset
+			\param sizer the function to estimate the memory used by a loaded asset, in bytes. If null, assets of this type don't count towards the memory budget*/
 		template<typename ASSET_TYPE>
-		void addAssetType(LoaderFunc<ASSET_TYPE> loader, UnloaderFunc<ASSET_TYPE> unloader=nullptr) {
+		void addAssetType(LoaderFunc<ASSET_TYPE> loader, UnloaderFunc<ASSET_TYPE> unloader=nullptr, SizeFunc<ASSET_TYPE> sizer=nullptr) {
 			if(getAssetList<ASSET_TYPE>() != nullptr) {
 				throw IllegalArgumentException("ASSET_TYPE", "cannot be added more than once");
 			}
-			assetLists.push_back(new AssetList<ASSET_TYPE>(loader, unloader));
+			size_t slot = getAssetTypeSlot<ASSET_TYPE>();
+			if(slot >= assetLists.size()) {
+				assetLists.resize(slot+1, nullptr);
+			}
+			assetLists[slot] = new AssetList<ASSET_TYPE>(this, loader, unloader, sizer);
 		}
 		
 		/*! Checks if the asset manager has the asset type
@@ -80,7 +117,7 @@ namespace fgl
 		}
 		
 		
-		/*! Loads an asset of a given type
+		/*! Loads an asset of a given type. If a memory budget is set, the returned asset may be evicted once other assets are loaded, unless an AssetHandle is held for it.
 			\param path the path to load the asset from
 			\returns the loaded asset
 			\throws an error if the asset could not be loaded*/
@@ -94,7 +131,8 @@ namespace fgl
 			if(assetList == nullptr) {
 				throw IllegalArgumentException("ASSET_TYPE", "type has not been added to the asset manager");
 			}
-			return assetList->load(LoadInfo{ this, rootdir, path });
+			FGL_PROFILE_ZONE("AssetManager::load")
+			return assetList->load(LoadInfo{ this, rootdir, path }, path)->asset;
 		}
 		
 		
@@ -106,7 +144,7 @@ namespace fgl
 			if(assetList == nullptr) {
 				throw IllegalArgumentException("ASSET_TYPE", "type has not been added to the asset manager");
 			}
-			assetList->unload(path);
+			assetList->unload(getValidAssetPath(path));
 		}
 		
 		/*! Unloads all assets of a given type */
@@ -128,7 +166,7 @@ namespace fgl
 			// attempt to load from self
 			auto assetList = getAssetList<ASSET_TYPE>();
 			if(assetList != nullptr) {
-				auto asset = assetList->get(getValidAssetPath(path));
+				auto asset = assetList->get(path);
 				if(asset != nullptr) {
 					return asset;
 				}
@@ -151,7 +189,7 @@ namespace fgl
 			// attempt to load from self
 			auto assetList = getAssetList<ASSET_TYPE>();
 			if(assetList != nullptr) {
-				auto asset = assetList->get(getValidAssetPath(path));
+				auto asset = assetList->get(path);
 				if(asset != nullptr) {
 					return asset;
 				}
@@ -175,12 +213,11 @@ namespace fgl
 			allAssets.reserve(count<ASSET_TYPE>(includeDependents));
 			auto assetList = getAssetList<ASSET_TYPE>();
 			if(assetList != nullptr) {
-				auto& assets = assetList->getAll();
-				allAssets.add(assets.begin(), assets.end());
+				assetList->getAll(allAssets);
 			}
 			if(includeDependents) {
 				for(auto assetManager : assetManagers) {
-					allAssets.add(assetManager->getAll<ASSET_TYPE>(true));
+					allAssets.addAll(assetManager->getAll<ASSET_TYPE>(true));
 				}
 			}
 			return allAssets;
@@ -195,12 +232,11 @@ namespace fgl
 			allAssets.reserve(count<ASSET_TYPE>(includeDependents));
 			auto assetList = getAssetList<ASSET_TYPE>();
 			if(assetList != nullptr) {
-				auto& assets = assetList->getAll();
-				allAssets.add(assets.begin(), assets.end());
+				assetList->getAll(allAssets);
 			}
 			if(includeDependents) {
 				for(auto assetManager : assetManagers) {
-					allAssets.add(assetManager->getAll<ASSET_TYPE>(true));
+					allAssets.addAll(assetManager->getAll<ASSET_TYPE>(true));
 				}
 			}
 			return allAssets;
@@ -214,8 +250,7 @@ namespace fgl
 			auto assetList = getAssetList<ASSET_TYPE>();
 			size_t count = 0;
 			if(assetList != nullptr) {
-				auto& assets = assetList->getAll();
-				count += assets.size();
+				count += assetList->getAssetCount();
 			}
 			if(includeDependents) {
 				for(auto assetManager : assetManagers) {
@@ -234,7 +269,7 @@ namespace fgl
 			if(assetList == nullptr) {
 				throw IllegalArgumentException("ASSET_TYPE", "type has not been added to the asset manager");
 			}
-			return assetList->add(path, asset);
+			return assetList->add(getValidAssetPath(path), asset);
 		}
 		
 		
@@ -251,6 +286,60 @@ namespace fgl
 		}
 		
 		
+		/*! Loads an asset of a given type if it hasn't already been loaded, and gives a handle to it. The asset will not be evicted while any handle to it is held.
+			\param path the path to load the asset from
+			\returns a handle to the loaded asset
+			\throws an error if the asset could not be loaded*/
+		template<typename ASSET_TYPE>
+		AssetHandle<ASSET_TYPE> acquire(const String& path) {
+			auto handle = getHandle<ASSET_TYPE>(path);
+			if(handle) {
+				return handle;
+			}
+			auto assetList = getAssetList<ASSET_TYPE>();
+			if(assetList == nullptr) {
+				throw IllegalArgumentException("ASSET_TYPE", "type has not been added to the asset manager");
+			}
+			// the handle takes its reference before the memory budget is enforced, so the new asset can't be evicted
+			handle = AssetHandle<ASSET_TYPE>(assetList->load(LoadInfo{ this, rootdir, path }, path, false)->shared_from_this());
+			enforceMemoryBudget();
+			return handle;
+		}
+		
+		/*! Gives a handle to an already loaded asset of a given type from this asset manager or a dependent one. The asset will not be evicted while any handle to it is held.
+			\param path the path that the asset was loaded from
+			\returns a handle to the loaded asset, or an empty handle if the asset has not been loaded*/
+		template<typename ASSET_TYPE>
+		AssetHandle<ASSET_TYPE> getHandle(const String& path) {
+			auto assetList = getAssetList<ASSET_TYPE>();
+			if(assetList != nullptr) {
+				auto entry = assetList->find(path);
+				if(entry != nullptr) {
+					return AssetHandle<ASSET_TYPE>(entry->shared_from_this());
+				}
+			}
+			for(auto assetManager : assetManagers) {
+				auto handle = assetManager->getHandle<ASSET_TYPE>(path);
+				if(handle) {
+					return handle;
+				}
+			}
+			return AssetHandle<ASSET_TYPE>();
+		}
+		
+		
+		/*! Gives the estimated memory used by loaded assets of a given type. This does not include assets stored in dependent asset managers.
+			\returns the estimated memory usage, in bytes*/
+		template<typename ASSET_TYPE>
+		size_t getMemoryUsage() const {
+			auto assetList = getAssetList<ASSET_TYPE>();
+			if(assetList == nullptr) {
+				return 0;
+			}
+			return assetList->getMemoryUsage();
+		}
+		
+		
 		/*! Loads and stores a TextureImage from the given path.
 			\param path the path to load the TextureImage, relative to the AssetManager root
 			\returns a TextureImage pointer if one was successfully loaded or was already stored in the AssetManager, or null if an error occurred*/
@@ -361,6 +450,17 @@ namespace fgl
 		/*! Unloads and deallocates all stored assets. This does not include assets stored in dependent asset managers */
 		void unloadAllAssets();
 		
+		/*! Gives the estimated memory used by all loaded assets. This does not include assets stored in dependent asset managers.
+			\returns the estimated memory usage, in bytes*/
+		size_t getMemoryUsage() const;
+		/*! Sets the memory budget for loaded assets. When the estimated memory usage goes over the budget, the least recently used assets that have no AssetHandle referencing them are unloaded, and will be loaded again the next time they're requested.
+			Assets given to the asset manager with add() are never evicted, since they can't be reloaded. Assets loaded by a BatchLoader can be evicted like any other loaded asset.
+			\param budget the memory budget, in bytes, or 0 for no budget*/
+		void setMemoryBudget(size_t budget);
+		/*! Gets the memory budget for loaded assets.
+			\returns the memory budget, in bytes, or 0 if there is no budget*/
+		size_t getMemoryBudget() const;
+		
 		
 		
 		/*! Adds a dependent asset manager to get assets from before attempting to load the asset
@@ -383,133 +483,145 @@ namespace fgl
 		void swapAssets(AssetManager* assetManager);
 		
 	private:
+		class PlainAssetList;
+		
+		// bookkeeping for a loaded asset, shared with any handles to it
+		struct AssetEntry {
+			// the list storing the asset, or null once the asset has been unloaded
+			PlainAssetList* owner = nullptr;
+			String path;
+			size_t size = 0;
+			size_t refCount = 0;
+			// whether the asset can be evicted and loaded again from its path
+			bool reloadable = false;
+			// whether the asset is in the unreferenced assets list
+			bool unreferenced = false;
+			std::list<AssetEntry*>::iterator unreferencedIterator;
+		};
+		
+		template<typename ASSET_TYPE>
+		struct TypedAssetEntry : public AssetEntry, public std::enable_shared_from_this<TypedAssetEntry<ASSET_TYPE>> {
+			ASSET_TYPE* asset = nullptr;
+		};
+		
 		// generic "asset list" class acts as a base class for typed asset lists
 		class PlainAssetList {
 		public:
+			explicit PlainAssetList(AssetManager* manager) : manager(manager) {}
 			virtual ~PlainAssetList() = default;
 			
-			virtual void unload(const String& path) = 0;
+			virtual void unload(const String& fullpath) = 0;
 			virtual void unloadAll() = 0;
 			virtual size_t getAssetCount() const = 0;
+			virtual size_t getMemoryUsage() const = 0;
+			virtual void clearAliases() = 0;
+			
+			AssetManager* manager;
 		};
 		
 		// manage assets for a given type
+		// assets are indexed by their resolved path, and the paths that callers use to look them up are cached as aliases,
+		// so that repeated lookups with the same path don't need to resolve the path again
 		template<typename ASSET_TYPE>
 		class AssetList : public PlainAssetList {
 		public:
-			struct AssetNode {
-				String path;
-				ASSET_TYPE* asset;
-			};
-			
-			typedef std::list<AssetNode> AssetNodeList;
+			typedef TypedAssetEntry<ASSET_TYPE> Entry;
 			
-			AssetList(LoaderFunc<ASSET_TYPE> loader, UnloaderFunc<ASSET_TYPE> unloader)
-				: loader(loader), unloader(unloader) {
+			AssetList(AssetManager* manager, LoaderFunc<ASSET_TYPE> loader, UnloaderFunc<ASSET_TYPE> unloader, SizeFunc<ASSET_TYPE> sizer)
+				: PlainAssetList(manager), loader(loader), unloader(unloader), sizer(sizer), memoryUsage(0) {
 				//
 			};
 			
 			virtual ~AssetList() {
 				for(auto& pair : assets) {
-					if(unloader) {
-						unloader(pair.asset);
-					}
-					else {
-						delete pair.asset;
-					}
+					detach(*pair.second);
 				}
 			}
 			
-			typename AssetNodeList::iterator find(const String& path) {
-				for(auto it=assets.begin(); it!=assets.end(); it++) {
-					if(it->path == path) {
-						return it;
-					}
-				}
-				return assets.end();
-			}
-			
-			typename AssetNodeList::const_iterator find(const String& path) const {
-				for(auto it=assets.begin(); it!=assets.end(); it++) {
-					if(it->path == path) {
-						return it;
-					}
-				}
-				return assets.end();
-			}
-			
 			String getPath(const ASSET_TYPE* asset) const {
-				for(auto it=assets.begin(); it!=assets.end(); it++) {
-					if(it->asset == asset) {
-						return it->path;
-					}
+				auto pathIt = paths.find(asset);
+				if(pathIt == paths.end()) {
+					throw OutOfBoundsException("asset not found");
 				}
-				throw OutOfBoundsException("asset not found");
+				return pathIt->second->path;
 			}
 			
-			
-			ASSET_TYPE* get(const String& path) {
-				auto assetIt = find(path);
+			Entry* find(const String& path) const {
+				auto aliasIt = aliases.find(path);
+				if(aliasIt != aliases.end()) {
+					return aliasIt->second;
+				}
+				auto assetIt = assets.find(manager->getValidAssetPath(path));
 				if(assetIt == assets.end()) {
 					return nullptr;
 				}
-				return assetIt->asset;
+				auto entry = assetIt->second.get();
+				aliases.emplace(path, entry);
+				return entry;
 			}
 			
-			const ASSET_TYPE* get(const String& path) const {
-				auto assetIt = find(path);
-				if(assetIt == assets.end()) {
+			ASSET_TYPE* get(const String& path) const {
+				auto entry = find(path);
+				if(entry == nullptr) {
 					return nullptr;
 				}
-				return assetIt->asset;
+				manager->touchAsset(entry);
+				return entry->asset;
 			}
 			
-			const std::list<ASSET_TYPE*>& getAll() {
-				return assets;
+			template<typename LIST_TYPE>
+			void getAll(LIST_TYPE& list) const {
+				for(auto& pair : assets) {
+					list.add(pair.second->asset);
+				}
 			}
 			
-			const std::list<const ASSET_TYPE*>& getAll() const {
-				return reinterpret_cast<const std::list<const ASSET_TYPE*>&>(assets);
+			Entry* load(LoadInfo info, const String& alias, bool enforceBudget=true) {
+				return addLoaded(info.getFullPath(), loader(info), alias, enforceBudget);
 			}
 			
-			ASSET_TYPE* load(LoadInfo info) {
-				auto asset = loader(info);
-				assets.push_back({ info.path, asset });
-				return asset;
+			// adds an asset that was loaded from its path somewhere else, so that it can be evicted and loaded again like any other loaded asset
+			Entry* addLoaded(const String& fullpath, ASSET_TYPE* asset, const String& alias, bool enforceBudget=true) {
+				auto entry = insert(fullpath, asset, true);
+				aliases.emplace(alias, entry);
+				if(enforceBudget) {
+					manager->enforceMemoryBudget(entry);
+				}
+				return entry;
 			}
 			
-			void add(const String& path, ASSET_TYPE* asset) {
-				auto assetIt = find(path);
-				if(assetIt != assets.end()) {
+			void add(const String& fullpath, ASSET_TYPE* asset) {
+				if(assets.find(fullpath) != assets.end()) {
 					throw IllegalArgumentException("path", "conflicts with already loaded asset");
 				}
-				assets.push_back({ path, asset });
+				insert(fullpath, asset, false);
+				manager->enforceMemoryBudget();
 			}
 			
-			virtual void unload(const String& path) override {
-				auto assetIt = find(path);
+			virtual void unload(const String& fullpath) override {
+				auto assetIt = assets.find(fullpath);
 				if(assetIt != assets.end()) {
-					if(unloader) {
-						unloader(assetIt->asset);
-					}
-					else {
-						delete assetIt->asset;
-					}
+					auto entry = assetIt->second;
 					assets.erase(assetIt);
+					paths.erase(entry->asset);
+					removeAliases(entry.get());
+					memoryUsage -= entry->size;
+					manager->onAssetRemoved(entry.get());
+					detach(*entry);
 				}
 			}
 			
 			virtual void unloadAll() override {
-				auto it = assets.begin();
-				while(it != assets.end()) {
-					if(unloader) {
-						unloader(it->asset);
-					}
-					else {
-						delete it->asset;
-					}
-					assets.erase(it);
-					it = assets.begin();
+				auto unloadingAssets = std::move(assets);
+				assets.clear();
+				paths.clear();
+				aliases.clear();
+				memoryUsage = 0;
+				for(auto& pair : unloadingAssets) {
+					manager->onAssetRemoved(pair.second.get());
+				}
+				for(auto& pair : unloadingAssets) {
+					detach(*pair.second);
 				}
 			}
 			
@@ -517,39 +629,114 @@ namespace fgl
 				return assets.size();
 			}
 			
+			virtual size_t getMemoryUsage() const override {
+				return memoryUsage;
+			}
+			
+			virtual void clearAliases() override {
+				aliases.clear();
+			}
+			
 		private:
-			AssetNodeList assets;
+			Entry* insert(const String& fullpath, ASSET_TYPE* asset, bool reloadable) {
+				auto entry = std::make_shared<Entry>();
+				entry->owner = this;
+				entry->path = fullpath;
+				entry->asset = asset;
+				entry->reloadable = reloadable;
+				if(sizer) {
+					entry->size = sizer(asset);
+				}
+				assets[fullpath] = entry;
+				paths[asset] = entry.get();
+				memoryUsage += entry->size;
+				manager->onAssetAdded(entry.get());
+				return entry.get();
+			}
+			
+			// destroys the asset, leaving any handles to it empty
+			void detach(Entry& entry) {
+				auto asset = entry.asset;
+				entry.asset = nullptr;
+				entry.owner = nullptr;
+				if(unloader) {
+					unloader(asset);
+				}
+				else {
+					delete asset;
+				}
+			}
+			
+			void removeAliases(const Entry* entry) {
+				for(auto it=aliases.begin(); it!=aliases.end();) {
+					if(it->second == entry) {
+						it = aliases.erase(it);
+					}
+					else {
+						it++;
+					}
+				}
+			}
+			
+			std::unordered_map<String, std::shared_ptr<Entry>> assets;
+			std::unordered_map<const ASSET_TYPE*, Entry*> paths;
+			mutable std::unordered_map<String, Entry*> aliases;
 			LoaderFunc<ASSET_TYPE> loader;
 			UnloaderFunc<ASSET_TYPE> unloader;
+			SizeFunc<ASSET_TYPE> sizer;
+			size_t memoryUsage;
 		};
 		
 		
 		String getValidAssetPath(const String& path) const;
 		
+		// adds an asset that was loaded from a path relative to the root, such as by a BatchLoader, so that it's managed as if it were loaded by this asset manager
+		template<typename ASSET_TYPE>
+		void addLoaded(const String& path, ASSET_TYPE* asset) {
+			auto assetList = getAssetList<ASSET_TYPE>();
+			if(assetList == nullptr) {
+				throw IllegalArgumentException("ASSET_TYPE", "type has not been added to the asset manager");
+			}
+			assetList->addLoaded(getValidAssetPath(path), asset, path);
+		}
 		
+		// reference counting and eviction for asset entries
+		static void retainAsset(AssetEntry* entry);
+		static void releaseAsset(AssetEntry* entry);
+		void onAssetAdded(AssetEntry* entry);
+		void onAssetRemoved(AssetEntry* entry);
+		void touchAsset(AssetEntry* entry) const;
+		void enforceMemoryBudget(const AssetEntry* keepEntry=nullptr);
+		
+		
+		
+		// give a unique index for each asset type, shared by all asset managers
+		static size_t nextAssetTypeSlot();
+		
+		template<typename ASSET_TYPE>
+		static size_t getAssetTypeSlot() {
+			static const size_t slot = nextAssetTypeSlot();
+			return slot;
+		}
 		
 		// give an asset list for a specific type
 		template<typename ASSET_TYPE>
 		AssetList<ASSET_TYPE>* getAssetList() {
-			for(auto assetList : assetLists) {
-				auto typedAssetList = dynamic_cast<AssetList<ASSET_TYPE>*>(assetList);
-				if(typedAssetList != nullptr) {
-					return typedAssetList;
-				}
+			size_t slot = getAssetTypeSlot<ASSET_TYPE>();
+			if(slot >= assetLists.size()) {
+				return nullptr;
 			}
-			return nullptr;
+			return static_cast<AssetList<ASSET_TYPE>*>(assetLists[slot]);
 		}
 		
 		// give an asset list for a specific type
 		template<typename ASSET_TYPE>
 		const AssetList<ASSET_TYPE>* getAssetList() const {
-			for(auto assetList : assetLists) {
-				auto typedAssetList = dynamic_cast<const AssetList<ASSET_TYPE>*>(assetList);
-				if(typedAssetList != nullptr) {
-					return typedAssetList;
-				}
+			size_t slot = getAssetTypeSlot<ASSET_TYPE>();
+			if(slot >= assetLists.size()) {
+				return nullptr;
 			}
-			return nullptr;
+			return static_cast<const AssetList<ASSET_TYPE>*>(assetLists[slot]);
 		}
 		
 		
@@ -577,9 +764,125 @@ namespace fgl
 		
 		
 		
-		std::list<PlainAssetList*> assetLists;
+		std::vector<PlainAssetList*> assetLists;
 		Window* window;
 		String rootdir;
 		std::list<AssetManager*> assetManagers;
+		ArrayList<AssetPack*> packs;
+		
+		// reloadable assets with no handles, from least to most recently used
+		mutable std::list<AssetEntry*> unreferencedAssets;
+		size_t memoryUsage;
+		size_t memoryBudget;
+	};
+	
+	
+	
+	/*! A reference counted handle to an asset stored in an AssetManager. While any handle to an asset is held, the asset will not be evicted to stay within the AssetManager's memory budget.
+		If the asset is explicitly unloaded, the handle becomes empty.*/
+	template<typename ASSET_TYPE>
+	class AssetHandle
+	{
+		friend class AssetManager;
+	public:
+		/*! Constructs an empty handle.*/
+		AssetHandle() {
+			//
+		}
+		
+		/*! Constructs an empty handle.*/
+		AssetHandle(std::nullptr_t) {
+			//
+		}
+		
+		/*! copy constructor*/
+		AssetHandle(const AssetHandle& handle)
+			: entry(handle.entry) {
+			if(entry) {
+				AssetManager::retainAsset(entry.get());
+			}
+		}
+		
+		/*! move constructor*/
+		AssetHandle(AssetHandle&& handle)
+			: entry(std::move(handle.entry)) {
+			//
+		}
+		
+		/*! destructor*/
+		~AssetHandle() {
+			reset();
+		}
+		
+		/*! copy assignment operator*/
+		AssetHandle& operator=(const AssetHandle& handle) {
+			if(this != &handle) {
+				reset();
+				entry = handle.entry;
+				if(entry) {
+					AssetManager::retainAsset(entry.get());
+				}
+			}
+			return *this;
+		}
+		
+		/*! move assignment operator*/
+		AssetHandle& operator=(AssetHandle&& handle) {
+			if(this != &handle) {
+				reset();
+				entry = std::move(handle.entry);
+			}
+			return *this;
+		}
+		
+		
+		/*! Releases the handle's reference to the asset, leaving the handle empty.*/
+		void reset() {
+			if(entry) {
+				AssetManager::releaseAsset(entry.get());
+				entry.reset();
+			}
+		}
+		
+		/*! Gets the referenced asset.
+			\returns the asset, or null if the handle is empty or the asset has been unloaded*/
+		ASSET_TYPE* get() const {
+			if(!entry) {
+				return nullptr;
+			}
+			return entry->asset;
+		}
+		
+		/*! Gets the full path of the referenced asset.
+			\returns the path that the asset was loaded from, or an empty String if the handle is empty*/
+		String getPath() const {
+			if(!entry) {
+				return "";
+			}
+			return entry->path;
+		}
+		
+		ASSET_TYPE* operator->() const {
+			return get();
+		}
+		
+		ASSET_TYPE& operator*() const {
+			return *get();
+		}
+		
+		/*! Tells whether the handle references a loaded asset.*/
+		explicit operator bool() const {
+			return get() != nullptr;
+		}
+		
+	private:
+		explicit AssetHandle(std::shared_ptr<AssetManager::TypedAssetEntry<ASSET_TYPE>> entry)
+			: entry(std::move(entry)) {
+			if(this->entry) {
+				AssetManager::retainAsset(this->entry.get());
+			}
+		}
+		
+		std::shared_ptr<AssetManager::TypedAssetEntry<ASSET_TYPE>> entry;
 	};
 }
@@ -68,7 +68,8 @@ namespace fgl
 			STYLE_HIDDEN = 0x00000004,
 			STYLE_RESIZABLE = 0x00000008,
 			STYLE_MINIMIZED = 0x00000010,
-			STYLE_MAXIMIZED = 0x00000020
+			STYLE_MAXIMIZED = 0x00000020,
+			STYLE_SOFTWARE = 0x00000040
 		};
 
 		enum WindowPosition
@@ -0,0 +1,22 @@
+
+#pragma once
+
+#include <GameLibrary/World/WorldObject.hpp>
+
+namespace fgl
+{
+	/*! Marks a WorldObject to be replicated by a ReplicationServer. The object's Transform2DAspect position and Velocity2DAspect velocity are sent to every client.*/
+	class ReplicatedAspect : public WorldObjectAspect
+	{
+	public:
+		/*! Constructs the aspect.
+			\param networkID the ID of the object on every end of the connection, or 0 to have the ReplicationServer assign one*/
+		explicit ReplicatedAspect(Uint32 networkID=0);
+		
+		void setNetworkID(Uint32 networkID);
+		Uint32 getNetworkID() const;
+		
+	private:
+		Uint32 networkID;
+	};
+}
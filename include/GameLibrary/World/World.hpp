@@ -17,8 +17,10 @@ namespace fgl
 		World(AssetManager* assetManager, const ArrayList<WorldCamera*>& cameras = {});
 		virtual ~World();
 		
-		virtual void update(ApplicationData appData);
-		virtual void draw(ApplicationData appData, Graphics graphics) const;
+		virtual void update(const ApplicationData& appData);
+		virtual void draw(const ApplicationData& appData, Graphics graphics) const;
+		// tells whether the world needs to keep updating without input. Any object might move on its own, so a world with objects is always animating unless a subclass knows better
+		virtual bool isAnimating() const;
 		
 		DrawManager* getDrawManager();
 		const DrawManager* getDrawManager() const;
@@ -37,7 +37,7 @@ namespace fgl
 		const World* getWorld() const;
 		
 	protected:
-		virtual void drawWorld(const World* world, ApplicationData appData, Graphics graphics) const;
+		virtual void drawWorld(const World* world, const ApplicationData& appData, Graphics graphics) const;
 		
 	private:
 		class WorldElement : public ScreenElement {
@@ -45,7 +45,7 @@ namespace fgl
 		public:
 			WorldElement(const RectangleD& frame, WorldCamera* camera);
 		protected:
-			virtual void drawMain(ApplicationData appData, Graphics graphics) const;
+			virtual void drawMain(const ApplicationData& appData, Graphics graphics) const;
 		private:
 			WorldCamera* camera;
 		};
@@ -103,7 +103,7 @@ namespace fgl
 		//
 	}
 	
-	void Actor::update(ApplicationData appData)
+	void Actor::update(const ApplicationData& appData)
 	{
 		prevx = x;
 		prevy = y;
@@ -126,7 +126,7 @@ namespace fgl
 		}
 	}
 	
-	void Actor::draw(ApplicationData appData, Graphics graphics) const
+	void Actor::draw(const ApplicationData& appData, Graphics graphics) const
 	{
 		//Open for implementation
 	}
@@ -494,7 +494,7 @@ namespace fgl
 		return unlisted;
 	}
 	
-	void Actor::updateMouse(ApplicationData&appData)
+	void Actor::updateMouse(const ApplicationData& appData)
 	{
 		Window* window = appData.getWindow();
 		TransformD mouseTransform = appData.getTransform().getInverse();
@@ -599,7 +599,7 @@ namespace fgl
 		callMouseEvents(appData, mouseEventCalls);
 	}
 	
-	void Actor::updateTouch(ApplicationData&appData)
+	void Actor::updateTouch(const ApplicationData& appData)
 	{
 		Window* window = appData.getWindow();
 		TransformD mouseTransform = appData.getTransform().getInverse();
@@ -669,7 +669,7 @@ namespace fgl
 		callMouseEvents(appData, mouseEventCalls);
 	}
 
-	void Actor::callMouseEvents(ApplicationData&appData, const ArrayList<ActorMouseEvent>& eventCallData)
+	void Actor::callMouseEvents(const ApplicationData& appData, const ArrayList<ActorMouseEvent>& eventCallData)
 	{
 		bool didmousepress = false;
 		bool didmouserelease = false;
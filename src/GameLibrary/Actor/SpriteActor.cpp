@@ -68,7 +68,7 @@ namespace fgl
 		}
 	}
 	
-	void SpriteActor::update(ApplicationData appData)
+	void SpriteActor::update(const ApplicationData& appData)
 	{
 		animationPlayer.update(appData, [&](AnimationPlayer::AnimationEvent event){
 			if(event==AnimationPlayer::ANIMATIONEVENT_FINISHED)
@@ -79,12 +79,12 @@ namespace fgl
 		Actor::update(appData);
 	}
 
-	void SpriteActor::draw(ApplicationData appData, Graphics graphics) const
+	void SpriteActor::draw(const ApplicationData& appData, Graphics graphics) const
 	{
 		drawActor(appData, graphics, x, y, scale);
 	}
 	
-	void SpriteActor::drawActor(ApplicationData&appData, Graphics&graphics, double x, double y, double scale) const
+	void SpriteActor::drawActor(const ApplicationData& appData, Graphics&graphics, double x, double y, double scale) const
 	{
 		if(visible && scale!=0 && animationPlayer.getAnimation()!=nullptr)
 		{
@@ -351,6 +351,32 @@ namespace fgl
 		return false;
 	}
 	
+	bool SpriteActor_checkPixelSpans(TextureImage* img, const PixelIterator::Span& span, TextureImage* actor_img, const PixelIterator::Span& actor_span)
+	{
+		// narrow both spans down to the samples between their visible ends until a sample is visible in both
+		size_t startSample = Math::max(span.sample, actor_span.sample);
+		size_t endSample = Math::min(span.sample+span.count, actor_span.sample+actor_span.count);
+		while(startSample < endSample)
+		{
+			size_t firstSample = 0;
+			size_t lastSample = 0;
+			size_t actor_firstSample = 0;
+			size_t actor_lastSample = 0;
+			if(!img->checkPixelSpan(span.slice(startSample, endSample), &firstSample, &lastSample)
+				|| !actor_img->checkPixelSpan(actor_span.slice(startSample, endSample), &actor_firstSample, &actor_lastSample))
+			{
+				return false;
+			}
+			if(firstSample == actor_firstSample || lastSample == actor_lastSample)
+			{
+				return true;
+			}
+			startSample = Math::max(firstSample, actor_firstSample);
+			endSample = Math::min(lastSample, actor_lastSample) + 1;
+		}
+		return false;
+	}
+	
 	bool SpriteActor::isColliding(SpriteActor* actor) const
 	{
 		if(actor == nullptr)
@@ -445,6 +471,32 @@ namespace fgl
 				actor_pxlIter = new PixelIterator(dimensions, actor_srcRect, actor_frame, actor_overlap, incr, incr, transform, Vector2d(ratiox, ratioy), actor_mirrorHorizontal, actor_mirrorVertical);
 			}
 			PixelIterator& actor_pxlIterRef = *actor_pxlIter;
+			
+			if(!pxlIterRef.hasTransform() && !actor_pxlIterRef.hasTransform())
+			{
+				PixelIterator::Span span;
+				PixelIterator::Span actor_span;
+				bool running = pxlIterRef.nextPixelSpan(&span);
+				bool actor_running = actor_pxlIterRef.nextPixelSpan(&actor_span);
+				while(running && actor_running)
+				{
+					if(SpriteActor_checkPixelSpans(img, span, actor_img, actor_span))
+					{
+						delete pxlIter;
+						delete actor_pxlIter;
+						return true;
+					}
+					running = pxlIterRef.nextPixelSpan(&span);
+					actor_running = actor_pxlIterRef.nextPixelSpan(&actor_span);
+				}
+				delete pxlIter;
+				delete actor_pxlIter;
+				if(running != actor_running)
+				{
+					throw Exception("Unknown collision bug. This exception means there is a bug within the SpriteActor::isColliding function");
+				}
+				return false;
+			}
 
 			bool running = pxlIterRef.nextPixelIndex();
 			bool actor_running = actor_pxlIterRef.nextPixelIndex();
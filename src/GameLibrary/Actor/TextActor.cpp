@@ -36,17 +36,17 @@ namespace fgl
 		//
 	}
 	
-	void TextActor::update(ApplicationData appData)
+	void TextActor::update(const ApplicationData& appData)
 	{
 		Actor::update(appData);
 	}
 	
-	void TextActor::draw(ApplicationData appData, Graphics graphics) const
+	void TextActor::draw(const ApplicationData& appData, Graphics graphics) const
 	{
 		drawActor(appData, graphics, x, y, scale);
 	}
 	
-	void TextActor::drawActor(ApplicationData&appData, Graphics&graphics, double x, double y, double scale) const
+	void TextActor::drawActor(const ApplicationData& appData, Graphics&graphics, double x, double y, double scale) const
 	{
 		if(visible && scale!=0 && font!=nullptr)
 		{
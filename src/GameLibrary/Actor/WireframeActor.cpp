@@ -31,17 +31,17 @@ namespace fgl
 		//
 	}
 	
-	void WireframeActor::update(ApplicationData appData)
+	void WireframeActor::update(const ApplicationData& appData)
 	{
 		Actor::update(appData);
 	}
 	
-	void WireframeActor::draw(ApplicationData appData, Graphics graphics) const
+	void WireframeActor::draw(const ApplicationData& appData, Graphics graphics) const
 	{
 		drawActor(appData, graphics, x, y, scale);
 	}
 
-	void WireframeActor::drawActor(ApplicationData&appData, Graphics&graphics, double x, double y, double scale) const
+	void WireframeActor::drawActor(const ApplicationData& appData, Graphics&graphics, double x, double y, double scale) const
 	{
 		if(visible && scale!=0)
 		{
@@ -1,14 +1,22 @@
 
 #include <GameLibrary/Application/Application.hpp>
 #include <GameLibrary/Exception/InitializeLibraryException.hpp>
+#include <GameLibrary/Input/InputRecorder.hpp>
 #include <GameLibrary/IO/FileTools.hpp>
 #include <GameLibrary/Utilities/PlatformChecks.hpp>
+#include <GameLibrary/Utilities/Profiler.hpp>
+#include <GameLibrary/Utilities/TaskScheduler.hpp>
 #include <GameLibrary/Utilities/Thread.hpp>
 #include <GameLibrary/Utilities/Time/DateTime.hpp>
 #include "EventManager.hpp"
 #include <SDL.h>
+#include <condition_variable>
 #include <ctime>
 #include <cstdlib>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
 
 #ifdef TARGETPLATFORM_WINDOWS
 	#define WIN32_LEAN_AND_MEAN
@@ -37,6 +45,135 @@ namespace fgl
 		}
 	};
 
+	class Application_SimulationThread;
+
+	//the simulation thread that the main thread is waiting on, if any, so that main thread tasks can wake the wait
+	static std::mutex Application_waitingSimulationMutex;
+	static Application_SimulationThread* Application_waitingSimulation = nullptr;
+
+	void Application_wakeMainThread();
+
+	//runs update and draw for pipelined frames, while the main thread draws the previous frame
+	class Application_SimulationThread
+	{
+		friend void Application_wakeMainThread();
+	private:
+		std::function<void()> frameFunction;
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::exception_ptr exception;
+		bool running;
+		bool busy;
+		
+		void run()
+		{
+			Profiler::setThreadName("simulation");
+			std::unique_lock<std::mutex> lock(mutex);
+			while(true)
+			{
+				condition.wait(lock, [&]() {
+					return busy || !running;
+				});
+				if(!running)
+				{
+					return;
+				}
+				lock.unlock();
+				std::exception_ptr frameException;
+				try
+				{
+					frameFunction();
+				}
+				catch(...)
+				{
+					frameException = std::current_exception();
+				}
+				lock.lock();
+				exception = frameException;
+				busy = false;
+				condition.notify_all();
+			}
+		}
+		
+	public:
+		explicit Application_SimulationThread(const std::function<void()>& frame)
+			: frameFunction(frame),
+			running(true),
+			busy(false)
+		{
+			thread = std::thread([this]() {
+				run();
+			});
+		}
+		
+		~Application_SimulationThread()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				running = false;
+			}
+			condition.notify_all();
+			thread.join();
+		}
+		
+		void startFrame()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			busy = true;
+			condition.notify_all();
+		}
+		
+		void finishFrame()
+		{
+			{
+				std::lock_guard<std::mutex> waitingLock(Application_waitingSimulationMutex);
+				Application_waitingSimulation = this;
+			}
+			//set after the event manager has set its own wake function, which this one also calls
+			TaskScheduler::setMainThreadWakeFunction(&Application_wakeMainThread);
+			std::unique_lock<std::mutex> lock(mutex);
+			while(true)
+			{
+				condition.wait(lock, [&]() {
+					return !busy || TaskScheduler::hasMainThreadTasks();
+				});
+				if(!busy)
+				{
+					break;
+				}
+				//the simulation thread may be waiting on a task from Thread::runOnMainThread
+				lock.unlock();
+				Thread::update();
+				lock.lock();
+			}
+			lock.unlock();
+			{
+				std::lock_guard<std::mutex> waitingLock(Application_waitingSimulationMutex);
+				Application_waitingSimulation = nullptr;
+			}
+			if(exception)
+			{
+				std::exception_ptr frameException = exception;
+				exception = nullptr;
+				std::rethrow_exception(frameException);
+			}
+		}
+	};
+
+	void Application_wakeMainThread()
+	{
+		EventManager::wake();
+		std::lock_guard<std::mutex> waitingLock(Application_waitingSimulationMutex);
+		Application_SimulationThread* simulation = Application_waitingSimulation;
+		if(simulation != nullptr)
+		{
+			//locked so the notification can't land between the waiting thread checking for tasks and starting to wait
+			std::lock_guard<std::mutex> lock(simulation->mutex);
+			simulation->condition.notify_all();
+		}
+	}
+
 	Application* MainApplication = nullptr;
 
 	Application* Application::getMainApplication()
@@ -45,6 +182,10 @@ namespace fgl
 	}
 
 	Application::Application()
+		: framePacer(30),
+		pipelinedRendering(false),
+		idleWaitEnabled(false),
+		requestedFrameTime(0)
 	{
 		window = nullptr;
 		app_running = false;
@@ -110,16 +251,21 @@ namespace fgl
 		//
 	}
 
-	void Application::update(ApplicationData appData)
+	void Application::update(const ApplicationData& appData)
 	{
 		//
 	}
 
-	void Application::draw(ApplicationData appData, Graphics graphics) const
+	void Application::draw(const ApplicationData& appData, Graphics graphics) const
 	{
 		//
 	}
 
+	bool Application::isAnimating() const
+	{
+		return false;
+	}
+
 	int Application::run(const WindowSettings&windowSettings, int orientations)
 	{
 		std::srand((unsigned int)(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now())));
@@ -263,45 +409,160 @@ namespace fgl
 		}
 		
 		apptime.start();
+		framePacer.reset();
+		Profiler::setThreadName("main");
+		
+		//in pipelined mode, frame N is updated and recorded on the simulation thread while the main thread draws frame N-1
+		std::unique_ptr<Application_SimulationThread> simulation;
+		const ApplicationData* frameData = nullptr;
+		Graphics* frameGraphics = nullptr;
+		size_t recordIndex = 0;
+		bool hasRecordedFrame = false;
+		if(pipelinedRendering)
+		{
+			simulation.reset(new Application_SimulationThread([&]() {
+				{
+					FGL_PROFILE_ZONE("Application::update")
+					update(*frameData);
+				}
+				if(!app_closing)
+				{
+					FGL_PROFILE_ZONE("Application::draw")
+					draw(*frameData, *frameGraphics);
+				}
+			}));
+		}
 		
 		while(app_running && !app_closing)
 		{
-			long long startFrameTime = apptime.getMilliseconds();
-
-			EventManager::update();
-			if(EventManager::recievedQuitRequest() || !window->isOpen())
-			{
-				this->close(0);
-			}
-			
-			double framespeedMult = (double)(((long double)sleeptime)/((long double)1000));
-			ApplicationData appdata(this, window, window->getAssetManager(), apptime, window->getViewportTransform(), framespeedMult);
-			if(!app_closing)
+			framePacer.beginFrame();
+			Int64 requestedTime = requestedFrameTime.load();
+			if(requestedTime != 0 && requestedTime <= FramePacer::now())
 			{
-				update(appdata);
+				//this frame is the one that was requested, unless an earlier frame was requested in the meantime
+				requestedFrameTime.compare_exchange_strong(requestedTime, 0);
 			}
-			if(!app_closing)
+
 			{
-				draw(appdata, *(window->getGraphics()));
+				FGL_PROFILE_ZONE("Application::frame")
+				{
+					FGL_PROFILE_ZONE("EventManager::update")
+					EventManager::update();
+				}
+				if(EventManager::recievedQuitRequest() || !window->isOpen())
+				{
+					this->close(0);
+				}
+				
+				double framespeedMult = (double)(((long double)sleeptime)/((long double)1000));
+				TimeInterval frameTime = apptime;
+				bool fixedTimestep = (InputRecorder::isRecording() || InputRecorder::isReplaying());
+				if(fixedTimestep)
+				{
+					//each frame advances the time by exactly one frame, so a replay runs the same way as its recording
+					frameTime = TimeInterval((long long)(InputRecorder::getFrameNumber() * sleeptime));
+				}
+				ApplicationData appdata(this, window, window->getAssetManager(), frameTime, window->getViewportTransform(), framespeedMult);
+				if(!fixedTimestep)
+				{
+					appdata.setFrameDelta(framePacer.getFrameDelta(), framePacer.getSmoothedFrameDelta());
+				}
+				appdata.setFrameTimeHistogram(&framePacer.getHistogram());
+				if(simulation)
+				{
+					RenderCommandList& recordList = commandLists[recordIndex];
+					recordList.clear();
+					Graphics recordGraphics(*(window->getGraphics()));
+					recordGraphics.commandList = &recordList;
+					frameData = &appdata;
+					frameGraphics = &recordGraphics;
+					//checked before the simulation thread starts, since update can close the Application
+					bool drawPreviousFrame = (hasRecordedFrame && !app_closing);
+					if(!app_closing)
+					{
+						simulation->startFrame();
+					}
+					if(drawPreviousFrame)
+					{
+						FGL_PROFILE_ZONE("Application::render")
+						try
+						{
+							window->getGraphics()->executeCommands(commandLists[1-recordIndex]);
+							window->refresh();
+						}
+						catch(...)
+						{
+							//the simulation thread is still using this frame's data, so it has to finish before unwinding
+							try
+							{
+								simulation->finishFrame();
+							}
+							catch(...)
+							{
+								//
+							}
+							throw;
+						}
+					}
+					simulation->finishFrame();
+					hasRecordedFrame = true;
+					recordIndex = 1 - recordIndex;
+				}
+				else
+				{
+					if(!app_closing)
+					{
+						FGL_PROFILE_ZONE("Application::update")
+						update(appdata);
+					}
+					if(!app_closing)
+					{
+						FGL_PROFILE_ZONE("Application::draw")
+						draw(appdata, *(window->getGraphics()));
+					}
+					if(!app_closing)
+					{
+						FGL_PROFILE_ZONE("Window::refresh")
+						window->refresh();
+					}
+				}
 			}
-			if(!app_closing)
+			Profiler::endFrame();
+			
+			//replays run as fast as possible, so they can be used as benchmarks
+			if(!app_closing && !InputRecorder::isReplaying())
 			{
-				window->refresh();
-
-				long long endFrameTime = apptime.getMilliseconds();
-				unsigned long long totalFrameTime = (unsigned long long)(endFrameTime - startFrameTime);
-				if(totalFrameTime > sleeptime || sleeptime==0)
+				bool idle = (idleWaitEnabled && !InputRecorder::isRecording() && !isAnimating());
+				if(idle && hasRecordedFrame)
 				{
-					Thread::sleep(1);
+					//show the last recorded frame now, since it would otherwise wait until after the next event
+					FGL_PROFILE_ZONE("Application::render")
+					window->getGraphics()->executeCommands(commandLists[1-recordIndex]);
+					window->refresh();
+					hasRecordedFrame = false;
 				}
-				else
+				framePacer.waitForNextFrame();
+				if(idle)
 				{
-					unsigned long long adjustedSleepTime = sleeptime - totalFrameTime;
-					Thread::sleep(adjustedSleepTime);
+					//nothing is changing on screen, so wait for input, a main thread task, or a requested frame
+					long long timeout = -1;
+					Int64 requestedTime = requestedFrameTime.load();
+					if(requestedTime != 0)
+					{
+						Int64 remaining = requestedTime - FramePacer::now();
+						timeout = (remaining > 0) ? (long long)((remaining + 999999) / 1000000) : 0;
+					}
+					if(timeout != 0)
+					{
+						FGL_PROFILE_ZONE("EventManager::waitForEvent")
+						EventManager::waitForEvent(timeout);
+						framePacer.resume();
+					}
 				}
 			}
 		}
 
+		simulation.reset();
 		apptime.stop();
 
 		unloadContent(window->getAssetManager());
@@ -322,6 +583,7 @@ namespace fgl
 		{
 			sleeptime = (unsigned long long)(1000/fps);
 		}
+		framePacer.setTargetFPS((double)fps);
 	}
 
 	unsigned int Application::getFPS() const
@@ -329,6 +591,58 @@ namespace fgl
 		return fps;
 	}
 
+	void Application::setPipelinedRendering(bool pipelined)
+	{
+		pipelinedRendering = pipelined;
+	}
+
+	bool Application::isPipelinedRendering() const
+	{
+		return pipelinedRendering;
+	}
+
+	void Application::setIdleWaitEnabled(bool enabled)
+	{
+		idleWaitEnabled = enabled;
+	}
+
+	bool Application::isIdleWaitEnabled() const
+	{
+		return idleWaitEnabled;
+	}
+
+	void Application::requestFrame(long long delayMilliseconds)
+	{
+		if(delayMilliseconds < 0)
+		{
+			delayMilliseconds = 0;
+		}
+		Int64 time = FramePacer::now() + ((Int64)delayMilliseconds * 1000000);
+		Int64 requestedTime = requestedFrameTime.load();
+		while(requestedTime == 0 || time < requestedTime)
+		{
+			if(requestedFrameTime.compare_exchange_weak(requestedTime, time))
+			{
+				if(!Thread::isMainThread())
+				{
+					//the main thread may already be waiting with a later timeout
+					EventManager::wake();
+				}
+				return;
+			}
+		}
+	}
+
+	FramePacer& Application::getFramePacer()
+	{
+		return framePacer;
+	}
+
+	const FramePacer& Application::getFramePacer() const
+	{
+		return framePacer;
+	}
+
 	Window* Application::getWindow() const
 	{
 		return window;
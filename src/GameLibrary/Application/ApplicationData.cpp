@@ -12,6 +12,9 @@ namespace fgl
 		timeInterval = time;
 		transform = transfrm;
 		framespeedMult = fpsMult;
+		frameDelta = fpsMult;
+		smoothedFrameDelta = fpsMult;
+		frameTimeHistogram = nullptr;
 	}
 
 	Application* ApplicationData::getApplication() const
@@ -53,6 +56,36 @@ namespace fgl
 	{
 		return framespeedMult;
 	}
+	
+	double ApplicationData::getFrameDelta() const
+	{
+		return frameDelta;
+	}
+	
+	double ApplicationData::getSmoothedFrameDelta() const
+	{
+		return smoothedFrameDelta;
+	}
+	
+	const FramePacer::Histogram& ApplicationData::getFrameTimeHistogram() const
+	{
+		if(frameTimeHistogram == nullptr)
+		{
+			static const FramePacer::Histogram emptyHistogram;
+			return emptyHistogram;
+		}
+		return *frameTimeHistogram;
+	}
+	
+	const HashDictionary& ApplicationData::getAdditionalData() const
+	{
+		if(!additionalData)
+		{
+			static const HashDictionary emptyAdditionalData;
+			return emptyAdditionalData;
+		}
+		return *additionalData;
+	}
 
 	void ApplicationData::setApplication(Application*app)
 	{
@@ -78,4 +111,41 @@ namespace fgl
 	{
 		transform = transfrm;
 	}
+	
+	void ApplicationData::setFrameDelta(double delta, double smoothedDelta)
+	{
+		frameDelta = delta;
+		smoothedFrameDelta = smoothedDelta;
+	}
+	
+	void ApplicationData::setFrameTimeHistogram(const FramePacer::Histogram* histogram)
+	{
+		frameTimeHistogram = histogram;
+	}
+	
+	void ApplicationData::setAdditionalData(const HashDictionary::Key& key, Any value)
+	{
+		if(!additionalData)
+		{
+			additionalData = std::make_shared<HashDictionary>();
+		}
+		else if(additionalData.use_count() > 1)
+		{
+			additionalData = std::make_shared<HashDictionary>(*additionalData);
+		}
+		additionalData->set(key, std::move(value));
+	}
+	
+	void ApplicationData::removeAdditionalData(const HashDictionary::Key& key)
+	{
+		if(!additionalData || !additionalData->has(key))
+		{
+			return;
+		}
+		if(additionalData.use_count() > 1)
+		{
+			additionalData = std::make_shared<HashDictionary>(*additionalData);
+		}
+		additionalData->remove(key);
+	}
 }
@@ -3,6 +3,9 @@
 #include <GameLibrary/Window/Window.hpp>
 #include <GameLibrary/Exception/IllegalArgumentException.hpp>
 #include <GameLibrary/Exception/IllegalStateException.hpp>
+#include <GameLibrary/IO/FileTools.hpp>
+#include <GameLibrary/Utilities/Profiler.hpp>
+#include <chrono>
 
 namespace fgl
 {
@@ -13,11 +16,14 @@ namespace fgl
 		loadcurrent = 0;
 		loadtotal = 0;
 		loading = false;
+		workerCount = std::thread::hardware_concurrency();
+		decodeindex = 0;
+		decoding = false;
 	}
 
 	BatchLoader::~BatchLoader()
 	{
-		//
+		stopWorkers();
 	}
 	
 	AssetManager* BatchLoader::getAssetManager() const
@@ -88,9 +94,24 @@ namespace fgl
 		return loadtotal;
 	}
 
+	void BatchLoader::setWorkerCount(unsigned int count)
+	{
+		workerCount = count;
+	}
+	
+	unsigned int BatchLoader::getWorkerCount() const
+	{
+		return workerCount;
+	}
+
 	void BatchLoader::loadAll()
 	{
-		if(!loading) {
+		if(loading)
+		{
+			return;
+		}
+		if(workerCount == 0)
+		{
 			if(eventListeners.size()>0) {
 				auto listeners = eventListeners;
 				for(auto listener : listeners) {
@@ -102,50 +123,378 @@ namespace fgl
 				loadNext();
 				loadindex++;
 			}
-			loading = false;
-			if(loadindex == (loadlist.size()-1)) {
-				auto listeners = eventListeners;
-				for(auto listener : listeners) {
-					listener->onBatchLoaderFinish(this);
+			finishLoad();
+		}
+		else
+		{
+			loadAllAsync();
+			while(update(-1));
+		}
+	}
+	
+	void BatchLoader::loadAllAsync()
+	{
+		if(loading)
+		{
+			return;
+		}
+		if(eventListeners.size()>0) {
+			auto listeners = eventListeners;
+			for(auto listener : listeners) {
+				listener->onBatchLoaderStart(this);
+			}
+		}
+		loading = true;
+		startWorkers();
+	}
+	
+	bool BatchLoader::update(double timeBudget)
+	{
+		if(!loading)
+		{
+			return false;
+		}
+		auto startTime = std::chrono::steady_clock::now();
+		while(loading && loadindex<loadlist.size())
+		{
+			if(!uploadNext(timeBudget < 0))
+			{
+				// the next asset is still being decoded
+				return true;
+			}
+			loadindex++;
+			if(timeBudget >= 0)
+			{
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+				if(elapsed.count() >= timeBudget)
+				{
+					break;
+				}
+			}
+		}
+		if(loading && loadindex<loadlist.size())
+		{
+			return true;
+		}
+		finishLoad();
+		return false;
+	}
+	
+	bool BatchLoader::isLoading() const
+	{
+		return loading;
+	}
+	
+	void BatchLoader::finishLoad()
+	{
+		stopWorkers();
+		bool finished = (loading && loadindex >= loadlist.size());
+		loading = false;
+		if(finished) {
+			auto listeners = eventListeners;
+			for(auto listener : listeners) {
+				listener->onBatchLoaderFinish(this);
+			}
+		}
+	}
+	
+	void BatchLoader::startWorkers()
+	{
+		stopWorkers();
+		if(loadindex >= loadlist.size())
+		{
+			return;
+		}
+		if((assetManager == nullptr) && (workerCount > 0))
+		{
+			for(size_t i=loadindex; i<loadlist.size(); i++)
+			{
+				if(loadlist[i].type != LOADTYPE_FUNCTION)
+				{
+					loading = false;
+					throw IllegalStateException("AssetManager cannot be null while loading a texture or font");
 				}
 			}
 		}
+		decodeResults.clear();
+		decodeResults.resize(loadlist.size());
+		size_t decodeCount = 0;
+		for(size_t i=loadindex; i<loadlist.size(); i++)
+		{
+			const LoadInfo& info = loadlist[i];
+			DecodeResult& result = decodeResults[i];
+			switch(info.type)
+			{
+				case LOADTYPE_TEXTURE:
+				result.needsDecode = (assetManager->getTexture(info.path) == nullptr);
+				break;
+				
+				case LOADTYPE_FONT:
+				result.needsDecode = (assetManager->getFont(info.path) == nullptr);
+				break;
+				
+				case LOADTYPE_FUNCTION:
+				result.needsDecode = false;
+				break;
+			}
+			if(result.needsDecode)
+			{
+				decodeCount++;
+			}
+		}
+		if(decodeCount == 0)
+		{
+			return;
+		}
+		// SDL_image initializes its decoders lazily and without locking, so make sure that happens here before the workers start
+		Image();
+		decodeindex = loadindex;
+		decoding = true;
+		size_t threadCount = (size_t)workerCount;
+		if(decodeCount < threadCount)
+		{
+			threadCount = decodeCount;
+		}
+		workers.reserve(threadCount);
+		for(size_t i=0; i<threadCount; i++)
+		{
+			workers.emplace_back(&BatchLoader::runWorker, this);
+		}
+	}
+	
+	void BatchLoader::stopWorkers()
+	{
+		decoding = false;
+		for(auto& worker : workers)
+		{
+			worker.join();
+		}
+		workers.clear();
+	}
+	
+	void BatchLoader::runWorker()
+	{
+		size_t loadsize = loadlist.size();
+		while(decoding)
+		{
+			size_t index = decodeindex++;
+			if(index >= loadsize)
+			{
+				return;
+			}
+			DecodeResult& result = decodeResults[index];
+			if(!result.needsDecode)
+			{
+				continue;
+			}
+			decode(loadlist[index], result);
+			std::unique_lock<std::mutex> lock(decodeMutex);
+			result.finished = true;
+			lock.unlock();
+			decodeCondition.notify_all();
+		}
+	}
+	
+	void BatchLoader::decode(const LoadInfo& info, DecodeResult& result) const
+	{
+		FGL_PROFILE_ZONE("BatchLoader::decode")
+		// packed assets are decoded straight from the memory-mapped pack
+		AssetPack::Entry packEntry;
+		bool packed = assetManager->findPackedFile(info.path, &packEntry);
+		FILE* file = nullptr;
+		if(!packed)
+		{
+			file = assetManager->openFile(info.path, "rb");
+			if(file == nullptr)
+			{
+				result.success = false;
+				result.error = "unable to load file";
+				return;
+			}
+		}
+		try
+		{
+			switch(info.type)
+			{
+				case LOADTYPE_TEXTURE:
+				result.image = std::unique_ptr<Image>(new Image());
+				if(packed)
+				{
+					result.success = result.image->loadFromPointer(packEntry.data, packEntry.size, &result.error);
+				}
+				else
+				{
+					result.success = result.image->loadFromFile(file, &result.error);
+				}
+				if(result.success)
+				{
+					result.pixelMask = TextureImage::createPixelMask(*result.image);
+				}
+				break;
+				
+				case LOADTYPE_FONT:
+				if(packed)
+				{
+					result.fontData.assign(packEntry.data, packEntry.size);
+					result.success = true;
+				}
+				else
+				{
+					result.success = result.fontData.loadFromFile(file, &result.error);
+				}
+				break;
+				
+				case LOADTYPE_FUNCTION:
+				result.success = false;
+				break;
+			}
+		}
+		catch(const Exception& e)
+		{
+			result.success = false;
+			result.error = e.what();
+		}
+		catch(const std::bad_alloc&)
+		{
+			result.success = false;
+			result.error = "out of memory";
+		}
+		if(file != nullptr)
+		{
+			FileTools::closeFile(file);
+		}
+	}
+	
+	bool BatchLoader::uploadNext(bool wait)
+	{
+		DecodeResult* result = nullptr;
+		if(loadindex < decodeResults.size() && decodeResults[loadindex].needsDecode)
+		{
+			result = &decodeResults[loadindex];
+			std::unique_lock<std::mutex> lock(decodeMutex);
+			if(!result->finished)
+			{
+				if(!wait)
+				{
+					return false;
+				}
+				decodeCondition.wait(lock, [&]{
+					return result->finished;
+				});
+			}
+		}
+		
+		if(result == nullptr)
+		{
+			// nothing was decoded ahead of time, so just load it here
+			loadNext();
+			return true;
+		}
+		
+		const LoadInfo& info = loadlist[loadindex];
+		bool success = result->success;
+		String error = result->error;
+		if(success)
+		{
+			switch(info.type)
+			{
+				case LOADTYPE_TEXTURE: {
+					if(assetManager->getTexture(info.path) != nullptr) {
+						// already loaded by an earlier load function
+						break;
+					}
+					auto texture = new TextureImage();
+					success = texture->loadFromImage(*result->image, std::move(result->pixelMask), *assetManager->getWindow()->getGraphics(), &error);
+					if(success) {
+						assetManager->addLoaded<TextureImage>(info.path, texture);
+					}
+					else {
+						delete texture;
+					}
+				}
+				break;
+				
+				case LOADTYPE_FONT: {
+					if(assetManager->getFont(info.path) != nullptr) {
+						// already loaded by an earlier load function
+						break;
+					}
+					auto font = new Font();
+					success = font->loadFromData(std::move(result->fontData), &error);
+					if(success) {
+						assetManager->addLoaded<Font>(info.path, font);
+					}
+					else {
+						delete font;
+					}
+				}
+				break;
+				
+				case LOADTYPE_FUNCTION:
+				break;
+			}
+		}
+		result->image = nullptr;
+		result->fontData = Data();
+		
+		loadcurrent += info.value;
+		callLoadListeners(info, success, error);
+		return true;
+	}
+	
+	void BatchLoader::callLoadListeners(const LoadInfo& info, bool success, const String& error)
+	{
+		auto listeners = eventListeners;
+		for(auto listener : listeners) {
+			switch(info.type) {
+				case LOADTYPE_TEXTURE:
+				if(success) {
+					listener->onBatchLoaderLoadTexture(this, info.path, info.value);
+				}
+				else {
+					listener->onBatchLoaderErrorTexture(this, info.path, info.value, error);
+				}
+				break;
+				
+				case LOADTYPE_FONT:
+				if(success) {
+					listener->onBatchLoaderLoadFont(this, info.path, info.value);
+				}
+				else {
+					listener->onBatchLoaderErrorFont(this, info.path, info.value, error);
+				}
+				break;
+				
+				case LOADTYPE_FUNCTION:
+				if(success) {
+					listener->onBatchLoaderLoadFunction(this, info.func, info.value);
+				}
+				else {
+					listener->onBatchLoaderErrorFunction(this, info.func, info.value, error);
+				}
+				break;
+			}
+		}
 	}
 
 	void BatchLoader::loadNext() {
 		if(loadindex < loadlist.size()) {
 			LoadInfo info = loadlist.get(loadindex);
+			bool success = false;
+			String error;
 			switch(info.type) {
 				case LOADTYPE_TEXTURE: {
 					if(assetManager == nullptr) {
 						throw IllegalStateException("AssetManager cannot be null while loading a texture");
 					}
-					bool success;
-					String error;
 					try {
 						assetManager->loadTexture(info.path);
 						success = true;
 					}
-					catch(Exception ex) {
+					catch(const Exception& ex) {
 						success = false;
 						error = ex.what();
 					}
-					loadcurrent += info.value;
-					if(success) {
-						ArrayList<BatchLoaderEventListener*> listeners = eventListeners;
-						for(unsigned int i=0; i<listeners.size(); i++)
-						{
-							BatchLoaderEventListener*listener = listeners.get(i);
-							listener->onBatchLoaderLoadTexture(this, info.path, info.value);
-						}
-					}
-					else {
-						ArrayList<BatchLoaderEventListener*> listeners = eventListeners;
-						for(unsigned int i=0; i<listeners.size(); i++) {
-							BatchLoaderEventListener*listener = listeners.get(i);
-							listener->onBatchLoaderErrorTexture(this, info.path, info.value, error);
-						}
-					}
 				}
 				break;
 				
@@ -153,61 +502,36 @@ namespace fgl
 					if(assetManager == nullptr) {
 						throw IllegalStateException("AssetManager cannot be null while loading a font");
 					}
-					bool success;
-					String error;
 					try {
 						assetManager->loadFont(info.path);
 						success = true;
 					}
-					catch(Exception ex) {
+					catch(const Exception& ex) {
 						success = false;
 						error = ex.what();
 					}
-					loadcurrent += info.value;
-					if(success) {
-						auto listeners = eventListeners;
-						for(auto listener : listeners) {
-							listener->onBatchLoaderLoadFont(this, info.path, info.value);
-						}
-					}
-					else {
-						auto listeners = eventListeners;
-						for(auto listener : listeners) {
-							listener->onBatchLoaderErrorFont(this, info.path, info.value, error);
-						}
-					}
 				}
 				break;
 
 				case LOADTYPE_FUNCTION: {
-					String error;
-					bool success = info.func(assetManager, &error);
-					loadcurrent += info.value;
-					if(success) {
-						auto listeners = eventListeners;
-						for(auto listener : listeners) {
-							listener->onBatchLoaderLoadFunction(this, info.func, info.value);
-						}
-					}
-					else {
-						auto listeners = eventListeners;
-						for(auto listener : listeners) {
-							listener->onBatchLoaderErrorFunction(this, info.func, info.value, error);
-						}
-					}
+					success = info.func(assetManager, &error);
 				}
 				break;
 			}
+			loadcurrent += info.value;
+			callLoadListeners(info, success, error);
 		}
 	}
 
 	void BatchLoader::stopLoad() {
 		loading = false;
+		stopWorkers();
 	}
-
+	
 	void BatchLoader::clear() {
-		loading = false;
+		stopLoad();
 		loadlist.clear();
+		decodeResults.clear();
 		loadindex = 0;
 		loadcurrent = 0;
 		loadtotal = 0;
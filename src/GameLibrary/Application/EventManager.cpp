@@ -4,20 +4,42 @@
 #include <GameLibrary/Input/Keyboard.hpp>
 #include <GameLibrary/Input/Mouse.hpp>
 #include <GameLibrary/Input/Multitouch.hpp>
+#include <GameLibrary/Utilities/TaskScheduler.hpp>
 #include <GameLibrary/Utilities/Thread.hpp>
 #include <GameLibrary/Window/Window.hpp>
 #include <SDL.h>
+#include <atomic>
 #include <condition_variable>
+#include <limits>
 
 namespace fgl
 {
 	ArrayList<Window*> EventManager_windows;
 	static std::mutex EventManager_windows_mutex;
 	static bool EventManager_quitRequest = false;
+	//the user event pushed to wake the main thread, and whether one is already queued, so a burst of tasks only queues one
+	static std::atomic<Uint32> EventManager_wakeEventType((Uint32)-1);
+	static std::atomic<bool> EventManager_wakePending(false);
 	
 	Keyboard::Key Keyboard_SDLK_to_Key(int code);
 	Mouse::Button Mouse_SDL_to_MouseButton(byte button);
 	
+	//gets the index of a window in EventManager_windows, so that recorded input can find the same window when it's replayed
+	Int32 EventManager_getWindowIndex(Window* window)
+	{
+		if(window == nullptr)
+		{
+			return -1;
+		}
+		std::lock_guard<std::mutex> lock(EventManager_windows_mutex);
+		size_t index = EventManager_windows.indexOf(window);
+		if(index == ArrayList<Window*>::NOT_FOUND)
+		{
+			return -1;
+		}
+		return (Int32)index;
+	}
+	
 	const ArrayList<Window*>& EventManager::getWindows()
 	{
 		return EventManager_windows;
@@ -82,6 +104,149 @@ namespace fgl
 		return EventManager_quitRequest;
 	}
 	
+	void EventManager_pushWakeEvent()
+	{
+		Uint32 eventType = EventManager_wakeEventType.load(std::memory_order_acquire);
+		if(eventType == (Uint32)-1 || EventManager_wakePending.exchange(true))
+		{
+			return;
+		}
+		SDL_Event event;
+		SDL_zero(event);
+		event.type = eventType;
+		if(SDL_PushEvent(&event) != 1)
+		{
+			EventManager_wakePending = false;
+		}
+	}
+	
+	//called on the main thread
+	void EventManager_registerWakeEvent()
+	{
+		if(EventManager_wakeEventType.load(std::memory_order_relaxed) != (Uint32)-1)
+		{
+			return;
+		}
+		Uint32 eventType = SDL_RegisterEvents(1);
+		if(eventType != (Uint32)-1)
+		{
+			EventManager_wakeEventType.store(eventType, std::memory_order_release);
+			TaskScheduler::setMainThreadWakeFunction(&EventManager_pushWakeEvent);
+		}
+	}
+	
+	bool EventManager::waitForEvent(long long timeoutMilliseconds)
+	{
+		if(!Thread::isMainThread())
+		{
+			return false;
+		}
+		EventManager_registerWakeEvent();
+		//the wake function is set before checking for tasks, so a task scheduled after the check still wakes the wait
+		if(TaskScheduler::hasMainThreadTasks())
+		{
+			return true;
+		}
+		//a null event leaves the event in the queue
+		int result;
+		if(timeoutMilliseconds < 0)
+		{
+			result = SDL_WaitEvent(nullptr);
+		}
+		else if(timeoutMilliseconds > (long long)std::numeric_limits<int>::max())
+		{
+			result = SDL_WaitEventTimeout(nullptr, std::numeric_limits<int>::max());
+		}
+		else
+		{
+			result = SDL_WaitEventTimeout(nullptr, (int)timeoutMilliseconds);
+		}
+		return (result == 1 || TaskScheduler::hasMainThreadTasks());
+	}
+	
+	void EventManager::wake()
+	{
+		EventManager_pushWakeEvent();
+	}
+	
+	void EventManager::handleInputEvent(const InputRecorder::Event& event, bool replayed)
+	{
+		typedef InputRecorder::EventType EventType;
+		if(!replayed)
+		{
+			if(InputRecorder::isReplaying())
+			{
+				return;
+			}
+			InputRecorder::recordEvent(event);
+		}
+		
+		Window* window = nullptr;
+		if(event.window >= 0)
+		{
+			EventManager_windows_mutex.lock();
+			if((size_t)event.window < EventManager_windows.size())
+			{
+				window = EventManager_windows.get((size_t)event.window);
+			}
+			EventManager_windows_mutex.unlock();
+		}
+		
+		switch(event.type)
+		{
+			case EventType::END:
+			break;
+			
+			case EventType::KEY_PRESS:
+			Keyboard::handleKeyPress((Keyboard::Key)event.code);
+			break;
+			
+			case EventType::KEY_RELEASE:
+			Keyboard::handleKeyRelease((Keyboard::Key)event.code);
+			break;
+			
+			case EventType::TEXT_INPUT:
+			Keyboard::handleTextInput(event.text);
+			break;
+			
+			case EventType::MOUSE_MOVE:
+			Mouse::handleMouseMovement(window, event.index, Vector2d((double)event.x, (double)event.y), Vector2d((double)event.dx, (double)event.dy));
+			break;
+			
+			case EventType::MOUSE_PRESS:
+			Mouse::handleButtonPress(window, event.index, (Mouse::Button)event.code, Vector2d((double)event.x, (double)event.y));
+			break;
+			
+			case EventType::MOUSE_RELEASE:
+			Mouse::handleButtonRelease(window, event.index, (Mouse::Button)event.code, Vector2d((double)event.x, (double)event.y));
+			break;
+			
+			case EventType::TOUCH_DOWN:
+			case EventType::TOUCH_MOVE:
+			case EventType::TOUCH_UP:
+			if(window != nullptr)
+			{
+				//touch positions are relative to the window size
+				Vector2u winSize = window->getSize();
+				Vector2d fingerpos = Vector2d(((double)event.x)*((double)winSize.x), ((double)event.y)*((double)winSize.y));
+				if(event.type == EventType::TOUCH_DOWN)
+				{
+					Multitouch::handleTouchDown(window, (long long)event.code, fingerpos);
+				}
+				else if(event.type == EventType::TOUCH_UP)
+				{
+					Multitouch::handleTouchUp(window, (long long)event.code, fingerpos);
+				}
+				else
+				{
+					Vector2d diffingerpos = Vector2d(((double)event.dx)*((double)winSize.x), ((double)event.dy)*((double)winSize.y));
+					Multitouch::handleTouchMove(window, (long long)event.code, fingerpos, diffingerpos);
+				}
+			}
+			break;
+		}
+	}
+	
 	void EventManager::update(bool updateInputs)
 	{
 		if(!Thread::isMainThread())
@@ -94,6 +259,7 @@ namespace fgl
 		int data2 = 0;
 
 		EventManager_quitRequest = false;
+		EventManager_registerWakeEvent();
 		
 		Thread::runInAutoreleasePool([&]{
 			//event polling
@@ -101,6 +267,12 @@ namespace fgl
 			while(SDL_PollEvent(&event))
 			{
 				bool skip = false;
+				if(event.type == EventManager_wakeEventType.load(std::memory_order_relaxed))
+				{
+					//the tasks that sent this are run by Thread::update below
+					EventManager_wakePending = false;
+					continue;
+				}
 				if(resizingWindow != nullptr)
 				{
 					if(event.type==SDL_WINDOWEVENT && event.window.event==SDL_WINDOWEVENT_RESIZED)
@@ -127,7 +299,8 @@ namespace fgl
 						{
 							Window*window = EventManager::getWindowFromID(event.motion.windowID);
 							//TODO add support for multiple mouse indexes
-							Mouse::handleMouseMovement(window, 0, Vector2d((double)event.motion.x, (double)event.motion.y), Vector2d((double)event.motion.xrel, (double)event.motion.yrel));
+							handleInputEvent(InputRecorder::Event(InputRecorder::EventType::MOUSE_MOVE, EventManager_getWindowIndex(window), 0, 0,
+								(float)event.motion.x, (float)event.motion.y, (float)event.motion.xrel, (float)event.motion.yrel));
 						}
 						break;
 						
@@ -139,12 +312,14 @@ namespace fgl
 							if(event.button.state == SDL_PRESSED)
 							{
 								//TODO add support for multiple mouse indexes
-								Mouse::handleButtonPress(window, 0, button, Vector2d((double)event.button.x, (double)event.button.y));
+								handleInputEvent(InputRecorder::Event(InputRecorder::EventType::MOUSE_PRESS, EventManager_getWindowIndex(window), 0, (Int64)button,
+									(float)event.button.x, (float)event.button.y));
 							}
 							else if(event.button.state == SDL_RELEASED)
 							{
 								//TODO add support for multiple mouse indexes
-								Mouse::handleButtonRelease(window, 0, button, Vector2d((double)event.button.x, (double)event.button.y));
+								handleInputEvent(InputRecorder::Event(InputRecorder::EventType::MOUSE_RELEASE, EventManager_getWindowIndex(window), 0, (Int64)button,
+									(float)event.button.x, (float)event.button.y));
 							}
 						}
 						break;
@@ -153,21 +328,18 @@ namespace fgl
 						case SDL_FINGERUP:
 						case SDL_FINGERDOWN:
 						{
-							Window*window = EventManager_windows.get(0);
-							Vector2u winSize = window->getSize();
-							Vector2d fingerpos = Vector2d(((double)event.tfinger.x)*((double)winSize.x), ((double)event.tfinger.y)*((double)winSize.y));
+							//touch events are sent to the first window
 							if(event.tfinger.type==SDL_FINGERDOWN)
 							{
-								Multitouch::handleTouchDown(window, (long long)event.tfinger.fingerId, fingerpos);
+								handleInputEvent(InputRecorder::Event(InputRecorder::EventType::TOUCH_DOWN, 0, 0, (Int64)event.tfinger.fingerId, event.tfinger.x, event.tfinger.y));
 							}
 							else if(event.tfinger.type == SDL_FINGERUP)
 							{
-								Multitouch::handleTouchUp(window, (long long)event.tfinger.fingerId, fingerpos);
+								handleInputEvent(InputRecorder::Event(InputRecorder::EventType::TOUCH_UP, 0, 0, (Int64)event.tfinger.fingerId, event.tfinger.x, event.tfinger.y));
 							}
 							else if(event.tfinger.type == SDL_FINGERMOTION)
 							{
-								Vector2d diffingerpos = Vector2d(((double)event.tfinger.dx)*((double)winSize.x), ((double)event.tfinger.dy)*((double)winSize.y));
-								Multitouch::handleTouchMove(window, (long long)event.tfinger.fingerId, fingerpos, diffingerpos);
+								handleInputEvent(InputRecorder::Event(InputRecorder::EventType::TOUCH_MOVE, 0, 0, (Int64)event.tfinger.fingerId, event.tfinger.x, event.tfinger.y, event.tfinger.dx, event.tfinger.dy));
 							}
 						}
 						break;
@@ -177,18 +349,20 @@ namespace fgl
 						{
 							if(event.key.state==SDL_PRESSED)
 							{
-								Keyboard::handleKeyPress(Keyboard_SDLK_to_Key(event.key.keysym.sym));
+								handleInputEvent(InputRecorder::Event(InputRecorder::EventType::KEY_PRESS, -1, 0, (Int64)Keyboard_SDLK_to_Key(event.key.keysym.sym)));
 							}
 							else if(event.key.state == SDL_RELEASED)
 							{
-								Keyboard::handleKeyRelease(Keyboard_SDLK_to_Key(event.key.keysym.sym));
+								handleInputEvent(InputRecorder::Event(InputRecorder::EventType::KEY_RELEASE, -1, 0, (Int64)Keyboard_SDLK_to_Key(event.key.keysym.sym)));
 							}
 						}
 						break;
 						
 						case SDL_TEXTINPUT:
 						{
-							Keyboard::handleTextInput(event.text.text);
+							InputRecorder::Event inputEvent(InputRecorder::EventType::TEXT_INPUT);
+							inputEvent.text = event.text.text;
+							handleInputEvent(inputEvent);
 						}
 						break;
 						
@@ -242,6 +416,14 @@ namespace fgl
 			
 			if(updateInputs)
 			{
+				//replayed events are sent at the same point in the frame as live events
+				InputRecorder::Event replayedEvent;
+				while(InputRecorder::nextReplayEvent(&replayedEvent))
+				{
+					handleInputEvent(replayedEvent, true);
+				}
+				InputRecorder::endFrame();
+				
 				Keyboard::update();
 				Mouse::update();
 				Multitouch::update();
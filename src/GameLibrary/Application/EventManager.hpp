@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <GameLibrary/Types.hpp>
+#include <GameLibrary/Input/InputRecorder.hpp>
 #include <GameLibrary/Utilities/ArrayList.hpp>
 
 struct SDL_Window;
@@ -28,9 +29,18 @@ namespace fgl
 		static void addWindow(Window*window);
 		static void removeWindow(Window*window);
 		
+		/*! Records an input event if input is being recorded, and sends it to Keyboard, Mouse or Multitouch. Live events are ignored while a log is being replayed.*/
+		static void handleInputEvent(const InputRecorder::Event& event, bool replayed=false);
+		
 	public:
 		/*! Polls all queued events*/
 		static void update(bool updateInputs=true);
 		static bool recievedQuitRequest();
+		/*! Waits until an event is queued, a task is scheduled on the main thread, or a timeout passes. The event is left in the queue for update to handle.
+			\param timeoutMilliseconds the longest time to wait, or a negative value to wait with no timeout
+			\returns true if an event or task is waiting, or false if the timeout passed*/
+		static bool waitForEvent(long long timeoutMilliseconds);
+		/*! Wakes the main thread if it's waiting in waitForEvent. Can be called from any thread.*/
+		static void wake();
 	};
 }
@@ -0,0 +1,227 @@
+#include <GameLibrary/Application/FramePacer.hpp>
+#include <GameLibrary/Exception/IllegalArgumentException.hpp>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace fgl
+{
+	constexpr Int64 FramePacer::Histogram::BUCKET_NANOSECONDS;
+	constexpr size_t FramePacer::Histogram::BUCKET_COUNT;
+	constexpr Int64 FramePacer::DEFAULT_SPIN_NANOSECONDS;
+
+	// how much each new frame delta moves the smoothed frame delta
+	static const double FramePacer_smoothingFactor = 0.1;
+
+	FramePacer::Histogram::Histogram()
+	{
+		clear();
+	}
+
+	void FramePacer::Histogram::add(Int64 nanoseconds)
+	{
+		size_t index = 0;
+		if(nanoseconds > 0)
+		{
+			index = (size_t)(nanoseconds / BUCKET_NANOSECONDS);
+			if(index >= BUCKET_COUNT)
+			{
+				index = BUCKET_COUNT - 1;
+			}
+		}
+		counts[index]++;
+		totalCount++;
+	}
+
+	void FramePacer::Histogram::clear()
+	{
+		for(size_t i=0; i<BUCKET_COUNT; i++)
+		{
+			counts[i] = 0;
+		}
+		totalCount = 0;
+	}
+
+	size_t FramePacer::Histogram::getCount(size_t index) const
+	{
+		if(index >= BUCKET_COUNT)
+		{
+			throw IllegalArgumentException("index", "out of bounds");
+		}
+		return counts[index];
+	}
+
+	size_t FramePacer::Histogram::getTotalCount() const
+	{
+		return totalCount;
+	}
+
+	Int64 FramePacer::Histogram::getPercentile(double fraction) const
+	{
+		if(totalCount == 0)
+		{
+			return 0;
+		}
+		size_t target = (size_t)std::ceil(fraction * (double)totalCount);
+		if(target == 0)
+		{
+			target = 1;
+		}
+		size_t count = 0;
+		for(size_t i=0; i<BUCKET_COUNT; i++)
+		{
+			count += counts[i];
+			if(count >= target)
+			{
+				return (Int64)(i+1) * BUCKET_NANOSECONDS;
+			}
+		}
+		return (Int64)BUCKET_COUNT * BUCKET_NANOSECONDS;
+	}
+
+
+
+	FramePacer::FramePacer(double fps)
+		: spinNanoseconds(DEFAULT_SPIN_NANOSECONDS),
+		frameStartTime(0)
+	{
+		setTargetFPS(fps);
+		reset();
+	}
+
+	void FramePacer::setTargetFPS(double fps_arg)
+	{
+		if(fps_arg < 0)
+		{
+			throw IllegalArgumentException("fps", "cannot be negative");
+		}
+		fps = fps_arg;
+		if(fps > 0)
+		{
+			frameNanoseconds = (Int64)std::llround(1000000000.0 / fps);
+		}
+		else
+		{
+			frameNanoseconds = 0;
+		}
+		deadline = frameStartTime;
+	}
+
+	double FramePacer::getTargetFPS() const
+	{
+		return fps;
+	}
+
+	void FramePacer::setSpinTime(Int64 nanoseconds)
+	{
+		if(nanoseconds < 0)
+		{
+			throw IllegalArgumentException("nanoseconds", "cannot be negative");
+		}
+		spinNanoseconds = nanoseconds;
+	}
+
+	Int64 FramePacer::getSpinTime() const
+	{
+		return spinNanoseconds;
+	}
+
+	void FramePacer::reset()
+	{
+		frameStartTime = 0;
+		deadline = 0;
+		frameDelta = 0;
+		smoothedFrameDelta = (double)frameNanoseconds / 1000000000.0;
+		histogram.clear();
+		lateFrameCount = 0;
+	}
+
+	void FramePacer::beginFrame()
+	{
+		Int64 time = now();
+		if(frameStartTime == 0)
+		{
+			deadline = time;
+		}
+		else
+		{
+			frameDelta = time - frameStartTime;
+			histogram.add(frameDelta);
+			double seconds = (double)frameDelta / 1000000000.0;
+			if(histogram.getTotalCount() == 1)
+			{
+				smoothedFrameDelta = seconds;
+			}
+			else
+			{
+				smoothedFrameDelta += (seconds - smoothedFrameDelta) * FramePacer_smoothingFactor;
+			}
+		}
+		frameStartTime = time;
+	}
+
+	void FramePacer::waitForNextFrame()
+	{
+		Int64 time = now();
+		if(frameNanoseconds == 0)
+		{
+			deadline = time;
+			return;
+		}
+		deadline += frameNanoseconds;
+		if(time >= deadline)
+		{
+			lateFrameCount++;
+			if((time - deadline) >= frameNanoseconds)
+			{
+				// too far behind to catch up, so start counting from now
+				deadline = time;
+			}
+			return;
+		}
+		Int64 remaining = deadline - time;
+		if(remaining > spinNanoseconds)
+		{
+			std::this_thread::sleep_for(std::chrono::nanoseconds(remaining - spinNanoseconds));
+		}
+		while(now() < deadline)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	void FramePacer::resume()
+	{
+		frameStartTime = 0;
+		frameDelta = frameNanoseconds;
+	}
+
+	double FramePacer::getFrameDelta() const
+	{
+		if(histogram.getTotalCount() == 0)
+		{
+			return (double)frameNanoseconds / 1000000000.0;
+		}
+		return (double)frameDelta / 1000000000.0;
+	}
+
+	double FramePacer::getSmoothedFrameDelta() const
+	{
+		return smoothedFrameDelta;
+	}
+
+	const FramePacer::Histogram& FramePacer::getHistogram() const
+	{
+		return histogram;
+	}
+
+	size_t FramePacer::getLateFrameCount() const
+	{
+		return lateFrameCount;
+	}
+
+	Int64 FramePacer::now()
+	{
+		return (Int64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
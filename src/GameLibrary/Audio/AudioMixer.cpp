@@ -0,0 +1,710 @@
+
+#include <GameLibrary/Audio/AudioMixer.hpp>
+#include <GameLibrary/Exception/IllegalArgumentException.hpp>
+#include <GameLibrary/IO/FileTools.hpp>
+#include <SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#define AUDIOMIXER_SSE2
+	#include <emmintrin.h>
+#endif
+
+namespace fgl
+{
+	const unsigned int AudioMixer::SAMPLE_RATE = 48000;
+	const unsigned int AudioMixer::CHANNELS = 2;
+
+	// the number of source frames read from a music file at a time
+	static const size_t AudioMixer_streamChunkFrames = 4096;
+	// the number of floats in a music ring buffer. a power of two, just over a second of audio
+	static const size_t AudioMixer_streamRingSize = 131072;
+	// how often the streamer checks whether its ring buffers need filling
+	static const std::chrono::milliseconds AudioMixer_streamerInterval = std::chrono::milliseconds(10);
+
+	struct AudioMixerCommand : public MPSCQueueNode
+	{
+		enum Type
+		{
+			PLAY,
+			STOP,
+			SET_GAIN,
+			SET_PAN,
+			STOP_ALL,
+			PLAY_MUSIC,
+			STOP_MUSIC,
+			SET_MUSIC_GAIN,
+			SET_MASTER_GAIN
+		};
+
+		AudioMixerCommand(Type type, Uint32 voiceID=0, float value=0)
+			: type(type), voiceID(voiceID), value(value), pan(0), loop(false), sound(nullptr), stream(nullptr) {
+			//
+		}
+
+		Type type;
+		Uint32 voiceID;
+		float value;
+		float pan;
+		bool loop;
+		const Sound* sound;
+		AudioMixerStream* stream;
+	};
+
+	struct AudioMixerVoice
+	{
+		// 0 if the voice is free
+		Uint32 id;
+		const Sound* sound;
+		size_t position;
+		bool loop;
+		bool stopping;
+		float gain;
+		float pan;
+		// the gains of each channel at the end of the last mixed block
+		float gainLeft;
+		float gainRight;
+	};
+
+	// a music track being read by the streamer thread into a ring buffer, and read out by the audio thread
+	struct AudioMixerStream
+	{
+		AudioMixerStream()
+			: file(nullptr), converter(nullptr), remaining(0), loop(false), endOfFile(false), ring(AudioMixer_streamRingSize, 0.0f),
+			readPosition(0), writePosition(0), finished(false), released(false) {
+			//
+		}
+
+		~AudioMixerStream()
+		{
+			if(converter != nullptr)
+			{
+				SDL_FreeAudioStream(converter);
+			}
+			if(file != nullptr)
+			{
+				FileTools::closeFile(file);
+			}
+		}
+
+		// only touched by the streamer thread, once the stream has started
+		FILE* file;
+		SDL_AudioStream* converter;
+		Music::Format format;
+		Uint64 remaining;
+		bool loop;
+		bool endOfFile;
+		std::vector<Uint8> chunk;
+		std::vector<float> converted;
+
+		// positions only ever increase, and are wrapped into the ring when indexing it
+		std::vector<float> ring;
+		std::atomic<size_t> readPosition;
+		std::atomic<size_t> writePosition;
+		// set by the streamer once the whole track is in the ring
+		std::atomic<bool> finished;
+		// set by the audio thread once it won't read the ring again
+		std::atomic<bool> released;
+	};
+
+
+
+	// adds stereo samples to the output, while moving each channel's gain by a fixed step per frame
+	void AudioMixer_mixStereo(float* output, const float* input, size_t frames, float gainLeft, float gainRight, float stepLeft, float stepRight)
+	{
+		size_t i = 0;
+		#if defined(AUDIOMIXER_SSE2)
+			if(frames >= 2)
+			{
+				// two frames per vector
+				__m128 gains = _mm_setr_ps(gainLeft, gainRight, gainLeft + stepLeft, gainRight + stepRight);
+				__m128 steps = _mm_setr_ps(stepLeft*2.0f, stepRight*2.0f, stepLeft*2.0f, stepRight*2.0f);
+				size_t pairs = frames / 2;
+				for(size_t j=0; j<pairs; j++)
+				{
+					__m128 samples = _mm_loadu_ps(input + (j * 4));
+					__m128 mixed = _mm_loadu_ps(output + (j * 4));
+					_mm_storeu_ps(output + (j * 4), _mm_add_ps(mixed, _mm_mul_ps(samples, gains)));
+					gains = _mm_add_ps(gains, steps);
+				}
+				i = pairs * 2;
+				gainLeft += stepLeft * (float)i;
+				gainRight += stepRight * (float)i;
+			}
+		#endif
+		for(; i<frames; i++)
+		{
+			output[i*2] += input[i*2] * gainLeft;
+			output[(i*2)+1] += input[(i*2)+1] * gainRight;
+			gainLeft += stepLeft;
+			gainRight += stepRight;
+		}
+	}
+
+	// scales every sample by the master gain, and clamps it to the range of the device
+	void AudioMixer_finish(float* output, size_t count, float gain)
+	{
+		size_t i = 0;
+		#if defined(AUDIOMIXER_SSE2)
+			__m128 gains = _mm_set1_ps(gain);
+			__m128 minimum = _mm_set1_ps(-1.0f);
+			__m128 maximum = _mm_set1_ps(1.0f);
+			for(; (i+4)<=count; i+=4)
+			{
+				__m128 samples = _mm_mul_ps(_mm_loadu_ps(output + i), gains);
+				_mm_storeu_ps(output + i, _mm_min_ps(_mm_max_ps(samples, minimum), maximum));
+			}
+		#endif
+		for(; i<count; i++)
+		{
+			output[i] = std::min(std::max(output[i] * gain, -1.0f), 1.0f);
+		}
+	}
+
+	// constant power panning, so that a sound is equally loud at any position
+	void AudioMixer_panGains(float gain, float pan, float& left, float& right)
+	{
+		float angle = (std::min(std::max(pan, -1.0f), 1.0f) + 1.0f) * 0.785398163f;
+		left = gain * std::cos(angle);
+		right = gain * std::sin(angle);
+	}
+
+	void AudioMixer_callback(void* userdata, Uint8* stream, int length)
+	{
+		AudioMixer* mixer = (AudioMixer*)userdata;
+		mixer->mix((float*)stream, (size_t)length / (sizeof(float) * AudioMixer::CHANNELS));
+	}
+
+	// converts the next part of a track into its ring buffer. returns false if the ring is full or the track has ended
+	bool AudioMixer_fillStream(AudioMixerStream* stream)
+	{
+		if(stream->finished.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+		size_t writePosition = stream->writePosition.load(std::memory_order_relaxed);
+		size_t space = stream->ring.size() - (writePosition - stream->readPosition.load(std::memory_order_acquire));
+		size_t available = (size_t)SDL_AudioStreamAvailable(stream->converter) / sizeof(float);
+		if(available == 0)
+		{
+			if(stream->endOfFile)
+			{
+				stream->finished.store(true, std::memory_order_release);
+				return false;
+			}
+			size_t frameSize = (SDL_AUDIO_BITSIZE(stream->format.sampleFormat) / 8) * stream->format.channels;
+			size_t readSize = (size_t)std::min<Uint64>(stream->remaining, AudioMixer_streamChunkFrames * frameSize);
+			size_t bytesRead = std::fread(stream->chunk.data(), 1, readSize, stream->file);
+			bytesRead -= bytesRead % frameSize;
+			stream->remaining -= bytesRead;
+			if(bytesRead > 0 && SDL_AudioStreamPut(stream->converter, stream->chunk.data(), (int)bytesRead) != 0)
+			{
+				bytesRead = 0;
+			}
+			if(bytesRead == 0 || stream->remaining == 0)
+			{
+				if(bytesRead > 0 && stream->loop && std::fseek(stream->file, (long)stream->format.dataOffset, SEEK_SET) == 0)
+				{
+					stream->remaining = stream->format.dataSize;
+				}
+				else
+				{
+					SDL_AudioStreamFlush(stream->converter);
+					stream->endOfFile = true;
+				}
+			}
+			return true;
+		}
+		// only whole frames are written, so the audio thread never reads half of one
+		size_t count = std::min(std::min(space, available), stream->converted.size());
+		count -= count % AudioMixer::CHANNELS;
+		if(count == 0)
+		{
+			return false;
+		}
+		int received = SDL_AudioStreamGet(stream->converter, stream->converted.data(), (int)(count * sizeof(float)));
+		if(received <= 0)
+		{
+			stream->finished.store(true, std::memory_order_release);
+			return false;
+		}
+		count = (size_t)received / sizeof(float);
+		size_t mask = stream->ring.size() - 1;
+		for(size_t i=0; i<count; i++)
+		{
+			stream->ring[(writePosition + i) & mask] = stream->converted[i];
+		}
+		stream->writePosition.store(writePosition + count, std::memory_order_release);
+		return true;
+	}
+
+
+
+	AudioMixer::AudioMixer(size_t maxVoices_arg)
+		: device(0),
+		voices(nullptr),
+		maxVoices(maxVoices_arg),
+		music(nullptr),
+		musicGain(1.0f),
+		musicTargetGain(1.0f),
+		masterGain(1.0f),
+		nextVoiceID(1),
+		activeVoiceCount(0),
+		streamerRunning(false)
+	{
+		if(maxVoices == 0)
+		{
+			throw IllegalArgumentException("maxVoices", "must be greater than 0");
+		}
+		voices = new AudioMixerVoice[maxVoices];
+		std::memset(voices, 0, sizeof(AudioMixerVoice) * maxVoices);
+	}
+
+	AudioMixer::~AudioMixer()
+	{
+		close();
+		if(streamerThread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(streamerMutex);
+				streamerRunning = false;
+			}
+			streamerCondition.notify_all();
+			streamerThread.join();
+		}
+		for(auto stream : streams)
+		{
+			delete stream;
+		}
+		while(AudioMixerCommand* command = commands.pop())
+		{
+			delete command;
+		}
+		while(AudioMixerCommand* command = retiredCommands.pop())
+		{
+			delete command;
+		}
+		delete[] voices;
+	}
+
+	bool AudioMixer::open(unsigned int bufferFrames, String* error)
+	{
+		if(device != 0)
+		{
+			return true;
+		}
+		if(!SDL_WasInit(SDL_INIT_AUDIO) && SDL_InitSubSystem(SDL_INIT_AUDIO) != 0)
+		{
+			if(error != nullptr)
+			{
+				*error = SDL_GetError();
+			}
+			return false;
+		}
+		SDL_AudioSpec desired;
+		std::memset(&desired, 0, sizeof(desired));
+		desired.freq = (int)SAMPLE_RATE;
+		desired.format = AUDIO_F32SYS;
+		desired.channels = (Uint8)CHANNELS;
+		desired.samples = (Uint16)bufferFrames;
+		desired.callback = &AudioMixer_callback;
+		desired.userdata = this;
+		SDL_AudioSpec obtained;
+		// SDL converts to the device's format after the callback, so the mix is always in the same format
+		device = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained, 0);
+		if(device == 0)
+		{
+			if(error != nullptr)
+			{
+				*error = SDL_GetError();
+			}
+			return false;
+		}
+		SDL_PauseAudioDevice(device, 0);
+		return true;
+	}
+
+	void AudioMixer::close()
+	{
+		if(device != 0)
+		{
+			// waits for the callback to return
+			SDL_CloseAudioDevice(device);
+			device = 0;
+		}
+	}
+
+	bool AudioMixer::isOpen() const
+	{
+		return (device != 0);
+	}
+
+	Uint32 AudioMixer::play(const Sound* sound, float gain, float pan, bool loop)
+	{
+		if(sound == nullptr)
+		{
+			throw IllegalArgumentException("sound", "cannot be null");
+		}
+		Uint32 voiceID = nextVoiceID.fetch_add(1, std::memory_order_relaxed);
+		if(voiceID == 0)
+		{
+			voiceID = nextVoiceID.fetch_add(1, std::memory_order_relaxed);
+		}
+		AudioMixerCommand* command = new AudioMixerCommand(AudioMixerCommand::PLAY, voiceID, gain);
+		command->sound = sound;
+		command->pan = pan;
+		command->loop = loop;
+		pushCommand(command);
+		return voiceID;
+	}
+
+	void AudioMixer::stop(Uint32 voiceID)
+	{
+		pushCommand(new AudioMixerCommand(AudioMixerCommand::STOP, voiceID));
+	}
+
+	void AudioMixer::setGain(Uint32 voiceID, float gain)
+	{
+		pushCommand(new AudioMixerCommand(AudioMixerCommand::SET_GAIN, voiceID, gain));
+	}
+
+	void AudioMixer::setPan(Uint32 voiceID, float pan)
+	{
+		pushCommand(new AudioMixerCommand(AudioMixerCommand::SET_PAN, voiceID, pan));
+	}
+
+	void AudioMixer::stopAll()
+	{
+		pushCommand(new AudioMixerCommand(AudioMixerCommand::STOP_ALL));
+	}
+
+	bool AudioMixer::playMusic(const Music* music_arg, float gain, bool loop, String* error)
+	{
+		if(music_arg == nullptr)
+		{
+			throw IllegalArgumentException("music", "cannot be null");
+		}
+		else if(!music_arg->isOpen())
+		{
+			throw IllegalArgumentException("music", "has not been opened");
+		}
+		const Music::Format& format = music_arg->getFormat();
+		AudioMixerStream* stream = new AudioMixerStream();
+		stream->format = format;
+		stream->remaining = format.dataSize;
+		stream->loop = loop;
+		stream->file = FileTools::openFile(music_arg->getPath(), "rb", error);
+		if(stream->file == nullptr)
+		{
+			delete stream;
+			return false;
+		}
+		stream->converter = SDL_NewAudioStream(format.sampleFormat, (Uint8)format.channels, (int)format.sampleRate, AUDIO_F32SYS, (Uint8)CHANNELS, (int)SAMPLE_RATE);
+		if(stream->converter == nullptr || std::fseek(stream->file, (long)format.dataOffset, SEEK_SET) != 0)
+		{
+			if(error != nullptr)
+			{
+				*error = (stream->converter == nullptr) ? (String)SDL_GetError() : (String)"Unable to seek to the start of the music";
+			}
+			delete stream;
+			return false;
+		}
+		size_t frameSize = (SDL_AUDIO_BITSIZE(format.sampleFormat) / 8) * format.channels;
+		stream->chunk.resize(AudioMixer_streamChunkFrames * frameSize);
+		stream->converted.resize(AudioMixer_streamChunkFrames * CHANNELS);
+
+		// read the start of the track here, since the streamer can't see the stream yet
+		while(stream->writePosition.load(std::memory_order_relaxed) < (AudioMixer_streamChunkFrames * CHANNELS) && AudioMixer_fillStream(stream))
+		{
+			//
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(streamerMutex);
+			streams.push_back(stream);
+			if(!streamerRunning)
+			{
+				streamerRunning = true;
+				streamerThread = std::thread([=]{
+					runStreamer();
+				});
+			}
+		}
+		streamerCondition.notify_all();
+
+		pushCommand(new AudioMixerCommand(AudioMixerCommand::SET_MUSIC_GAIN, 0, gain));
+		AudioMixerCommand* command = new AudioMixerCommand(AudioMixerCommand::PLAY_MUSIC);
+		command->stream = stream;
+		pushCommand(command);
+		return true;
+	}
+
+	void AudioMixer::stopMusic()
+	{
+		pushCommand(new AudioMixerCommand(AudioMixerCommand::STOP_MUSIC));
+	}
+
+	void AudioMixer::setMusicGain(float gain)
+	{
+		pushCommand(new AudioMixerCommand(AudioMixerCommand::SET_MUSIC_GAIN, 0, gain));
+	}
+
+	void AudioMixer::setMasterGain(float gain)
+	{
+		pushCommand(new AudioMixerCommand(AudioMixerCommand::SET_MASTER_GAIN, 0, gain));
+	}
+
+	void AudioMixer::mix(float* output, size_t frames)
+	{
+		while(AudioMixerCommand* command = commands.pop())
+		{
+			applyCommand(command);
+			// the game thread frees it, so that the audio thread never calls into the allocator
+			retiredCommands.push(command);
+		}
+
+		std::memset(output, 0, sizeof(float) * CHANNELS * frames);
+		if(frames == 0)
+		{
+			return;
+		}
+		float blockScale = 1.0f / (float)frames;
+
+		size_t activeCount = 0;
+		for(size_t i=0; i<maxVoices; i++)
+		{
+			AudioMixerVoice& voice = voices[i];
+			if(voice.id == 0)
+			{
+				continue;
+			}
+			const float* samples = voice.sound->getSamples();
+			size_t frameCount = voice.sound->getFrameCount();
+			if(samples == nullptr || voice.position >= frameCount)
+			{
+				voice.id = 0;
+				continue;
+			}
+			activeCount++;
+			float targetLeft = 0;
+			float targetRight = 0;
+			if(!voice.stopping)
+			{
+				AudioMixer_panGains(voice.gain, voice.pan, targetLeft, targetRight);
+			}
+			float stepLeft = (targetLeft - voice.gainLeft) * blockScale;
+			float stepRight = (targetRight - voice.gainRight) * blockScale;
+			size_t mixed = 0;
+			while(mixed < frames)
+			{
+				size_t count = std::min(frames - mixed, frameCount - voice.position);
+				AudioMixer_mixStereo(output + (mixed * CHANNELS), samples + (voice.position * CHANNELS), count,
+					voice.gainLeft + (stepLeft * (float)mixed), voice.gainRight + (stepRight * (float)mixed), stepLeft, stepRight);
+				mixed += count;
+				voice.position += count;
+				if(voice.position >= frameCount)
+				{
+					if(!voice.loop)
+					{
+						break;
+					}
+					voice.position = 0;
+				}
+			}
+			voice.gainLeft = targetLeft;
+			voice.gainRight = targetRight;
+			if(voice.stopping || voice.position >= frameCount)
+			{
+				voice.id = 0;
+			}
+		}
+
+		if(music != nullptr)
+		{
+			size_t readPosition = music->readPosition.load(std::memory_order_relaxed);
+			bool finished = music->finished.load(std::memory_order_acquire);
+			size_t available = music->writePosition.load(std::memory_order_acquire) - readPosition;
+			size_t count = std::min(available / CHANNELS, frames);
+			float step = (musicTargetGain - musicGain) * blockScale;
+			size_t mask = music->ring.size() - 1;
+			size_t start = readPosition & mask;
+			// the ring holds a whole number of frames, so a frame never wraps around the end
+			size_t firstCount = std::min(count, (music->ring.size() - start) / CHANNELS);
+			AudioMixer_mixStereo(output, music->ring.data() + start, firstCount, musicGain, musicGain, step, step);
+			AudioMixer_mixStereo(output + (firstCount * CHANNELS), music->ring.data(), count - firstCount,
+				musicGain + (step * (float)firstCount), musicGain + (step * (float)firstCount), step, step);
+			music->readPosition.store(readPosition + (count * CHANNELS), std::memory_order_release);
+			musicGain = musicTargetGain;
+			if(finished && count == (available / CHANNELS))
+			{
+				releaseMusic();
+			}
+		}
+
+		AudioMixer_finish(output, frames * CHANNELS, masterGain);
+		activeVoiceCount.store(activeCount, std::memory_order_relaxed);
+	}
+
+	size_t AudioMixer::getActiveVoiceCount() const
+	{
+		return activeVoiceCount.load(std::memory_order_relaxed);
+	}
+
+	size_t AudioMixer::getMaxVoices() const
+	{
+		return maxVoices;
+	}
+
+	void AudioMixer::pushCommand(AudioMixerCommand* command)
+	{
+		{
+			std::lock_guard<std::mutex> lock(retiredMutex);
+			while(AudioMixerCommand* retired = retiredCommands.pop())
+			{
+				delete retired;
+			}
+		}
+		commands.push(command);
+	}
+
+	void AudioMixer::applyCommand(AudioMixerCommand* command)
+	{
+		switch(command->type)
+		{
+			case AudioMixerCommand::PLAY:
+			for(size_t i=0; i<maxVoices; i++)
+			{
+				AudioMixerVoice& voice = voices[i];
+				if(voice.id == 0)
+				{
+					voice.id = command->voiceID;
+					voice.sound = command->sound;
+					voice.position = 0;
+					voice.loop = command->loop;
+					voice.stopping = false;
+					voice.gain = command->value;
+					voice.pan = command->pan;
+					// start at full volume rather than fading in, so that the attack of the sound is kept
+					AudioMixer_panGains(voice.gain, voice.pan, voice.gainLeft, voice.gainRight);
+					break;
+				}
+			}
+			break;
+
+			case AudioMixerCommand::STOP:
+			if(AudioMixerVoice* voice = findVoice(command->voiceID))
+			{
+				voice->stopping = true;
+			}
+			break;
+
+			case AudioMixerCommand::SET_GAIN:
+			if(AudioMixerVoice* voice = findVoice(command->voiceID))
+			{
+				voice->gain = command->value;
+			}
+			break;
+
+			case AudioMixerCommand::SET_PAN:
+			if(AudioMixerVoice* voice = findVoice(command->voiceID))
+			{
+				voice->pan = command->value;
+			}
+			break;
+
+			case AudioMixerCommand::STOP_ALL:
+			for(size_t i=0; i<maxVoices; i++)
+			{
+				voices[i].stopping = true;
+			}
+			break;
+
+			case AudioMixerCommand::PLAY_MUSIC:
+			releaseMusic();
+			music = command->stream;
+			break;
+
+			case AudioMixerCommand::STOP_MUSIC:
+			releaseMusic();
+			break;
+
+			case AudioMixerCommand::SET_MUSIC_GAIN:
+			musicTargetGain = command->value;
+			if(music == nullptr)
+			{
+				musicGain = command->value;
+			}
+			break;
+
+			case AudioMixerCommand::SET_MASTER_GAIN:
+			masterGain = command->value;
+			break;
+		}
+	}
+
+	AudioMixerVoice* AudioMixer::findVoice(Uint32 voiceID)
+	{
+		if(voiceID == 0)
+		{
+			return nullptr;
+		}
+		for(size_t i=0; i<maxVoices; i++)
+		{
+			if(voices[i].id == voiceID)
+			{
+				return &voices[i];
+			}
+		}
+		return nullptr;
+	}
+
+	void AudioMixer::releaseMusic()
+	{
+		if(music != nullptr)
+		{
+			// the streamer deletes the stream once it sees this
+			music->released.store(true, std::memory_order_release);
+			music = nullptr;
+		}
+	}
+
+	void AudioMixer::runStreamer()
+	{
+		std::vector<AudioMixerStream*> filling;
+		std::unique_lock<std::mutex> lock(streamerMutex);
+		while(streamerRunning)
+		{
+			filling.clear();
+			for(auto it=streams.begin(); it!=streams.end();)
+			{
+				AudioMixerStream* stream = *it;
+				if(stream->released.load(std::memory_order_acquire))
+				{
+					delete stream;
+					it = streams.erase(it);
+					continue;
+				}
+				filling.push_back(stream);
+				++it;
+			}
+			// streams are only deleted by this thread, so they can be read from the disk without holding the lock
+			lock.unlock();
+			for(auto stream : filling)
+			{
+				while(AudioMixer_fillStream(stream))
+				{
+					//
+				}
+			}
+			lock.lock();
+			if(streamerRunning)
+			{
+				streamerCondition.wait_for(lock, AudioMixer_streamerInterval);
+			}
+		}
+	}
+}
@@ -0,0 +1,177 @@
+
+#include <GameLibrary/Audio/Music.hpp>
+#include <GameLibrary/IO/FileTools.hpp>
+#include <SDL.h>
+#include <cstring>
+
+namespace fgl
+{
+	Uint32 Music_readUint32(const Uint8* bytes)
+	{
+		return (Uint32)bytes[0] | ((Uint32)bytes[1] << 8) | ((Uint32)bytes[2] << 16) | ((Uint32)bytes[3] << 24);
+	}
+
+	Uint16 Music_readUint16(const Uint8* bytes)
+	{
+		return (Uint16)((Uint16)bytes[0] | ((Uint16)bytes[1] << 8));
+	}
+
+	bool Music_fail(const char* message, String* error)
+	{
+		if(error != nullptr)
+		{
+			*error = message;
+		}
+		return false;
+	}
+
+	// reads the fmt and data chunks of a RIFF WAVE file
+	bool Music_readHeader(FILE* file, Music::Format& format, String* error)
+	{
+		Uint8 header[12];
+		if(std::fread(header, 1, 12, file) != 12 || std::memcmp(header, "RIFF", 4) != 0 || std::memcmp(header+8, "WAVE", 4) != 0)
+		{
+			return Music_fail("File is not a WAV file", error);
+		}
+		bool foundFormat = false;
+		Uint64 offset = 12;
+		Uint8 chunkHeader[8];
+		while(std::fread(chunkHeader, 1, 8, file) == 8)
+		{
+			Uint32 chunkSize = Music_readUint32(chunkHeader+4);
+			offset += 8;
+			if(std::memcmp(chunkHeader, "fmt ", 4) == 0)
+			{
+				Uint8 fmt[40];
+				if(chunkSize < 16 || chunkSize > sizeof(fmt) || std::fread(fmt, 1, chunkSize, file) != chunkSize)
+				{
+					return Music_fail("Invalid WAV format chunk", error);
+				}
+				Uint16 encoding = Music_readUint16(fmt);
+				Uint16 bits = Music_readUint16(fmt+14);
+				if(encoding == 0xFFFE && chunkSize >= 26)
+				{
+					// WAVE_FORMAT_EXTENSIBLE stores the encoding at the start of the sub-format GUID
+					encoding = Music_readUint16(fmt+24);
+				}
+				format.channels = Music_readUint16(fmt+2);
+				format.sampleRate = Music_readUint32(fmt+4);
+				if(encoding == 1 && bits == 8)
+				{
+					format.sampleFormat = AUDIO_U8;
+				}
+				else if(encoding == 1 && bits == 16)
+				{
+					format.sampleFormat = AUDIO_S16LSB;
+				}
+				else if(encoding == 1 && bits == 32)
+				{
+					format.sampleFormat = AUDIO_S32LSB;
+				}
+				else if(encoding == 3 && bits == 32)
+				{
+					format.sampleFormat = AUDIO_F32LSB;
+				}
+				else
+				{
+					return Music_fail("Unsupported WAV sample format", error);
+				}
+				if(format.channels == 0 || format.channels > 8 || format.sampleRate == 0)
+				{
+					return Music_fail("Invalid WAV format chunk", error);
+				}
+				foundFormat = true;
+			}
+			else if(std::memcmp(chunkHeader, "data", 4) == 0)
+			{
+				if(!foundFormat)
+				{
+					return Music_fail("WAV data chunk comes before the format chunk", error);
+				}
+				format.dataOffset = offset;
+				format.dataSize = chunkSize;
+				// streams that were cut short still play up to the end of the file
+				if(std::fseek(file, 0, SEEK_END) == 0)
+				{
+					long fileSize = std::ftell(file);
+					if(fileSize >= 0 && (Uint64)fileSize < (offset + chunkSize))
+					{
+						format.dataSize = (Uint64)fileSize - offset;
+					}
+				}
+				size_t frameSize = (SDL_AUDIO_BITSIZE(format.sampleFormat) / 8) * format.channels;
+				format.dataSize -= format.dataSize % frameSize;
+				return true;
+			}
+			else if(std::fseek(file, (long)chunkSize, SEEK_CUR) != 0)
+			{
+				break;
+			}
+			// chunks are padded to an even size
+			if((chunkSize % 2) == 1 && std::fseek(file, 1, SEEK_CUR) != 0)
+			{
+				break;
+			}
+			offset += chunkSize + (chunkSize % 2);
+		}
+		return Music_fail("WAV file has no data chunk", error);
+	}
+
+	Music::Music()
+		: opened(false)
+	{
+		std::memset(&format, 0, sizeof(format));
+	}
+
+	bool Music::openFromPath(const String& path_arg, String* error)
+	{
+		FILE* file = FileTools::openFile(path_arg, "rb", error);
+		if(file == nullptr)
+		{
+			return false;
+		}
+		Format newFormat;
+		bool success = Music_readHeader(file, newFormat, error);
+		FileTools::closeFile(file);
+		if(!success)
+		{
+			return false;
+		}
+		path = path_arg;
+		format = newFormat;
+		opened = true;
+		return true;
+	}
+
+	void Music::close()
+	{
+		path = "";
+		std::memset(&format, 0, sizeof(format));
+		opened = false;
+	}
+
+	bool Music::isOpen() const
+	{
+		return opened;
+	}
+
+	const String& Music::getPath() const
+	{
+		return path;
+	}
+
+	const Music::Format& Music::getFormat() const
+	{
+		return format;
+	}
+
+	double Music::getDuration() const
+	{
+		if(!opened)
+		{
+			return 0;
+		}
+		size_t frameSize = (SDL_AUDIO_BITSIZE(format.sampleFormat) / 8) * format.channels;
+		return (double)(format.dataSize / frameSize) / (double)format.sampleRate;
+	}
+}
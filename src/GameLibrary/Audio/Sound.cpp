@@ -0,0 +1,129 @@
+
+#include <GameLibrary/Audio/Sound.hpp>
+#include <GameLibrary/Audio/AudioMixer.hpp>
+#include "../SDL_ext/SDL_RWops_ext.hpp"
+#include <SDL.h>
+#include <climits>
+
+namespace fgl
+{
+	// decodes WAV data and converts it to the mixer's format
+	bool Sound_decode(SDL_RWops* rw, std::vector<float>& samples, String* error)
+	{
+		if(rw == nullptr)
+		{
+			if(error != nullptr)
+			{
+				*error = SDL_GetError();
+			}
+			return false;
+		}
+		SDL_AudioSpec spec;
+		Uint8* buffer = nullptr;
+		Uint32 length = 0;
+		if(SDL_LoadWAV_RW(rw, 1, &spec, &buffer, &length) == nullptr)
+		{
+			if(error != nullptr)
+			{
+				*error = SDL_GetError();
+			}
+			return false;
+		}
+		SDL_AudioStream* converter = SDL_NewAudioStream(spec.format, spec.channels, spec.freq, AUDIO_F32SYS, (Uint8)AudioMixer::CHANNELS, (int)AudioMixer::SAMPLE_RATE);
+		if(converter == nullptr)
+		{
+			if(error != nullptr)
+			{
+				*error = SDL_GetError();
+			}
+			SDL_FreeWAV(buffer);
+			return false;
+		}
+		bool success = (SDL_AudioStreamPut(converter, buffer, (int)length) == 0 && SDL_AudioStreamFlush(converter) == 0);
+		SDL_FreeWAV(buffer);
+		if(!success)
+		{
+			if(error != nullptr)
+			{
+				*error = SDL_GetError();
+			}
+			SDL_FreeAudioStream(converter);
+			return false;
+		}
+		size_t frameSize = sizeof(float) * AudioMixer::CHANNELS;
+		size_t available = (size_t)SDL_AudioStreamAvailable(converter) / frameSize;
+		std::vector<float> decoded;
+		decoded.resize(available * AudioMixer::CHANNELS);
+		int received = (available > 0) ? SDL_AudioStreamGet(converter, decoded.data(), (int)(available * frameSize)) : 0;
+		SDL_FreeAudioStream(converter);
+		if(received < 0)
+		{
+			if(error != nullptr)
+			{
+				*error = SDL_GetError();
+			}
+			return false;
+		}
+		decoded.resize(((size_t)received / frameSize) * AudioMixer::CHANNELS);
+		samples.swap(decoded);
+		return true;
+	}
+
+	Sound::Sound()
+	{
+		//
+	}
+
+	bool Sound::loadFromPointer(const void* pointer, size_t length, String* error)
+	{
+		if(length > (size_t)INT_MAX)
+		{
+			if(error != nullptr)
+			{
+				*error = "sound data is too large";
+			}
+			return false;
+		}
+		return Sound_decode(SDL_RWFromConstMem(pointer, (int)length), samples, error);
+	}
+
+	bool Sound::loadFromPath(const String& path, String* error)
+	{
+		return Sound_decode(SDL_RWFromFile(path, "rb"), samples, error);
+	}
+
+	bool Sound::loadFromFile(FILE* file, String* error)
+	{
+		return Sound_decode(SDL_RWFromFILE(file, SDL_FALSE), samples, error);
+	}
+
+	void Sound::create(const float* samples_arg, size_t frameCount)
+	{
+		samples.assign(samples_arg, samples_arg + (frameCount * AudioMixer::CHANNELS));
+	}
+
+	void Sound::clear()
+	{
+		samples.clear();
+		samples.shrink_to_fit();
+	}
+
+	const float* Sound::getSamples() const
+	{
+		if(samples.size() == 0)
+		{
+			return nullptr;
+		}
+		return samples.data();
+	}
+
+	size_t Sound::getFrameCount() const
+	{
+		return samples.size() / AudioMixer::CHANNELS;
+	}
+
+	double Sound::getDuration() const
+	{
+		return (double)getFrameCount() / (double)AudioMixer::SAMPLE_RATE;
+	}
+}
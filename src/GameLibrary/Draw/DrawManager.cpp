@@ -1,5 +1,6 @@
 
 #include <GameLibrary/Draw/DrawManager.hpp>
+#include <GameLibrary/Utilities/Profiler.hpp>
 
 namespace fgl
 {
@@ -47,7 +48,8 @@ namespace fgl
 	
 	
 	
-	void DrawManager::update(ApplicationData appData) {
+	void DrawManager::update(const ApplicationData& appData) {
+		FGL_PROFILE_ZONE("DrawManager::update")
 		auto tmpListeners = listeners;
 		
 		// call listener "begin" events
@@ -63,7 +65,7 @@ namespace fgl
 		}
 	}
 	
-	void DrawManager::updateDrawables(ApplicationData appData) {
+	void DrawManager::updateDrawables(const ApplicationData& appData) {
 		// open for implementation
 	}
 	
@@ -71,6 +73,7 @@ namespace fgl
 	
 	
 	void DrawManager::draw(DrawContext context, Graphics graphics) const {
+		FGL_PROFILE_ZONE("DrawManager::draw")
 		// draw drawables
 		for(auto& node : drawables) {
 			if(!shouldDraw(node.drawable)) {
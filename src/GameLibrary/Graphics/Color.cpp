@@ -94,7 +94,7 @@ namespace fgl
 		/*double x = (double)orig;
 		double n = (double)comp;
 		return (Uint8)((-n / 255) * (n - x - 255));*/
-		return (Uint8)(orig*((double)comp/255));
+		return (Uint8)(((unsigned int)orig*(unsigned int)comp)/255);
 	}
 
 	Color Color::composite(const Color& comp) const
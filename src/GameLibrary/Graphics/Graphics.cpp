@@ -1,9 +1,12 @@
 
 #include <GameLibrary/Graphics/Graphics.hpp>
+#include <GameLibrary/Graphics/RenderCommandList.hpp>
 #include <GameLibrary/Graphics/TextureImage.hpp>
 #include <GameLibrary/IO/Console.hpp>
+#include <GameLibrary/IO/Logger.hpp>
 #include <GameLibrary/Utilities/Math.hpp>
 #include <GameLibrary/Utilities/PlatformChecks.hpp>
+#include <GameLibrary/Utilities/Profiler.hpp>
 #include <GameLibrary/Utilities/Font/Font.hpp>
 #include <GameLibrary/Window/Viewport.hpp>
 #include <GameLibrary/Window/Window.hpp>
@@ -11,6 +14,8 @@
 #include <SDL.h>
 #include <SDL2_gfxPrimitives.h>
 #include <stdio.h>
+#include <new>
+#include <vector>
 
 #define WIN32_LEAN_AND_MEAN
 #if defined(TARGETPLATFORM_WINDOWS)
@@ -58,6 +63,92 @@ namespace fgl
 #endif
 	}
 
+	enum Graphics_CommandType : Uint32
+	{
+		GRAPHICS_COMMAND_BEGINDRAW,
+		GRAPHICS_COMMAND_ENDDRAW,
+		GRAPHICS_COMMAND_LINE,
+		GRAPHICS_COMMAND_POINT,
+		GRAPHICS_COMMAND_TEXTURE,
+		GRAPHICS_COMMAND_POLYGON,
+		GRAPHICS_COMMAND_GLYPHS
+	};
+
+	struct Graphics_BeginDrawCommand
+	{
+		SDL_Rect clip;
+		Color color;
+	};
+
+	struct Graphics_LineCommand
+	{
+		int x1;
+		int y1;
+		int x2;
+		int y2;
+	};
+
+	struct Graphics_PointCommand
+	{
+		int x;
+		int y;
+	};
+
+	struct Graphics_TextureCommand
+	{
+		SDL_Texture* texture;
+		SDL_Rect srcrect;
+		SDL_Rect dstrect;
+		double rotation;
+		SDL_Point center;
+		SDL_RendererFlip flip;
+		Color colormod;
+	};
+
+	//followed by the x coordinates and then the y coordinates of the points
+	struct Graphics_PolygonCommand
+	{
+		Uint32 count;
+		Color color;
+	};
+
+	//followed by the position of each glyph and then the glyph characters
+	struct Graphics_GlyphsCommand
+	{
+		Font* font;
+		unsigned int size;
+		int style;
+		Uint32 count;
+		double scaleRatio;
+		double rotation;
+		bool flipX;
+		bool flipY;
+		Color color;
+	};
+
+	void Graphics_executeBeginDraw(SDL_Renderer* renderer, const Graphics_BeginDrawCommand& command)
+	{
+		SDL_RenderSetClipRect(renderer, &command.clip);
+		SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+	}
+
+	void Graphics_executeEndDraw(SDL_Renderer* renderer)
+	{
+		SDL_SetRenderDrawColor(renderer, 0,0,0,255);
+		SDL_RenderSetClipRect(renderer, nullptr);
+	}
+
+	void Graphics_executeTexture(SDL_Renderer* renderer, const Graphics_TextureCommand& command)
+	{
+		SDL_SetTextureColorMod(command.texture, command.colormod.r, command.colormod.g, command.colormod.b);
+		SDL_SetTextureAlphaMod(command.texture, command.colormod.a);
+
+		SDL_RenderCopyEx(renderer, command.texture, &command.srcrect, &command.dstrect, command.rotation, &command.center, command.flip);
+
+		SDL_SetTextureColorMod(command.texture, 255, 255, 255);
+		SDL_SetTextureAlphaMod(command.texture, 255);
+	}
+
 	Font* Graphics::defaultFont = nullptr;
 	String Graphics::defaultFontPath = Graphics_getDefaultFontPath();
 
@@ -101,7 +192,7 @@ namespace fgl
 				{
 					renderTarget_width = 0;
 					renderTarget_height = 0;
-					Console::writeErrorLine("Unable to create texture for render target");
+					FGL_LOG_RATE_LIMITED(Logger::LEVEL_ERROR, 1000, (String)"Unable to create texture for render target: " + SDL_GetError());
 				}
 				else
 				{
@@ -234,10 +325,16 @@ namespace fgl
 			throw Exception("Cannot create Graphics object for window that is not created");
 		}
 		window = &win;
+		commandList = nullptr;
 		renderTarget = nullptr;
 		renderTarget_width = 0;
 		renderTarget_height = 0;
-		renderer = (void*)SDL_CreateRenderer(win.sdlWindow,-1,SDL_RENDERER_ACCELERATED);
+		Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+		if((SDL_GetWindowFlags(win.sdlWindow) & SDL_WINDOW_OPENGL) != SDL_WINDOW_OPENGL)
+		{
+			rendererFlags = SDL_RENDERER_SOFTWARE;
+		}
+		renderer = (void*)SDL_CreateRenderer(win.sdlWindow,-1,rendererFlags);
 		if(renderer==nullptr)
 		{
 			//TODO replace with more specific exception type
@@ -255,7 +352,7 @@ namespace fgl
 			bool success = defaultFont->loadFromPath(defaultFontPath, &error);
 			if(!success)
 			{
-				Console::writeLine("\""+defaultFontPath+"\": "+error);
+				FGL_LOG_WARNING("\""+defaultFontPath+"\": "+error);
 			}
 			defaultFont->setAntialiasing(true);
 		}
@@ -299,6 +396,7 @@ namespace fgl
 		rotation(g.rotation),
 		scaling(g.scaling),
 		transform(g.transform),
+		commandList(g.commandList),
 		derived(true)
 	{
 		//
@@ -332,11 +430,17 @@ namespace fgl
 		clip.w = (int)(clipRight - (double)clip.x);
 		clip.h = (int)(clipBottom - (double)clip.y);
 
-		Color colorComp = color.composite(tintColor);
-		byte newAlpha = (byte)(colorComp.a * alpha);
-
-		SDL_RenderSetClipRect((SDL_Renderer*)renderer, &clip);
-		SDL_SetRenderDrawColor((SDL_Renderer*)renderer, colorComp.r, colorComp.g, colorComp.b, newAlpha);
+		Graphics_BeginDrawCommand command;
+		command.clip = clip;
+		command.color = getDrawColor();
+		if(commandList != nullptr)
+		{
+			commandList->add(GRAPHICS_COMMAND_BEGINDRAW, &command, sizeof(command));
+		}
+		else
+		{
+			Graphics_executeBeginDraw((SDL_Renderer*)renderer, command);
+		}
 
 		//SDL_GLContext context = SDL_RendererGetGLContext((SDL_Renderer*)renderer);
 		//SDL_GL_MakeCurrent((SDL_Window*)window->windowdata, context);
@@ -350,8 +454,14 @@ namespace fgl
 		//SDL_GL_MakeCurrent((SDL_Window*)window->windowdata, context);
 		//glPopMatrix();
 
-		SDL_SetRenderDrawColor((SDL_Renderer*)renderer, 0,0,0,255);
-		SDL_RenderSetClipRect((SDL_Renderer*)renderer, nullptr);
+		if(commandList != nullptr)
+		{
+			commandList->add(GRAPHICS_COMMAND_ENDDRAW, nullptr, 0);
+		}
+		else
+		{
+			Graphics_executeEndDraw((SDL_Renderer*)renderer);
+		}
 	}
 
 	void* Graphics::getRenderer() const
@@ -359,6 +469,75 @@ namespace fgl
 		return renderer;
 	}
 
+	Color Graphics::getDrawColor() const
+	{
+		Color colorComp = color.composite(tintColor);
+		colorComp.a = (byte)(colorComp.a * alpha);
+		return colorComp;
+	}
+
+	bool Graphics::isRecording() const
+	{
+		return (commandList != nullptr);
+	}
+
+	void Graphics::executeCommands(const RenderCommandList& commands)
+	{
+		FGL_PROFILE_ZONE("Graphics::executeCommands")
+		SDL_Renderer* sdlRenderer = (SDL_Renderer*)renderer;
+		RenderCommandList::Command command;
+		size_t offset = 0;
+		while(commands.read(&offset, &command))
+		{
+			switch(command.type)
+			{
+				case GRAPHICS_COMMAND_BEGINDRAW:
+				Graphics_executeBeginDraw(sdlRenderer, *((const Graphics_BeginDrawCommand*)command.data));
+				break;
+
+				case GRAPHICS_COMMAND_ENDDRAW:
+				Graphics_executeEndDraw(sdlRenderer);
+				break;
+
+				case GRAPHICS_COMMAND_LINE:
+				{
+					const Graphics_LineCommand& line = *((const Graphics_LineCommand*)command.data);
+					SDL_RenderDrawLine(sdlRenderer, line.x1, line.y1, line.x2, line.y2);
+				}
+				break;
+
+				case GRAPHICS_COMMAND_POINT:
+				{
+					const Graphics_PointCommand& point = *((const Graphics_PointCommand*)command.data);
+					SDL_RenderDrawPoint(sdlRenderer, point.x, point.y);
+				}
+				break;
+
+				case GRAPHICS_COMMAND_TEXTURE:
+				Graphics_executeTexture(sdlRenderer, *((const Graphics_TextureCommand*)command.data));
+				break;
+
+				case GRAPHICS_COMMAND_POLYGON:
+				{
+					const Graphics_PolygonCommand& polygon = *((const Graphics_PolygonCommand*)command.data);
+					const Sint16* polygonX = (const Sint16*)command.extra;
+					const Sint16* polygonY = polygonX + polygon.count;
+					filledPolygonRGBA(sdlRenderer, polygonX, polygonY, (int)polygon.count, polygon.color.r, polygon.color.g, polygon.color.b, polygon.color.a);
+				}
+				break;
+
+				case GRAPHICS_COMMAND_GLYPHS:
+				{
+					const Graphics_GlyphsCommand& glyphs = *((const Graphics_GlyphsCommand*)command.data);
+					const Vector2d* positions = (const Vector2d*)command.extra;
+					const Uint16* text = (const Uint16*)(positions + glyphs.count);
+					drawGlyphsRaw(glyphs.font, glyphs.size, glyphs.style, text, positions, glyphs.count, glyphs.scaleRatio, glyphs.flipX, glyphs.flipY, glyphs.rotation, glyphs.color);
+				}
+				break;
+			}
+		}
+	}
+
 	Font* Graphics::getDefaultFont()
 	{
 		if(defaultFont == nullptr)
@@ -368,7 +547,7 @@ namespace fgl
 			bool success = defaultFont->loadFromPath(defaultFontPath, &error);
 			if(!success)
 			{
-				Console::writeLine(error);
+				FGL_LOG_WARNING("\""+defaultFontPath+"\": "+error);
 			}
 			defaultFont->setAntialiasing(true);
 		}
@@ -542,32 +721,76 @@ namespace fgl
 
 	void Graphics::drawString(const WideString& text, double x1, double y1)
 	{
+		FGL_PROFILE_ZONE("Graphics::drawString")
 		unsigned int fontSize = font->getSize();
 		unsigned int renderedFontSize = fontSize;
 		if(window->getViewport()==nullptr || !window->getViewport()->maintainResolution)
 		{
 			renderedFontSize = (unsigned int)Math::abs(scaling.y*(double)fontSize);
 		}
-		ArrayList<RenderedGlyphContainer::RenderedGlyph> glyphs = font->getRenderedGlyphs((Font::GlyphString)text,renderer, renderedFontSize, font->getStyle());
-		Vector2u dimensions = font->measureString(text);
-		font->setSize(renderedFontSize);
-		Vector2u realDimensions = font->measureString(text);
-		Color compColor = color.composite(tintColor);
-
-		bool negWidth = (scaling.x < 0);
-		bool negHeight = (scaling.y < 0);
+		Font::GlyphString glyphText = (Font::GlyphString)text;
+		Vector2u dimensions = font->measureString(glyphText, fontSize);
+		Vector2u realDimensions = font->measureString(glyphText, renderedFontSize);
+
+		Graphics_GlyphsCommand command;
+		command.font = font;
+		command.size = renderedFontSize;
+		command.style = font->getStyle();
+		command.count = (Uint32)glyphText.length();
+		command.scaleRatio = Math::abs(scaling.x/scaling.y);
+		command.rotation = rotation;
+		command.flipX = (scaling.x < 0);
+		command.flipY = (scaling.y < 0);
+		command.color = color.composite(tintColor);
 
 		beginDraw();
 
+		//the glyph textures are rendered by the renderer's thread, so only their positions are worked out here
+		Vector2d* positions = nullptr;
+		Uint16* glyphChars = nullptr;
+		std::vector<Vector2d> immediatePositions;
+		if(commandList != nullptr)
+		{
+			size_t positionsSize = (size_t)command.count*sizeof(Vector2d);
+			byte* extra = (byte*)commandList->add(GRAPHICS_COMMAND_GLYPHS, &command, sizeof(command), positionsSize + ((size_t)command.count*sizeof(Uint16)));
+			positions = (Vector2d*)extra;
+			glyphChars = (Uint16*)(extra + positionsSize);
+		}
+		else
+		{
+			immediatePositions.resize((size_t)command.count);
+			positions = immediatePositions.data();
+		}
+
 		double y1_top = y1 - (double)dimensions.y;
 		double x_offset = 0;
-		double scaleRatio = Math::abs(scaling.x/scaling.y);
 		double dimensionRatio = (double)dimensions.x/(double)realDimensions.x;
-		for(size_t i = 0; i < glyphs.size(); i++)
+		for(size_t i = 0; i < glyphText.length(); i++)
+		{
+			RenderedGlyphContainer::glyph_char glyphChar = glyphText.charAt(i);
+			new (positions+i) Vector2d(transform.transform(Vector2d(x1 + x_offset, y1_top)));
+			if(glyphChars != nullptr)
+			{
+				glyphChars[i] = (Uint16)glyphChar;
+			}
+			Vector2u glyphDimensions = font->measureString((Font::GlyphString)glyphChar, renderedFontSize);
+			x_offset += (double)glyphDimensions.x*dimensionRatio;
+		}
+
+		if(commandList == nullptr)
 		{
-			RenderedGlyphContainer::RenderedGlyph& glyph = glyphs.get(i);
-			SDL_Texture*texture = (SDL_Texture*)glyph.texture;
-			Vector2u glyphDimensions = font->measureString((Font::GlyphString)text.charAt(i));
+			drawGlyphsRaw(font, renderedFontSize, command.style, glyphText.getData(), positions, glyphText.length(), command.scaleRatio, command.flipX, command.flipY, rotation, command.color);
+		}
+
+		endDraw();
+	}
+
+	void Graphics::drawGlyphsRaw(Font* glyphFont, unsigned int size, int style, const Uint16* text, const Vector2d* positions, size_t count, double scaleRatio, bool flipX, bool flipY, double glyphRotation, const Color& colormod)
+	{
+		ArrayList<RenderedGlyphContainer::RenderedGlyph> glyphs = glyphFont->getRenderedGlyphs(Font::GlyphString(text, count), renderer, size, style);
+		for(size_t i = 0; i < glyphs.size() && i < count; i++)
+		{
+			SDL_Texture* texture = (SDL_Texture*)glyphs.get(i).texture;
 			unsigned int format = 0;
 			int access = 0;
 			int w = 0;
@@ -576,25 +799,18 @@ namespace fgl
 			double realWidth = (double)w*scaleRatio;
 			double realHeight = (double)h;
 
-			if(negWidth)
+			if(flipX)
 			{
 				realWidth = -realWidth;
 			}
-			if(negHeight)
+			if(flipY)
 			{
 				realHeight = -realHeight;
 			}
 
-			Vector2d pnt = transform.transform(Vector2d(x1 + x_offset, y1_top));
-
-			drawTextureRaw(glyph.texture, pnt.x, pnt.y, pnt.x+realWidth, pnt.y+realHeight, 0, 0, (unsigned int)w, (unsigned int)h, rotation, compColor);
-
-			x_offset += (double)glyphDimensions.x*dimensionRatio;
+			const Vector2d& pnt = positions[i];
+			drawTextureRaw(texture, pnt.x, pnt.y, pnt.x+realWidth, pnt.y+realHeight, 0, 0, (unsigned int)w, (unsigned int)h, glyphRotation, colormod);
 		}
-
-		endDraw();
-
-		font->setSize(fontSize);
 	}
 
 	void Graphics::drawString(const WideString&text, const Vector2d& point)
@@ -604,9 +820,22 @@ namespace fgl
 
 	void Graphics::drawLineRaw(double x1, double y1, double x2, double y2, double width)
 	{
+		FGL_PROFILE_ZONE("Graphics::drawLine")
 		if(width==1.0)
 		{
-			SDL_RenderDrawLine((SDL_Renderer*)renderer, (int)x1, (int)y1, (int)x2, (int)y2);
+			Graphics_LineCommand command;
+			command.x1 = (int)x1;
+			command.y1 = (int)y1;
+			command.x2 = (int)x2;
+			command.y2 = (int)y2;
+			if(commandList != nullptr)
+			{
+				commandList->add(GRAPHICS_COMMAND_LINE, &command, sizeof(command));
+			}
+			else
+			{
+				SDL_RenderDrawLine((SDL_Renderer*)renderer, command.x1, command.y1, command.x2, command.y2);
+			}
 		}
 		else
 		{
@@ -677,33 +906,29 @@ namespace fgl
 				origin.y = (int)widthOffset;
 			}
 
-			Uint8 r = 0;
-			Uint8 g = 0;
-			Uint8 b = 0;
-			Uint8 a = 0;
-			SDL_GetRenderDrawColor((SDL_Renderer*)renderer, &r, &g, &b, &a);
-
-			SDL_Texture* texture = (SDL_Texture*)pixel->texture;
-
-			SDL_Rect intDstRect;
-			intDstRect.x = (int)dstRect.x;
-			intDstRect.y = (int)dstRect.y;
-			intDstRect.w = (int)((dstRect.x+dstRect.width) - (double)intDstRect.x);
-			intDstRect.h = (int)((dstRect.y+dstRect.height) - (double)intDstRect.y);
-
-			SDL_Rect srcRect;
-			srcRect.x = 0;
-			srcRect.y = 0;
-			srcRect.w = 1;
-			srcRect.h = 1;
-
-			SDL_SetTextureColorMod(texture, r, g, b);
-			SDL_SetTextureAlphaMod(texture, a);
-
-			SDL_RenderCopyEx((SDL_Renderer*)renderer, texture, &srcRect, &intDstRect, degrees, &origin, SDL_FLIP_NONE);
-
-			SDL_SetTextureColorMod(texture, 255, 255, 255);
-			SDL_SetTextureAlphaMod(texture, 255);
+			Graphics_TextureCommand command;
+			command.texture = (SDL_Texture*)pixel->texture;
+			command.dstrect.x = (int)dstRect.x;
+			command.dstrect.y = (int)dstRect.y;
+			command.dstrect.w = (int)((dstRect.x+dstRect.width) - (double)command.dstrect.x);
+			command.dstrect.h = (int)((dstRect.y+dstRect.height) - (double)command.dstrect.y);
+			command.srcrect.x = 0;
+			command.srcrect.y = 0;
+			command.srcrect.w = 1;
+			command.srcrect.h = 1;
+			command.rotation = degrees;
+			command.center = origin;
+			command.flip = SDL_FLIP_NONE;
+			command.colormod = getDrawColor();
+
+			if(commandList != nullptr)
+			{
+				commandList->add(GRAPHICS_COMMAND_TEXTURE, &command, sizeof(command));
+			}
+			else
+			{
+				Graphics_executeTexture((SDL_Renderer*)renderer, command);
+			}
 		}
 	}
 
@@ -763,12 +988,7 @@ namespace fgl
 
 		beginDraw();
 
-		Uint8 r = 0;
-		Uint8 g = 0;
-		Uint8 b = 0;
-		Uint8 a = 0;
-		SDL_GetRenderDrawColor((SDL_Renderer*)renderer, &r, &g, &b, &a);
-		Color color(r, g, b, a);
+		Color color = getDrawColor();
 
 		drawImageRaw(pixel, topleft.x, topleft.y, topleft.x+fullwidth, topleft.y+scaling.y, 0, 0, 1, 1, rotation, color);
 		drawImageRaw(pixel, topright.x, topright.y, topright.x-scaling.x, topright.y+fullheight, 0, 0, 1, 1, -rotation, color);
@@ -785,17 +1005,12 @@ namespace fgl
 
 	void Graphics::fillRect(double x, double y, double width, double height)
 	{
+		FGL_PROFILE_ZONE("Graphics::fillRect")
 		Vector2d pnt = transform.transform(Vector2d(x, y));
 
 		beginDraw();
 
-		Uint8 r = 0;
-		Uint8 g = 0;
-		Uint8 b = 0;
-		Uint8 a = 0;
-		SDL_GetRenderDrawColor((SDL_Renderer*)renderer, &r, &g, &b, &a);
-
-		drawImageRaw(pixel, pnt.x, pnt.y, pnt.x+(width*scaling.x), pnt.y+(height*scaling.y), 0, 0, 1, 1, rotation, Color(r, g, b, a));
+		drawImageRaw(pixel, pnt.x, pnt.y, pnt.x+(width*scaling.x), pnt.y+(height*scaling.y), 0, 0, 1, 1, rotation, getDrawColor());
 
 		endDraw();
 	}
@@ -827,6 +1042,7 @@ namespace fgl
 
 	void Graphics::drawPolygon(const PolygonD& polygon)
 	{
+		FGL_PROFILE_ZONE("Graphics::drawPolygon")
 		if(polygon.getPoints().size() > 0)
 		{
 			const ArrayList<Vector2d>& origPoints = polygon.getPoints();
@@ -838,7 +1054,17 @@ namespace fgl
 			if(points.size() == 1)
 			{
 				const Vector2d& point = points.get(0);
-				SDL_RenderDrawPoint((SDL_Renderer*)renderer, (int)point.x, (int)point.y);
+				Graphics_PointCommand command;
+				command.x = (int)point.x;
+				command.y = (int)point.y;
+				if(commandList != nullptr)
+				{
+					commandList->add(GRAPHICS_COMMAND_POINT, &command, sizeof(command));
+				}
+				else
+				{
+					SDL_RenderDrawPoint((SDL_Renderer*)renderer, command.x, command.y);
+				}
 			}
 			else
 			{
@@ -869,26 +1095,38 @@ namespace fgl
 
 	void Graphics::fillPolygon(const PolygonD& polygon)
 	{
+		FGL_PROFILE_ZONE("Graphics::fillPolygon")
 		if(polygon.getPoints().size() > 0)
 		{
 			PolygonD transformedPolygon = transform.transform(polygon);
 			const ArrayList<Vector2d>& points = transformedPolygon.getPoints();
-			Sint16* polygonX = new Sint16[points.size()];
-			Sint16* polygonY = new Sint16[points.size()];
+
+			beginDraw();
+
+			Graphics_PolygonCommand command;
+			command.count = (Uint32)points.size();
+			command.color = getDrawColor();
+			std::vector<Sint16> immediatePoints;
+			Sint16* polygonX = nullptr;
+			if(commandList != nullptr)
+			{
+				polygonX = (Sint16*)commandList->add(GRAPHICS_COMMAND_POLYGON, &command, sizeof(command), points.size()*2*sizeof(Sint16));
+			}
+			else
+			{
+				immediatePoints.resize(points.size()*2);
+				polygonX = immediatePoints.data();
+			}
+			Sint16* polygonY = polygonX + points.size();
 			for(size_t i=0; i<points.size(); i++)
 			{
 				polygonX[i] = (Sint16)points[i].x;
 				polygonY[i] = (Sint16)points[i].y;
 			}
-
-			beginDraw();
-
-			Uint8 r = 0;
-			Uint8 g = 0;
-			Uint8 b = 0;
-			Uint8 a = 0;
-			SDL_GetRenderDrawColor((SDL_Renderer*)renderer, &r, &g, &b, &a);
-			filledPolygonRGBA((SDL_Renderer*)renderer, polygonX, polygonY, (int)points.size(), r, g, b, a);
+			if(commandList == nullptr)
+			{
+				filledPolygonRGBA((SDL_Renderer*)renderer, polygonX, polygonY, (int)points.size(), command.color.r, command.color.g, command.color.b, command.color.a);
+			}
 
 			endDraw();
 		}
@@ -896,6 +1134,7 @@ namespace fgl
 
 	void Graphics::drawTextureRaw(void* texture, double dx1, double dy1, double dx2, double dy2, unsigned int sx1, unsigned int sy1, unsigned int sx2, unsigned int sy2, double rotation, const Color& colormod)
 	{
+		FGL_PROFILE_ZONE("Graphics::drawTexture")
 		bool flipHort = false;
 		bool flipVert = false;
 		SDL_RendererFlip flip = SDL_FLIP_NONE;
@@ -944,19 +1183,26 @@ namespace fgl
 			center.y = 0;
 		}
 
-		SDL_Rect srcrect;
-		srcrect.x = (int)sx1;
-		srcrect.y = (int)sy1;
-		srcrect.w = (int)(sx2 - sx1);
-		srcrect.h = (int)(sy2 - sy1);
-
-		SDL_SetTextureColorMod((SDL_Texture*)texture, colormod.r, colormod.g, colormod.b);
-		SDL_SetTextureAlphaMod((SDL_Texture*)texture, colormod.a);
-
-		SDL_RenderCopyEx((SDL_Renderer*)renderer, (SDL_Texture*)texture, &srcrect, &dstrect, rotation, &center, flip);
-
-		SDL_SetTextureColorMod((SDL_Texture*)texture, 255, 255, 255);
-		SDL_SetTextureAlphaMod((SDL_Texture*)texture, 255);
+		Graphics_TextureCommand command;
+		command.texture = (SDL_Texture*)texture;
+		command.srcrect.x = (int)sx1;
+		command.srcrect.y = (int)sy1;
+		command.srcrect.w = (int)(sx2 - sx1);
+		command.srcrect.h = (int)(sy2 - sy1);
+		command.dstrect = dstrect;
+		command.rotation = rotation;
+		command.center = center;
+		command.flip = flip;
+		command.colormod = colormod;
+
+		if(commandList != nullptr)
+		{
+			commandList->add(GRAPHICS_COMMAND_TEXTURE, &command, sizeof(command));
+		}
+		else
+		{
+			Graphics_executeTexture((SDL_Renderer*)renderer, command);
+		}
 	}
 
 	void Graphics::drawImageRaw(TextureImage* img, double dx1, double dy1, double dx2, double dy2, unsigned int sx1, unsigned int sy1, unsigned int sx2, unsigned int sy2, double rotation, const Color& colormod)
@@ -1,10 +1,13 @@
 
 #include <GameLibrary/Graphics/Image.hpp>
+#include <GameLibrary/Graphics/PixelConverter.hpp>
 #include <GameLibrary/Graphics/PixelIterator.hpp>
+#include <GameLibrary/Exception/IllegalArgumentException.hpp>
 #include <GameLibrary/Exception/InitializeLibraryException.hpp>
 #include <GameLibrary/Exception/Graphics/ImageOutOfBoundsException.hpp>
 #include <GameLibrary/Exception/Graphics/UnsupportedImageFormatException.hpp>
 #include <SDL_image.h>
+#include "../SDL_ext/SDL_PixelFormat_ext.hpp"
 #include "../SDL_ext/SDL_RWops_ext.hpp"
 
 namespace fgl
@@ -95,6 +98,25 @@ namespace fgl
 
 	bool Image_loadFromSDLSurface(SDL_Surface* surface, ArrayList<Color>& pixels, String* error)
 	{
+		PixelConverter::Layout layout;
+		Color palette[256];
+		SDL_Surface* convertedSurface = nullptr;
+		if(!SDL_GetPixelConverterLayout(surface->format, &layout, palette))
+		{
+			//formats without whole byte channels (eg 16 bit pixels) are converted by SDL first
+			convertedSurface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA8888, 0);
+			if(convertedSurface == nullptr)
+			{
+				if(error!=nullptr)
+				{
+					*error = SDL_GetError();
+				}
+				return false;
+			}
+			surface = convertedSurface;
+			SDL_GetPixelConverterLayout(surface->format, &layout, palette);
+		}
+
 		int mustlock = SDL_MUSTLOCK(surface);
 		if(mustlock!=0)
 		{
@@ -104,83 +126,29 @@ namespace fgl
 				{
 					*error = SDL_GetError();
 				}
+				if(convertedSurface != nullptr)
+				{
+					SDL_FreeSurface(convertedSurface);
+				}
 				return false;
 			}
 		}
 
-		unsigned int bpp = (unsigned int)surface->format->BytesPerPixel;
-
-		unsigned int rmask = (unsigned int)surface->format->Rmask;
-		unsigned int rshift = (unsigned int)surface->format->Rshift;
-		unsigned int gmask = (unsigned int)surface->format->Gmask;
-		unsigned int gshift = (unsigned int)surface->format->Gshift;
-		unsigned int bmask = (unsigned int)surface->format->Bmask;
-		unsigned int bshift = (unsigned int)surface->format->Bshift;
-		unsigned int amask = (unsigned int)surface->format->Amask;
-		unsigned int ashift = (unsigned int)surface->format->Ashift;
-
 		//TODO check for integer overflow
 		size_t width = (size_t)surface->w;
 		size_t height = (size_t)surface->h;
-		size_t total = width*height;
-		pixels.resize(total);
-
-		unsigned int pitchDif = ((unsigned int)surface->pitch - ((unsigned int)width*bpp));
-
-		size_t counter = 0;
-		byte*surfacePixels = (byte*)surface->pixels;
-
-		size_t i=0;
-		for(size_t ycnt=0; ycnt<height; ycnt++)
-		{
-			for(size_t xcnt = 0; xcnt < width; xcnt++)
-			{
-				switch(bpp)
-				{
-					case 1:
-					pixels[i].r = surfacePixels[counter];
-					pixels[i].g = surfacePixels[counter];
-					pixels[i].b = surfacePixels[counter];
-					pixels[i].a = 255;
-					break;
-
-					case 2:
-					pixels[i].r = surfacePixels[counter];
-					pixels[i].g = surfacePixels[counter+1];
-					pixels[i].b = surfacePixels[counter+1];
-					pixels[i].a = 255;
-					break;
+		pixels.resize(width*height);
 
-					case 3:
-					{
-						Uint32 color = *((Uint32*)&surfacePixels[counter]);
-						pixels[i].r = (byte)((color & rmask) >> rshift);
-						pixels[i].g = (byte)((color & gmask) >> gshift);
-						pixels[i].b = (byte)((color & bmask) >> bshift);
-						pixels[i].a = 255;
-					}
-					break;
-
-					case 4:
-					{
-						Uint32 color = *((Uint32*)&surfacePixels[counter]);
-						pixels[i].r = (byte)((color & rmask) >> rshift);
-						pixels[i].g = (byte)((color & gmask) >> gshift);
-						pixels[i].b = (byte)((color & bmask) >> bshift);
-						pixels[i].a = (byte)((color & amask) >> ashift);
-					}
-					break;
-				}
-				i++;
-				counter += (size_t)bpp;
-			}
-			counter += (size_t)pitchDif;
-		}
+		PixelConverter::convert(layout, surface->pixels, width, height, (size_t)surface->pitch, pixels.getVector().data(), width*sizeof(Color), nullptr);
 
 		if(mustlock != 0)
 		{
 			SDL_UnlockSurface(surface);
 		}
+		if(convertedSurface != nullptr)
+		{
+			SDL_FreeSurface(convertedSurface);
+		}
 
 		return true;
 	}
@@ -384,21 +352,7 @@ namespace fgl
 
 	void Image::recolor(const ArrayList<std::pair<Color, Color>>& colorSwaps)
 	{
-		size_t total = pixels.size();
-		size_t totalSwaps = colorSwaps.size();
-		for(size_t i=0; i<total; i++)
-		{
-			const Color& color = pixels.get(i);
-			for(size_t j=0; j<totalSwaps; j++)
-			{
-				const std::pair<Color,Color>& colorSwap = colorSwaps.get(j);
-				if(color.equals(colorSwap.first))
-				{
-					pixels.set(i, colorSwap.second);
-					j = totalSwaps;
-				}
-			}
-		}
+		PixelConverter::recolor(pixels.getVector().data(), pixels.size(), colorSwaps.getData(), colorSwaps.size());
 	}
 	
 	void Image::applyCompositeMask(const Image& mask)
@@ -407,17 +361,17 @@ namespace fgl
 		{
 			return;
 		}
+		if(mask.width == width && mask.height == height)
+		{
+			PixelConverter::composite(pixels.getVector().data(), mask.pixels.getData(), pixels.size());
+			return;
+		}
 		RectangleD dstRect = RectangleD(0,0,(double)width,(double)height);
 		PixelIterator pxlIter(Vector2u((unsigned int)width,(unsigned int)height), RectangleU(0,0,(unsigned int)width,(unsigned int)height), dstRect, dstRect, 1, 1, false, false);
 		
 		PixelIterator mask_pxlIter(Vector2u((unsigned int)mask.width,(unsigned int)mask.height), RectangleU(0,0,(unsigned int)mask.width,(unsigned int)mask.height), dstRect, dstRect, 1, 1, false, false);
 		
-		std::vector<bool> masked(pixels.size());
-		size_t total = pixels.size();
-		for(size_t i=0; i<total; i++)
-		{
-			masked[i] = false;
-		}
+		PixelMask masked(pixels.size());
 
 		bool running = pxlIter.nextPixelIndex();
 		bool mask_running = mask_pxlIter.nextPixelIndex();
@@ -435,7 +389,7 @@ namespace fgl
 					const Color& mask_color = mask.getPixel(mask_index);
 					Color curcol = pixels[index];
 					pixels[index] = curcol.composite(mask_color);
-					masked[index] = true;
+					masked.set(index, true);
 				}
 			}
 			
@@ -448,6 +402,67 @@ namespace fgl
 		}
 	}
 
+	void Image::blit(const Image& image, const RectangleU& srcRect, const Vector2i& position, BlendMode blendMode)
+	{
+		if((size_t)srcRect.x + (size_t)srcRect.width > image.width || (size_t)srcRect.y + (size_t)srcRect.height > image.height)
+		{
+			throw IllegalArgumentException("srcRect", "not within bounds of image");
+		}
+		if(&image == this)
+		{
+			//the source and destination areas may overlap
+			Image copy = image;
+			blit(copy, srcRect, position, blendMode);
+			return;
+		}
+
+		//clip the area to the bounds of this image
+		long long left = (long long)position.x;
+		long long top = (long long)position.y;
+		long long right = left + (long long)srcRect.width;
+		long long bottom = top + (long long)srcRect.height;
+		size_t srcLeft = (size_t)srcRect.x;
+		size_t srcTop = (size_t)srcRect.y;
+		if(left < 0)
+		{
+			srcLeft += (size_t)(-left);
+			left = 0;
+		}
+		if(top < 0)
+		{
+			srcTop += (size_t)(-top);
+			top = 0;
+		}
+		if(right > (long long)width)
+		{
+			right = (long long)width;
+		}
+		if(bottom > (long long)height)
+		{
+			bottom = (long long)height;
+		}
+		if(left >= right || top >= bottom)
+		{
+			return;
+		}
+
+		size_t rowLength = (size_t)(right - left);
+		size_t rowCount = (size_t)(bottom - top);
+		Color* dstRow = pixels.getVector().data() + ((size_t)top*width) + (size_t)left;
+		const Color* srcRow = image.pixels.getData() + (srcTop*image.width) + srcLeft;
+		for(size_t y=0; y<rowCount; y++)
+		{
+			PixelConverter::blend(dstRow, srcRow, rowLength, blendMode);
+			dstRow += width;
+			srcRow += image.width;
+		}
+	}
+
+	void Image::blit(const Image& image, const Vector2i& position, BlendMode blendMode)
+	{
+		blit(image, RectangleU(0, 0, (unsigned int)image.width, (unsigned int)image.height), position, blendMode);
+	}
+
 	size_t Image::getLength() const
 	{
 		return (size_t)pixels.size();
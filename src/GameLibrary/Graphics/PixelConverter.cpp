@@ -0,0 +1,1003 @@
+
+#include <GameLibrary/Graphics/PixelConverter.hpp>
+#include <GameLibrary/Exception/IllegalArgumentException.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	#define PIXELCONVERTER_BIG_ENDIAN
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#define PIXELCONVERTER_SSE2
+	#include <emmintrin.h>
+#endif
+
+// AVX2 is used when the whole library is built for it, or otherwise checked for at runtime on compilers that can target it per function
+#if defined(__AVX2__)
+	#define PIXELCONVERTER_AVX2
+	#define PIXELCONVERTER_AVX2_TARGET
+	#include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define PIXELCONVERTER_AVX2
+	#define PIXELCONVERTER_AVX2_RUNTIME
+	#define PIXELCONVERTER_AVX2_TARGET __attribute__((target("avx2")))
+	#include <immintrin.h>
+#endif
+
+namespace fgl
+{
+	static_assert(sizeof(Color) == 4, "Color must be a packed 32 bit value");
+
+	typedef void(*PixelConverter_RowFunction)(const PixelConverter::Layout& layout, const Uint8* src, size_t count, Color* dst, Uint32* mask, size_t maskIndex);
+
+	// ors up to 32 mask bits into the mask, starting at any bit index. the bits must already be cleared
+	inline void PixelConverter_orMaskBits(Uint32* mask, size_t bitIndex, Uint32 bits, unsigned int count)
+	{
+		size_t word = bitIndex / PixelMask::BITS_PER_WORD;
+		unsigned int offset = (unsigned int)(bitIndex % PixelMask::BITS_PER_WORD);
+		mask[word] |= bits << offset;
+		if(offset != 0 && (offset + count) > PixelMask::BITS_PER_WORD)
+		{
+			mask[word+1] |= bits >> (PixelMask::BITS_PER_WORD - offset);
+		}
+	}
+
+	template<unsigned int BYTES_PER_PIXEL>
+	inline Uint32 PixelConverter_readPacked(const Uint8* src)
+	{
+		if(BYTES_PER_PIXEL == 4)
+		{
+			Uint32 value;
+			std::memcpy(&value, src, 4);
+			return value;
+		}
+		#ifdef PIXELCONVERTER_BIG_ENDIAN
+			return ((Uint32)src[0] << 16) | ((Uint32)src[1] << 8) | (Uint32)src[2];
+		#else
+			return (Uint32)src[0] | ((Uint32)src[1] << 8) | ((Uint32)src[2] << 16);
+		#endif
+	}
+
+	template<unsigned int BYTES_PER_PIXEL>
+	void PixelConverter_convertRowScalar(const PixelConverter::Layout& layout, const Uint8* src, size_t count, Color* dst, Uint32* mask, size_t maskIndex)
+	{
+		for(size_t i=0; i<count; i++)
+		{
+			Color color;
+			if(BYTES_PER_PIXEL == 1)
+			{
+				color = layout.palette[src[i]];
+			}
+			else
+			{
+				Uint32 value = PixelConverter_readPacked<BYTES_PER_PIXEL>(src + (i*BYTES_PER_PIXEL));
+				color.r = (Uint8)(value >> layout.rshift);
+				color.g = (Uint8)(value >> layout.gshift);
+				color.b = (Uint8)(value >> layout.bshift);
+				color.a = layout.hasAlpha ? (Uint8)(value >> layout.ashift) : 255;
+			}
+			dst[i] = color;
+			if(mask != nullptr)
+			{
+				size_t bitIndex = maskIndex + i;
+				mask[bitIndex / PixelMask::BITS_PER_WORD] |= (Uint32)(color.a != 0) << (bitIndex % PixelMask::BITS_PER_WORD);
+			}
+		}
+	}
+
+	void PixelConverter_convertRowScalar(const PixelConverter::Layout& layout, const Uint8* src, size_t count, Color* dst, Uint32* mask, size_t maskIndex)
+	{
+		switch(layout.bytesPerPixel)
+		{
+			case 1:
+			PixelConverter_convertRowScalar<1>(layout, src, count, dst, mask, maskIndex);
+			break;
+
+			case 3:
+			PixelConverter_convertRowScalar<3>(layout, src, count, dst, mask, maskIndex);
+			break;
+
+			case 4:
+			PixelConverter_convertRowScalar<4>(layout, src, count, dst, mask, maskIndex);
+			break;
+		}
+	}
+
+	void PixelConverter_createMaskScalar(const Color* pixels, size_t count, Uint32* mask)
+	{
+		for(size_t i=0; i<count; i++)
+		{
+			mask[i / PixelMask::BITS_PER_WORD] |= (Uint32)(pixels[i].a != 0) << (i % PixelMask::BITS_PER_WORD);
+		}
+	}
+
+	inline Uint32 PixelConverter_colorToWord(const Color& color)
+	{
+		Uint32 word;
+		std::memcpy(&word, &color, 4);
+		return word;
+	}
+
+	// t / 255, rounded to the nearest integer, for t <= 255*255
+	inline Uint32 PixelConverter_div255(Uint32 t)
+	{
+		t += 128;
+		return (t + (t >> 8)) >> 8;
+	}
+
+	// t / 255, rounded down, for t <= 255*255
+	inline Uint32 PixelConverter_div255Floor(Uint32 t)
+	{
+		return (t + 1 + (t >> 8)) >> 8;
+	}
+
+	// an open addressing hash table from original colors to replacement colors. empty slots hold a key that none of the swaps use,
+	// and map that key to itself, so a pixel that happens to equal the empty key is left alone without any special case
+	struct PixelConverter_ColorSwapTable
+	{
+		std::vector<Uint32> keys;
+		std::vector<Uint32> values;
+		Uint32 emptyKey;
+		unsigned int shift;
+		size_t slotMask;
+
+		PixelConverter_ColorSwapTable(const std::pair<Color,Color>* colorSwaps, size_t swapCount)
+		{
+			// keep the table at most 1/4 full, so that most lookups hit on the first probe
+			unsigned int bits = 4;
+			while(((size_t)1 << bits) < (swapCount * 4))
+			{
+				bits++;
+			}
+			size_t slotCount = (size_t)1 << bits;
+			shift = 32 - bits;
+			slotMask = slotCount - 1;
+
+			std::vector<Uint32> sortedKeys;
+			sortedKeys.reserve(swapCount);
+			for(size_t i=0; i<swapCount; i++)
+			{
+				sortedKeys.push_back(PixelConverter_colorToWord(colorSwaps[i].first));
+			}
+			std::sort(sortedKeys.begin(), sortedKeys.end());
+			emptyKey = 0;
+			for(Uint32 key : sortedKeys)
+			{
+				if(key == emptyKey)
+				{
+					emptyKey++;
+				}
+				else if(key > emptyKey)
+				{
+					break;
+				}
+			}
+
+			keys.assign(slotCount, emptyKey);
+			values.assign(slotCount, emptyKey);
+			for(size_t i=0; i<swapCount; i++)
+			{
+				Uint32 key = PixelConverter_colorToWord(colorSwaps[i].first);
+				size_t slot = getSlot(key);
+				while(keys[slot] != emptyKey && keys[slot] != key)
+				{
+					slot = (slot + 1) & slotMask;
+				}
+				// the first swap for a color wins
+				if(keys[slot] == emptyKey)
+				{
+					keys[slot] = key;
+					values[slot] = PixelConverter_colorToWord(colorSwaps[i].second);
+				}
+			}
+		}
+
+		size_t getSlot(Uint32 color) const
+		{
+			return (size_t)((Uint32)(color * 0x9E3779B1u) >> shift);
+		}
+
+		Uint32 lookup(Uint32 color) const
+		{
+			size_t slot = getSlot(color);
+			while(true)
+			{
+				Uint32 key = keys[slot];
+				if(key == color)
+				{
+					return values[slot];
+				}
+				else if(key == emptyKey)
+				{
+					return color;
+				}
+				slot = (slot + 1) & slotMask;
+			}
+		}
+	};
+
+	void PixelConverter_recolorScalar(const PixelConverter_ColorSwapTable& table, Color* pixels, size_t count)
+	{
+		// sprites have long runs of the same color, so the last lookup is reused
+		Uint32 lastColor = table.emptyKey;
+		Uint32 lastReplacement = table.emptyKey;
+		for(size_t i=0; i<count; i++)
+		{
+			Uint32 color = PixelConverter_colorToWord(pixels[i]);
+			if(color != lastColor)
+			{
+				lastColor = color;
+				lastReplacement = table.lookup(color);
+			}
+			std::memcpy((void*)&pixels[i], &lastReplacement, 4);
+		}
+	}
+
+	void PixelConverter_compositeScalar(Color* pixels, const Color* mask, size_t count)
+	{
+		for(size_t i=0; i<count; i++)
+		{
+			Color& color = pixels[i];
+			const Color& maskColor = mask[i];
+			color.r = (Uint8)PixelConverter_div255Floor((Uint32)color.r * maskColor.r);
+			color.g = (Uint8)PixelConverter_div255Floor((Uint32)color.g * maskColor.g);
+			color.b = (Uint8)PixelConverter_div255Floor((Uint32)color.b * maskColor.b);
+			color.a = (Uint8)PixelConverter_div255Floor((Uint32)color.a * maskColor.a);
+		}
+	}
+
+	void PixelConverter_blendScalar(Color* dst, const Color* src, size_t count, Image::BlendMode blendMode)
+	{
+		switch(blendMode)
+		{
+			case Image::BlendMode::REPLACE:
+			if(count > 0)
+			{
+				std::memmove((void*)dst, src, count*sizeof(Color));
+			}
+			break;
+
+			case Image::BlendMode::ALPHA:
+			for(size_t i=0; i<count; i++)
+			{
+				const Color& srcColor = src[i];
+				Color& dstColor = dst[i];
+				Uint32 alpha = srcColor.a;
+				if(alpha == 255)
+				{
+					dstColor = srcColor;
+				}
+				else if(alpha != 0)
+				{
+					Uint32 inverseAlpha = 255 - alpha;
+					dstColor.r = (Uint8)PixelConverter_div255((srcColor.r * alpha) + (dstColor.r * inverseAlpha));
+					dstColor.g = (Uint8)PixelConverter_div255((srcColor.g * alpha) + (dstColor.g * inverseAlpha));
+					dstColor.b = (Uint8)PixelConverter_div255((srcColor.b * alpha) + (dstColor.b * inverseAlpha));
+					dstColor.a = (Uint8)PixelConverter_div255((255 * alpha) + (dstColor.a * inverseAlpha));
+				}
+			}
+			break;
+
+			case Image::BlendMode::ADD:
+			for(size_t i=0; i<count; i++)
+			{
+				const Color& srcColor = src[i];
+				Color& dstColor = dst[i];
+				Uint32 alpha = srcColor.a;
+				dstColor.r = (Uint8)std::min<Uint32>(255, dstColor.r + PixelConverter_div255(srcColor.r * alpha));
+				dstColor.g = (Uint8)std::min<Uint32>(255, dstColor.g + PixelConverter_div255(srcColor.g * alpha));
+				dstColor.b = (Uint8)std::min<Uint32>(255, dstColor.b + PixelConverter_div255(srcColor.b * alpha));
+			}
+			break;
+
+			case Image::BlendMode::MULTIPLY:
+			for(size_t i=0; i<count; i++)
+			{
+				const Color& srcColor = src[i];
+				Color& dstColor = dst[i];
+				dstColor.r = (Uint8)PixelConverter_div255((Uint32)srcColor.r * dstColor.r);
+				dstColor.g = (Uint8)PixelConverter_div255((Uint32)srcColor.g * dstColor.g);
+				dstColor.b = (Uint8)PixelConverter_div255((Uint32)srcColor.b * dstColor.b);
+			}
+			break;
+		}
+	}
+
+
+
+#ifdef PIXELCONVERTER_SSE2
+	// SSE2 has no byte shuffle, so packed pixels are split into channels with shifts, and other pixels use the scalar conversion
+	void PixelConverter_convertRowSSE2(const PixelConverter::Layout& layout, const Uint8* src, size_t count, Color* dst, Uint32* mask, size_t maskIndex)
+	{
+		size_t i = 0;
+		if(layout.bytesPerPixel == 4)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i byteMask = _mm_set1_epi32(0xFF);
+			const __m128i alphaMask = _mm_set1_epi32(layout.hasAlpha ? 0xFF : 0);
+			const __m128i alphaFill = _mm_set1_epi32(layout.hasAlpha ? 0 : 0xFF);
+			const __m128i rshift = _mm_cvtsi32_si128((int)layout.rshift);
+			const __m128i gshift = _mm_cvtsi32_si128((int)layout.gshift);
+			const __m128i bshift = _mm_cvtsi32_si128((int)layout.bshift);
+			const __m128i ashift = _mm_cvtsi32_si128((int)layout.ashift);
+			for(; (i+16)<=count; i+=16)
+			{
+				Uint32 bits = 0;
+				for(unsigned int j=0; j<16; j+=4)
+				{
+					__m128i pixels = _mm_loadu_si128((const __m128i*)(src + ((i+j)*4)));
+					__m128i r = _mm_and_si128(_mm_srl_epi32(pixels, rshift), byteMask);
+					__m128i g = _mm_and_si128(_mm_srl_epi32(pixels, gshift), byteMask);
+					__m128i b = _mm_and_si128(_mm_srl_epi32(pixels, bshift), byteMask);
+					__m128i a = _mm_or_si128(_mm_and_si128(_mm_srl_epi32(pixels, ashift), alphaMask), alphaFill);
+					__m128i color = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, 24), _mm_slli_epi32(g, 16)), _mm_or_si128(_mm_slli_epi32(b, 8), a));
+					_mm_storeu_si128((__m128i*)(dst + i + j), color);
+					int transparent = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, zero)));
+					bits |= (Uint32)(~transparent & 0xF) << j;
+				}
+				if(mask != nullptr)
+				{
+					PixelConverter_orMaskBits(mask, maskIndex + i, bits, 16);
+				}
+			}
+		}
+		PixelConverter_convertRowScalar(layout, src + (i*layout.bytesPerPixel), count - i, dst + i, mask, maskIndex + i);
+	}
+
+	void PixelConverter_createMaskSSE2(const Color* pixels, size_t count, Uint32* mask)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i alphaMask = _mm_set1_epi32(0xFF);
+		size_t i = 0;
+		for(; (i+32)<=count; i+=32)
+		{
+			Uint32 bits = 0;
+			for(unsigned int j=0; j<32; j+=4)
+			{
+				__m128i colors = _mm_loadu_si128((const __m128i*)(pixels + i + j));
+				int transparent = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(colors, alphaMask), zero)));
+				bits |= (Uint32)(~transparent & 0xF) << j;
+			}
+			mask[i / PixelMask::BITS_PER_WORD] = bits;
+		}
+		PixelConverter_createMaskScalar(pixels + i, count - i, mask + (i / PixelMask::BITS_PER_WORD));
+	}
+
+	// the 16 bit versions of div255 and div255Floor, on pixels unpacked to 16 bits per channel
+	inline __m128i PixelConverter_div255SSE2(__m128i t)
+	{
+		t = _mm_add_epi16(t, _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+	}
+
+	inline __m128i PixelConverter_div255FloorSSE2(__m128i t)
+	{
+		return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(t, _mm_set1_epi16(1)), _mm_srli_epi16(t, 8)), 8);
+	}
+
+	// copies the alpha of each unpacked pixel into all 4 of its channels
+	inline __m128i PixelConverter_broadcastAlphaSSE2(__m128i pixels)
+	{
+		return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+	}
+
+	void PixelConverter_compositeSSE2(Color* pixels, const Color* mask, size_t count)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		size_t i = 0;
+		for(; (i+4)<=count; i+=4)
+		{
+			__m128i colors = _mm_loadu_si128((const __m128i*)(pixels + i));
+			__m128i maskColors = _mm_loadu_si128((const __m128i*)(mask + i));
+			__m128i low = PixelConverter_div255FloorSSE2(_mm_mullo_epi16(_mm_unpacklo_epi8(colors, zero), _mm_unpacklo_epi8(maskColors, zero)));
+			__m128i high = PixelConverter_div255FloorSSE2(_mm_mullo_epi16(_mm_unpackhi_epi8(colors, zero), _mm_unpackhi_epi8(maskColors, zero)));
+			_mm_storeu_si128((__m128i*)(pixels + i), _mm_packus_epi16(low, high));
+		}
+		PixelConverter_compositeScalar(pixels + i, mask + i, count - i);
+	}
+
+	void PixelConverter_blendSSE2(Color* dst, const Color* src, size_t count, Image::BlendMode blendMode)
+	{
+		if(blendMode == Image::BlendMode::REPLACE)
+		{
+			PixelConverter_blendScalar(dst, src, count, blendMode);
+			return;
+		}
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i alphaMask = _mm_set1_epi32(0xFF);
+		const __m128i max16 = _mm_set1_epi16(255);
+		size_t i = 0;
+		for(; (i+4)<=count; i+=4)
+		{
+			__m128i srcColors = _mm_loadu_si128((const __m128i*)(src + i));
+			__m128i dstColors = _mm_loadu_si128((const __m128i*)(dst + i));
+			__m128i result;
+			switch(blendMode)
+			{
+				case Image::BlendMode::ALPHA:
+				{
+					__m128i alpha = _mm_and_si128(srcColors, alphaMask);
+					if(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(alpha, alphaMask))) == 0xF)
+					{
+						_mm_storeu_si128((__m128i*)(dst + i), srcColors);
+						continue;
+					}
+					else if(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(alpha, zero))) == 0xF)
+					{
+						continue;
+					}
+					// the alpha channel blends as if the source alpha channel were 255
+					__m128i opaqueSrc = _mm_or_si128(srcColors, alphaMask);
+					__m128i alphaLow = PixelConverter_broadcastAlphaSSE2(_mm_unpacklo_epi8(srcColors, zero));
+					__m128i alphaHigh = PixelConverter_broadcastAlphaSSE2(_mm_unpackhi_epi8(srcColors, zero));
+					__m128i low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(opaqueSrc, zero), alphaLow), _mm_mullo_epi16(_mm_unpacklo_epi8(dstColors, zero), _mm_sub_epi16(max16, alphaLow)));
+					__m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(opaqueSrc, zero), alphaHigh), _mm_mullo_epi16(_mm_unpackhi_epi8(dstColors, zero), _mm_sub_epi16(max16, alphaHigh)));
+					result = _mm_packus_epi16(PixelConverter_div255SSE2(low), PixelConverter_div255SSE2(high));
+				}
+				break;
+
+				case Image::BlendMode::ADD:
+				{
+					// the source alpha channel is cleared so that the destination alpha is kept
+					__m128i colorSrc = _mm_andnot_si128(alphaMask, srcColors);
+					__m128i alphaLow = PixelConverter_broadcastAlphaSSE2(_mm_unpacklo_epi8(srcColors, zero));
+					__m128i alphaHigh = PixelConverter_broadcastAlphaSSE2(_mm_unpackhi_epi8(srcColors, zero));
+					__m128i low = PixelConverter_div255SSE2(_mm_mullo_epi16(_mm_unpacklo_epi8(colorSrc, zero), alphaLow));
+					__m128i high = PixelConverter_div255SSE2(_mm_mullo_epi16(_mm_unpackhi_epi8(colorSrc, zero), alphaHigh));
+					result = _mm_adds_epu8(dstColors, _mm_packus_epi16(low, high));
+				}
+				break;
+
+				default:
+				{
+					// multiply. the source alpha channel is set to 255 so that the destination alpha is kept
+					__m128i opaqueSrc = _mm_or_si128(srcColors, alphaMask);
+					__m128i low = PixelConverter_div255SSE2(_mm_mullo_epi16(_mm_unpacklo_epi8(opaqueSrc, zero), _mm_unpacklo_epi8(dstColors, zero)));
+					__m128i high = PixelConverter_div255SSE2(_mm_mullo_epi16(_mm_unpackhi_epi8(opaqueSrc, zero), _mm_unpackhi_epi8(dstColors, zero)));
+					result = _mm_packus_epi16(low, high);
+				}
+				break;
+			}
+			_mm_storeu_si128((__m128i*)(dst + i), result);
+		}
+		PixelConverter_blendScalar(dst + i, src + i, count - i, blendMode);
+	}
+#endif
+
+
+
+#ifdef PIXELCONVERTER_AVX2
+	PIXELCONVERTER_AVX2_TARGET
+	inline Uint32 PixelConverter_visibleBitsAVX2(__m256i colors)
+	{
+		__m256i alpha = _mm256_and_si256(colors, _mm256_set1_epi32(0xFF));
+		int transparent = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(alpha, _mm256_setzero_si256())));
+		return (Uint32)(~transparent & 0xFF);
+	}
+
+	PIXELCONVERTER_AVX2_TARGET
+	void PixelConverter_convertRowAVX2(const PixelConverter::Layout& layout, const Uint8* src, size_t count, Color* dst, Uint32* mask, size_t maskIndex)
+	{
+		size_t i = 0;
+		unsigned int bpp = layout.bytesPerPixel;
+		if(bpp == 3 || bpp == 4)
+		{
+			// each 128 bit lane holds 4 source pixels, which are shuffled into Color byte order (a, b, g, r)
+			Uint8 control[32];
+			for(unsigned int lane=0; lane<2; lane++)
+			{
+				for(unsigned int j=0; j<4; j++)
+				{
+					Uint8* pixelControl = control + (lane*16) + (j*4);
+					unsigned int offset = j * bpp;
+					pixelControl[0] = layout.hasAlpha ? (Uint8)(offset + (layout.ashift / 8)) : 0x80;
+					pixelControl[1] = (Uint8)(offset + (layout.bshift / 8));
+					pixelControl[2] = (Uint8)(offset + (layout.gshift / 8));
+					pixelControl[3] = (Uint8)(offset + (layout.rshift / 8));
+				}
+			}
+			const __m256i shuffle = _mm256_loadu_si256((const __m256i*)control);
+			const __m256i alphaFill = _mm256_set1_epi32(layout.hasAlpha ? 0 : 0xFF);
+			if(bpp == 4)
+			{
+				for(; (i+16)<=count; i+=16)
+				{
+					const Uint8* pixels = src + (i*4);
+					__m256i colors0 = _mm256_or_si256(_mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)pixels), shuffle), alphaFill);
+					__m256i colors1 = _mm256_or_si256(_mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(pixels + 32)), shuffle), alphaFill);
+					_mm256_storeu_si256((__m256i*)(dst + i), colors0);
+					_mm256_storeu_si256((__m256i*)(dst + i + 8), colors1);
+					if(mask != nullptr)
+					{
+						Uint32 bits = PixelConverter_visibleBitsAVX2(colors0) | (PixelConverter_visibleBitsAVX2(colors1) << 8);
+						PixelConverter_orMaskBits(mask, maskIndex + i, bits, 16);
+					}
+				}
+			}
+			else
+			{
+				// each lane loads 16 bytes for 12 bytes of pixels, so stop while the last load is still inside the row
+				for(; (i+18)<=count; i+=16)
+				{
+					const Uint8* pixels = src + (i*3);
+					__m256i pixels0 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)pixels)), _mm_loadu_si128((const __m128i*)(pixels + 12)), 1);
+					__m256i pixels1 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(pixels + 24))), _mm_loadu_si128((const __m128i*)(pixels + 36)), 1);
+					__m256i colors0 = _mm256_or_si256(_mm256_shuffle_epi8(pixels0, shuffle), alphaFill);
+					__m256i colors1 = _mm256_or_si256(_mm256_shuffle_epi8(pixels1, shuffle), alphaFill);
+					_mm256_storeu_si256((__m256i*)(dst + i), colors0);
+					_mm256_storeu_si256((__m256i*)(dst + i + 8), colors1);
+					if(mask != nullptr)
+					{
+						Uint32 bits = PixelConverter_visibleBitsAVX2(colors0) | (PixelConverter_visibleBitsAVX2(colors1) << 8);
+						PixelConverter_orMaskBits(mask, maskIndex + i, bits, 16);
+					}
+				}
+			}
+		}
+		else if(bpp == 1)
+		{
+			const int* palette = (const int*)layout.palette;
+			for(; (i+16)<=count; i+=16)
+			{
+				__m128i indexes = _mm_loadu_si128((const __m128i*)(src + i));
+				__m256i colors0 = _mm256_i32gather_epi32(palette, _mm256_cvtepu8_epi32(indexes), 4);
+				__m256i colors1 = _mm256_i32gather_epi32(palette, _mm256_cvtepu8_epi32(_mm_srli_si128(indexes, 8)), 4);
+				_mm256_storeu_si256((__m256i*)(dst + i), colors0);
+				_mm256_storeu_si256((__m256i*)(dst + i + 8), colors1);
+				if(mask != nullptr)
+				{
+					Uint32 bits = PixelConverter_visibleBitsAVX2(colors0) | (PixelConverter_visibleBitsAVX2(colors1) << 8);
+					PixelConverter_orMaskBits(mask, maskIndex + i, bits, 16);
+				}
+			}
+		}
+		PixelConverter_convertRowScalar(layout, src + (i*bpp), count - i, dst + i, mask, maskIndex + i);
+	}
+
+	PIXELCONVERTER_AVX2_TARGET
+	void PixelConverter_createMaskAVX2(const Color* pixels, size_t count, Uint32* mask)
+	{
+		size_t i = 0;
+		for(; (i+32)<=count; i+=32)
+		{
+			Uint32 bits = 0;
+			for(unsigned int j=0; j<32; j+=8)
+			{
+				bits |= PixelConverter_visibleBitsAVX2(_mm256_loadu_si256((const __m256i*)(pixels + i + j))) << j;
+			}
+			mask[i / PixelMask::BITS_PER_WORD] = bits;
+		}
+		PixelConverter_createMaskScalar(pixels + i, count - i, mask + (i / PixelMask::BITS_PER_WORD));
+	}
+
+	// the 16 bit versions of div255 and div255Floor, on pixels unpacked to 16 bits per channel
+	PIXELCONVERTER_AVX2_TARGET
+	inline __m256i PixelConverter_div255AVX2(__m256i t)
+	{
+		t = _mm256_add_epi16(t, _mm256_set1_epi16(128));
+		return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+	}
+
+	PIXELCONVERTER_AVX2_TARGET
+	inline __m256i PixelConverter_div255FloorAVX2(__m256i t)
+	{
+		return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(t, _mm256_set1_epi16(1)), _mm256_srli_epi16(t, 8)), 8);
+	}
+
+	// copies the alpha of each unpacked pixel into all 4 of its channels
+	PIXELCONVERTER_AVX2_TARGET
+	inline __m256i PixelConverter_broadcastAlphaAVX2(__m256i pixels)
+	{
+		return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+	}
+
+	PIXELCONVERTER_AVX2_TARGET
+	void PixelConverter_compositeAVX2(Color* pixels, const Color* mask, size_t count)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		size_t i = 0;
+		for(; (i+8)<=count; i+=8)
+		{
+			__m256i colors = _mm256_loadu_si256((const __m256i*)(pixels + i));
+			__m256i maskColors = _mm256_loadu_si256((const __m256i*)(mask + i));
+			__m256i low = PixelConverter_div255FloorAVX2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(colors, zero), _mm256_unpacklo_epi8(maskColors, zero)));
+			__m256i high = PixelConverter_div255FloorAVX2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(colors, zero), _mm256_unpackhi_epi8(maskColors, zero)));
+			_mm256_storeu_si256((__m256i*)(pixels + i), _mm256_packus_epi16(low, high));
+		}
+		PixelConverter_compositeScalar(pixels + i, mask + i, count - i);
+	}
+
+	PIXELCONVERTER_AVX2_TARGET
+	void PixelConverter_blendAVX2(Color* dst, const Color* src, size_t count, Image::BlendMode blendMode)
+	{
+		if(blendMode == Image::BlendMode::REPLACE)
+		{
+			PixelConverter_blendScalar(dst, src, count, blendMode);
+			return;
+		}
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i alphaMask = _mm256_set1_epi32(0xFF);
+		const __m256i max16 = _mm256_set1_epi16(255);
+		size_t i = 0;
+		for(; (i+8)<=count; i+=8)
+		{
+			__m256i srcColors = _mm256_loadu_si256((const __m256i*)(src + i));
+			__m256i dstColors = _mm256_loadu_si256((const __m256i*)(dst + i));
+			__m256i result;
+			switch(blendMode)
+			{
+				case Image::BlendMode::ALPHA:
+				{
+					__m256i alpha = _mm256_and_si256(srcColors, alphaMask);
+					if(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(alpha, alphaMask))) == 0xFF)
+					{
+						_mm256_storeu_si256((__m256i*)(dst + i), srcColors);
+						continue;
+					}
+					else if(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(alpha, zero))) == 0xFF)
+					{
+						continue;
+					}
+					// the alpha channel blends as if the source alpha channel were 255
+					__m256i opaqueSrc = _mm256_or_si256(srcColors, alphaMask);
+					__m256i alphaLow = PixelConverter_broadcastAlphaAVX2(_mm256_unpacklo_epi8(srcColors, zero));
+					__m256i alphaHigh = PixelConverter_broadcastAlphaAVX2(_mm256_unpackhi_epi8(srcColors, zero));
+					__m256i low = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(opaqueSrc, zero), alphaLow), _mm256_mullo_epi16(_mm256_unpacklo_epi8(dstColors, zero), _mm256_sub_epi16(max16, alphaLow)));
+					__m256i high = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(opaqueSrc, zero), alphaHigh), _mm256_mullo_epi16(_mm256_unpackhi_epi8(dstColors, zero), _mm256_sub_epi16(max16, alphaHigh)));
+					result = _mm256_packus_epi16(PixelConverter_div255AVX2(low), PixelConverter_div255AVX2(high));
+				}
+				break;
+
+				case Image::BlendMode::ADD:
+				{
+					// the source alpha channel is cleared so that the destination alpha is kept
+					__m256i colorSrc = _mm256_andnot_si256(alphaMask, srcColors);
+					__m256i alphaLow = PixelConverter_broadcastAlphaAVX2(_mm256_unpacklo_epi8(srcColors, zero));
+					__m256i alphaHigh = PixelConverter_broadcastAlphaAVX2(_mm256_unpackhi_epi8(srcColors, zero));
+					__m256i low = PixelConverter_div255AVX2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(colorSrc, zero), alphaLow));
+					__m256i high = PixelConverter_div255AVX2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(colorSrc, zero), alphaHigh));
+					result = _mm256_adds_epu8(dstColors, _mm256_packus_epi16(low, high));
+				}
+				break;
+
+				default:
+				{
+					// multiply. the source alpha channel is set to 255 so that the destination alpha is kept
+					__m256i opaqueSrc = _mm256_or_si256(srcColors, alphaMask);
+					__m256i low = PixelConverter_div255AVX2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(opaqueSrc, zero), _mm256_unpacklo_epi8(dstColors, zero)));
+					__m256i high = PixelConverter_div255AVX2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(opaqueSrc, zero), _mm256_unpackhi_epi8(dstColors, zero)));
+					result = _mm256_packus_epi16(low, high);
+				}
+				break;
+			}
+			_mm256_storeu_si256((__m256i*)(dst + i), result);
+		}
+		PixelConverter_blendScalar(dst + i, src + i, count - i, blendMode);
+	}
+
+	PIXELCONVERTER_AVX2_TARGET
+	void PixelConverter_recolorAVX2(const PixelConverter_ColorSwapTable& table, Color* pixels, size_t count)
+	{
+		const int* keys = (const int*)table.keys.data();
+		const int* values = (const int*)table.values.data();
+		const __m256i multiplier = _mm256_set1_epi32((int)0x9E3779B1u);
+		const __m128i shift = _mm_cvtsi32_si128((int)table.shift);
+		const __m256i emptyKey = _mm256_set1_epi32((int)table.emptyKey);
+		size_t i = 0;
+		for(; (i+8)<=count; i+=8)
+		{
+			__m256i colors = _mm256_loadu_si256((const __m256i*)(pixels + i));
+			__m256i slots = _mm256_srl_epi32(_mm256_mullo_epi32(colors, multiplier), shift);
+			__m256i slotKeys = _mm256_i32gather_epi32(keys, slots, 4);
+			__m256i found = _mm256_cmpeq_epi32(slotKeys, colors);
+			__m256i replacements = _mm256_i32gather_epi32(values, slots, 4);
+			_mm256_storeu_si256((__m256i*)(pixels + i), _mm256_blendv_epi8(colors, replacements, found));
+			// any pixel whose first slot holds a different color has to keep probing
+			int finished = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_or_si256(found, _mm256_cmpeq_epi32(slotKeys, emptyKey))));
+			if(finished != 0xFF)
+			{
+				Uint32 original[8];
+				_mm256_storeu_si256((__m256i*)original, colors);
+				for(unsigned int j=0; j<8; j++)
+				{
+					if((finished & (1 << j)) == 0)
+					{
+						Uint32 replacement = table.lookup(original[j]);
+						std::memcpy((void*)&pixels[i+j], &replacement, 4);
+					}
+				}
+			}
+		}
+		PixelConverter_recolorScalar(table, pixels + i, count - i);
+	}
+#endif
+
+
+
+	PixelConverter::InstructionSet PixelConverter_detectInstructionSet()
+	{
+		#if defined(PIXELCONVERTER_AVX2_RUNTIME)
+			__builtin_cpu_init();
+			if(__builtin_cpu_supports("avx2"))
+			{
+				return PixelConverter::InstructionSet::AVX2;
+			}
+		#elif defined(PIXELCONVERTER_AVX2)
+			return PixelConverter::InstructionSet::AVX2;
+		#endif
+		#if defined(PIXELCONVERTER_SSE2)
+			return PixelConverter::InstructionSet::SSE2;
+		#else
+			return PixelConverter::InstructionSet::SCALAR;
+		#endif
+	}
+
+	PixelConverter::InstructionSet PixelConverter_clampInstructionSet(PixelConverter::InstructionSet instructionSet)
+	{
+		PixelConverter::InstructionSet supportedSet = PixelConverter::getInstructionSet();
+		if(instructionSet > supportedSet)
+		{
+			instructionSet = supportedSet;
+		}
+		#ifndef PIXELCONVERTER_SSE2
+			if(instructionSet == PixelConverter::InstructionSet::SSE2)
+			{
+				instructionSet = PixelConverter::InstructionSet::SCALAR;
+			}
+		#endif
+		return instructionSet;
+	}
+
+	PixelConverter::Layout PixelConverter::getLayout(Format format, const Color* palette)
+	{
+		Layout layout;
+		layout.bytesPerPixel = 4;
+		layout.hasAlpha = true;
+		layout.ashift = 0;
+		layout.palette = nullptr;
+		switch(format)
+		{
+			case Format::RGBA8888:
+			layout.rshift = 24;
+			layout.gshift = 16;
+			layout.bshift = 8;
+			layout.ashift = 0;
+			break;
+
+			case Format::ARGB8888:
+			layout.ashift = 24;
+			layout.rshift = 16;
+			layout.gshift = 8;
+			layout.bshift = 0;
+			break;
+
+			case Format::ABGR8888:
+			layout.ashift = 24;
+			layout.bshift = 16;
+			layout.gshift = 8;
+			layout.rshift = 0;
+			break;
+
+			case Format::BGRA8888:
+			layout.bshift = 24;
+			layout.gshift = 16;
+			layout.rshift = 8;
+			layout.ashift = 0;
+			break;
+
+			case Format::RGB888:
+			layout.hasAlpha = false;
+			layout.rshift = 16;
+			layout.gshift = 8;
+			layout.bshift = 0;
+			break;
+
+			case Format::BGR888:
+			layout.hasAlpha = false;
+			layout.bshift = 16;
+			layout.gshift = 8;
+			layout.rshift = 0;
+			break;
+
+			case Format::RGB24:
+			case Format::BGR24:
+			{
+				layout.bytesPerPixel = 3;
+				layout.hasAlpha = false;
+				// 24 bit pixels are byte arrays, so the shift of the first byte depends on the byte order
+				#ifdef PIXELCONVERTER_BIG_ENDIAN
+					unsigned int firstShift = 16;
+					unsigned int lastShift = 0;
+				#else
+					unsigned int firstShift = 0;
+					unsigned int lastShift = 16;
+				#endif
+				layout.rshift = (format == Format::RGB24) ? firstShift : lastShift;
+				layout.gshift = 8;
+				layout.bshift = (format == Format::RGB24) ? lastShift : firstShift;
+			}
+			break;
+
+			case Format::INDEX8:
+			layout.bytesPerPixel = 1;
+			layout.rshift = 0;
+			layout.gshift = 0;
+			layout.bshift = 0;
+			layout.palette = palette;
+			break;
+		}
+		return layout;
+	}
+
+	bool PixelConverter::isLayoutSupported(const Layout& layout)
+	{
+		if(layout.bytesPerPixel == 1)
+		{
+			return (layout.palette != nullptr);
+		}
+		else if(layout.bytesPerPixel == 3 || layout.bytesPerPixel == 4)
+		{
+			unsigned int bits = layout.bytesPerPixel * 8;
+			unsigned int shifts[] = { layout.rshift, layout.gshift, layout.bshift, layout.hasAlpha ? layout.ashift : 0 };
+			for(unsigned int shift : shifts)
+			{
+				if((shift % 8) != 0 || shift >= bits)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+		return false;
+	}
+
+	PixelConverter::InstructionSet PixelConverter::getInstructionSet()
+	{
+		static const InstructionSet instructionSet = PixelConverter_detectInstructionSet();
+		return instructionSet;
+	}
+
+	void PixelConverter::convert(const Layout& layout, const void* src, size_t width, size_t height, size_t srcPitch, Color* dst, size_t dstPitch, PixelMask* mask, InstructionSet instructionSet)
+	{
+		if(!isLayoutSupported(layout))
+		{
+			throw IllegalArgumentException("layout", "pixel layout is not supported");
+		}
+		Uint32* maskData = nullptr;
+		if(mask != nullptr)
+		{
+			mask->resize(width*height);
+			mask->fill(false);
+			maskData = mask->getData();
+		}
+
+		PixelConverter_RowFunction convertRow = &PixelConverter_convertRowScalar;
+		switch(PixelConverter_clampInstructionSet(instructionSet))
+		{
+			case InstructionSet::SCALAR:
+			break;
+
+			case InstructionSet::SSE2:
+			#ifdef PIXELCONVERTER_SSE2
+				convertRow = &PixelConverter_convertRowSSE2;
+			#endif
+			break;
+
+			case InstructionSet::AVX2:
+			#ifdef PIXELCONVERTER_AVX2
+				convertRow = &PixelConverter_convertRowAVX2;
+			#endif
+			break;
+		}
+
+		const Uint8* srcRow = (const Uint8*)src;
+		Uint8* dstRow = (Uint8*)dst;
+		for(size_t y=0; y<height; y++)
+		{
+			convertRow(layout, srcRow, width, (Color*)dstRow, maskData, y*width);
+			srcRow += srcPitch;
+			dstRow += dstPitch;
+		}
+	}
+
+	void PixelConverter::createMask(const Color* pixels, size_t count, PixelMask* mask, InstructionSet instructionSet)
+	{
+		mask->resize(count);
+		mask->fill(false);
+		Uint32* maskData = mask->getData();
+		switch(PixelConverter_clampInstructionSet(instructionSet))
+		{
+			case InstructionSet::SCALAR:
+			PixelConverter_createMaskScalar(pixels, count, maskData);
+			break;
+
+			case InstructionSet::SSE2:
+			#ifdef PIXELCONVERTER_SSE2
+				PixelConverter_createMaskSSE2(pixels, count, maskData);
+			#else
+				PixelConverter_createMaskScalar(pixels, count, maskData);
+			#endif
+			break;
+
+			case InstructionSet::AVX2:
+			#ifdef PIXELCONVERTER_AVX2
+				PixelConverter_createMaskAVX2(pixels, count, maskData);
+			#else
+				PixelConverter_createMaskScalar(pixels, count, maskData);
+			#endif
+			break;
+		}
+	}
+
+	void PixelConverter::recolor(Color* pixels, size_t count, const std::pair<Color,Color>* colorSwaps, size_t swapCount, InstructionSet instructionSet)
+	{
+		if(swapCount == 0 || count == 0)
+		{
+			return;
+		}
+		PixelConverter_ColorSwapTable table(colorSwaps, swapCount);
+		#ifdef PIXELCONVERTER_AVX2
+			if(PixelConverter_clampInstructionSet(instructionSet) == InstructionSet::AVX2)
+			{
+				PixelConverter_recolorAVX2(table, pixels, count);
+				return;
+			}
+		#endif
+		// without a gather instruction, the lookups can't be vectorized
+		PixelConverter_recolorScalar(table, pixels, count);
+	}
+
+	void PixelConverter::composite(Color* pixels, const Color* mask, size_t count, InstructionSet instructionSet)
+	{
+		switch(PixelConverter_clampInstructionSet(instructionSet))
+		{
+			case InstructionSet::SCALAR:
+			PixelConverter_compositeScalar(pixels, mask, count);
+			break;
+
+			case InstructionSet::SSE2:
+			#ifdef PIXELCONVERTER_SSE2
+				PixelConverter_compositeSSE2(pixels, mask, count);
+			#else
+				PixelConverter_compositeScalar(pixels, mask, count);
+			#endif
+			break;
+
+			case InstructionSet::AVX2:
+			#ifdef PIXELCONVERTER_AVX2
+				PixelConverter_compositeAVX2(pixels, mask, count);
+			#else
+				PixelConverter_compositeScalar(pixels, mask, count);
+			#endif
+			break;
+		}
+	}
+
+	void PixelConverter::blend(Color* dst, const Color* src, size_t count, Image::BlendMode blendMode, InstructionSet instructionSet)
+	{
+		switch(PixelConverter_clampInstructionSet(instructionSet))
+		{
+			case InstructionSet::SCALAR:
+			PixelConverter_blendScalar(dst, src, count, blendMode);
+			break;
+
+			case InstructionSet::SSE2:
+			#ifdef PIXELCONVERTER_SSE2
+				PixelConverter_blendSSE2(dst, src, count, blendMode);
+			#else
+				PixelConverter_blendScalar(dst, src, count, blendMode);
+			#endif
+			break;
+
+			case InstructionSet::AVX2:
+			#ifdef PIXELCONVERTER_AVX2
+				PixelConverter_blendAVX2(dst, src, count, blendMode);
+			#else
+				PixelConverter_blendScalar(dst, src, count, blendMode);
+			#endif
+			break;
+		}
+	}
+}
@@ -6,6 +6,59 @@
 
 namespace fgl
 {
+	size_t PixelIterator_countSamples(double length, double increment)
+	{
+		if(!(increment > 0) || !(length > 0))
+		{
+			return 0;
+		}
+		return (size_t)Math::ceil(length/increment);
+	}
+	
+	Int64 PixelIterator_toFixed(double value)
+	{
+		return (Int64)Math::floor(value*(double)((Int64)1 << PixelIterator::Span::FIXED_SHIFT));
+	}
+	
+	Int64 PixelIterator_roundFixed(double value)
+	{
+		return (Int64)Math::floor((value*(double)((Int64)1 << PixelIterator::Span::FIXED_SHIFT)) + 0.5);
+	}
+	
+	void PixelIterator_setSpanColumns(PixelIterator::Span* span)
+	{
+		unsigned int firstColumn = span->getColumn(0);
+		unsigned int lastColumn = span->getColumn(span->count-1);
+		if(firstColumn <= lastColumn)
+		{
+			span->srcStart = firstColumn;
+			span->srcEnd = lastColumn+1;
+		}
+		else
+		{
+			span->srcStart = lastColumn;
+			span->srcEnd = firstColumn+1;
+		}
+	}
+	
+	PixelIterator::Span PixelIterator::Span::slice(size_t startSample, size_t endSample) const
+	{
+		Span span = *this;
+		size_t firstSample = Math::max(startSample, sample);
+		size_t lastSample = Math::min(endSample, sample+count);
+		if(firstSample >= lastSample)
+		{
+			span.count = 0;
+			span.srcEnd = span.srcStart;
+			return span;
+		}
+		span.start = start + ((Int64)(firstSample - sample)*step);
+		span.sample = firstSample;
+		span.count = lastSample - firstSample;
+		PixelIterator_setSpanColumns(&span);
+		return span;
+	}
+	
 	PixelIterator::PixelIterator(const Vector2u&dims, const RectangleU&srcrect, const RectangleD&dstrect, const RectangleD&looprect, double xincrement, double yincrement, bool mirrorHorizontal_arg, bool mirrorVertical_arg)
 	{
 		if((unsigned int)(srcrect.x + srcrect.width) > dims.x)
@@ -41,6 +94,7 @@ namespace fgl
 		currentPixelPoint = calculatePixelPoint(currentPoint);
 		currentPixelIndex = calculatePixelIndex(currentPixelPoint);
 		lastRowStartIndex = currentPixelIndex;
+		initializeSpans();
 	}
 	
 	PixelIterator::PixelIterator(const Vector2u&dims, const RectangleU&srcrect, const RectangleD&dstrect, const RectangleD&looprect, double xincrement, double yincrement, const TransformD&transform, const Vector2d&rat, bool mirrorHorizontal_arg, bool mirrorVertical_arg)
@@ -79,8 +133,42 @@ namespace fgl
 		currentPixelPoint = calculatePixelPoint(currentPoint);
 		currentPixelIndex = calculatePixelIndex(currentPixelPoint);
 		lastRowStartIndex = currentPixelIndex;
+		initializeSpans();
 	}
 
+	void PixelIterator::initializeSpans()
+	{
+		spanRows = PixelIterator_countSamples(loopRect.height, incr.y);
+		spanColumns = PixelIterator_countSamples(loopRect.width, incr.x);
+		spanRow = 0;
+		spanSample = 0;
+		srcLeftFixed = (Int64)srcRect.x << Span::FIXED_SHIFT;
+		srcRightFixed = (Int64)(srcRect.x + srcRect.width) << Span::FIXED_SHIFT;
+		srcTopFixed = (Int64)srcRect.y << Span::FIXED_SHIFT;
+		srcBottomFixed = (Int64)(srcRect.y + srcRect.height) << Span::FIXED_SHIFT;
+		double startX = loopRectRel.left*ratio.x;
+		double startY = loopRectRel.top*ratio.y;
+		// a mirrored sample at offset o lands in column (right - 1 - floor(o)), which is (right - 1 - o) rounded down in fixed point
+		if(mirrorHorizontal)
+		{
+			spanStartX = srcRightFixed - 1 - PixelIterator_toFixed(startX);
+		}
+		else
+		{
+			spanStartX = PixelIterator_toFixed(srcRectD.x + startX);
+		}
+		if(mirrorVertical)
+		{
+			spanStartY = srcBottomFixed - 1 - PixelIterator_toFixed(startY);
+		}
+		else
+		{
+			spanStartY = PixelIterator_toFixed(srcRectD.y + startY);
+		}
+		spanStepX = PixelIterator_roundFixed(incrpxl.x);
+		spanStepY = PixelIterator_roundFixed(incrpxl.y);
+	}
+	
 	Vector2d PixelIterator::calculatePixelPoint(const Vector2d& point)
 	{
 		if(usesTransform)
@@ -88,9 +176,10 @@ namespace fgl
 			Vector2d pixelPoint = inverseTransform.transform(point);
 			pixelPoint.x *= ratio.x;
 			pixelPoint.y *= ratio.y;
+			// a mirrored offset o lands in the pixel (right - 1 - floor(o)), so that an offset of 0 is the last pixel of the source rectangle
 			if(mirrorHorizontal)
 			{
-				pixelPoint.x = srcRectD.x + (srcRectD.width - (pixelPoint.x-srcRectD.x));
+				pixelPoint.x = srcRectRight - 1.0 - Math::floor(pixelPoint.x);
 			}
 			else
 			{
@@ -98,7 +187,7 @@ namespace fgl
 			}
 			if(mirrorVertical)
 			{
-				pixelPoint.y = srcRectD.y + (srcRectD.height - (pixelPoint.y-srcRectD.y));
+				pixelPoint.y = srcRectBottom - 1.0 - Math::floor(pixelPoint.y);
 			}
 			else
 			{
@@ -111,7 +200,7 @@ namespace fgl
 			Vector2d pixelPoint(point.x*ratio.x, point.y*ratio.y);
 			if(mirrorHorizontal)
 			{
-				pixelPoint.x = srcRectD.x + (srcRectD.width - (pixelPoint.x-srcRectD.x));
+				pixelPoint.x = srcRectRight - 1.0 - Math::floor(pixelPoint.x);
 			}
 			else
 			{
@@ -119,8 +208,9 @@ namespace fgl
 			}
 			if(mirrorVertical)
 			{
-				pixelPoint.y = srcRectD.y + (srcRectD.height - (pixelPoint.y-srcRectD.y));
-				row = Math::ceil(pixelPoint.y) - pixelPoint.y;
+				// the row offset is tracked unmirrored, so the image row changes at the same samples as it does without mirroring
+				row = pixelPoint.y - Math::floor(pixelPoint.y);
+				pixelPoint.y = srcRectBottom - 1.0 - Math::floor(pixelPoint.y);
 			}
 			else
 			{
@@ -176,7 +266,8 @@ namespace fgl
 				currentPoint.x += incr.x;
 				if(mirrorHorizontal)
 				{
-					currentPixelIndex -= incrpxl.x;
+					// mirrored columns are whole pixels, so step by the columns crossed rather than by the fractional increment
+					currentPixelIndex = lastRowStartIndex - (Math::floor(currentPoint.x*ratio.x) - Math::floor(loopRectRel.left*ratio.x));
 				}
 				else
 				{
@@ -221,6 +312,117 @@ namespace fgl
 		return running;
 	}
 
+	bool PixelIterator::nextPixelSpan(Span* span)
+	{
+		if(spanRow >= spanRows)
+		{
+			spanRow = 0;
+			spanSample = 0;
+			return false;
+		}
+		span->row = 0;
+		span->srcStart = 0;
+		span->srcEnd = 0;
+		span->start = 0;
+		span->step = 0;
+		span->sample = 0;
+		span->count = 0;
+		span->point = Vector2d(loopRect.x, loopRect.y + (((double)spanRow)*incr.y));
+		span->pointStep = incr.x;
+		if(usesTransform && spanColumns > 0)
+		{
+			// a transformed row of samples can cross any number of image rows, so each sample gets its own span
+			Vector2d point(loopRectRel.left + (((double)spanSample)*incr.x), loopRectRel.top + (((double)spanRow)*incr.y));
+			Vector2d pixelPoint = calculatePixelPoint(point);
+			span->sample = spanSample;
+			if(calculatePixelIndex(pixelPoint) >= 0)
+			{
+				span->row = (unsigned int)pixelPoint.y;
+				span->start = PixelIterator_toFixed(pixelPoint.x);
+				span->count = 1;
+				PixelIterator_setSpanColumns(span);
+			}
+			spanSample++;
+			if(spanSample >= spanColumns)
+			{
+				spanSample = 0;
+				spanRow++;
+			}
+			return true;
+		}
+		
+		Int64 y = 0;
+		if(mirrorVertical)
+		{
+			y = spanStartY - ((Int64)spanRow*spanStepY);
+		}
+		else
+		{
+			y = spanStartY + ((Int64)spanRow*spanStepY);
+		}
+		spanRow++;
+		if(y < srcTopFixed || y >= srcBottomFixed || spanColumns == 0)
+		{
+			return true;
+		}
+		
+		// find the range of samples that land inside the source rectangle
+		Int64 x = spanStartX;
+		Int64 step = spanStepX;
+		Int64 columns = (Int64)spanColumns;
+		Int64 firstSample = 0;
+		Int64 endSample = 0;
+		if(step == 0)
+		{
+			if(x >= srcLeftFixed && x < srcRightFixed)
+			{
+				endSample = columns;
+			}
+		}
+		else if(mirrorHorizontal)
+		{
+			if(x >= srcRightFixed)
+			{
+				firstSample = ((x - srcRightFixed)/step) + 1;
+			}
+			if(x >= srcLeftFixed)
+			{
+				endSample = ((x - srcLeftFixed)/step) + 1;
+			}
+		}
+		else
+		{
+			if(x < srcLeftFixed)
+			{
+				firstSample = ((srcLeftFixed - x) + step - 1)/step;
+			}
+			if(x < srcRightFixed)
+			{
+				endSample = ((srcRightFixed - x) + step - 1)/step;
+			}
+		}
+		if(endSample > columns)
+		{
+			endSample = columns;
+		}
+		if(firstSample >= endSample)
+		{
+			return true;
+		}
+		span->row = (unsigned int)(y >> Span::FIXED_SHIFT);
+		span->step = mirrorHorizontal ? -step : step;
+		span->start = x + (firstSample*span->step);
+		span->sample = (size_t)firstSample;
+		span->count = (size_t)(endSample - firstSample);
+		PixelIterator_setSpanColumns(span);
+		return true;
+	}
+
+	bool PixelIterator::hasTransform() const
+	{
+		return usesTransform;
+	}
+
 	Vector2d PixelIterator::getCurrentPixelPoint() const
 	{
 		return currentPixelPoint;
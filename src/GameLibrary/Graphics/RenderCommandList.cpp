@@ -0,0 +1,93 @@
+#include <GameLibrary/Graphics/RenderCommandList.hpp>
+#include <cstring>
+
+namespace fgl
+{
+	struct RenderCommandList_Header
+	{
+		Uint32 type;
+		Uint32 size;
+		Uint32 extraSize;
+		Uint32 padding;
+	};
+
+	size_t RenderCommandList_align(size_t size)
+	{
+		return (size + 7) & ~((size_t)7);
+	}
+
+	RenderCommandList::RenderCommandList()
+		: length(0),
+		commandCount(0)
+	{
+		//
+	}
+
+	void RenderCommandList::clear()
+	{
+		length = 0;
+		commandCount = 0;
+	}
+
+	void* RenderCommandList::add(Uint32 type, const void* data, size_t size, size_t extraSize)
+	{
+		size_t dataOffset = length + sizeof(RenderCommandList_Header);
+		size_t extraOffset = dataOffset + RenderCommandList_align(size);
+		size_t end = extraOffset + RenderCommandList_align(extraSize);
+		if(end > buffer.size())
+		{
+			size_t capacity = buffer.size() * 2;
+			if(capacity < end)
+			{
+				capacity = end;
+			}
+			if(capacity < 4096)
+			{
+				capacity = 4096;
+			}
+			buffer.resize(capacity);
+		}
+		RenderCommandList_Header header;
+		header.type = type;
+		header.size = (Uint32)size;
+		header.extraSize = (Uint32)extraSize;
+		header.padding = 0;
+		std::memcpy(buffer.data() + length, &header, sizeof(header));
+		if(size > 0)
+		{
+			std::memcpy(buffer.data() + dataOffset, data, size);
+		}
+		length = end;
+		commandCount++;
+		return (void*)(buffer.data() + extraOffset);
+	}
+
+	bool RenderCommandList::read(size_t* offset, Command* command) const
+	{
+		if(*offset >= length)
+		{
+			return false;
+		}
+		RenderCommandList_Header header;
+		std::memcpy(&header, buffer.data() + *offset, sizeof(header));
+		size_t dataOffset = *offset + sizeof(RenderCommandList_Header);
+		size_t extraOffset = dataOffset + RenderCommandList_align(header.size);
+		command->type = header.type;
+		command->data = (const void*)(buffer.data() + dataOffset);
+		command->size = (size_t)header.size;
+		command->extra = (const void*)(buffer.data() + extraOffset);
+		command->extraSize = (size_t)header.extraSize;
+		*offset = extraOffset + RenderCommandList_align(header.extraSize);
+		return true;
+	}
+
+	size_t RenderCommandList::getCommandCount() const
+	{
+		return commandCount;
+	}
+
+	size_t RenderCommandList::getByteSize() const
+	{
+		return length;
+	}
+}
@@ -1,12 +1,16 @@
 
 #include <GameLibrary/Graphics/TextureImage.hpp>
 #include <GameLibrary/Graphics/Image.hpp>
+#include <GameLibrary/Graphics/PixelConverter.hpp>
+#include <GameLibrary/Exception/IllegalArgumentException.hpp>
 #include <GameLibrary/Exception/InitializeLibraryException.hpp>
 #include <GameLibrary/Exception/Graphics/ImageOutOfBoundsException.hpp>
 #include <GameLibrary/Exception/Graphics/TextureImageCreateException.hpp>
 #include <GameLibrary/Exception/Graphics/TextureImageUpdateException.hpp>
 #include <SDL.h>
 #include <SDL_image.h>
+#include <cstring>
+#include "../SDL_ext/SDL_PixelFormat_ext.hpp"
 #include "../SDL_ext/SDL_RWops_ext.hpp"
 
 namespace fgl
@@ -54,10 +58,7 @@ namespace fgl
 			//TODO check for integer overflow
 			size_t total = w*h;
 			pixels.resize(total);
-			for(size_t i=0; i<total; i++)
-			{
-				pixels[i] = false;
-			}
+			pixels.fill(false);
 		}
 		else
 		{
@@ -68,8 +69,7 @@ namespace fgl
 			}
 			width = 0;
 			height = 0;
-			pixels.resize(0);
-			pixels.shrink_to_fit();
+			pixels.clear();
 		}
 	}
 
@@ -113,31 +113,38 @@ namespace fgl
 		height = 0;
 	}
 
-	SDL_Texture* TextureImage_loadFromSDLSurface(SDL_Surface* surface, std::vector<bool>& pixels, SDL_Renderer* renderer, String* error, bool freeSurface)
+	SDL_Texture* TextureImage_loadFromSDLSurface(SDL_Surface* surface, PixelMask& pixels, SDL_Renderer* renderer, String* error, bool freeSurface)
 	{
-		SDL_Surface* convertedSurface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA8888, 0);
-		if(convertedSurface==nullptr)
+		PixelConverter::Layout layout;
+		Color palette[256];
+		if(!SDL_GetPixelConverterLayout(surface->format, &layout, palette))
 		{
-			if(error!=nullptr)
+			//formats without whole byte channels (eg 16 bit pixels) are converted by SDL first
+			SDL_Surface* convertedSurface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA8888, 0);
+			if(convertedSurface==nullptr)
 			{
-				*error = SDL_GetError();
+				if(error!=nullptr)
+				{
+					*error = SDL_GetError();
+				}
+				if(freeSurface)
+				{
+					SDL_FreeSurface(surface);
+				}
+				return nullptr;
 			}
 			if(freeSurface)
 			{
 				SDL_FreeSurface(surface);
 			}
-			return nullptr;
+			surface = convertedSurface;
+			freeSurface = true;
+			SDL_GetPixelConverterLayout(surface->format, &layout, palette);
 		}
-		if(freeSurface)
-		{
-			SDL_FreeSurface(surface);
-		}
-		surface = convertedSurface;
 
 		//TODO check for integer overflow
 		size_t w = (size_t)surface->w;
 		size_t h = (size_t)surface->h;
-		size_t totalSize = w*h;
 		
 		SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, (int)w, (int)h);
 		if(texture == nullptr)
@@ -146,7 +153,10 @@ namespace fgl
 			{
 				*error = SDL_GetError();
 			}
-			SDL_FreeSurface(surface);
+			if(freeSurface)
+			{
+				SDL_FreeSurface(surface);
+			}
 			return nullptr;
 		}
 
@@ -160,96 +170,48 @@ namespace fgl
 					*error = SDL_GetError();
 				}
 				SDL_DestroyTexture(texture);
-				SDL_FreeSurface(convertedSurface);
+				if(freeSurface)
+				{
+					SDL_FreeSurface(surface);
+				}
 				return nullptr;
 			}
 		}
-		
-		SDL_UpdateTexture(texture, nullptr, surface->pixels, surface->pitch);
-		
-		unsigned int bpp = (unsigned int)surface->format->BytesPerPixel;
-		
-		unsigned int rmask = (unsigned int)surface->format->Rmask;
-		unsigned int rshift = (unsigned int)surface->format->Rshift;
-		unsigned int gmask = (unsigned int)surface->format->Gmask;
-		unsigned int gshift = (unsigned int)surface->format->Gshift;
-		unsigned int bmask = (unsigned int)surface->format->Bmask;
-		unsigned int bshift = (unsigned int)surface->format->Bshift;
-		unsigned int amask = (unsigned int)surface->format->Amask;
-		unsigned int ashift = (unsigned int)surface->format->Ashift;
-
-		pixels.resize(totalSize);
-		pixels.shrink_to_fit();
-
-		unsigned int pitchDif = ((unsigned int)surface->pitch - ((unsigned int)w*bpp));
 
-		size_t counter = 0;
-		byte*surfacePixels = (byte*)surface->pixels;
-
-		size_t i=0;
-		for(size_t ycnt=0; ycnt<h; ycnt++)
+		void* texturePixels;
+		int texturePitch;
+		if(SDL_LockTexture(texture, nullptr, &texturePixels, &texturePitch) < 0)
 		{
-			for(size_t xcnt = 0; xcnt < w; xcnt++)
+			if(error!=nullptr)
 			{
-				Color px;
-				switch(bpp)
-				{
-					case 1:
-					px.r = surfacePixels[counter];
-					px.g = surfacePixels[counter];
-					px.b = surfacePixels[counter];
-					px.a = 255;
-					break;
-
-					case 2:
-					px.r = surfacePixels[counter];
-					px.g = surfacePixels[counter+1];
-					px.b = surfacePixels[counter+1];
-					px.a = 255;
-					break;
-
-					case 3:
-					{
-						Uint32 color = *((Uint32*)&surfacePixels[counter]);
-						px.r = (byte)((color & rmask) >> rshift);
-						px.g = (byte)((color & gmask) >> gshift);
-						px.b = (byte)((color & bmask) >> bshift);
-						px.a = 255;
-					}
-					break;
-
-					case 4:
-					{
-						Uint32 color = *((Uint32*)&surfacePixels[counter]);
-						px.r = (byte)((color & rmask) >> rshift);
-						px.g = (byte)((color & gmask) >> gshift);
-						px.b = (byte)((color & bmask) >> bshift);
-						px.a = (byte)((color & amask) >> ashift);
-					}
-					break;
-				}
-
-				if(px.a>0)
-				{
-					pixels[i] = true;
-				}
-				else
-				{
-					pixels[i] = false;
-				}
-				i++;
-				counter += (size_t)bpp;
+				*error = SDL_GetError();
+			}
+			if(mustlock != 0)
+			{
+				SDL_UnlockSurface(surface);
 			}
-			counter += (size_t)pitchDif;
+			SDL_DestroyTexture(texture);
+			if(freeSurface)
+			{
+				SDL_FreeSurface(surface);
+			}
+			return nullptr;
 		}
 
+		//Color has the same memory layout as an RGBA8888 pixel, so the surface is converted straight into the texture, building the mask in the same pass
+		PixelConverter::convert(layout, surface->pixels, w, h, (size_t)surface->pitch, (Color*)texturePixels, (size_t)texturePitch, &pixels);
+
+		SDL_UnlockTexture(texture);
 		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
 
 		if(mustlock != 0)
 		{
 			SDL_UnlockSurface(surface);
 		}
-		SDL_FreeSurface(surface);
+		if(freeSurface)
+		{
+			SDL_FreeSurface(surface);
+		}
 
 		return texture;
 	}
@@ -340,8 +302,17 @@ namespace fgl
 	}
 
 	bool TextureImage::loadFromImage(const Image& image, Graphics& graphics, String*error)
+	{
+		return loadFromImage(image, createPixelMask(image), graphics, error);
+	}
+
+	bool TextureImage::loadFromImage(const Image& image, PixelMask&& pixelMask, Graphics& graphics, String*error)
 	{
 		const ArrayList<Color>& image_pixels = image.getPixels();
+		if(pixelMask.size() != image_pixels.size())
+		{
+			throw IllegalArgumentException("pixelMask", "size does not match the size of the image");
+		}
 		if(image_pixels.size()>0)
 		{
 			//TODO check for integer overflow
@@ -362,7 +333,6 @@ namespace fgl
 			//TODO check for integer overflow
 			size_t w = image.getWidth();
 			size_t h = image.getHeight();
-			size_t totalsize = w*h;
 			void* pixelptr;
 			int pitch;
 			if(SDL_LockTexture(newTexture, nullptr, &pixelptr, &pitch) < 0)
@@ -377,22 +347,15 @@ namespace fgl
 
 			texture = (void*)newTexture;
 
-			pixels.resize(totalsize);
-			pixels.shrink_to_fit();
+			pixels = std::move(pixelMask);
 
-			fgl::Uint32* texture_pixels = (Uint32*)pixelptr;
-			for(size_t i=0; i<totalsize; i++)
+			//Color has the same memory layout as an RGBA8888 pixel, so rows are copied straight into the texture
+			const Color* image_pixels_ptr = image_pixels.getData();
+			Uint8* texture_row = (Uint8*)pixelptr;
+			for(size_t y=0; y<h; y++)
 			{
-				const Color& px = image_pixels[i];
-				if(px.a>0)
-				{
-					pixels[i] = true;
-				}
-				else
-				{
-					pixels[i] = false;
-				}
-				texture_pixels[i] = px.getRGBA();
+				std::memcpy(texture_row, image_pixels_ptr + (y*w), w*sizeof(Color));
+				texture_row += pitch;
 			}
 
 			SDL_UnlockTexture((SDL_Texture*)texture);
@@ -412,13 +375,20 @@ namespace fgl
 			}
 			width = 0;
 			height = 0;
-			pixels.resize(0);
-			pixels.shrink_to_fit();
+			pixels.clear();
 			return true;
 		}
 		return false;
 	}
 
+	PixelMask TextureImage::createPixelMask(const Image& image)
+	{
+		const ArrayList<Color>& image_pixels = image.getPixels();
+		PixelMask pixelMask;
+		PixelConverter::createMask(image_pixels.getData(), image_pixels.size(), &pixelMask);
+		return pixelMask;
+	}
+
 	bool TextureImage::checkPixel(size_t index) const
 	{
 		if(index < pixels.size())
@@ -437,7 +407,56 @@ namespace fgl
 		throw ImageOutOfBoundsException(x, y, width, height);
 	}
 
-	const std::vector<bool>& TextureImage::getPixelBools() const
+	bool TextureImage::checkPixelSpan(const PixelIterator::Span& span, size_t* firstSample, size_t* lastSample) const
+	{
+		if(span.count == 0)
+		{
+			return false;
+		}
+		if(span.row >= height || span.srcEnd > width)
+		{
+			throw ImageOutOfBoundsException(span.srcEnd-1, span.row, width, height);
+		}
+		size_t rowIndex = width*span.row;
+		Int64 stepSize = (span.step < 0) ? -span.step : span.step;
+		if(stepSize <= ((Int64)1 << PixelIterator::Span::FIXED_SHIFT))
+		{
+			// every column between srcStart and srcEnd has a sample in it
+			if(!pixels.any(rowIndex+span.srcStart, rowIndex+span.srcEnd))
+			{
+				return false;
+			}
+			else if(firstSample==nullptr && lastSample==nullptr)
+			{
+				return true;
+			}
+		}
+		size_t first = 0;
+		while(first < span.count && !pixels.get(rowIndex+span.getColumn(first)))
+		{
+			first++;
+		}
+		if(first == span.count)
+		{
+			return false;
+		}
+		if(firstSample != nullptr)
+		{
+			*firstSample = span.sample + first;
+		}
+		if(lastSample != nullptr)
+		{
+			size_t last = span.count - 1;
+			while(last > first && !pixels.get(rowIndex+span.getColumn(last)))
+			{
+				last--;
+			}
+			*lastSample = span.sample + last;
+		}
+		return true;
+	}
+
+	const PixelMask& TextureImage::getPixelMask() const
 	{
 		return pixels;
 	}
@@ -0,0 +1,459 @@
+
+#ifdef _WIN32
+	#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <GameLibrary/IO/AssetPack.hpp>
+#include <GameLibrary/IO/FileTools.hpp>
+#include <GameLibrary/Utilities/PlatformChecks.hpp>
+#include <GameLibrary/Exception/OutOfBoundsException.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#if defined(TARGETPLATFORM_WINDOWS)
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace fgl
+{
+	static_assert(sizeof(AssetPack::Header) == 32, "AssetPack::Header must match the pack file layout");
+	static_assert(sizeof(AssetPack::IndexEntry) == 32, "AssetPack::IndexEntry must match the pack file layout");
+
+	const char AssetPack::MAGIC[8] = { 'F', 'G', 'L', 'P', 'A', 'C', 'K', '\0' };
+	const uint32_t AssetPack::VERSION = 1;
+	const size_t AssetPack::ALIGNMENT = 16;
+
+	namespace
+	{
+		int AssetPack_comparePaths(const char* left, size_t leftLength, const char* right, size_t rightLength)
+		{
+			int cmp = std::memcmp(left, right, std::min(leftLength, rightLength));
+			if(cmp != 0)
+			{
+				return cmp;
+			}
+			if(leftLength < rightLength)
+			{
+				return -1;
+			}
+			else if(leftLength > rightLength)
+			{
+				return 1;
+			}
+			return 0;
+		}
+
+		bool AssetPack_writePadding(FILE* file, uint64_t& offset, size_t alignment)
+		{
+			static const char zeros[64] = {0};
+			size_t padding = (size_t)((alignment - (offset % alignment)) % alignment);
+			if(padding > 0)
+			{
+				if(std::fwrite(zeros, 1, padding, file) != padding)
+				{
+					return false;
+				}
+				offset += padding;
+			}
+			return true;
+		}
+	}
+
+	AssetPack::AssetPack()
+		: mappedData(nullptr),
+		mappedSize(0)
+		#ifdef _WIN32
+		, fileHandle(nullptr),
+		mappingHandle(nullptr)
+		#endif
+	{
+		//
+	}
+
+	AssetPack::~AssetPack()
+	{
+		close();
+	}
+
+	bool AssetPack::loadFromPath(const String& path, String* error)
+	{
+		close();
+		#if defined(TARGETPLATFORM_WINDOWS)
+			HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+			if(file == INVALID_HANDLE_VALUE)
+			{
+				if(error!=nullptr)
+				{
+					*error = "Unable to open pack file";
+				}
+				return false;
+			}
+			LARGE_INTEGER fileSize;
+			if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+			{
+				CloseHandle(file);
+				if(error!=nullptr)
+				{
+					*error = "Unable to read pack file size";
+				}
+				return false;
+			}
+			HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if(mapping == NULL)
+			{
+				CloseHandle(file);
+				if(error!=nullptr)
+				{
+					*error = "Unable to map pack file";
+				}
+				return false;
+			}
+			void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if(data == NULL)
+			{
+				CloseHandle(mapping);
+				CloseHandle(file);
+				if(error!=nullptr)
+				{
+					*error = "Unable to map pack file";
+				}
+				return false;
+			}
+			fileHandle = (void*)file;
+			mappingHandle = (void*)mapping;
+			mappedData = (const unsigned char*)data;
+			mappedSize = (size_t)fileSize.QuadPart;
+		#else
+			int fd = open(path, O_RDONLY);
+			if(fd == -1)
+			{
+				if(error!=nullptr)
+				{
+					*error = (String)"Unable to open pack file: " + std::strerror(errno);
+				}
+				return false;
+			}
+			struct stat fileStat;
+			if(fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+			{
+				::close(fd);
+				if(error!=nullptr)
+				{
+					*error = "Unable to read pack file size";
+				}
+				return false;
+			}
+			void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			// the mapping stays valid after the file descriptor is closed
+			::close(fd);
+			if(data == MAP_FAILED)
+			{
+				if(error!=nullptr)
+				{
+					*error = (String)"Unable to map pack file: " + std::strerror(errno);
+				}
+				return false;
+			}
+			mappedData = (const unsigned char*)data;
+			mappedSize = (size_t)fileStat.st_size;
+		#endif
+
+		// validate the header and index, so that lookups don't need to check bounds
+		String validationError;
+		const Header* header = (const Header*)mappedData;
+		if(mappedSize < sizeof(Header) || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0)
+		{
+			validationError = "File is not an asset pack";
+		}
+		else if(header->version != VERSION)
+		{
+			validationError = (String)"Unsupported asset pack version " + (unsigned int)header->version;
+		}
+		else if(((uint64_t)header->entryCount * sizeof(IndexEntry)) > (mappedSize - sizeof(Header))
+			|| header->pathsOffset > mappedSize || header->pathsSize > (mappedSize - header->pathsOffset))
+		{
+			validationError = "Asset pack index is corrupt";
+		}
+		else
+		{
+			const IndexEntry* index = (const IndexEntry*)(mappedData + sizeof(Header));
+			for(size_t i=0; i<header->entryCount; i++)
+			{
+				const IndexEntry& entry = index[i];
+				if(entry.pathOffset > header->pathsSize || entry.pathLength > (header->pathsSize - entry.pathOffset)
+					|| entry.dataOffset > mappedSize || entry.dataSize > (mappedSize - entry.dataOffset))
+				{
+					validationError = "Asset pack index is corrupt";
+					break;
+				}
+			}
+		}
+		if(validationError.length() > 0)
+		{
+			close();
+			if(error!=nullptr)
+			{
+				*error = validationError;
+			}
+			return false;
+		}
+		this->path = path;
+		return true;
+	}
+
+	void AssetPack::close()
+	{
+		if(mappedData == nullptr)
+		{
+			return;
+		}
+		#if defined(TARGETPLATFORM_WINDOWS)
+			UnmapViewOfFile((LPCVOID)mappedData);
+			CloseHandle((HANDLE)mappingHandle);
+			CloseHandle((HANDLE)fileHandle);
+			mappingHandle = nullptr;
+			fileHandle = nullptr;
+		#else
+			munmap((void*)mappedData, mappedSize);
+		#endif
+		mappedData = nullptr;
+		mappedSize = 0;
+		path = "";
+	}
+
+	bool AssetPack::isOpen() const
+	{
+		return (mappedData != nullptr);
+	}
+
+	const String& AssetPack::getPath() const
+	{
+		return path;
+	}
+
+	const AssetPack::IndexEntry* AssetPack::getIndex() const
+	{
+		return (const IndexEntry*)(mappedData + sizeof(Header));
+	}
+
+	bool AssetPack::find(const String& path, Entry* entry) const
+	{
+		if(mappedData == nullptr)
+		{
+			return false;
+		}
+		const Header* header = (const Header*)mappedData;
+		const IndexEntry* index = getIndex();
+		const char* paths = (const char*)(mappedData + header->pathsOffset);
+		const char* searchPath = path.getData();
+		size_t searchLength = path.length();
+		// binary search the sorted index
+		size_t lower = 0;
+		size_t upper = header->entryCount;
+		while(lower < upper)
+		{
+			size_t middle = lower + ((upper - lower) / 2);
+			const IndexEntry& indexEntry = index[middle];
+			int cmp = AssetPack_comparePaths(paths + indexEntry.pathOffset, indexEntry.pathLength, searchPath, searchLength);
+			if(cmp < 0)
+			{
+				lower = middle + 1;
+			}
+			else if(cmp > 0)
+			{
+				upper = middle;
+			}
+			else
+			{
+				if(entry != nullptr)
+				{
+					entry->data = (const void*)(mappedData + indexEntry.dataOffset);
+					entry->size = (size_t)indexEntry.dataSize;
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+
+	size_t AssetPack::getEntryCount() const
+	{
+		if(mappedData == nullptr)
+		{
+			return 0;
+		}
+		return ((const Header*)mappedData)->entryCount;
+	}
+
+	String AssetPack::getEntryPath(size_t index) const
+	{
+		if(index >= getEntryCount())
+		{
+			throw OutOfBoundsException("index is out of bounds");
+		}
+		const Header* header = (const Header*)mappedData;
+		const IndexEntry& indexEntry = getIndex()[index];
+		return String((const char*)(mappedData + header->pathsOffset + indexEntry.pathOffset), (size_t)indexEntry.pathLength);
+	}
+
+	bool AssetPack::build(const String& path, const ArrayList<std::pair<String, String>>& files, String* error)
+	{
+		struct BuildEntry
+		{
+			String packPath;
+			String sourcePath;
+			uint64_t size;
+		};
+
+		// gather the sizes of the source files
+		std::vector<BuildEntry> entries;
+		entries.reserve(files.size());
+		for(auto& file : files)
+		{
+			BuildEntry entry;
+			entry.packPath = normalizePath(file.first);
+			entry.sourcePath = file.second;
+			FILE* sourceFile = FileTools::openFile(entry.sourcePath, "rb", error);
+			if(sourceFile == nullptr)
+			{
+				return false;
+			}
+			std::fseek(sourceFile, 0, SEEK_END);
+			long size = std::ftell(sourceFile);
+			FileTools::closeFile(sourceFile);
+			if(size < 0)
+			{
+				if(error!=nullptr)
+				{
+					*error = "Unable to read size of " + entry.sourcePath;
+				}
+				return false;
+			}
+			entry.size = (uint64_t)size;
+			entries.push_back(std::move(entry));
+		}
+
+		// sort the entries by path so that they can be binary searched
+		std::sort(entries.begin(), entries.end(), [](const BuildEntry& left, const BuildEntry& right) {
+			return AssetPack_comparePaths(left.packPath.getData(), left.packPath.length(), right.packPath.getData(), right.packPath.length()) < 0;
+		});
+		for(size_t i=1; i<entries.size(); i++)
+		{
+			if(entries[i-1].packPath == entries[i].packPath)
+			{
+				if(error!=nullptr)
+				{
+					*error = "Duplicate path in asset pack: " + entries[i].packPath;
+				}
+				return false;
+			}
+		}
+
+		// lay out the index, path table, and file contents
+		Header header;
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.entryCount = (uint32_t)entries.size();
+		header.pathsOffset = sizeof(Header) + (entries.size() * sizeof(IndexEntry));
+		header.pathsSize = 0;
+		std::vector<IndexEntry> index;
+		index.reserve(entries.size());
+		for(auto& entry : entries)
+		{
+			IndexEntry indexEntry;
+			indexEntry.pathOffset = header.pathsSize;
+			indexEntry.pathLength = (uint32_t)entry.packPath.length();
+			indexEntry.flags = 0;
+			indexEntry.dataOffset = 0;
+			indexEntry.dataSize = entry.size;
+			header.pathsSize += entry.packPath.length();
+			index.push_back(indexEntry);
+		}
+		uint64_t dataOffset = header.pathsOffset + header.pathsSize;
+		for(auto& indexEntry : index)
+		{
+			dataOffset += (ALIGNMENT - (dataOffset % ALIGNMENT)) % ALIGNMENT;
+			indexEntry.dataOffset = dataOffset;
+			dataOffset += indexEntry.dataSize;
+		}
+
+		// write the pack file
+		FILE* packFile = FileTools::openFile(path, "wb", error);
+		if(packFile == nullptr)
+		{
+			return false;
+		}
+		bool success = true;
+		uint64_t offset = 0;
+		success = success && (std::fwrite(&header, sizeof(Header), 1, packFile) == 1);
+		success = success && (index.size() == 0 || std::fwrite(index.data(), sizeof(IndexEntry), index.size(), packFile) == index.size());
+		offset = header.pathsOffset;
+		for(size_t i=0; success && i<entries.size(); i++)
+		{
+			auto& packPath = entries[i].packPath;
+			success = (std::fwrite(packPath.getData(), 1, packPath.length(), packFile) == packPath.length());
+			offset += packPath.length();
+		}
+		std::vector<char> buffer(64 * 1024);
+		for(size_t i=0; success && i<entries.size(); i++)
+		{
+			success = AssetPack_writePadding(packFile, offset, ALIGNMENT);
+			if(!success)
+			{
+				break;
+			}
+			FILE* sourceFile = FileTools::openFile(entries[i].sourcePath, "rb", error);
+			if(sourceFile == nullptr)
+			{
+				FileTools::closeFile(packFile);
+				return false;
+			}
+			uint64_t remaining = entries[i].size;
+			while(success && remaining > 0)
+			{
+				size_t chunkSize = (size_t)std::min<uint64_t>(remaining, buffer.size());
+				success = (std::fread(buffer.data(), 1, chunkSize, sourceFile) == chunkSize)
+					&& (std::fwrite(buffer.data(), 1, chunkSize, packFile) == chunkSize);
+				remaining -= chunkSize;
+			}
+			FileTools::closeFile(sourceFile);
+			offset += entries[i].size;
+		}
+		if(std::fflush(packFile) != 0)
+		{
+			success = false;
+		}
+		FileTools::closeFile(packFile);
+		if(!success && error!=nullptr)
+		{
+			*error = "Unable to write asset pack " + path;
+		}
+		return success;
+	}
+
+	String AssetPack::normalizePath(const String& path)
+	{
+		String normalized = path.replace('\\', '/');
+		while(normalized.startsWith("./"))
+		{
+			normalized = normalized.substring(2);
+		}
+		size_t start = 0;
+		while(start < normalized.length() && normalized.charAt(start) == '/')
+		{
+			start++;
+		}
+		if(start > 0)
+		{
+			normalized = normalized.substring(start);
+		}
+		return normalized;
+	}
+}
@@ -1,26 +1,25 @@
-
 #include <GameLibrary/IO/Console.hpp>
-#include <iostream>
+#include <GameLibrary/IO/Logger.hpp>
 
 namespace fgl
 {
 	void Console::write(const String& output)
 	{
-		std::cout << output;
+		Logger::logOutput(Logger::LEVEL_INFO, output, false);
 	}
 
 	void Console::writeLine(const String& output)
 	{
-		std::cout << output << std::endl;
+		Logger::logOutput(Logger::LEVEL_INFO, output, true);
 	}
 
 	void Console::writeError(const String& output)
 	{
-		std::cerr << output;
+		Logger::logOutput(Logger::LEVEL_ERROR, output, false);
 	}
 
 	void Console::writeErrorLine(const String& output)
 	{
-		std::cerr << output << std::endl;
+		Logger::logOutput(Logger::LEVEL_ERROR, output, true);
 	}
 }
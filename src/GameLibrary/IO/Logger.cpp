@@ -0,0 +1,526 @@
+
+#include <GameLibrary/IO/Logger.hpp>
+#include <GameLibrary/IO/FileTools.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fgl
+{
+	constexpr size_t Logger::THREAD_BUFFER_SIZE;
+
+	std::atomic<Uint8> Logger::level(Logger::LEVEL_DEBUG);
+
+	// how often the writer drains the thread buffers when nothing is waiting on a flush
+	static const std::chrono::milliseconds Logger_writeInterval = std::chrono::milliseconds(5);
+	// how long a repeated line is held back before its repeat count is written anyway
+	static const Int64 Logger_repeatInterval = 1000000000;
+
+	struct LoggerRecord
+	{
+		Int64 time = 0;
+		Logger::Level level = Logger::LEVEL_INFO;
+		// written to the console without a level prefix, as Console output
+		bool raw = false;
+		bool newLine = true;
+		size_t suppressedCount = 0;
+		String text;
+		// the time of the first message in the line this message ends or continues, set by the writer
+		Int64 lineTime = 0;
+	};
+
+	// a single producer, single consumer ring of the messages logged by one thread
+	struct LoggerThreadBuffer
+	{
+		LoggerRecord records[Logger::THREAD_BUFFER_SIZE];
+		// written by the owning thread
+		std::atomic<size_t> head;
+		// written by the writer thread
+		std::atomic<size_t> tail;
+		// set once the owning thread exits, so the buffer can be freed after it's drained
+		std::atomic<bool> finished;
+		// the line time of the thread's unfinished line of partial Console output, used only by the writer
+		Int64 openLineTime = 0;
+		bool hasOpenLine = false;
+
+		LoggerThreadBuffer()
+			: head(0),
+			tail(0),
+			finished(false) {
+			//
+		}
+	};
+
+	struct LoggerRegistry
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<LoggerThreadBuffer>> buffers;
+		std::atomic<size_t> droppedCount;
+		size_t reportedDroppedCount = 0;
+		Int64 startTime = 0;
+
+		std::thread writer;
+		std::condition_variable wakeCondition;
+		std::condition_variable flushCondition;
+		bool writerRunning = false;
+		// set at exit, after which messages are written on the thread that logs them
+		std::atomic<bool> stopped;
+		size_t flushRequests = 0;
+		size_t completedFlushes = 0;
+
+		bool consoleEnabled = true;
+		FILE* file = nullptr;
+		// false while the file is in the middle of a line of partial Console output
+		bool fileLineStarted = false;
+
+		std::vector<LoggerRecord> batch;
+		LoggerRecord lastLine;
+		bool hasLastLine = false;
+		size_t repeatCount = 0;
+		Int64 repeatStartTime = 0;
+
+		LoggerRegistry()
+			: droppedCount(0),
+			stopped(false) {
+			//
+		}
+	};
+
+	LoggerRegistry& Logger_getRegistry()
+	{
+		// never destroyed, since threads can still be logging while the program exits
+		static LoggerRegistry* registry = new LoggerRegistry();
+		return *registry;
+	}
+
+	// marks the thread's buffer as finished when the thread exits
+	struct LoggerThreadHandle
+	{
+		LoggerThreadBuffer* buffer = nullptr;
+
+		~LoggerThreadHandle()
+		{
+			if(buffer != nullptr)
+			{
+				buffer->finished.store(true, std::memory_order_release);
+			}
+		}
+	};
+
+	static thread_local LoggerThreadHandle Logger_threadHandle;
+
+	Int64 Logger_now()
+	{
+		return (Int64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	const char* Logger_getLevelName(Logger::Level level)
+	{
+		switch(level)
+		{
+			case Logger::LEVEL_DEBUG:
+			return "DEBUG";
+
+			case Logger::LEVEL_INFO:
+			return "INFO";
+
+			case Logger::LEVEL_WARNING:
+			return "WARNING";
+
+			case Logger::LEVEL_ERROR:
+			return "ERROR";
+
+			default:
+			return "";
+		}
+	}
+
+	// writes one message to the console and the log file. the registry must be locked
+	void Logger_writeText(LoggerRegistry& registry, const LoggerRecord& record, const String& text)
+	{
+		if(registry.consoleEnabled)
+		{
+			FILE* stream = (record.level >= Logger::LEVEL_WARNING) ? stderr : stdout;
+			if(!record.raw)
+			{
+				std::fprintf(stream, "[%s] ", Logger_getLevelName(record.level));
+			}
+			std::fwrite((const char*)text, 1, text.length(), stream);
+			if(record.newLine)
+			{
+				std::fputc('\n', stream);
+			}
+		}
+		if(registry.file != nullptr)
+		{
+			if(!registry.fileLineStarted)
+			{
+				double seconds = (double)(record.time - registry.startTime) / 1000000000.0;
+				std::fprintf(registry.file, "[%.3f] %s ", seconds, Logger_getLevelName(record.level));
+			}
+			std::fwrite((const char*)text, 1, text.length(), registry.file);
+			if(record.newLine)
+			{
+				std::fputc('\n', registry.file);
+			}
+			registry.fileLineStarted = !record.newLine;
+		}
+	}
+
+	void Logger_writeRecord(LoggerRegistry& registry, const LoggerRecord& record)
+	{
+		if(record.suppressedCount > 0)
+		{
+			Logger_writeText(registry, record, record.text + " (" + record.suppressedCount + " similar messages suppressed)");
+		}
+		else
+		{
+			Logger_writeText(registry, record, record.text);
+		}
+	}
+
+	void Logger_writeRepeatCount(LoggerRegistry& registry)
+	{
+		if(registry.repeatCount > 0)
+		{
+			LoggerRecord record = registry.lastLine;
+			record.raw = false;
+			record.newLine = true;
+			Logger_writeText(registry, record, (String)"last message repeated " + registry.repeatCount + " more times");
+			registry.repeatCount = 0;
+		}
+	}
+
+	// writes a message, holding back identical log lines. Console output is always written as it was given. the registry must be locked
+	void Logger_write(LoggerRegistry& registry, LoggerRecord& record)
+	{
+		if(record.raw)
+		{
+			Logger_writeRepeatCount(registry);
+			Logger_writeText(registry, record, record.text);
+			registry.hasLastLine = false;
+			return;
+		}
+		if(record.newLine && record.suppressedCount == 0 && registry.hasLastLine && record.level == registry.lastLine.level
+			&& record.text == registry.lastLine.text)
+		{
+			if(registry.repeatCount == 0)
+			{
+				registry.repeatStartTime = record.time;
+			}
+			registry.repeatCount++;
+			return;
+		}
+		Logger_writeRepeatCount(registry);
+		Logger_writeRecord(registry, record);
+		registry.hasLastLine = record.newLine;
+		if(record.newLine)
+		{
+			registry.lastLine.level = record.level;
+			registry.lastLine.time = record.time;
+			registry.lastLine.text = std::move(record.text);
+		}
+	}
+
+	// writes every message waiting in the thread buffers. the registry must be locked
+	void Logger_drain(LoggerRegistry& registry, bool flushRepeats)
+	{
+		std::vector<LoggerRecord>& batch = registry.batch;
+		batch.clear();
+		for(size_t i=0; i<registry.buffers.size(); i++)
+		{
+			LoggerThreadBuffer* buffer = registry.buffers[i].get();
+			// check if the thread has finished before draining, so that none of its messages are missed
+			bool finished = buffer->finished.load(std::memory_order_acquire);
+			size_t tail = buffer->tail.load(std::memory_order_relaxed);
+			size_t head = buffer->head.load(std::memory_order_acquire);
+			for(size_t j=tail; j<head; j++)
+			{
+				LoggerRecord& record = buffer->records[j % Logger::THREAD_BUFFER_SIZE];
+				record.lineTime = buffer->hasOpenLine ? buffer->openLineTime : record.time;
+				buffer->openLineTime = record.lineTime;
+				buffer->hasOpenLine = !record.newLine;
+				batch.push_back(std::move(record));
+			}
+			buffer->tail.store(head, std::memory_order_release);
+			if(finished)
+			{
+				registry.buffers.erase(registry.buffers.begin()+i);
+				i--;
+			}
+		}
+		// sorting by line time keeps every part of a thread's line of partial Console output together, since another thread's
+		// message can't sort between messages with the same line time. a line split across drains can still be interrupted
+		std::stable_sort(batch.begin(), batch.end(), [](const LoggerRecord& left, const LoggerRecord& right) {
+			return left.lineTime < right.lineTime;
+		});
+		for(auto& record : batch)
+		{
+			Logger_write(registry, record);
+		}
+		size_t droppedCount = registry.droppedCount.load(std::memory_order_relaxed);
+		if(droppedCount != registry.reportedDroppedCount)
+		{
+			Logger_writeRepeatCount(registry);
+			LoggerRecord record;
+			record.time = Logger_now();
+			record.level = Logger::LEVEL_WARNING;
+			record.raw = false;
+			record.newLine = true;
+			Logger_writeText(registry, record, (String)"" + (droppedCount - registry.reportedDroppedCount) + " log messages were dropped because a thread logged too quickly");
+			registry.reportedDroppedCount = droppedCount;
+			registry.hasLastLine = false;
+		}
+		if(registry.repeatCount > 0 && (flushRepeats || (Logger_now() - registry.repeatStartTime) >= Logger_repeatInterval))
+		{
+			Logger_writeRepeatCount(registry);
+		}
+		if(batch.size() > 0 || flushRepeats)
+		{
+			std::fflush(stdout);
+			std::fflush(stderr);
+			if(registry.file != nullptr)
+			{
+				std::fflush(registry.file);
+			}
+		}
+		batch.clear();
+	}
+
+	void Logger_runWriter()
+	{
+		LoggerRegistry& registry = Logger_getRegistry();
+		std::unique_lock<std::mutex> lock(registry.mutex);
+		while(registry.writerRunning)
+		{
+			size_t flushRequests = registry.flushRequests;
+			Logger_drain(registry, (flushRequests != registry.completedFlushes));
+			if(flushRequests != registry.completedFlushes)
+			{
+				registry.completedFlushes = flushRequests;
+				registry.flushCondition.notify_all();
+			}
+			registry.wakeCondition.wait_for(lock, Logger_writeInterval, [&]() {
+				return !registry.writerRunning || registry.flushRequests != registry.completedFlushes;
+			});
+		}
+		Logger_drain(registry, true);
+	}
+
+	void Logger_stopWriter()
+	{
+		LoggerRegistry& registry = Logger_getRegistry();
+		{
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			registry.writerRunning = false;
+			registry.stopped.store(true, std::memory_order_release);
+		}
+		registry.wakeCondition.notify_all();
+		if(registry.writer.joinable())
+		{
+			registry.writer.join();
+		}
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		Logger_drain(registry, true);
+		if(registry.file != nullptr)
+		{
+			FileTools::closeFile(registry.file);
+			registry.file = nullptr;
+		}
+	}
+
+	// starts the writer thread on first use. the registry must be locked
+	void Logger_startWriter(LoggerRegistry& registry)
+	{
+		if(registry.writerRunning || registry.stopped.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+		registry.startTime = Logger_now();
+		registry.writerRunning = true;
+		registry.writer = std::thread(&Logger_runWriter);
+		std::atexit(&Logger_stopWriter);
+	}
+
+	LoggerThreadBuffer* Logger_getThreadBuffer()
+	{
+		LoggerThreadHandle& handle = Logger_threadHandle;
+		if(handle.buffer == nullptr)
+		{
+			LoggerRegistry& registry = Logger_getRegistry();
+			std::unique_ptr<LoggerThreadBuffer> buffer(new LoggerThreadBuffer());
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			Logger_startWriter(registry);
+			handle.buffer = buffer.get();
+			registry.buffers.push_back(std::move(buffer));
+		}
+		return handle.buffer;
+	}
+
+	void Logger_push(Logger::Level level, const String& text, bool raw, bool newLine, size_t suppressedCount)
+	{
+		LoggerRegistry& registry = Logger_getRegistry();
+		if(registry.stopped.load(std::memory_order_acquire))
+		{
+			// the writer has stopped at exit, so write the message right away
+			LoggerRecord record;
+			record.time = Logger_now();
+			record.level = level;
+			record.raw = raw;
+			record.newLine = newLine;
+			record.suppressedCount = suppressedCount;
+			record.text = text;
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			Logger_write(registry, record);
+			Logger_writeRepeatCount(registry);
+			std::fflush((level >= Logger::LEVEL_WARNING) ? stderr : stdout);
+			return;
+		}
+		LoggerThreadBuffer* buffer = Logger_getThreadBuffer();
+		size_t head = buffer->head.load(std::memory_order_relaxed);
+		if((head - buffer->tail.load(std::memory_order_acquire)) >= Logger::THREAD_BUFFER_SIZE)
+		{
+			if(!raw)
+			{
+				registry.droppedCount.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			// Console output is never dropped, so write out the waiting messages on this thread to make room
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			Logger_drain(registry, false);
+		}
+		LoggerRecord& record = buffer->records[head % Logger::THREAD_BUFFER_SIZE];
+		record.time = Logger_now();
+		record.level = level;
+		record.raw = raw;
+		record.newLine = newLine;
+		record.suppressedCount = suppressedCount;
+		record.text = text;
+		buffer->head.store(head+1, std::memory_order_release);
+	}
+
+
+
+	Logger::RateLimit::RateLimit(long long intervalMilliseconds)
+		: interval((Int64)intervalMilliseconds * 1000000),
+		nextTime(0),
+		suppressed(0)
+	{
+		//
+	}
+
+	bool Logger::RateLimit::allow(size_t* suppressedCount)
+	{
+		Int64 now = Logger_now();
+		Int64 next = nextTime.load(std::memory_order_relaxed);
+		if(now < next || !nextTime.compare_exchange_strong(next, now + interval, std::memory_order_relaxed))
+		{
+			suppressed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		size_t count = suppressed.exchange(0, std::memory_order_relaxed);
+		if(suppressedCount != nullptr)
+		{
+			*suppressedCount = count;
+		}
+		return true;
+	}
+
+
+
+	void Logger::log(Level level_arg, const String& message, size_t suppressedCount)
+	{
+		if(!isEnabled(level_arg))
+		{
+			return;
+		}
+		Logger_push(level_arg, message, false, true, suppressedCount);
+	}
+
+	void Logger::logOutput(Level level_arg, const String& output, bool newLine)
+	{
+		Logger_push(level_arg, output, true, newLine, 0);
+	}
+
+	void Logger::setLevel(Level level_arg)
+	{
+		level.store(level_arg, std::memory_order_relaxed);
+	}
+
+	Logger::Level Logger::getLevel()
+	{
+		return (Level)level.load(std::memory_order_relaxed);
+	}
+
+	bool Logger::isEnabled(Level level_arg)
+	{
+		return (level_arg != LEVEL_NONE && (Uint8)level_arg >= level.load(std::memory_order_relaxed));
+	}
+
+	void Logger::setConsoleEnabled(bool enabled)
+	{
+		flush();
+		LoggerRegistry& registry = Logger_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.consoleEnabled = enabled;
+	}
+
+	bool Logger::openFile(const String& path, bool append, String* error)
+	{
+		FILE* file = FileTools::openFile(path, append ? "ab" : "wb", error);
+		if(file == nullptr)
+		{
+			return false;
+		}
+		flush();
+		LoggerRegistry& registry = Logger_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		if(registry.file != nullptr)
+		{
+			FileTools::closeFile(registry.file);
+		}
+		registry.file = file;
+		registry.fileLineStarted = false;
+		return true;
+	}
+
+	void Logger::closeFile()
+	{
+		flush();
+		LoggerRegistry& registry = Logger_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		if(registry.file != nullptr)
+		{
+			FileTools::closeFile(registry.file);
+			registry.file = nullptr;
+		}
+	}
+
+	void Logger::flush()
+	{
+		LoggerRegistry& registry = Logger_getRegistry();
+		std::unique_lock<std::mutex> lock(registry.mutex);
+		if(!registry.writerRunning)
+		{
+			Logger_drain(registry, true);
+			return;
+		}
+		registry.flushRequests++;
+		size_t request = registry.flushRequests;
+		registry.wakeCondition.notify_all();
+		registry.flushCondition.wait(lock, [&]() {
+			return !registry.writerRunning || (Int64)(registry.completedFlushes - request) >= 0;
+		});
+	}
+
+	size_t Logger::getDroppedCount()
+	{
+		return Logger_getRegistry().droppedCount.load(std::memory_order_relaxed);
+	}
+}
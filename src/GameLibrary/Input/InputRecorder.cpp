@@ -0,0 +1,484 @@
+
+#include <GameLibrary/Input/InputRecorder.hpp>
+#include <GameLibrary/IO/FileTools.hpp>
+#include <GameLibrary/Exception/IllegalStateException.hpp>
+#include <cstring>
+#include <vector>
+
+namespace fgl
+{
+	const char InputRecorder::MAGIC[8] = { 'F', 'G', 'L', 'I', 'N', 'P', 'U', 'T' };
+	const Uint32 InputRecorder::VERSION = 1;
+
+	//the number of bytes before the first record of an input log
+	static const size_t InputRecorder_headerSize = sizeof(InputRecorder::MAGIC) + sizeof(Uint32);
+
+	//tells whether events are being recorded, and stores the records written so far
+	static bool InputRecorder_recording = false;
+	static std::vector<Uint8> InputRecorder_records;
+	//the frame of the most recent record
+	static size_t InputRecorder_lastRecordFrame = 0;
+
+	//tells whether a log is being replayed, and stores the log
+	static bool InputRecorder_replaying = false;
+	static Data InputRecorder_replayData;
+	//the offset of the type of the next record to replay, and the frame of that record
+	static size_t InputRecorder_replayOffset = 0;
+	static size_t InputRecorder_replayRecordFrame = 0;
+	static size_t InputRecorder_replayFrameCount = 0;
+
+	//the number of frames since recording or replaying started
+	static size_t InputRecorder_frameNumber = 0;
+
+	namespace
+	{
+		void InputRecorder_writeVarint(std::vector<Uint8>& bytes, Uint64 value)
+		{
+			while(value >= 0x80)
+			{
+				bytes.push_back((Uint8)(value | 0x80));
+				value >>= 7;
+			}
+			bytes.push_back((Uint8)value);
+		}
+
+		void InputRecorder_writeSignedVarint(std::vector<Uint8>& bytes, Int64 value)
+		{
+			//zigzag encoding, so that small negative values stay small
+			InputRecorder_writeVarint(bytes, ((Uint64)value << 1) ^ (Uint64)(value >> 63));
+		}
+
+		void InputRecorder_writeFloat(std::vector<Uint8>& bytes, float value)
+		{
+			Uint32 bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			for(size_t i=0; i<4; i++)
+			{
+				bytes.push_back((Uint8)(bits >> (i * 8)));
+			}
+		}
+
+		bool InputRecorder_readVarint(const Uint8* bytes, size_t size, size_t& offset, Uint64* value)
+		{
+			Uint64 result = 0;
+			for(unsigned int shift=0; shift<64; shift+=7)
+			{
+				if(offset >= size)
+				{
+					return false;
+				}
+				Uint8 byte = bytes[offset];
+				offset++;
+				result |= ((Uint64)(byte & 0x7F)) << shift;
+				if((byte & 0x80) == 0)
+				{
+					*value = result;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool InputRecorder_readSignedVarint(const Uint8* bytes, size_t size, size_t& offset, Int64* value)
+		{
+			Uint64 encoded = 0;
+			if(!InputRecorder_readVarint(bytes, size, offset, &encoded))
+			{
+				return false;
+			}
+			*value = (Int64)(encoded >> 1) ^ -(Int64)(encoded & 1);
+			return true;
+		}
+
+		bool InputRecorder_readFloat(const Uint8* bytes, size_t size, size_t& offset, float* value)
+		{
+			if(offset > size || (size - offset) < 4)
+			{
+				return false;
+			}
+			Uint32 bits = 0;
+			for(size_t i=0; i<4; i++)
+			{
+				bits |= ((Uint32)bytes[offset + i]) << (i * 8);
+			}
+			offset += 4;
+			std::memcpy(value, &bits, sizeof(bits));
+			return true;
+		}
+	}
+
+	void InputRecorder_writeEvent(std::vector<Uint8>& bytes, const InputRecorder::Event& event)
+	{
+		typedef InputRecorder::EventType EventType;
+		bytes.push_back((Uint8)event.type);
+		switch(event.type)
+		{
+			case EventType::END:
+			break;
+
+			case EventType::KEY_PRESS:
+			case EventType::KEY_RELEASE:
+			InputRecorder_writeVarint(bytes, (Uint64)event.code);
+			break;
+
+			case EventType::TEXT_INPUT:
+			InputRecorder_writeVarint(bytes, (Uint64)event.text.length());
+			bytes.insert(bytes.end(), (const Uint8*)event.text.getData(), (const Uint8*)event.text.getData() + event.text.length());
+			break;
+
+			case EventType::MOUSE_MOVE:
+			InputRecorder_writeSignedVarint(bytes, (Int64)event.window);
+			InputRecorder_writeVarint(bytes, (Uint64)event.index);
+			//mouse positions are whole pixels, so they are stored as integers
+			InputRecorder_writeSignedVarint(bytes, (Int64)event.x);
+			InputRecorder_writeSignedVarint(bytes, (Int64)event.y);
+			InputRecorder_writeSignedVarint(bytes, (Int64)event.dx);
+			InputRecorder_writeSignedVarint(bytes, (Int64)event.dy);
+			break;
+
+			case EventType::MOUSE_PRESS:
+			case EventType::MOUSE_RELEASE:
+			InputRecorder_writeSignedVarint(bytes, (Int64)event.window);
+			InputRecorder_writeVarint(bytes, (Uint64)event.index);
+			InputRecorder_writeVarint(bytes, (Uint64)event.code);
+			InputRecorder_writeSignedVarint(bytes, (Int64)event.x);
+			InputRecorder_writeSignedVarint(bytes, (Int64)event.y);
+			break;
+
+			case EventType::TOUCH_DOWN:
+			case EventType::TOUCH_UP:
+			InputRecorder_writeSignedVarint(bytes, (Int64)event.window);
+			InputRecorder_writeSignedVarint(bytes, event.code);
+			InputRecorder_writeFloat(bytes, event.x);
+			InputRecorder_writeFloat(bytes, event.y);
+			break;
+
+			case EventType::TOUCH_MOVE:
+			InputRecorder_writeSignedVarint(bytes, (Int64)event.window);
+			InputRecorder_writeSignedVarint(bytes, event.code);
+			InputRecorder_writeFloat(bytes, event.x);
+			InputRecorder_writeFloat(bytes, event.y);
+			InputRecorder_writeFloat(bytes, event.dx);
+			InputRecorder_writeFloat(bytes, event.dy);
+			break;
+		}
+	}
+
+	bool InputRecorder_readEvent(const Uint8* bytes, size_t size, size_t& offset, InputRecorder::Event* event)
+	{
+		typedef InputRecorder::EventType EventType;
+		if(offset >= size || bytes[offset] > (Uint8)EventType::TOUCH_UP)
+		{
+			return false;
+		}
+		*event = InputRecorder::Event((EventType)bytes[offset]);
+		offset++;
+
+		Uint64 value = 0;
+		Int64 signedValue = 0;
+		Int64 position[4] = { 0, 0, 0, 0 };
+		switch(event->type)
+		{
+			case EventType::END:
+			return true;
+
+			case EventType::KEY_PRESS:
+			case EventType::KEY_RELEASE:
+			if(!InputRecorder_readVarint(bytes, size, offset, &value))
+			{
+				return false;
+			}
+			event->code = (Int64)value;
+			return true;
+
+			case EventType::TEXT_INPUT:
+			if(!InputRecorder_readVarint(bytes, size, offset, &value) || value > (Uint64)(size - offset))
+			{
+				return false;
+			}
+			event->text = String((const char*)(bytes + offset), (size_t)value);
+			offset += (size_t)value;
+			return true;
+
+			case EventType::MOUSE_MOVE:
+			case EventType::MOUSE_PRESS:
+			case EventType::MOUSE_RELEASE:
+			{
+				if(!InputRecorder_readSignedVarint(bytes, size, offset, &signedValue))
+				{
+					return false;
+				}
+				event->window = (Int32)signedValue;
+				if(!InputRecorder_readVarint(bytes, size, offset, &value))
+				{
+					return false;
+				}
+				event->index = (Uint32)value;
+				size_t positionCount = 4;
+				if(event->type != EventType::MOUSE_MOVE)
+				{
+					if(!InputRecorder_readVarint(bytes, size, offset, &value))
+					{
+						return false;
+					}
+					event->code = (Int64)value;
+					positionCount = 2;
+				}
+				for(size_t i=0; i<positionCount; i++)
+				{
+					if(!InputRecorder_readSignedVarint(bytes, size, offset, &position[i]))
+					{
+						return false;
+					}
+				}
+				event->x = (float)position[0];
+				event->y = (float)position[1];
+				event->dx = (float)position[2];
+				event->dy = (float)position[3];
+			}
+			return true;
+
+			case EventType::TOUCH_DOWN:
+			case EventType::TOUCH_MOVE:
+			case EventType::TOUCH_UP:
+			if(!InputRecorder_readSignedVarint(bytes, size, offset, &signedValue))
+			{
+				return false;
+			}
+			event->window = (Int32)signedValue;
+			if(!InputRecorder_readSignedVarint(bytes, size, offset, &event->code)
+			   || !InputRecorder_readFloat(bytes, size, offset, &event->x)
+			   || !InputRecorder_readFloat(bytes, size, offset, &event->y))
+			{
+				return false;
+			}
+			if(event->type == EventType::TOUCH_MOVE)
+			{
+				if(!InputRecorder_readFloat(bytes, size, offset, &event->dx)
+				   || !InputRecorder_readFloat(bytes, size, offset, &event->dy))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+		return false;
+	}
+
+	void InputRecorder::startRecording()
+	{
+		if(InputRecorder_replaying)
+		{
+			throw IllegalStateException("Cannot record input while a log is being replayed");
+		}
+		InputRecorder_records.clear();
+		InputRecorder_lastRecordFrame = 0;
+		InputRecorder_frameNumber = 0;
+		InputRecorder_recording = true;
+	}
+
+	void InputRecorder::stopRecording()
+	{
+		InputRecorder_recording = false;
+	}
+
+	bool InputRecorder::isRecording()
+	{
+		return InputRecorder_recording;
+	}
+
+	Data InputRecorder::getRecording()
+	{
+		std::vector<Uint8> bytes;
+		bytes.reserve(InputRecorder_headerSize + InputRecorder_records.size() + 11);
+		bytes.insert(bytes.end(), MAGIC, MAGIC + sizeof(MAGIC));
+		for(size_t i=0; i<4; i++)
+		{
+			bytes.push_back((Uint8)(VERSION >> (i * 8)));
+		}
+		bytes.insert(bytes.end(), InputRecorder_records.begin(), InputRecorder_records.end());
+		//the end record moves to the last frame, so that frames without input at the end of the recording are kept
+		size_t frameCount = InputRecorder_frameNumber;
+		if(frameCount < InputRecorder_lastRecordFrame)
+		{
+			frameCount = InputRecorder_lastRecordFrame;
+		}
+		InputRecorder_writeVarint(bytes, (Uint64)(frameCount - InputRecorder_lastRecordFrame));
+		bytes.push_back((Uint8)EventType::END);
+		return Data(bytes.data(), bytes.size());
+	}
+
+	bool InputRecorder::saveRecording(const String& path, String* error)
+	{
+		Data data = getRecording();
+		FILE* file = FileTools::openFile(path, "wb", error);
+		if(file == nullptr)
+		{
+			return false;
+		}
+		size_t written = std::fwrite(data.getData(), 1, data.size(), file);
+		FileTools::closeFile(file);
+		if(written != data.size())
+		{
+			if(error != nullptr)
+			{
+				*error = "Unable to write input log";
+			}
+			return false;
+		}
+		return true;
+	}
+
+	bool InputRecorder::startReplay(const Data& data, String* error)
+	{
+		if(InputRecorder_recording)
+		{
+			throw IllegalStateException("Cannot replay a log while input is being recorded");
+		}
+		const Uint8* bytes = (const Uint8*)data.getData();
+		size_t size = data.size();
+		if(size < InputRecorder_headerSize || std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0)
+		{
+			if(error != nullptr)
+			{
+				*error = "Data is not an input log";
+			}
+			return false;
+		}
+		Uint32 version = 0;
+		for(size_t i=0; i<4; i++)
+		{
+			version |= ((Uint32)bytes[sizeof(MAGIC) + i]) << (i * 8);
+		}
+		if(version != VERSION)
+		{
+			if(error != nullptr)
+			{
+				*error = (String)"Unsupported input log version " + version;
+			}
+			return false;
+		}
+
+		//check every record before replaying, so a bad log fails here instead of partway through a replay
+		size_t offset = InputRecorder_headerSize;
+		size_t frame = 0;
+		bool ended = false;
+		while(!ended)
+		{
+			Uint64 frameDelta = 0;
+			Event event;
+			if(!InputRecorder_readVarint(bytes, size, offset, &frameDelta) || !InputRecorder_readEvent(bytes, size, offset, &event))
+			{
+				if(error != nullptr)
+				{
+					*error = (String)"Input log is truncated or corrupt at byte " + (Uint64)offset;
+				}
+				return false;
+			}
+			frame += (size_t)frameDelta;
+			if(event.type == EventType::END)
+			{
+				ended = true;
+			}
+		}
+
+		InputRecorder_replayData = data;
+		InputRecorder_replayOffset = InputRecorder_headerSize;
+		Uint64 firstFrame = 0;
+		InputRecorder_readVarint(bytes, size, InputRecorder_replayOffset, &firstFrame);
+		InputRecorder_replayRecordFrame = (size_t)firstFrame;
+		InputRecorder_replayFrameCount = frame;
+		InputRecorder_frameNumber = 0;
+		InputRecorder_replaying = true;
+		return true;
+	}
+
+	bool InputRecorder::startReplay(const String& path, String* error)
+	{
+		FILE* file = FileTools::openFile(path, "rb", error);
+		if(file == nullptr)
+		{
+			return false;
+		}
+		Data data;
+		bool success = data.loadFromFile(file, error);
+		FileTools::closeFile(file);
+		if(!success)
+		{
+			return false;
+		}
+		return startReplay(data, error);
+	}
+
+	void InputRecorder::stopReplay()
+	{
+		InputRecorder_replaying = false;
+		InputRecorder_replayData = Data();
+		InputRecorder_replayOffset = 0;
+		InputRecorder_replayRecordFrame = 0;
+		InputRecorder_replayFrameCount = 0;
+	}
+
+	bool InputRecorder::isReplaying()
+	{
+		return InputRecorder_replaying;
+	}
+
+	bool InputRecorder::isReplayFinished()
+	{
+		return InputRecorder_replaying && InputRecorder_frameNumber >= InputRecorder_replayFrameCount;
+	}
+
+	size_t InputRecorder::getReplayFrameCount()
+	{
+		return InputRecorder_replayFrameCount;
+	}
+
+	size_t InputRecorder::getFrameNumber()
+	{
+		return InputRecorder_frameNumber;
+	}
+
+	void InputRecorder::recordEvent(const Event& event)
+	{
+		if(!InputRecorder_recording)
+		{
+			return;
+		}
+		InputRecorder_writeVarint(InputRecorder_records, (Uint64)(InputRecorder_frameNumber - InputRecorder_lastRecordFrame));
+		InputRecorder_writeEvent(InputRecorder_records, event);
+		InputRecorder_lastRecordFrame = InputRecorder_frameNumber;
+	}
+
+	bool InputRecorder::nextReplayEvent(Event* event)
+	{
+		if(!InputRecorder_replaying || InputRecorder_replayRecordFrame != InputRecorder_frameNumber)
+		{
+			return false;
+		}
+		const Uint8* bytes = (const Uint8*)InputRecorder_replayData.getData();
+		size_t size = InputRecorder_replayData.size();
+		size_t offset = InputRecorder_replayOffset;
+		if(offset >= size || bytes[offset] == (Uint8)EventType::END)
+		{
+			return false;
+		}
+		if(!InputRecorder_readEvent(bytes, size, offset, event))
+		{
+			return false;
+		}
+		Uint64 frameDelta = 0;
+		InputRecorder_readVarint(bytes, size, offset, &frameDelta);
+		InputRecorder_replayOffset = offset;
+		InputRecorder_replayRecordFrame += (size_t)frameDelta;
+		return true;
+	}
+
+	void InputRecorder::endFrame()
+	{
+		if(InputRecorder_recording || InputRecorder_replaying)
+		{
+			InputRecorder_frameNumber++;
+		}
+	}
+}
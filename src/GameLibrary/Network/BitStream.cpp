@@ -0,0 +1,213 @@
+
+#include <GameLibrary/Network/BitStream.hpp>
+#include <GameLibrary/Exception/IllegalArgumentException.hpp>
+
+namespace fgl
+{
+	// the number of value bits for each of the variable length prefixes 0, 10, 110 and 111
+	static const unsigned int BitStream_varBitCounts[4] = { 4, 8, 16, 32 };
+
+	inline Uint32 BitStream_lowMask(unsigned int bitCount)
+	{
+		return (bitCount >= 32) ? 0xFFFFFFFF : ((1u << bitCount) - 1);
+	}
+
+	BitWriter::BitWriter()
+		: bitCount(0)
+	{
+		//
+	}
+
+	void BitWriter::writeBits(Uint32 value, unsigned int count)
+	{
+		if(count > 32)
+		{
+			throw IllegalArgumentException("bitCount", "cannot be greater than 32");
+		}
+		value &= BitStream_lowMask(count);
+		while(count > 0)
+		{
+			unsigned int offset = (unsigned int)(bitCount % 8);
+			if(offset == 0)
+			{
+				bytes.push_back(0);
+			}
+			unsigned int written = 8 - offset;
+			if(written > count)
+			{
+				written = count;
+			}
+			bytes[bitCount / 8] |= (Uint8)((value & BitStream_lowMask(written)) << offset);
+			value >>= written;
+			count -= written;
+			bitCount += written;
+		}
+	}
+
+	void BitWriter::writeBool(bool value)
+	{
+		writeBits(value ? 1 : 0, 1);
+	}
+
+	void BitWriter::writeVarUint(Uint32 value)
+	{
+		if(value < 0x10)
+		{
+			writeBits(0x0, 1);
+			writeBits(value, BitStream_varBitCounts[0]);
+		}
+		else if(value < 0x100)
+		{
+			writeBits(0x1, 2);
+			writeBits(value, BitStream_varBitCounts[1]);
+		}
+		else if(value < 0x10000)
+		{
+			writeBits(0x3, 3);
+			writeBits(value, BitStream_varBitCounts[2]);
+		}
+		else
+		{
+			writeBits(0x7, 3);
+			writeBits(value, BitStream_varBitCounts[3]);
+		}
+	}
+
+	void BitWriter::writeVarInt(Int32 value)
+	{
+		// zigzag encoding, so that small negative values stay small
+		writeVarUint(((Uint32)value << 1) ^ (Uint32)(value >> 31));
+	}
+
+	void BitWriter::overwriteBits(size_t bitPosition, Uint32 value, unsigned int count)
+	{
+		if(count > 32)
+		{
+			throw IllegalArgumentException("bitCount", "cannot be greater than 32");
+		}
+		else if(bitPosition + count > bitCount)
+		{
+			throw IllegalArgumentException("bitPosition", "is past the end of the written bits");
+		}
+		for(unsigned int i=0; i<count; i++)
+		{
+			size_t position = bitPosition + i;
+			Uint8 bit = (Uint8)(1 << (position % 8));
+			if(((value >> i) & 1) != 0)
+			{
+				bytes[position / 8] |= bit;
+			}
+			else
+			{
+				bytes[position / 8] &= (Uint8)~bit;
+			}
+		}
+	}
+
+	void BitWriter::truncate(size_t bitPosition)
+	{
+		if(bitPosition >= bitCount)
+		{
+			return;
+		}
+		bitCount = bitPosition;
+		bytes.resize((bitCount + 7) / 8);
+		if((bitCount % 8) != 0)
+		{
+			bytes[bitCount / 8] &= (Uint8)BitStream_lowMask((unsigned int)(bitCount % 8));
+		}
+	}
+
+	void BitWriter::clear()
+	{
+		bytes.clear();
+		bitCount = 0;
+	}
+
+	const Uint8* BitWriter::getData() const
+	{
+		return bytes.data();
+	}
+
+	size_t BitWriter::getBitCount() const
+	{
+		return bitCount;
+	}
+
+	size_t BitWriter::getByteCount() const
+	{
+		return bytes.size();
+	}
+
+
+
+	BitReader::BitReader(const void* data, size_t size)
+		: bytes((const Uint8*)data),
+		bitSize(size * 8),
+		bitPosition(0),
+		overflowed(false)
+	{
+		//
+	}
+
+	Uint32 BitReader::readBits(unsigned int count)
+	{
+		if(count > 32)
+		{
+			throw IllegalArgumentException("bitCount", "cannot be greater than 32");
+		}
+		else if(count > (bitSize - bitPosition))
+		{
+			overflowed = true;
+			bitPosition = bitSize;
+			return 0;
+		}
+		Uint32 value = 0;
+		unsigned int read = 0;
+		while(read < count)
+		{
+			unsigned int offset = (unsigned int)(bitPosition % 8);
+			unsigned int chunk = 8 - offset;
+			if(chunk > (count - read))
+			{
+				chunk = count - read;
+			}
+			Uint32 bits = ((Uint32)bytes[bitPosition / 8] >> offset) & BitStream_lowMask(chunk);
+			value |= bits << read;
+			read += chunk;
+			bitPosition += chunk;
+		}
+		return value;
+	}
+
+	bool BitReader::readBool()
+	{
+		return (readBits(1) != 0);
+	}
+
+	Uint32 BitReader::readVarUint()
+	{
+		unsigned int prefix = 0;
+		while(prefix < 3 && readBool())
+		{
+			prefix++;
+		}
+		return readBits(BitStream_varBitCounts[prefix]);
+	}
+
+	Int32 BitReader::readVarInt()
+	{
+		Uint32 value = readVarUint();
+		return (Int32)(value >> 1) ^ -(Int32)(value & 1);
+	}
+
+	bool BitReader::hasOverflowed() const
+	{
+		return overflowed;
+	}
+
+	size_t BitReader::getBitPosition() const
+	{
+		return bitPosition;
+	}
+}
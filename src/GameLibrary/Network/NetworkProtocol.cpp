@@ -0,0 +1,386 @@
+
+#include <GameLibrary/Network/NetworkProtocol.hpp>
+#include <GameLibrary/Exception/IllegalArgumentException.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace fgl
+{
+	// the longest time that a baseline's velocity is used to predict its position, so that the prediction can't overflow
+	static const Uint32 NetworkProtocol_maxPredictionTime = 10000;
+	// the largest number of changed objects in one packet
+	static const size_t NetworkProtocol_maxChanges = 0xFFFF;
+
+	enum NetworkProtocol_EntityChange : Uint8
+	{
+		NETWORKPROTOCOL_UNCHANGED,
+		NETWORKPROTOCOL_CHANGED,
+		NETWORKPROTOCOL_WRITTEN
+	};
+
+	const NetworkProtocol::EntityState* NetworkProtocol::Snapshot::find(Uint32 id) const
+	{
+		auto it = std::lower_bound(entities.begin(), entities.end(), id, [](const EntityState& state, Uint32 id) {
+			return state.id < id;
+		});
+		if(it == entities.end() || it->id != id)
+		{
+			return nullptr;
+		}
+		return &(*it);
+	}
+
+	Int32 NetworkProtocol::quantize(double value, unsigned int precision)
+	{
+		double steps = std::round(value * (double)precision);
+		if(steps >= (double)std::numeric_limits<Int32>::max())
+		{
+			return std::numeric_limits<Int32>::max();
+		}
+		else if(steps <= (double)std::numeric_limits<Int32>::min())
+		{
+			return std::numeric_limits<Int32>::min();
+		}
+		return (Int32)steps;
+	}
+
+	double NetworkProtocol::dequantize(Int32 value, unsigned int precision)
+	{
+		return (double)value / (double)precision;
+	}
+
+	// the state that an object is expected to have after moving at its baseline velocity for the time between snapshots.
+	// integer math with wrapping, so that both ends predict exactly the same values
+	NetworkProtocol::EntityState NetworkProtocol_predict(const NetworkProtocol::EntityState& baseline, Uint32 elapsedTime, const NetworkProtocol::Settings& settings)
+	{
+		Int64 divisor = (Int64)settings.velocityPrecision * 1000;
+		Int64 moveX = ((Int64)baseline.velocityX * (Int64)elapsedTime * (Int64)settings.positionPrecision) / divisor;
+		Int64 moveY = ((Int64)baseline.velocityY * (Int64)elapsedTime * (Int64)settings.positionPrecision) / divisor;
+		NetworkProtocol::EntityState predicted = baseline;
+		predicted.x = (Int32)((Uint32)baseline.x + (Uint32)moveX);
+		predicted.y = (Int32)((Uint32)baseline.y + (Uint32)moveY);
+		return predicted;
+	}
+
+	Uint32 NetworkProtocol_elapsedTime(const NetworkProtocol::Snapshot& snapshot, const NetworkProtocol::Snapshot* baseline)
+	{
+		if(baseline == nullptr)
+		{
+			return 0;
+		}
+		Uint32 elapsedTime = snapshot.time - baseline->time;
+		if(elapsedTime > NetworkProtocol_maxPredictionTime)
+		{
+			return NetworkProtocol_maxPredictionTime;
+		}
+		return elapsedTime;
+	}
+
+	inline Int32 NetworkProtocol_difference(Int32 value, Int32 predicted)
+	{
+		return (Int32)((Uint32)value - (Uint32)predicted);
+	}
+
+	inline Int32 NetworkProtocol_apply(Int32 predicted, Int32 difference)
+	{
+		return (Int32)((Uint32)predicted + (Uint32)difference);
+	}
+
+	void NetworkProtocol_checkSettings(const NetworkProtocol::Settings& settings)
+	{
+		if(settings.positionPrecision == 0)
+		{
+			throw IllegalArgumentException("settings", "positionPrecision must be greater than 0");
+		}
+		else if(settings.velocityPrecision == 0)
+		{
+			throw IllegalArgumentException("settings", "velocityPrecision must be greater than 0");
+		}
+	}
+
+	Uint8 NetworkProtocol::readPacketType(BitReader& reader)
+	{
+		return (Uint8)reader.readBits(4);
+	}
+
+	size_t NetworkProtocol::encodeSnapshot(const Snapshot& snapshot, const Snapshot* baseline, const Settings& settings, size_t* firstEntity, BitWriter& writer, Snapshot* sent)
+	{
+		NetworkProtocol_checkSettings(settings);
+		if(baseline != nullptr && (Int32)(snapshot.sequence - baseline->sequence) <= 0)
+		{
+			throw IllegalArgumentException("baseline", "must be older than the snapshot");
+		}
+		Uint32 elapsedTime = NetworkProtocol_elapsedTime(snapshot, baseline);
+		const EntityState zeroState = { 0, 0, 0, 0, 0 };
+
+		// walk both snapshots in ID order, to find removed objects, and objects that don't match their prediction
+		std::vector<Uint32> removedIDs;
+		std::vector<EntityState> predictions;
+		std::vector<Uint8> changes;
+		predictions.reserve(snapshot.entities.size());
+		changes.reserve(snapshot.entities.size());
+		size_t changeCount = 0;
+		size_t baselineIndex = 0;
+		size_t baselineCount = (baseline != nullptr) ? baseline->entities.size() : 0;
+		for(size_t i=0; i<snapshot.entities.size(); i++)
+		{
+			const EntityState& entity = snapshot.entities[i];
+			if(i > 0 && entity.id <= snapshot.entities[i-1].id)
+			{
+				throw IllegalArgumentException("snapshot", "entities must be sorted by ID");
+			}
+			while(baselineIndex < baselineCount && baseline->entities[baselineIndex].id < entity.id)
+			{
+				removedIDs.push_back(baseline->entities[baselineIndex].id);
+				baselineIndex++;
+			}
+			if(baselineIndex < baselineCount && baseline->entities[baselineIndex].id == entity.id)
+			{
+				EntityState predicted = NetworkProtocol_predict(baseline->entities[baselineIndex], elapsedTime, settings);
+				baselineIndex++;
+				predictions.push_back(predicted);
+				if(entity.x == predicted.x && entity.y == predicted.y && entity.velocityX == predicted.velocityX && entity.velocityY == predicted.velocityY)
+				{
+					changes.push_back(NETWORKPROTOCOL_UNCHANGED);
+					continue;
+				}
+			}
+			else
+			{
+				EntityState predicted = zeroState;
+				predicted.id = entity.id;
+				predictions.push_back(predicted);
+			}
+			changes.push_back(NETWORKPROTOCOL_CHANGED);
+			changeCount++;
+		}
+		for(; baselineIndex < baselineCount; baselineIndex++)
+		{
+			removedIDs.push_back(baseline->entities[baselineIndex].id);
+		}
+
+		// header
+		writer.writeBits(PACKET_SNAPSHOT, 4);
+		writer.writeBits(snapshot.sequence, 32);
+		writer.writeBits(snapshot.time, 32);
+		writer.writeVarUint((baseline != nullptr) ? (snapshot.sequence - baseline->sequence) : 0);
+
+		// removed objects, as the difference from the previous ID
+		writer.writeVarUint((Uint32)removedIDs.size());
+		Uint32 previousID = 0;
+		for(auto id : removedIDs)
+		{
+			writer.writeVarUint(id - previousID);
+			previousID = id;
+		}
+
+		// changed objects, starting at firstEntity and wrapping around, until the packet is full
+		size_t countPosition = writer.getBitCount();
+		writer.writeBits(0, 16);
+		size_t written = 0;
+		previousID = 0;
+		if(changeCount > 0)
+		{
+			size_t start = (firstEntity != nullptr) ? (*firstEntity % snapshot.entities.size()) : 0;
+			size_t j = 0;
+			for(; j<snapshot.entities.size() && written < NetworkProtocol_maxChanges; j++)
+			{
+				size_t i = (start + j) % snapshot.entities.size();
+				if(changes[i] == NETWORKPROTOCOL_UNCHANGED)
+				{
+					continue;
+				}
+				const EntityState& entity = snapshot.entities[i];
+				const EntityState& predicted = predictions[i];
+				size_t entityPosition = writer.getBitCount();
+				Int32 differences[4] = {
+					NetworkProtocol_difference(entity.x, predicted.x),
+					NetworkProtocol_difference(entity.y, predicted.y),
+					NetworkProtocol_difference(entity.velocityX, predicted.velocityX),
+					NetworkProtocol_difference(entity.velocityY, predicted.velocityY)
+				};
+				Uint32 mask = 0;
+				for(unsigned int k=0; k<4; k++)
+				{
+					if(differences[k] != 0)
+					{
+						mask |= (1u << k);
+					}
+				}
+				writer.writeVarInt((Int32)(entity.id - previousID));
+				writer.writeBits(mask, 4);
+				for(unsigned int k=0; k<4; k++)
+				{
+					if(differences[k] != 0)
+					{
+						writer.writeVarInt(differences[k]);
+					}
+				}
+				if(writer.getByteCount() > settings.maxPacketSize && written > 0)
+				{
+					writer.truncate(entityPosition);
+					break;
+				}
+				changes[i] = NETWORKPROTOCOL_WRITTEN;
+				previousID = entity.id;
+				written++;
+			}
+			if(firstEntity != nullptr)
+			{
+				*firstEntity = (start + j) % snapshot.entities.size();
+			}
+		}
+		writer.overwriteBits(countPosition, (Uint32)written, 16);
+
+		if(sent != nullptr)
+		{
+			sent->sequence = snapshot.sequence;
+			sent->time = snapshot.time;
+			sent->entities.clear();
+			sent->entities.reserve(snapshot.entities.size());
+			for(size_t i=0; i<snapshot.entities.size(); i++)
+			{
+				if(changes[i] != NETWORKPROTOCOL_CHANGED)
+				{
+					sent->entities.push_back(snapshot.entities[i]);
+				}
+				else if(baseline != nullptr && baseline->find(snapshot.entities[i].id) != nullptr)
+				{
+					// left out of the packet, so the receiver predicts it from the baseline
+					sent->entities.push_back(predictions[i]);
+				}
+			}
+		}
+		return changeCount - written;
+	}
+
+	bool NetworkProtocol::decodeSnapshot(BitReader& reader, const std::function<const Snapshot*(Uint32)>& findBaseline, const Settings& settings, Snapshot* snapshot, String* error)
+	{
+		NetworkProtocol_checkSettings(settings);
+		if(snapshot == nullptr)
+		{
+			throw IllegalArgumentException("snapshot", "cannot be null");
+		}
+		Uint32 sequence = reader.readBits(32);
+		Uint32 time = reader.readBits(32);
+		Uint32 baselineDistance = reader.readVarUint();
+		if(reader.hasOverflowed())
+		{
+			if(error != nullptr)
+			{
+				*error = "Snapshot packet is truncated";
+			}
+			return false;
+		}
+		const Snapshot* baseline = nullptr;
+		if(baselineDistance != 0)
+		{
+			baseline = findBaseline ? findBaseline(sequence - baselineDistance) : nullptr;
+			if(baseline == nullptr)
+			{
+				if(error != nullptr)
+				{
+					*error = (String)"Baseline snapshot " + (sequence - baselineDistance) + " is not available";
+				}
+				return false;
+			}
+		}
+		snapshot->sequence = sequence;
+		snapshot->time = time;
+		Uint32 elapsedTime = NetworkProtocol_elapsedTime(*snapshot, baseline);
+
+		// everything in the baseline that wasn't removed is where its velocity predicts
+		Uint32 removedCount = reader.readVarUint();
+		snapshot->entities.clear();
+		size_t baselineCount = (baseline != nullptr) ? baseline->entities.size() : 0;
+		snapshot->entities.reserve(baselineCount);
+		size_t baselineIndex = 0;
+		Uint32 removedID = 0;
+		for(Uint32 i=0; i<=removedCount && !reader.hasOverflowed(); i++)
+		{
+			bool last = (i == removedCount);
+			if(!last)
+			{
+				removedID += reader.readVarUint();
+			}
+			while(baselineIndex < baselineCount && (last || baseline->entities[baselineIndex].id < removedID))
+			{
+				snapshot->entities.push_back(NetworkProtocol_predict(baseline->entities[baselineIndex], elapsedTime, settings));
+				baselineIndex++;
+			}
+			if(!last && baselineIndex < baselineCount && baseline->entities[baselineIndex].id == removedID)
+			{
+				baselineIndex++;
+			}
+		}
+
+		// changed and added objects
+		Uint32 changeCount = reader.readBits(16);
+		std::vector<EntityState> added;
+		Uint32 previousID = 0;
+		for(Uint32 i=0; i<changeCount && !reader.hasOverflowed(); i++)
+		{
+			Uint32 id = previousID + (Uint32)reader.readVarInt();
+			previousID = id;
+			Uint32 mask = reader.readBits(4);
+			Int32 differences[4] = { 0, 0, 0, 0 };
+			for(unsigned int k=0; k<4; k++)
+			{
+				if((mask & (1u << k)) != 0)
+				{
+					differences[k] = reader.readVarInt();
+				}
+			}
+			EntityState* entity = const_cast<EntityState*>(snapshot->find(id));
+			if(entity == nullptr)
+			{
+				added.push_back({ id, 0, 0, 0, 0 });
+				entity = &added.back();
+			}
+			entity->x = NetworkProtocol_apply(entity->x, differences[0]);
+			entity->y = NetworkProtocol_apply(entity->y, differences[1]);
+			entity->velocityX = NetworkProtocol_apply(entity->velocityX, differences[2]);
+			entity->velocityY = NetworkProtocol_apply(entity->velocityY, differences[3]);
+		}
+		if(reader.hasOverflowed())
+		{
+			if(error != nullptr)
+			{
+				*error = "Snapshot packet is truncated";
+			}
+			return false;
+		}
+
+		if(added.size() > 0)
+		{
+			auto compare = [](const EntityState& left, const EntityState& right) {
+				return left.id < right.id;
+			};
+			std::sort(added.begin(), added.end(), compare);
+			size_t middle = snapshot->entities.size();
+			snapshot->entities.insert(snapshot->entities.end(), added.begin(), added.end());
+			std::inplace_merge(snapshot->entities.begin(), snapshot->entities.begin() + middle, snapshot->entities.end(), compare);
+			snapshot->entities.erase(std::unique(snapshot->entities.begin(), snapshot->entities.end(), [](const EntityState& left, const EntityState& right) {
+				return left.id == right.id;
+			}), snapshot->entities.end());
+		}
+		return true;
+	}
+
+	void NetworkProtocol::encodeAck(Uint32 sequence, BitWriter& writer)
+	{
+		writer.writeBits(PACKET_ACK, 4);
+		writer.writeBits(sequence, 32);
+	}
+
+	bool NetworkProtocol::decodeAck(BitReader& reader, Uint32* sequence)
+	{
+		if(sequence == nullptr)
+		{
+			throw IllegalArgumentException("sequence", "cannot be null");
+		}
+		*sequence = reader.readBits(32);
+		return !reader.hasOverflowed();
+	}
+}
@@ -0,0 +1,117 @@
+
+#include <GameLibrary/Network/NetworkTransport.hpp>
+#include <GameLibrary/Exception/IllegalArgumentException.hpp>
+
+namespace fgl
+{
+	// connections only change from one thread at a time, so a single lock keeps both ends of every connection consistent
+	static std::mutex LoopbackTransport_connectionMutex;
+
+	LoopbackTransport::LoopbackTransport()
+		: peer(nullptr),
+		lossRate(0),
+		packetsSent(0),
+		bytesSent(0)
+	{
+		//
+	}
+
+	LoopbackTransport::~LoopbackTransport()
+	{
+		disconnect();
+	}
+
+	void LoopbackTransport::connect(LoopbackTransport* transport1, LoopbackTransport* transport2)
+	{
+		if(transport1 == nullptr)
+		{
+			throw IllegalArgumentException("transport1", "cannot be null");
+		}
+		else if(transport2 == nullptr)
+		{
+			throw IllegalArgumentException("transport2", "cannot be null");
+		}
+		else if(transport1 == transport2)
+		{
+			throw IllegalArgumentException("transport2", "cannot be the same as transport1");
+		}
+		transport1->disconnect();
+		transport2->disconnect();
+		std::lock_guard<std::mutex> lock(LoopbackTransport_connectionMutex);
+		transport1->peer = transport2;
+		transport2->peer = transport1;
+	}
+
+	void LoopbackTransport::disconnect()
+	{
+		std::lock_guard<std::mutex> lock(LoopbackTransport_connectionMutex);
+		if(peer != nullptr)
+		{
+			peer->peer = nullptr;
+			peer = nullptr;
+		}
+	}
+
+	void LoopbackTransport::send(const void* data, size_t size)
+	{
+		bool dropped = false;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			packetsSent++;
+			bytesSent += size;
+			if(lossRate > 0)
+			{
+				dropped = (std::uniform_real_distribution<double>(0.0, 1.0)(random) < lossRate);
+			}
+		}
+		if(dropped)
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> connectionLock(LoopbackTransport_connectionMutex);
+		if(peer != nullptr)
+		{
+			std::lock_guard<std::mutex> lock(peer->mutex);
+			peer->incoming.emplace_back(data, size);
+		}
+	}
+
+	bool LoopbackTransport::receive(Data* packet)
+	{
+		if(packet == nullptr)
+		{
+			throw IllegalArgumentException("packet", "cannot be null");
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		if(incoming.size() == 0)
+		{
+			return false;
+		}
+		*packet = std::move(incoming.front());
+		incoming.pop_front();
+		return true;
+	}
+
+	void LoopbackTransport::setPacketLoss(double lossRate_arg, unsigned int seed)
+	{
+		if(lossRate_arg < 0 || lossRate_arg > 1)
+		{
+			throw IllegalArgumentException("lossRate", "must be between 0 and 1");
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		lossRate = lossRate_arg;
+		random.seed(seed);
+	}
+
+	size_t LoopbackTransport::getPacketsSent() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return packetsSent;
+	}
+
+	size_t LoopbackTransport::getBytesSent() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return bytesSent;
+	}
+}
@@ -0,0 +1,247 @@
+
+#include <GameLibrary/Network/ReplicationClient.hpp>
+#include <GameLibrary/Exception/IllegalArgumentException.hpp>
+#include <GameLibrary/World/World.hpp>
+#include <GameLibrary/World/Aspects/Movement/Transform2DAspect.hpp>
+#include <GameLibrary/World/Aspects/Movement/Velocity2DAspect.hpp>
+#include <GameLibrary/World/Aspects/Network/ReplicatedAspect.hpp>
+#include <cmath>
+
+namespace fgl
+{
+	const size_t ReplicationClient::HISTORY_SIZE = 32;
+
+	// how much of the difference between the render time and its target is made up each frame
+	static const double ReplicationClient_timeCorrection = 0.1;
+
+	ReplicationClient::ReplicationClient(World* world, NetworkTransport* transport, const ObjectFactory& factory, const NetworkProtocol::Settings& settings)
+		: world(world),
+		transport(transport),
+		factory(factory),
+		settings(settings),
+		interpolationDelay(100),
+		renderTime(0),
+		started(false)
+	{
+		if(world == nullptr)
+		{
+			throw IllegalArgumentException("world", "cannot be null");
+		}
+		else if(transport == nullptr)
+		{
+			throw IllegalArgumentException("transport", "cannot be null");
+		}
+		else if(!factory)
+		{
+			throw IllegalArgumentException("factory", "cannot be null");
+		}
+	}
+
+	void ReplicationClient::update(const ApplicationData& appData)
+	{
+		receive();
+		if(snapshots.size() == 0)
+		{
+			return;
+		}
+		double targetTime = (double)snapshots.back().time - interpolationDelay;
+		if(!started)
+		{
+			renderTime = targetTime;
+			started = true;
+		}
+		else
+		{
+			renderTime += appData.getFrameSpeedMultiplier() * 1000.0;
+			double drift = targetTime - renderTime;
+			if(std::abs(drift) > interpolationDelay)
+			{
+				// too far behind or ahead to catch up smoothly
+				renderTime = targetTime;
+			}
+			else
+			{
+				renderTime += drift * ReplicationClient_timeCorrection;
+			}
+		}
+		applySnapshots();
+	}
+
+	void ReplicationClient::receive()
+	{
+		while(transport->receive(&packet))
+		{
+			BitReader reader(packet.getData(), packet.size());
+			if(NetworkProtocol::readPacketType(reader) != NetworkProtocol::PACKET_SNAPSHOT)
+			{
+				continue;
+			}
+			if(!NetworkProtocol::decodeSnapshot(reader, [this](Uint32 sequence) { return findSnapshot(sequence); }, settings, &decoded))
+			{
+				continue;
+			}
+			// keep the snapshots in order, in case packets arrive out of order
+			Uint32 sequence = decoded.sequence;
+			auto it = snapshots.end();
+			while(it != snapshots.begin() && (Int32)((it-1)->sequence - sequence) > 0)
+			{
+				it--;
+			}
+			if(it == snapshots.begin() || (it-1)->sequence != sequence)
+			{
+				snapshots.insert(it, std::move(decoded));
+				decoded = NetworkProtocol::Snapshot();
+				if(snapshots.size() > HISTORY_SIZE)
+				{
+					snapshots.pop_front();
+				}
+			}
+			// only acknowledge snapshots that are kept, since the server may use them as baselines
+			if(findSnapshot(sequence) != nullptr)
+			{
+				writer.clear();
+				NetworkProtocol::encodeAck(sequence, writer);
+				transport->send(writer.getData(), writer.getByteCount());
+			}
+		}
+	}
+
+	void ReplicationClient::setInterpolationDelay(double delay)
+	{
+		if(delay < 0)
+		{
+			throw IllegalArgumentException("delay", "cannot be negative");
+		}
+		interpolationDelay = delay;
+	}
+
+	double ReplicationClient::getInterpolationDelay() const
+	{
+		return interpolationDelay;
+	}
+
+	double ReplicationClient::getRenderTime() const
+	{
+		return renderTime;
+	}
+
+	WorldObject* ReplicationClient::getObject(Uint32 networkID) const
+	{
+		auto it = objects.find(networkID);
+		if(it == objects.end())
+		{
+			return nullptr;
+		}
+		return it->second;
+	}
+
+	const NetworkProtocol::Snapshot* ReplicationClient::getLatestSnapshot() const
+	{
+		if(snapshots.size() == 0)
+		{
+			return nullptr;
+		}
+		return &snapshots.back();
+	}
+
+	const NetworkProtocol::Snapshot* ReplicationClient::findSnapshot(Uint32 sequence) const
+	{
+		for(auto it=snapshots.rbegin(); it!=snapshots.rend(); it++)
+		{
+			if(it->sequence == sequence)
+			{
+				return &(*it);
+			}
+		}
+		return nullptr;
+	}
+
+	void ReplicationClient::applySnapshots()
+	{
+		// find the snapshots on either side of the render time
+		size_t fromIndex = 0;
+		for(size_t i=0; i<snapshots.size(); i++)
+		{
+			if((double)snapshots[i].time <= renderTime)
+			{
+				fromIndex = i;
+			}
+			else
+			{
+				break;
+			}
+		}
+		const NetworkProtocol::Snapshot& from = snapshots[fromIndex];
+		const NetworkProtocol::Snapshot& to = snapshots[(fromIndex+1 < snapshots.size()) ? (fromIndex+1) : fromIndex];
+		double progress = 0;
+		if(to.time > from.time)
+		{
+			progress = (renderTime - (double)from.time) / (double)(to.time - from.time);
+			progress = std::fmin(std::fmax(progress, 0.0), 1.0);
+		}
+
+		// objects that no longer exist at the render time are removed
+		for(auto it=objects.begin(); it!=objects.end();)
+		{
+			if(from.find(it->first) == nullptr)
+			{
+				world->removeObject(it->second);
+				world->destroyObject(it->second);
+				it = objects.erase(it);
+			}
+			else
+			{
+				it++;
+			}
+		}
+
+		for(auto& state : from.entities)
+		{
+			WorldObject* object = nullptr;
+			auto objectIt = objects.find(state.id);
+			if(objectIt == objects.end())
+			{
+				object = factory(state.id);
+				if(object == nullptr)
+				{
+					continue;
+				}
+				auto replicated = object->getAspect<ReplicatedAspect>();
+				if(replicated == nullptr)
+				{
+					object->addAspect(new ReplicatedAspect(state.id));
+				}
+				else
+				{
+					replicated->setNetworkID(state.id);
+				}
+				world->addObject(object);
+				objects[state.id] = object;
+			}
+			else
+			{
+				object = objectIt->second;
+			}
+
+			const NetworkProtocol::EntityState* nextState = to.find(state.id);
+			if(nextState == nullptr)
+			{
+				nextState = &state;
+			}
+			auto transform = object->getAspect<Transform2DAspect>();
+			if(transform != nullptr)
+			{
+				Vector2d position = Vector2d(NetworkProtocol::dequantize(state.x, settings.positionPrecision), NetworkProtocol::dequantize(state.y, settings.positionPrecision));
+				Vector2d nextPosition = Vector2d(NetworkProtocol::dequantize(nextState->x, settings.positionPrecision), NetworkProtocol::dequantize(nextState->y, settings.positionPrecision));
+				transform->setPosition(position + ((nextPosition - position) * progress));
+			}
+			auto velocityAspect = object->getAspect<Velocity2DAspect>();
+			if(velocityAspect != nullptr)
+			{
+				Vector2d velocity = Vector2d(NetworkProtocol::dequantize(state.velocityX, settings.velocityPrecision), NetworkProtocol::dequantize(state.velocityY, settings.velocityPrecision));
+				Vector2d nextVelocity = Vector2d(NetworkProtocol::dequantize(nextState->velocityX, settings.velocityPrecision), NetworkProtocol::dequantize(nextState->velocityY, settings.velocityPrecision));
+				velocityAspect->setVelocity(velocity + ((nextVelocity - velocity) * progress));
+			}
+		}
+	}
+}
@@ -0,0 +1,196 @@
+
+#include <GameLibrary/Network/ReplicationServer.hpp>
+#include <GameLibrary/Exception/IllegalArgumentException.hpp>
+#include <GameLibrary/World/World.hpp>
+#include <GameLibrary/World/Aspects/Movement/Transform2DAspect.hpp>
+#include <GameLibrary/World/Aspects/Movement/Velocity2DAspect.hpp>
+#include <GameLibrary/World/Aspects/Network/ReplicatedAspect.hpp>
+#include <algorithm>
+
+namespace fgl
+{
+	const size_t ReplicationServer::HISTORY_SIZE = 32;
+
+	ReplicationServer::ReplicationServer(World* world, const NetworkProtocol::Settings& settings, double sendRate)
+		: world(world),
+		settings(settings),
+		sendInterval(0),
+		time(0),
+		nextSendTime(0),
+		sequence(0),
+		nextNetworkID(1),
+		bytesSent(0)
+	{
+		if(world == nullptr)
+		{
+			throw IllegalArgumentException("world", "cannot be null");
+		}
+		else if(sendRate <= 0)
+		{
+			throw IllegalArgumentException("sendRate", "must be greater than 0");
+		}
+		sendInterval = 1000.0 / sendRate;
+	}
+
+	void ReplicationServer::addConnection(NetworkTransport* transport)
+	{
+		if(transport == nullptr)
+		{
+			throw IllegalArgumentException("transport", "cannot be null");
+		}
+		for(auto& connection : connections)
+		{
+			if(connection.transport == transport)
+			{
+				return;
+			}
+		}
+		Connection connection;
+		connection.transport = transport;
+		connection.ackedSequence = 0;
+		connection.firstEntity = 0;
+		connection.history.resize(HISTORY_SIZE);
+		connections.push_back(std::move(connection));
+	}
+
+	void ReplicationServer::removeConnection(NetworkTransport* transport)
+	{
+		connections.remove_if([=](const Connection& connection) {
+			return connection.transport == transport;
+		});
+	}
+
+	void ReplicationServer::update(const ApplicationData& appData)
+	{
+		receive();
+		time += appData.getFrameSpeedMultiplier() * 1000.0;
+		if(time >= nextSendTime)
+		{
+			sendSnapshot();
+			// don't try to catch up on missed sends after a long frame
+			nextSendTime = std::max(nextSendTime + sendInterval, time);
+		}
+	}
+
+	void ReplicationServer::receive()
+	{
+		for(auto& connection : connections)
+		{
+			while(connection.transport->receive(&packet))
+			{
+				BitReader reader(packet.getData(), packet.size());
+				Uint32 ackedSequence = 0;
+				if(NetworkProtocol::readPacketType(reader) != NetworkProtocol::PACKET_ACK || !NetworkProtocol::decodeAck(reader, &ackedSequence))
+				{
+					continue;
+				}
+				// acks for snapshots that haven't been sent, or are older than the current baseline, are ignored
+				if((Int32)(ackedSequence - sequence) <= 0 && (connection.ackedSequence == 0 || (Int32)(ackedSequence - connection.ackedSequence) > 0))
+				{
+					connection.ackedSequence = ackedSequence;
+				}
+			}
+		}
+	}
+
+	void ReplicationServer::sendSnapshot()
+	{
+		sequence++;
+		if(sequence == 0)
+		{
+			sequence = 1;
+		}
+		captureSnapshot();
+		for(auto& connection : connections)
+		{
+			const NetworkProtocol::Snapshot* baseline = nullptr;
+			if(connection.ackedSequence != 0)
+			{
+				const NetworkProtocol::Snapshot& acked = connection.history[connection.ackedSequence % HISTORY_SIZE];
+				if(acked.sequence == connection.ackedSequence)
+				{
+					baseline = &acked;
+				}
+			}
+			NetworkProtocol::Snapshot& sent = connection.history[sequence % HISTORY_SIZE];
+			if(&sent == baseline)
+			{
+				// the baseline is about to be overwritten, so the connection starts over with every object
+				baseline = nullptr;
+			}
+			writer.clear();
+			NetworkProtocol::encodeSnapshot(snapshot, baseline, settings, &connection.firstEntity, writer, &sent);
+			connection.transport->send(writer.getData(), writer.getByteCount());
+			bytesSent += writer.getByteCount();
+		}
+	}
+
+	void ReplicationServer::captureSnapshot()
+	{
+		snapshot.sequence = sequence;
+		snapshot.time = (Uint32)(Int64)time;
+		snapshot.entities.clear();
+		for(auto object : world->getObjects())
+		{
+			auto replicated = object->getAspect<ReplicatedAspect>();
+			if(replicated == nullptr)
+			{
+				continue;
+			}
+			auto transform = object->getAspect<Transform2DAspect>();
+			if(transform == nullptr)
+			{
+				continue;
+			}
+			if(replicated->getNetworkID() == 0)
+			{
+				replicated->setNetworkID(nextNetworkID);
+				nextNetworkID++;
+				if(nextNetworkID == 0)
+				{
+					nextNetworkID = 1;
+				}
+			}
+			Vector2d position = transform->getPosition();
+			Vector2d velocity;
+			if(auto velocityAspect = object->getAspect<Velocity2DAspect>())
+			{
+				velocity = velocityAspect->getVelocity();
+			}
+			NetworkProtocol::EntityState state;
+			state.id = replicated->getNetworkID();
+			state.x = NetworkProtocol::quantize(position.x, settings.positionPrecision);
+			state.y = NetworkProtocol::quantize(position.y, settings.positionPrecision);
+			state.velocityX = NetworkProtocol::quantize(velocity.x, settings.velocityPrecision);
+			state.velocityY = NetworkProtocol::quantize(velocity.y, settings.velocityPrecision);
+			snapshot.entities.push_back(state);
+		}
+		std::sort(snapshot.entities.begin(), snapshot.entities.end(), [](const NetworkProtocol::EntityState& left, const NetworkProtocol::EntityState& right) {
+			return left.id < right.id;
+		});
+		// two objects with the same ID would corrupt the deltas, so only the first is sent
+		snapshot.entities.erase(std::unique(snapshot.entities.begin(), snapshot.entities.end(), [](const NetworkProtocol::EntityState& left, const NetworkProtocol::EntityState& right) {
+			return left.id == right.id;
+		}), snapshot.entities.end());
+	}
+
+	Uint32 ReplicationServer::getSequence() const
+	{
+		return sequence;
+	}
+
+	double ReplicationServer::getTime() const
+	{
+		return time;
+	}
+
+	size_t ReplicationServer::getBytesSent() const
+	{
+		return bytesSent;
+	}
+
+	const NetworkProtocol::Settings& ReplicationServer::getSettings() const
+	{
+		return settings;
+	}
+}
@@ -1,11 +1,9 @@
 
 #include <GameLibrary/Physics/CollisionManager.hpp>
-#include <GameLibrary/Utilities/Time/TimeInterval.hpp>
+#include <GameLibrary/Utilities/Profiler.hpp>
 
 namespace fgl
 {
-	//#define PRINT_COLLISION_TIME
-	
 	CollisionManager::CollisionManager() {
 		//
 	}
@@ -83,10 +81,7 @@ namespace fgl
 #define DOUBLECHECK_COLLISIONS
 
 	void CollisionManager::update(const ApplicationData& appData) {
-		#ifdef PRINT_COLLISION_TIME
-			auto interval = TimeInterval();
-			interval.start();
-		#endif
+		FGL_PROFILE_ZONE("CollisionManager::update")
 		
 		onWillBeginCollisionUpdates(appData);
 		
@@ -500,11 +495,6 @@ namespace fgl
 		for(auto listener : listeners) {
 			listener->onFinishCollisionUpdates(this, appData);
 		}
-		
-		#ifdef PRINT_COLLISION_TIME
-			interval.stop();
-			printf("collisions took %ims\n", (int)interval.getMilliseconds());
-		#endif
 	}
 
 
@@ -513,6 +503,7 @@ namespace fgl
 
 	std::list<CollisionPair> CollisionManager::getCollisionPairs() const
 	{
+		FGL_PROFILE_ZONE("CollisionManager::getCollisionPairs")
 		std::list<CollisionPair> pairs;
 		
 		std::list<CollisionPair> prevStaticCollisions;
@@ -25,8 +25,8 @@ namespace fgl
 
 	bool CollisionPair::shouldIgnoreCollision(const CollisionRect* rect1, const CollisionRect* rect2) const
 	{
-		auto tag1 = rect1->getTag();
-		auto tag2 = rect2->getTag();
+		auto& tag1 = rect1->getTag();
+		auto& tag2 = rect2->getTag();
 		for(auto& tagPair : ignoredRectPairs) {
 			if(tagPair.first==tag1 && tagPair.second==tag2) {
 				return true;
@@ -53,8 +53,13 @@ namespace fgl
 	}
 	
 	size_t CollisionRectBuilder::findMatchingRectIndex(const ArrayList<const CollisionRect*>& collisionRects, const String& tag) {
-		return collisionRects.indexWhere([tag](auto& rect) -> bool {
-			if(rect->getTag()==tag) {
+		// look up the tag without interning it, since a tag that was never interned can't belong to any rect
+		Atom tagAtom = Atom::find(tag);
+		if(tagAtom.length() == 0 && tag.length() > 0) {
+			return (size_t)-1;
+		}
+		return collisionRects.indexWhere([&](auto& rect) -> bool {
+			if(rect->getTagAtom()==tagAtom) {
 				return true;
 			}
 			return false;
@@ -32,6 +32,19 @@ namespace fgl
 		return (iterator.getCurrentPixelIndex()>=0);
 	}
 	
+	bool BoxCollisionRect::checkSpan(const PixelIterator::Span& span, size_t* firstSample, size_t* lastSample) const {
+		if(span.count == 0) {
+			return false;
+		}
+		if(firstSample != nullptr) {
+			*firstSample = span.sample;
+		}
+		if(lastSample != nullptr) {
+			*lastSample = span.sample + span.count - 1;
+		}
+		return true;
+	}
+	
 	bool BoxCollisionRect::check(const Vector2d& point) const {
 		if(rect.contains(point)) {
 			return true;
@@ -15,6 +15,10 @@ namespace fgl
 	}
 
 	const String& CollisionRect::getTag() const {
+		return tag.toString();
+	}
+
+	const Atom& CollisionRect::getTagAtom() const {
 		return tag;
 	}
 
@@ -468,6 +472,28 @@ namespace fgl
 		}
 	}
 
+	bool CollisionRect_checkSpans(const CollisionRect* collisionRect1, const PixelIterator::Span& span1, const CollisionRect* collisionRect2, const PixelIterator::Span& span2) {
+		// narrow both spans down to the samples between their visible ends until a sample is visible in both
+		size_t startSample = Math::max(span1.sample, span2.sample);
+		size_t endSample = Math::min(span1.sample+span1.count, span2.sample+span2.count);
+		while(startSample < endSample) {
+			size_t firstSample1 = 0;
+			size_t lastSample1 = 0;
+			size_t firstSample2 = 0;
+			size_t lastSample2 = 0;
+			if(!collisionRect1->checkSpan(span1.slice(startSample, endSample), &firstSample1, &lastSample1)
+				|| !collisionRect2->checkSpan(span2.slice(startSample, endSample), &firstSample2, &lastSample2)) {
+				return false;
+			}
+			if(firstSample1 == firstSample2 || lastSample1 == lastSample2) {
+				return true;
+			}
+			startSample = Math::max(firstSample1, firstSample2);
+			endSample = Math::min(lastSample1, lastSample2) + 1;
+		}
+		return false;
+	}
+
 	Vector2d CollisionRect::getPixelOnFilledCollisionOffset(const Collidable* pixelCollidable, const CollisionRect* pixelRect, const Collidable* filledCollidable, const CollisionRect* filledRect) {
 		auto transformState1 = pixelCollidable->getTransformState();
 		auto transformState2 = filledCollidable->getTransformState();
@@ -487,10 +513,13 @@ namespace fgl
 		
 		auto pixelIter = pixelRect->createPixelIterator(overlap.translated(-transformState1.position), increment);
 		
-		while(pixelIter.nextPixelIndex()) {
-			if(pixelRect->check(pixelIter)) {
-				auto point = pixelIter.getCurrentPoint();
-				double pointRight = point.x + increment1.x;
+		PixelIterator::Span span;
+		size_t firstSample = 0;
+		size_t lastSample = 0;
+		while(pixelIter.nextPixelSpan(&span)) {
+			if(pixelRect->checkSpan(span, &firstSample, &lastSample)) {
+				auto point = span.getPoint(firstSample);
+				double pointRight = span.getPoint(lastSample).x + increment1.x;
 				double pointBottom = point.y + increment1.y;
 				if(!colliding) {
 					pixelArea.left = point.x;
@@ -502,7 +531,7 @@ namespace fgl
 					if(point.x < pixelArea.left) {
 						pixelArea.left = point.x;
 					}
-					else if(pointRight > pixelArea.right) {
+					if(pointRight > pixelArea.right) {
 						pixelArea.right = pointRight;
 					}
 					if(point.y < pixelArea.top) {
@@ -606,8 +635,9 @@ namespace fgl
 		}
 		Vector2d increment1 = pixelRect->getPreferredIncrement();
 		PixelIterator pixelIter1 = pixelRect->createPixelIterator(intersect.translated(-transformState1.position), increment1);
-		while(pixelIter1.nextPixelIndex()) {
-			if(pixelRect->check(pixelIter1)) {
+		PixelIterator::Span span;
+		while(pixelIter1.nextPixelSpan(&span)) {
+			if(pixelRect->checkSpan(span, nullptr, nullptr)) {
 				return true;
 			}
 		}
@@ -628,8 +658,19 @@ namespace fgl
 		Vector2d increment = Vector2d(Math::min(increment1.x, increment2.x), Math::min(increment1.x, increment2.x));
 		PixelIterator pixelIter1 = collisionRect1->createPixelIterator(intersect.translated(-transformState1.position), increment);
 		PixelIterator pixelIter2 = collisionRect2->createPixelIterator(intersect.translated(-transformState2.position), increment);
-		while(pixelIter1.nextPixelIndex() && pixelIter2.nextPixelIndex()) {
-			if(collisionRect1->check(pixelIter1) && collisionRect2->check(pixelIter2)) {
+		if(pixelIter1.hasTransform() || pixelIter2.hasTransform()) {
+			// the spans of a transformed iterator don't line up with rows of samples
+			while(pixelIter1.nextPixelIndex() && pixelIter2.nextPixelIndex()) {
+				if(collisionRect1->check(pixelIter1) && collisionRect2->check(pixelIter2)) {
+					return true;
+				}
+			}
+			return false;
+		}
+		PixelIterator::Span span1;
+		PixelIterator::Span span2;
+		while(pixelIter1.nextPixelSpan(&span1) && pixelIter2.nextPixelSpan(&span2)) {
+			if(CollisionRect_checkSpans(collisionRect1, span1, collisionRect2, span2)) {
 				return true;
 			}
 		}
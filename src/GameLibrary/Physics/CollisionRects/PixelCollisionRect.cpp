@@ -59,6 +59,10 @@ namespace fgl
 		return false;
 	}
 	
+	bool PixelCollisionRect::checkSpan(const PixelIterator::Span& span, size_t* firstSample, size_t* lastSample) const {
+		return image->checkPixelSpan(span, firstSample, lastSample);
+	}
+	
 	bool PixelCollisionRect::check(const Vector2d& point) const {
 		if(boundingRect.contains(point)) {
 			if(usesTransform) {
@@ -67,14 +71,15 @@ namespace fgl
 				Vector2d pixelPoint = inverseTransform.transform(point);
 				pixelPoint.x *= srcRectD.width / dstRect.width;
 				pixelPoint.y *= srcRectD.height / dstRect.height;
+				// mirrored the same way as PixelIterator, so an offset of 0 is the last pixel of the source rectangle
 				if(mirroredHorizontal) {
-					pixelPoint.x = srcRectD.x + (srcRectD.width - (pixelPoint.x-srcRectD.x));
+					pixelPoint.x = srcRectD.getRight() - 1.0 - Math::floor(pixelPoint.x);
 				}
 				else {
 					pixelPoint.x = srcRectD.x + pixelPoint.x;
 				}
 				if(mirroredVertical) {
-					pixelPoint.y = srcRectD.y + (srcRectD.height - (pixelPoint.y-srcRectD.y));
+					pixelPoint.y = srcRectD.getBottom() - 1.0 - Math::floor(pixelPoint.y);
 				}
 				else {
 					pixelPoint.y = srcRectD.y + pixelPoint.y;
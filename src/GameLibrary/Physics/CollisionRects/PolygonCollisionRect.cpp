@@ -38,6 +38,28 @@ namespace fgl
 		return polygon.contains(iterator.getCurrentPoint());
 	}
 	
+	bool PolygonCollisionRect::checkSpan(const PixelIterator::Span& span, size_t* firstSample, size_t* lastSample) const {
+		size_t endSample = span.sample + span.count;
+		size_t first = span.sample;
+		while(first < endSample && !polygon.contains(span.getPoint(first))) {
+			first++;
+		}
+		if(first == endSample) {
+			return false;
+		}
+		if(firstSample != nullptr) {
+			*firstSample = first;
+		}
+		if(lastSample != nullptr) {
+			size_t last = endSample - 1;
+			while(last > first && !polygon.contains(span.getPoint(last))) {
+				last--;
+			}
+			*lastSample = last;
+		}
+		return true;
+	}
+	
 	bool PolygonCollisionRect::check(const Vector2d& point) const {
 		return polygon.contains(point);
 	}
@@ -0,0 +1,56 @@
+
+#include "SDL_PixelFormat_ext.hpp"
+
+//palette must have room for 256 colors, and is filled in if the format uses a palette
+SDL_bool SDL_GetPixelConverterLayout(const SDL_PixelFormat* format, fgl::PixelConverter::Layout* layout, fgl::Color* palette)
+{
+	if(SDL_ISPIXELFORMAT_INDEXED(format->format))
+	{
+		if(format->BitsPerPixel != 8 || format->palette == nullptr)
+		{
+			return SDL_FALSE;
+		}
+		int colorCount = format->palette->ncolors;
+		for(int i=0; i<256; i++)
+		{
+			if(i < colorCount)
+			{
+				const SDL_Color& color = format->palette->colors[i];
+				palette[i] = fgl::Color(color.r, color.g, color.b, color.a);
+			}
+			else
+			{
+				palette[i] = fgl::Color(0, 0, 0, 255);
+			}
+		}
+		*layout = fgl::PixelConverter::getLayout(fgl::PixelConverter::Format::INDEX8, palette);
+		return SDL_TRUE;
+	}
+
+	unsigned int bpp = (unsigned int)format->BytesPerPixel;
+	if(bpp != 3 && bpp != 4)
+	{
+		return SDL_FALSE;
+	}
+	//every channel has to be a whole byte
+	if(format->Rmask != ((Uint32)0xFF << format->Rshift) || format->Gmask != ((Uint32)0xFF << format->Gshift) || format->Bmask != ((Uint32)0xFF << format->Bshift))
+	{
+		return SDL_FALSE;
+	}
+	if(format->Amask != 0 && format->Amask != ((Uint32)0xFF << format->Ashift))
+	{
+		return SDL_FALSE;
+	}
+	layout->bytesPerPixel = bpp;
+	layout->rshift = (unsigned int)format->Rshift;
+	layout->gshift = (unsigned int)format->Gshift;
+	layout->bshift = (unsigned int)format->Bshift;
+	layout->ashift = (unsigned int)format->Ashift;
+	layout->hasAlpha = (format->Amask != 0);
+	layout->palette = nullptr;
+	if(!fgl::PixelConverter::isLayoutSupported(*layout))
+	{
+		return SDL_FALSE;
+	}
+	return SDL_TRUE;
+}
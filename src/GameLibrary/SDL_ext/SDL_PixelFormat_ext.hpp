@@ -0,0 +1,7 @@
+
+#pragma once
+
+#include <SDL.h>
+#include <GameLibrary/Graphics/PixelConverter.hpp>
+
+SDL_bool SDL_GetPixelConverterLayout(const SDL_PixelFormat* format, fgl::PixelConverter::Layout* layout, fgl::Color* palette);
@@ -81,7 +81,7 @@ namespace fgl
 		data.completion = completion;
 	}
 	
-	void Screen::TransitionData_checkInitialization(ApplicationData& appData, Screen::TransitionData&data)
+	void Screen::TransitionData_checkInitialization(const ApplicationData& appData, Screen::TransitionData&data)
 	{
 		if(data.requiresInitializing)
 		{
@@ -90,7 +90,7 @@ namespace fgl
 		}
 	}
 	
-	bool Screen::TransitionData_applyProgress(ApplicationData& appData, Screen::TransitionData&data)
+	bool Screen::TransitionData_applyProgress(const ApplicationData& appData, Screen::TransitionData&data)
 	{
 		if(data.action != TRANSITION_NONE)
 		{
@@ -106,7 +106,7 @@ namespace fgl
 		return false;
 	}
 	
-	std::function<void()> Screen::TransitionData_checkFinished(ApplicationData& appData, Screen::TransitionData& data)
+	std::function<void()> Screen::TransitionData_checkFinished(const ApplicationData& appData, Screen::TransitionData& data)
 	{
 		//apply any progress to the presenting transition
 		std::function<void()> completion = data.completion;
@@ -169,6 +169,26 @@ namespace fgl
 		return false;
 	}
 
+	bool Screen::isAnimating() const
+	{
+		if(transitions.size() > 0)
+		{
+			return true;
+		}
+		for(auto& childScreenContainer : childScreens)
+		{
+			if(childScreenContainer.visible && childScreenContainer.screen->isAnimating())
+			{
+				return true;
+			}
+		}
+		if(element != nullptr && element->isAnimating())
+		{
+			return true;
+		}
+		return false;
+	}
+
 	void Screen::addChildScreen(Screen* screen, float zLayer, bool visible)
 	{
 		if(screen->parentScreen!=nullptr)
@@ -334,7 +354,7 @@ namespace fgl
 		//Open for implementation
 	}
 	
-	void Screen::update(ApplicationData appData)
+	void Screen::update(const ApplicationData& appData)
 	{
 		handleFirstShowing();
 		element->layoutChildElementsIfNeeded();
@@ -432,7 +452,7 @@ namespace fgl
 		childScreen->draw(appData, graphics);
 	}
 	
-	void Screen::draw(ApplicationData appData, Graphics graphics) const
+	void Screen::draw(const ApplicationData& appData, Graphics graphics) const
 	{
 		if(drawingOverlayTransition)
 		{
@@ -911,7 +931,7 @@ namespace fgl
 		return unlisted;
 	}
 	
-	void Screen::updateElementMouse(ApplicationData appData)
+	void Screen::updateElementMouse(const ApplicationData& appData)
 	{
 		Window* window = appData.getWindow();
 		ScreenElement* element = getElement();
@@ -995,7 +1015,7 @@ namespace fgl
 		}
 	}
 	
-	void Screen::updateElementTouch(ApplicationData appData)
+	void Screen::updateElementTouch(const ApplicationData& appData)
 	{
 		Window* window = appData.getWindow();
 		ScreenElement* element = getElement();
@@ -2,9 +2,69 @@
 #include <GameLibrary/Screen/ScreenElement.hpp>
 #include <GameLibrary/Exception/IllegalArgumentException.hpp>
 #include <GameLibrary/Exception/IllegalStateException.hpp>
+#include <algorithm>
+#include <cmath>
 
 namespace fgl
 {
+	// child elements are only bucketed into a grid once there are enough of them that checking each one is slower
+	#define TOUCHGRID_MIN_ELEMENTS 16
+	#define TOUCHGRID_MAX_CELLS_PER_SIDE 64
+	
+	struct ScreenElement::TouchGrid
+	{
+		RectangleD bounds;
+		size_t columns;
+		size_t rows;
+		// the indexes of the child elements whose touch bounds overlap each cell, in increasing order
+		ArrayList<ArrayList<size_t>> cells;
+		
+		size_t getColumn(double x) const
+		{
+			if(bounds.width <= 0)
+			{
+				return 0;
+			}
+			double column = std::floor(((x - bounds.x) / bounds.width) * (double)columns);
+			if(column < 0)
+			{
+				return 0;
+			}
+			else if(column >= (double)columns)
+			{
+				return columns-1;
+			}
+			return (size_t)column;
+		}
+		
+		size_t getRow(double y) const
+		{
+			if(bounds.height <= 0)
+			{
+				return 0;
+			}
+			double row = std::floor(((y - bounds.y) / bounds.height) * (double)rows);
+			if(row < 0)
+			{
+				return 0;
+			}
+			else if(row >= (double)rows)
+			{
+				return rows-1;
+			}
+			return (size_t)row;
+		}
+	};
+	
+	RectangleD ScreenElement_combineBounds(const RectangleD& rect1, const RectangleD& rect2)
+	{
+		double left = std::min(rect1.x, rect2.x);
+		double top = std::min(rect1.y, rect2.y);
+		double right = std::max(rect1.x+rect1.width, rect2.x+rect2.width);
+		double bottom = std::max(rect1.y+rect1.height, rect2.y+rect2.height);
+		return RectangleD(left, top, right-left, bottom-top);
+	}
+	
 	void ScreenElement::autoLayoutFrame()
 	{
 		if(parentElement!=nullptr) {
@@ -26,7 +86,11 @@ namespace fgl
 		alpha(1.0),
 		visible(true),
 		clipsToFrame(false),
-		needsLayout(true)
+		needsLayout(true),
+		touchGrid(nullptr),
+		allTouchEventsCount(0),
+		touchIndexValid(false),
+		needsAllTouchEventsCached(false)
 	{
 		//
 	}
@@ -36,29 +100,39 @@ namespace fgl
 		for(auto element : childElements) {
 			delete element;
 		}
+		delete touchGrid;
 	}
 	
-	void ScreenElement::update(ApplicationData appData) {
+	void ScreenElement::update(const ApplicationData& appData) {
 		layoutChildElementsIfNeeded();
 		updateElements(appData);
 	}
 	
+	bool ScreenElement::isAnimating() const {
+		for(auto element : childElements) {
+			if(element->isVisible() && element->isAnimating()) {
+				return true;
+			}
+		}
+		return false;
+	}
+	
 	void ScreenElement::onLayoutChildElements() {
 		// open for implementation
 	}
 	
-	void ScreenElement::updateElements(ApplicationData appData)
+	void ScreenElement::updateElements(const ApplicationData& appData)
 	{
-		appData = getChildrenApplicationData(appData);
+		auto childAppData = getChildrenApplicationData(appData);
 		ArrayList<ScreenElement*> children = childElements;
 		for(size_t i=0; i<children.size(); i++)
 		{
 			ScreenElement* element = children.get(i);
-			element->update(appData);
+			element->update(childAppData);
 		}
 	}
 	
-	void ScreenElement::drawBackground(ApplicationData appData, Graphics graphics) const
+	void ScreenElement::drawBackground(const ApplicationData& appData, Graphics graphics) const
 	{
 		if(!backgroundColor.equals(Colors::TRANSPARENT))
 		{
@@ -68,7 +142,7 @@ namespace fgl
 		}
 	}
 
-	void ScreenElement::drawBorder(ApplicationData appData, Graphics graphics) const
+	void ScreenElement::drawBorder(const ApplicationData& appData, Graphics graphics) const
 	{
 		if(borderWidth != 0 && !borderColor.equals(Colors::TRANSPARENT))
 		{
@@ -91,23 +165,23 @@ namespace fgl
 		}
 	}
 	
-	void ScreenElement::drawMain(ApplicationData appData, Graphics graphics) const
+	void ScreenElement::drawMain(const ApplicationData& appData, Graphics graphics) const
 	{
 		//Open for implementation
 	}
 	
-	void ScreenElement::drawElements(ApplicationData appData, Graphics graphics) const
+	void ScreenElement::drawElements(const ApplicationData& appData, Graphics graphics) const
 	{
-		appData = getChildrenApplicationData(appData);
+		auto childAppData = getChildrenApplicationData(appData);
 		auto childGraphics = getChildrenGraphics(graphics);
 		ArrayList<ScreenElement*> children = childElements;
 		for(auto element : children)
 		{
-			element->draw(appData, childGraphics);
+			element->draw(childAppData, childGraphics);
 		}
 	}
 	
-	void ScreenElement::draw(ApplicationData appData, Graphics graphics) const
+	void ScreenElement::draw(const ApplicationData& appData, Graphics graphics) const
 	{
 		if(visible)
 		{
@@ -124,11 +198,12 @@ namespace fgl
 		}
 	}
 	
-	ApplicationData ScreenElement::getChildrenApplicationData(ApplicationData appData) const
+	ApplicationData ScreenElement::getChildrenApplicationData(const ApplicationData& appData) const
 	{
 		auto frame = getFrame();
-		appData.getTransform().translate(frame.x, frame.y);
-		return appData;
+		ApplicationData childAppData = appData;
+		childAppData.getTransform().translate(frame.x, frame.y);
+		return childAppData;
 	}
 	
 	Graphics ScreenElement::getChildrenGraphics(Graphics graphics) const
@@ -142,6 +217,7 @@ namespace fgl
 	{
 		frame = frame_arg;
 		setNeedsLayout();
+		invalidateTouchIndex();
 	}
 	
 	void ScreenElement::layoutChildElements() {
@@ -228,6 +304,10 @@ namespace fgl
 		}
 		childElements.add(element);
 		element->parentElement = this;
+		for(ScreenElement* parent=this; parent!=nullptr; parent=parent->parentElement) {
+			parent->allTouchEventsCount += element->allTouchEventsCount;
+		}
+		invalidateTouchIndex();
 		setNeedsLayout();
 		element->onAddToScreenElement(this);
 	}
@@ -241,6 +321,10 @@ namespace fgl
 		}
 		childElements.add(index, element);
 		element->parentElement = this;
+		for(ScreenElement* parent=this; parent!=nullptr; parent=parent->parentElement) {
+			parent->allTouchEventsCount += element->allTouchEventsCount;
+		}
+		invalidateTouchIndex();
 		setNeedsLayout();
 		element->onAddToScreenElement(this);
 	}
@@ -256,6 +340,10 @@ namespace fgl
 		}
 		auto oldParentElement = parentElement;
 		parentElement->childElements.remove(index);
+		for(ScreenElement* parent=oldParentElement; parent!=nullptr; parent=parent->parentElement) {
+			parent->allTouchEventsCount -= allTouchEventsCount;
+		}
+		oldParentElement->invalidateTouchIndex();
 		parentElement = nullptr;
 		onRemoveFromScreenElement(oldParentElement);
 	}
@@ -281,6 +369,7 @@ namespace fgl
 			ScreenElement* element = childElements.get(index);
 			childElements.remove(index);
 			childElements.add(element);
+			invalidateTouchIndex();
 		}
 	}
 	
@@ -305,6 +394,7 @@ namespace fgl
 			ScreenElement* element = childElements.get(index);
 			childElements.remove(index);
 			childElements.add(0, element);
+			invalidateTouchIndex();
 		}
 	}
 	
@@ -436,50 +526,203 @@ namespace fgl
 		//Open for implementation
 	}
 
-	bool ScreenElement::sendTouchEvent(const TouchEvent& touchEvent)
+	bool ScreenElement::needsAllTouchEvents() const
 	{
-		if(handleTouchEvent(touchEvent))
+		return false;
+	}
+	
+	void ScreenElement::updateNeedsAllTouchEvents()
+	{
+		bool needsAll = needsAllTouchEvents();
+		if(needsAll == needsAllTouchEventsCached)
 		{
-			auto childEvent = touchEvent.withAppData(getChildrenApplicationData(touchEvent.getApplicationData()));
-			ArrayList<ScreenElement*> elements = childElements;
-			for(size_t i=(elements.size()-1); i!=-1; i--) {
-				ScreenElement* element = elements[i];
-				element->sendHandledTouchEvent(childEvent);
+			return;
+		}
+		needsAllTouchEventsCached = needsAll;
+		for(ScreenElement* element=this; element!=nullptr; element=element->parentElement)
+		{
+			if(needsAll)
+			{
+				element->allTouchEventsCount++;
+			}
+			else
+			{
+				element->allTouchEventsCount--;
 			}
-			return true;
 		}
-		else
+	}
+	
+	RectangleD ScreenElement::calculateTouchBounds() const
+	{
+		if(childElements.size() == 0)
+		{
+			return frame;
+		}
+		RectangleD childBounds = childTouchBounds;
+		childBounds.x += frame.x;
+		childBounds.y += frame.y;
+		return ScreenElement_combineBounds(frame, childBounds);
+	}
+	
+	void ScreenElement::invalidateTouchIndex()
+	{
+		// an element's touch bounds are only valid if all of its child elements' touch bounds are, so the walk can stop at the first invalid element
+		for(ScreenElement* element=this; element!=nullptr && element->touchIndexValid; element=element->parentElement)
+		{
+			element->touchIndexValid = false;
+		}
+	}
+	
+	void ScreenElement::updateTouchIndex()
+	{
+		if(touchIndexValid)
+		{
+			return;
+		}
+		size_t childCount = childElements.size();
+		for(size_t i=0; i<childCount; i++)
 		{
-			auto childEvent = touchEvent.withAppData(getChildrenApplicationData(touchEvent.getApplicationData()));
-			bool handled = false;
-			ArrayList<ScreenElement*> elements = childElements;
-			for(size_t i=(elements.size()-1); i!=-1; i--)
+			ScreenElement* element = childElements[i];
+			element->updateTouchIndex();
+			if(i == 0)
+			{
+				childTouchBounds = element->touchBounds;
+			}
+			else
+			{
+				childTouchBounds = ScreenElement_combineBounds(childTouchBounds, element->touchBounds);
+			}
+		}
+		
+		if(childCount >= TOUCHGRID_MIN_ELEMENTS)
+		{
+			if(touchGrid == nullptr)
+			{
+				touchGrid = new TouchGrid();
+			}
+			// aim for a couple of elements in each cell
+			size_t cellsPerSide = (size_t)std::ceil(std::sqrt((double)childCount / 2.0));
+			cellsPerSide = std::min(cellsPerSide, (size_t)TOUCHGRID_MAX_CELLS_PER_SIDE);
+			touchGrid->bounds = childTouchBounds;
+			touchGrid->columns = (childTouchBounds.width > 0) ? cellsPerSide : 1;
+			touchGrid->rows = (childTouchBounds.height > 0) ? cellsPerSide : 1;
+			touchGrid->cells.clear();
+			touchGrid->cells.resize(touchGrid->columns * touchGrid->rows);
+			for(size_t i=0; i<childCount; i++)
 			{
-				ScreenElement* element = elements[i];
-				if(handled)
+				const RectangleD& bounds = childElements[i]->touchBounds;
+				size_t left = touchGrid->getColumn(bounds.x);
+				size_t right = touchGrid->getColumn(bounds.x + bounds.width);
+				size_t top = touchGrid->getRow(bounds.y);
+				size_t bottom = touchGrid->getRow(bounds.y + bounds.height);
+				for(size_t row=top; row<=bottom; row++)
 				{
-					element->sendHandledTouchEvent(childEvent);
+					for(size_t column=left; column<=right; column++)
+					{
+						touchGrid->cells[(row * touchGrid->columns) + column].add(i);
+					}
 				}
-				else
+			}
+		}
+		else if(touchGrid != nullptr)
+		{
+			delete touchGrid;
+			touchGrid = nullptr;
+		}
+		
+		touchBounds = calculateTouchBounds();
+		touchIndexValid = true;
+	}
+	
+	ArrayList<ScreenElement*> ScreenElement::getTouchEventChildElements(const Vector2d& point) const
+	{
+		std::vector<size_t> indexes;
+		if(touchGrid != nullptr)
+		{
+			if(touchGrid->bounds.contains(point))
+			{
+				auto& cell = touchGrid->cells[(touchGrid->getRow(point.y) * touchGrid->columns) + touchGrid->getColumn(point.x)];
+				for(auto index : cell)
 				{
-					if(element->sendTouchEvent(childEvent))
+					if(childElements[index]->touchBounds.contains(point))
 					{
-						handled = true;
+						indexes.push_back(index);
 					}
 				}
 			}
+		}
+		else
+		{
+			for(size_t childElements_size=childElements.size(), i=0; i<childElements_size; i++)
+			{
+				if(childElements[i]->touchBounds.contains(point))
+				{
+					indexes.push_back(i);
+				}
+			}
+		}
+		// elements that are tracking a touch still need its events after it leaves their touch bounds
+		size_t ownCount = needsAllTouchEventsCached ? 1 : 0;
+		if(allTouchEventsCount > ownCount)
+		{
+			for(size_t childElements_size=childElements.size(), i=0; i<childElements_size; i++)
+			{
+				if(childElements[i]->allTouchEventsCount > 0)
+				{
+					indexes.push_back(i);
+				}
+			}
+		}
+		std::sort(indexes.begin(), indexes.end());
+		indexes.erase(std::unique(indexes.begin(), indexes.end()), indexes.end());
+		
+		ArrayList<ScreenElement*> elements;
+		elements.reserve(indexes.size());
+		for(size_t i=indexes.size()-1; i!=(size_t)-1; i--)
+		{
+			elements.add(childElements[indexes[i]]);
+		}
+		return elements;
+	}
+
+	bool ScreenElement::sendTouchEvent(const TouchEvent& touchEvent)
+	{
+		bool handled = handleTouchEvent(touchEvent);
+		if(childElements.size() == 0)
+		{
 			return handled;
 		}
+		// updated after handling the event, in case the handler changed the child elements
+		updateTouchIndex();
+		auto childEvent = touchEvent.withAppData(getChildrenApplicationData(touchEvent.getApplicationData()));
+		ArrayList<ScreenElement*> elements = getTouchEventChildElements(childEvent.getPosition());
+		for(auto element : elements)
+		{
+			if(handled)
+			{
+				element->sendHandledTouchEvent(childEvent);
+			}
+			else if(element->sendTouchEvent(childEvent))
+			{
+				handled = true;
+			}
+		}
+		return handled;
 	}
 
 	void ScreenElement::sendHandledTouchEvent(const TouchEvent& touchEvent)
 	{
 		otherElementHandledTouchEvent(touchEvent);
+		if(childElements.size() == 0)
+		{
+			return;
+		}
+		// the child elements under the touch are told about it too, along with any that are tracking a touch
+		updateTouchIndex();
 		auto childEvent = touchEvent.withAppData(getChildrenApplicationData(touchEvent.getApplicationData()));
-		ArrayList<ScreenElement*> elements = childElements;
-		for(size_t i=(elements.size()-1); i!=-1; i--)
+		ArrayList<ScreenElement*> elements = getTouchEventChildElements(childEvent.getPosition());
+		for(auto element : elements)
 		{
-			ScreenElement* element = elements[i];
 			element->sendHandledTouchEvent(childEvent);
 		}
 	}
@@ -502,7 +745,7 @@ namespace fgl
 		}
 	}
 
-	ScreenElement::TouchEvent::TouchEvent(const EventType& eventType, unsigned int touchID, ApplicationData appData, const Vector2d& realPosition, bool isMouse)
+	ScreenElement::TouchEvent::TouchEvent(const EventType& eventType, unsigned int touchID, const ApplicationData& appData, const Vector2d& realPosition, bool isMouse)
 		: eventType(eventType),
 		touchID(touchID),
 		appData(appData),
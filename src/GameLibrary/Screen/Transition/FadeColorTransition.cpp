@@ -20,7 +20,7 @@ namespace fgl
 		//
 	}
 	
-	void FadeColorTransition::draw(ApplicationData appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const
+	void FadeColorTransition::draw(const ApplicationData& appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const
 	{
 		double firstPart = (1-frozenPortion)/2;
 		double secondPart = 1-firstPart;
@@ -15,7 +15,7 @@ namespace fgl
 		//
 	}
 
-	void FadeZoomTransition::draw(ApplicationData appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const
+	void FadeZoomTransition::draw(const ApplicationData& appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const
 	{
 		double zoom = startZoom + ((double)progress * (endZoom - startZoom));
 
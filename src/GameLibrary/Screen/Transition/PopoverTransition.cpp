@@ -22,7 +22,7 @@ namespace fgl
 		//
 	}
 	
-	void PopoverTransition::draw(ApplicationData appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const
+	void PopoverTransition::draw(const ApplicationData& appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const
 	{
 		Vector2d e1size = screen1->getSize();
 		Vector2d e2size = screen2->getSize();
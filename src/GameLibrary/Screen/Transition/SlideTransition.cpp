@@ -21,7 +21,7 @@ namespace fgl
 		//
 	}
 	
-	void SlideTransition::draw(ApplicationData appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const
+	void SlideTransition::draw(const ApplicationData& appData, Graphics graphics, double progress, Screen* screen1, Screen* screen2) const
 	{
 		Graphics screen1Graphics(graphics);
 		Graphics screen2Graphics(graphics);
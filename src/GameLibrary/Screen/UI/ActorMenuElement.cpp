@@ -21,7 +21,7 @@ namespace fgl
 		}
 	}
 	
-	void ActorMenuElement::update(ApplicationData appData)
+	void ActorMenuElement::update(const ApplicationData& appData)
 	{
 		ScreenElement::update(appData);
 		ArrayList<std::pair<Keyboard::Key, KeyDirection> > keyList = keys;
@@ -256,12 +256,12 @@ namespace fgl
 		}
 	}
 	
-	void ActorMenuElement::drawActor(ApplicationData appData, Graphics graphics, Actor*actor) const
+	void ActorMenuElement::drawActor(const ApplicationData& appData, Graphics graphics, Actor*actor) const
 	{
 		actor->draw(appData, graphics);
 	}
 	
-	void ActorMenuElement::drawMain(ApplicationData appData, Graphics graphics) const
+	void ActorMenuElement::drawMain(const ApplicationData& appData, Graphics graphics) const
 	{
 		size_t hoveredIndex = selectedIndex;
 		for(size_t i=0; i<actors.size(); i++)
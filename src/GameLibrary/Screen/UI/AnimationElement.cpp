@@ -33,13 +33,24 @@ namespace fgl
 		//
 	}
 	
-	void AnimationElement::update(ApplicationData appData)
+	void AnimationElement::update(const ApplicationData& appData)
 	{
 		animationPlayer.update(appData);
 		updateAnimationImage();
 		ScreenElement::update(appData);
 	}
 	
+	bool AnimationElement::isAnimating() const
+	{
+		Animation* animation = animationPlayer.getAnimation();
+		if(animation != nullptr && animation->getFrameCount() > 1 && animation->getFPS() > 0
+			&& animationPlayer.getDirection() != Animation::Direction::STOPPED)
+		{
+			return true;
+		}
+		return ScreenElement::isAnimating();
+	}
+	
 	void AnimationElement::setAnimation(Animation* anim, const Animation::Direction& direction)
 	{
 		animationPlayer.setAnimation(anim, direction);
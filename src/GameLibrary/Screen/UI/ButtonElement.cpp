@@ -81,7 +81,7 @@ namespace fgl
 		}
 	}
 	
-	void ButtonElement::draw(ApplicationData appData, Graphics graphics) const
+	void ButtonElement::draw(const ApplicationData& appData, Graphics graphics) const
 	{
 		auto tintColor = getTintColor(buttonState);
 		if(tintColor!=Colors::WHITE)
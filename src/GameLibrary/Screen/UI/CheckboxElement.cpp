@@ -14,7 +14,7 @@ namespace fgl
 		setBorderWidth(1);
 	}
 	
-	void CheckboxElement::drawMain(ApplicationData appData, Graphics graphics) const
+	void CheckboxElement::drawMain(const ApplicationData& appData, Graphics graphics) const
 	{
 		if(toggle)
 		{
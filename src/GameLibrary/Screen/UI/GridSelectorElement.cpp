@@ -18,7 +18,7 @@ namespace fgl
 		//
 	}
 	
-	void GridSelectorElement::update(fgl::ApplicationData appData)
+	void GridSelectorElement::update(const fgl::ApplicationData& appData)
 	{
 		ZoomPanElement::update(appData);
 		
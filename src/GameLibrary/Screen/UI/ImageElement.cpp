@@ -32,7 +32,7 @@ namespace fgl
 		//
 	}
 	
-	void ImageElement::drawMain(ApplicationData appData, Graphics graphics) const
+	void ImageElement::drawMain(const ApplicationData& appData, Graphics graphics) const
 	{
 		if(image!=nullptr)
 		{
@@ -12,7 +12,7 @@ namespace fgl
 		menuScreen = screen;
 	}
 	
-	void MenuScreen::MainElement::drawActor(ApplicationData appData, Graphics graphics, Actor*actor) const
+	void MenuScreen::MainElement::drawActor(const ApplicationData& appData, Graphics graphics, Actor*actor) const
 	{
 		menuScreen->drawItem(appData, graphics, actor);
 	}
@@ -66,7 +66,7 @@ namespace fgl
 		element->addChildElement(mainElement);
 	}
 	
-	void MenuScreen::drawItem(ApplicationData appData, Graphics graphics, Actor*item) const
+	void MenuScreen::drawItem(const ApplicationData& appData, Graphics graphics, Actor*item) const
 	{
 		item->draw(appData, graphics);
 	}
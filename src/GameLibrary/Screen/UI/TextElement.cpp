@@ -29,7 +29,7 @@ namespace fgl
 		//
 	}
 
-	void TextElement::drawMain(ApplicationData appData, Graphics graphics) const
+	void TextElement::drawMain(const ApplicationData& appData, Graphics graphics) const
 	{
 		auto fontSize = getAdjustedFontSize();
 		ArrayList<MeasuredLine> lines = measureLines(fontSize);
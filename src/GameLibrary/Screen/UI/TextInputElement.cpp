@@ -54,7 +54,7 @@ namespace fgl
 		addChildElement(textElement);
 	}
 	
-	void TextInputElement::update(ApplicationData appData)
+	void TextInputElement::update(const ApplicationData& appData)
 	{
 		TouchElement::update(appData);
 	}
@@ -77,6 +77,7 @@ namespace fgl
 		TextInputElement_input_responder = this;
 		Keyboard::addEventListener(&textInputListener);
 		Keyboard::startTextInput();
+		updateNeedsAllTouchEvents();
 		return true;
 	}
 	
@@ -93,6 +94,7 @@ namespace fgl
 		TextInputElement_input_responder = nullptr;
 		Keyboard::removeEventListener(&textInputListener);
 		Keyboard::endTextInput();
+		updateNeedsAllTouchEvents();
 	}
 	
 	bool TextInputElement::isTextInputResponder() const
@@ -179,6 +181,7 @@ namespace fgl
 	void TextInputElement::setResigningOnOutsideTouchEnabled(bool toggle)
 	{
 		resignsOnOutsideTouch = toggle;
+		updateNeedsAllTouchEvents();
 	}
 
 	bool TextInputElement::isResigningOnOutsideTouchEnabled() const
@@ -233,6 +236,16 @@ namespace fgl
 		}
 	}
 	
+	bool TextInputElement::needsAllTouchEvents() const
+	{
+		//touches outside of the element make it resign
+		if(resignsOnOutsideTouch && isTextInputResponder())
+		{
+			return true;
+		}
+		return TouchElement::needsAllTouchEvents();
+	}
+	
 	void TextInputElement::onRemoveFromScreenElement(ScreenElement* parent) {
 		if(isTextInputResponder()) {
 			resignTextInputResponder();
@@ -14,7 +14,7 @@ namespace fgl
 		//
 	}
 	
-	void TouchElement::update(ApplicationData appData)
+	void TouchElement::update(const ApplicationData& appData)
 	{
 		ScreenElement::update(appData);
 		if(!isVisibleInHeirarchy() || !touchEnabled)
@@ -94,6 +94,7 @@ namespace fgl
 		{
 			TouchData touchData = { .lastEvent=touchEvent, .inside=true };
 			touches.add(touchData);
+			updateNeedsAllTouchEvents();
 		}
 		else
 		{
@@ -109,6 +110,7 @@ namespace fgl
 		if(touchIndex!=-1)
 		{
 			touches.remove(touchIndex);
+			updateNeedsAllTouchEvents();
 		}
 	}
 	
@@ -215,4 +217,10 @@ namespace fgl
 	{
 		cancelTouch(touchEvent);
 	}
+	
+	bool TouchElement::needsAllTouchEvents() const
+	{
+		//moves and releases of a tracked touch are sent even after the touch leaves the element
+		return (touches.size() > 0);
+	}
 }
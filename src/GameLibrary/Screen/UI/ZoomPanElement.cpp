@@ -18,6 +18,7 @@ namespace fgl
 		contentSize(0,0),
 		zoomScale(1),
 		lastScrollbarFocusMillis(0),
+		scrollbarsShowing(true),
 		horizontalScrollbarTouchID(0),
 		horizontalScrollbarDragging(false),
 		verticalScrollbarTouchID(0),
@@ -72,13 +73,22 @@ namespace fgl
 		zoomOnPoint(fixedPoint, zoom);
 	}
 	
-	void ZoomPanElement::drawElements(ApplicationData appData, Graphics graphics) const
+	bool ZoomPanElement::isAnimating() const
+	{
+		if(scrollbarsShowing)
+		{
+			return true;
+		}
+		return ScreenElement::isAnimating();
+	}
+	
+	void ZoomPanElement::drawElements(const ApplicationData& appData, Graphics graphics) const
 	{
 		ScreenElement::drawElements(appData, graphics);
 		drawScrollbars(appData, graphics);
 	}
 	
-	void ZoomPanElement::drawScrollbars(ApplicationData appData, Graphics graphics) const
+	void ZoomPanElement::drawScrollbars(const ApplicationData& appData, Graphics graphics) const
 	{
 		double visibility = 0;
 		auto currentTimeMillis = appData.getTime().getMilliseconds();
@@ -91,6 +101,7 @@ namespace fgl
 		{
 			visibility = 0.7 - (((double)(timeSinceLastFocus - SCROLLBAR_VISIBLE_TIME) / (double)SCROLLBAR_FADE_TIME)*0.7);
 		}
+		scrollbarsShowing = (visibility > 0);
 		
 		auto frame = getFrame();
 		auto scrollbarFrames = getScrollbarFrames();
@@ -126,6 +137,7 @@ namespace fgl
 				horizontalScrollbarTouchOffset = touchpos - scrollbarFrames.first.getCenter();
 				horizontalScrollbarTouchID = touchEvent.getTouchID();
 				lastScrollbarFocusMillis = touchEvent.getApplicationData().getTime().getMilliseconds();
+				updateNeedsAllTouchEvents();
 				return true;
 			}
 			if(!verticalScrollbarDragging && scrollbarFrames.second.contains(touchpos))
@@ -134,6 +146,7 @@ namespace fgl
 				verticalScrollbarTouchOffset = touchpos - scrollbarFrames.second.getCenter();
 				verticalScrollbarTouchID = touchEvent.getTouchID();
 				lastScrollbarFocusMillis = touchEvent.getApplicationData().getTime().getMilliseconds();
+				updateNeedsAllTouchEvents();
 				return true;
 			}
 			break;
@@ -186,6 +199,7 @@ namespace fgl
 				horizontalScrollbarDragging = false;
 				horizontalScrollbarTouchID = 0;
 				horizontalScrollbarTouchOffset = Vector2d(0,0);
+				updateNeedsAllTouchEvents();
 				return false;
 			}
 			if(verticalScrollbarDragging && verticalScrollbarTouchID==touchEvent.getTouchID())
@@ -193,6 +207,7 @@ namespace fgl
 				verticalScrollbarDragging = false;
 				verticalScrollbarTouchID = 0;
 				verticalScrollbarTouchOffset = Vector2d(0,0);
+				updateNeedsAllTouchEvents();
 				return false;
 			}
 			break;
@@ -214,14 +229,26 @@ namespace fgl
 			verticalScrollbarTouchID = 0;
 			verticalScrollbarTouchOffset = Vector2d(0,0);
 		}
+		updateNeedsAllTouchEvents();
+	}
+	
+	bool ZoomPanElement::needsAllTouchEvents() const
+	{
+		//a dragged scrollbar keeps following the touch outside of the element
+		return (horizontalScrollbarDragging || verticalScrollbarDragging);
+	}
+	
+	RectangleD ZoomPanElement::calculateTouchBounds() const
+	{
+		return getFrame();
 	}
 	
-	ApplicationData ZoomPanElement::getChildrenApplicationData(ApplicationData appData) const
+	ApplicationData ZoomPanElement::getChildrenApplicationData(const ApplicationData& appData) const
 	{
-		appData = ScreenElement::getChildrenApplicationData(appData);
-		appData.getTransform().translate(-contentOffset.x*zoomScale, -contentOffset.y*zoomScale);
-		appData.getTransform().scale(zoomScale, zoomScale);
-		return appData;
+		ApplicationData childAppData = ScreenElement::getChildrenApplicationData(appData);
+		childAppData.getTransform().translate(-contentOffset.x*zoomScale, -contentOffset.y*zoomScale);
+		childAppData.getTransform().scale(zoomScale, zoomScale);
+		return childAppData;
 	}
 	
 	Graphics ZoomPanElement::getChildrenGraphics(Graphics graphics) const
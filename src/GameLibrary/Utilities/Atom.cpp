@@ -0,0 +1,86 @@
+
+#include <GameLibrary/Utilities/Atom.hpp>
+#include <mutex>
+#include <unordered_set>
+
+namespace fgl
+{
+	// interned strings are split across several tables, so that threads interning different strings rarely wait on each other
+	struct AtomTable
+	{
+		std::mutex mutex;
+		std::unordered_set<String> strings;
+	};
+
+	static constexpr size_t Atom_tableCount = 16;
+
+	static AtomTable* Atom_getTables()
+	{
+		// the tables are never destroyed, so atoms stay valid during static destruction
+		static AtomTable* tables = new AtomTable[Atom_tableCount];
+		return tables;
+	}
+
+	static AtomTable& Atom_getTable(const String& str)
+	{
+		return Atom_getTables()[(str.hash() >> 7) % Atom_tableCount];
+	}
+
+	static const String* Atom_intern(const String& str)
+	{
+		AtomTable& table = Atom_getTable(str);
+		std::lock_guard<std::mutex> lock(table.mutex);
+		// unordered_set nodes never move, so the address of the interned string stays valid
+		return &(*table.strings.insert(str).first);
+	}
+
+	static const String* Atom_find(const String& str)
+	{
+		AtomTable& table = Atom_getTable(str);
+		std::lock_guard<std::mutex> lock(table.mutex);
+		auto it = table.strings.find(str);
+		if(it == table.strings.end())
+		{
+			return nullptr;
+		}
+		return &(*it);
+	}
+
+	static const String* Atom_empty()
+	{
+		static const String* empty = Atom_intern(String());
+		return empty;
+	}
+
+	Atom::Atom()
+		: string(Atom_empty())
+	{
+		//
+	}
+
+	Atom::Atom(const String& str)
+		: string((str.length() == 0) ? Atom_empty() : Atom_intern(str))
+	{
+		//
+	}
+
+	Atom::Atom(const char* str)
+		: string((str == nullptr || str[0] == '\0') ? Atom_empty() : Atom_intern(String(str)))
+	{
+		//
+	}
+
+	Atom Atom::find(const String& str)
+	{
+		Atom atom;
+		if(str.length() > 0)
+		{
+			const String* string = Atom_find(str);
+			if(string != nullptr)
+			{
+				atom.string = string;
+			}
+		}
+		return atom;
+	}
+}
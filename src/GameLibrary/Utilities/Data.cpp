@@ -108,6 +108,22 @@ namespace fgl
 		return *this;
 	}
 	
+	Data& Data::operator=(Data&& dataPacket)
+	{
+		if(this != &dataPacket)
+		{
+			if(data!=nullptr)
+			{
+				std::free(data);
+			}
+			data = dataPacket.data;
+			length = dataPacket.length;
+			dataPacket.data = nullptr;
+			dataPacket.length = 0;
+		}
+		return *this;
+	}
+	
 	bool Data::loadFromPath(const String& path, String* error)
 	{
 		FILE* file = fgl::FileTools::openFile(path, "rb", error);
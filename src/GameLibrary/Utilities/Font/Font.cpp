@@ -181,15 +181,28 @@ namespace fgl
 		{
 			throw fgl::IllegalArgumentException("file", "cannot be null");
 		}
-		mlock.lock();
 		Data* fontDataPacket = new Data();
 		if(!fontDataPacket->loadFromFile(file, error))
 		{
 			delete fontDataPacket;
-			mlock.unlock();
 			return false;
 		}
-		
+		return loadFromDataPacket(fontDataPacket, error);
+	}
+	
+	bool Font::loadFromData(const Data& data, String* error)
+	{
+		return loadFromDataPacket(new Data(data), error);
+	}
+	
+	bool Font::loadFromData(Data&& data, String* error)
+	{
+		return loadFromDataPacket(new Data(std::move(data)), error);
+	}
+	
+	bool Font::loadFromDataPacket(Data* fontDataPacket, String* error)
+	{
+		mlock.lock();
 		SDL_RWops* ops = SDL_RWFromConstMem(fontDataPacket->getData(), (int)fontDataPacket->size());
 		if(ops == nullptr)
 		{
@@ -373,4 +386,13 @@ namespace fgl
 	{
 		return antialiasing;
 	}
+	
+	size_t Font::getDataSize() const
+	{
+		if(fontData==nullptr)
+		{
+			return 0;
+		}
+		return fontData->size();
+	}
 }
@@ -4,96 +4,78 @@
 namespace fgl
 {
 	Number::Number()
-		: ptr(new Derived<long long>(0LL))
 	{
-		//
+		new(&storage) Derived<long long>(0LL);
 	}
 	
 	Number::Number(const Number& number)
-		: ptr(number.ptr->clone())
 	{
-		//
+		number.base()->clone(&storage);
 	}
 	
-	Number::Number(Number&& number)
-		: ptr(number.ptr)
+	Number::Number(Number&& number) noexcept
 	{
-		number.ptr = nullptr;
-	}
-	
-	Number::Number(Base* base)
-		: ptr(base)
-	{
-		//
+		// the value is stored inline, so moving is the same as copying
+		number.base()->clone(&storage);
 	}
 	
 	Number::~Number()
 	{
-		if(ptr!=nullptr)
-		{
-			delete ptr;
-		}
+		base()->~Base();
 	}
 	
 	Number& Number::operator=(const Number& number)
 	{
-		Base* old_ptr = ptr;
-		ptr = number.ptr->clone();
-		delete old_ptr;
+		if(&number != this)
+		{
+			base()->~Base();
+			number.base()->clone(&storage);
+		}
 		return *this;
 	}
 	
-	Number& Number::operator=(Number&& number)
+	Number& Number::operator=(Number&& number) noexcept
 	{
-		Base* old_ptr = ptr;
-		ptr = number.ptr;
-		number.ptr = nullptr;
-		delete old_ptr;
+		if(&number != this)
+		{
+			base()->~Base();
+			number.base()->clone(&storage);
+		}
 		return *this;
 	}
 	
 	void Number::selectOptimalType(const Number& right)
 	{
-		size_t r_size = right.ptr->getNumberOfBytes();
-		size_t size = ptr->getNumberOfBytes();
-		bool r_fp = right.ptr->isFloatingPoint();
-		bool fp = ptr->isFloatingPoint();
-		bool r_uns = right.ptr->isUnsigned();
-		bool uns = ptr->isUnsigned();
+		size_t r_size = right.base()->getNumberOfBytes();
+		size_t size = base()->getNumberOfBytes();
+		bool r_fp = right.base()->isFloatingPoint();
+		bool fp = base()->isFloatingPoint();
+		bool r_uns = right.base()->isUnsigned();
+		bool uns = base()->isUnsigned();
 		if(size < r_size)
 		{
 			if(r_fp || (r_uns && fp))
 			{
-				Base* old_ptr = ptr;
-				ptr = new Derived<long double>(old_ptr->to<long double>());
-				delete old_ptr;
+				setValue<long double>(base()->to<long double>());
 			}
 			else
 			{
-				Base* old_ptr = ptr;
-				ptr = new Derived<long long>(old_ptr->to<long long>());
-				delete old_ptr;
+				setValue<long long>(base()->to<long long>());
 			}
 		}
 		else if(r_fp && !fp)
 		{
-			Base* old_ptr = ptr;
-			ptr = new Derived<long double>(old_ptr->to<long double>());
-			delete old_ptr;
+			setValue<long double>(base()->to<long double>());
 		}
 		else if(!r_uns && uns)
 		{
 			if(r_fp)
 			{
-				Base* old_ptr = ptr;
-				ptr = new Derived<long double>(old_ptr->to<long double>());
-				delete old_ptr;
+				setValue<long double>(base()->to<long double>());
 			}
 			else
 			{
-				Base* old_ptr = ptr;
-				ptr = new Derived<long long>(old_ptr->to<long long>());
-				delete old_ptr;
+				setValue<long long>(base()->to<long long>());
 			}
 		}
 	}
@@ -101,100 +83,102 @@ namespace fgl
 	Number& Number::operator+=(const Number& number)
 	{
 		selectOptimalType(number);
-		ptr->add(number.ptr);
+		base()->add(number.base());
 		return *this;
 	}
 	
 	Number& Number::operator-=(const Number& number)
 	{
 		selectOptimalType(number);
-		ptr->subtract(number.ptr);
+		base()->subtract(number.base());
 		return *this;
 	}
 	
 	Number& Number::operator*=(const Number& number)
 	{
 		selectOptimalType(number);
-		ptr->multiply(number.ptr);
+		base()->multiply(number.base());
 		return *this;
 	}
 	
 	Number& Number::operator/=(const Number& number)
 	{
 		selectOptimalType(number);
-		ptr->divide(number.ptr);
+		base()->divide(number.base());
 		return *this;
 	}
 	
 	Number& Number::operator%=(const Number& number)
 	{
 		selectOptimalType(number);
-		ptr->mod(number.ptr);
+		base()->mod(number.base());
 		return *this;
 	}
 	
 	Number& Number::operator++()
 	{
-		ptr->increment();
+		base()->increment();
 		return *this;
 	}
 	
 	Number& Number::operator--()
 	{
-		ptr->decrement();
+		base()->decrement();
 		return *this;
 	}
 	
 	Number Number::operator-() const
 	{
-		Base* base = ptr->toSigned();
-		base->neg();
-		return Number(base);
+		Number number;
+		number.base()->~Base();
+		base()->toSigned(&number.storage);
+		number.base()->neg();
+		return number;
 	}
 	
 	int Number::compare(const Number& num) const
 	{
-		return ptr->compare(num.ptr);
+		return base()->compare(num.base());
 	}
 	
 	bool Number::equals(const Number& num) const
 	{
-		return (ptr->compare(num.ptr) == 0);
+		return (base()->compare(num.base()) == 0);
 	}
 	
 	bool Number::isBool() const
 	{
-		return ptr->isBool();
+		return base()->isBool();
 	}
 	
 	bool Number::isIntegral() const
 	{
-		return ptr->isIntegral();
+		return base()->isIntegral();
 	}
 	
 	bool Number::isFloatingPoint() const
 	{
-		return ptr->isFloatingPoint();
+		return base()->isFloatingPoint();
 	}
 	
 	bool Number::isSigned() const
 	{
-		return ptr->isSigned();
+		return base()->isSigned();
 	}
 	
 	bool Number::isUnsigned() const
 	{
-		return ptr->isUnsigned();
+		return base()->isUnsigned();
 	}
 	
 	String Number::toString() const
 	{
-		return ptr->toString();
+		return base()->toString();
 	}
 	
 	std::ostream& operator<<(std::ostream& stream, const Number& num)
 	{
-		return num.ptr->stream(stream);
+		return num.base()->stream(stream);
 	}
 	
 	Number operator+(const Number& left, const Number& right)
@@ -9,20 +9,25 @@
 #include <GameLibrary/Utilities/PlatformChecks.hpp>
 #include <GameLibrary/Exception/IllegalArgumentException.hpp>
 #include <GameLibrary/Exception/NumberFormatException.hpp>
-#include <pugixml.hpp>
-#include <base64.hpp>
+#include <cerrno>
 #include <cstdio>
-#include <iomanip>
-#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <string>
 #include <time.h>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 //loading and saving plist code adapted from PlistCpp. https://github.com/animetrics/PlistCpp
 //All credit goes to animetrics
 
 namespace fgl
 {
-	Number extractNumber(const Dictionary& dict, const Dictionary::Key& key, const Number& defaultValue)
+	template<typename DICT_TYPE>
+	Number Plist_extractNumber(const DICT_TYPE& dict, const typename DICT_TYPE::Key& key, const Number& defaultValue)
 	{
 		try
 		{
@@ -86,26 +91,39 @@ namespace fgl
 			return defaultValue;
 		}
 	}
-
 	
-	void Plist_base64Decode(const char* encodedData, std::vector<char>& data);
-	void Plist_base64Encode(std::string& dataEncoded, const Data& data);
+	Number extractNumber(const Dictionary& dict, const Dictionary::Key& key, const Number& defaultValue)
+	{
+		return Plist_extractNumber(dict, key, defaultValue);
+	}
 	
+	Number extractNumber(const HashDictionary& dict, const HashDictionary::Key& key, const Number& defaultValue)
+	{
+		return Plist_extractNumber(dict, key, defaultValue);
+	}
+
+
+
+	// containers nested deeper than this are treated as malformed, rather than risking a stack overflow
+	static constexpr size_t Plist_maxDepth = 512;
+	// the output is flushed to the file whenever this many bytes are buffered
+	static constexpr size_t Plist_outputBufferSize = 65536;
+	// seconds between the unix epoch and the binary plist epoch (2001-01-01 00:00:00 UTC)
+	static constexpr double Plist_binaryEpochOffset = 978307200.0;
+
 	std::pair<size_t, size_t> Plist_getParsePosition(const void* ptr, size_t offset);
-	bool Plist_parse(Any* dst, const void* ptr, pugi::xml_node& node, String* error);
-	bool Plist_parseDictionary(Plist::dict* dst, const void* ptr, pugi::xml_node&node, String* error);
-	bool Plist_parseArray(Plist::array* dst, const void* ptr, pugi::xml_node& node, String* error);
-	bool Plist_parseDate(Plist::date* dst, const void* ptr, pugi::xml_node& node, String* error);
-	void Plist_parse_error(const void* ptr, pugi::xml_node& node, const String& error_message, String* error);
-	
-	bool Plist_write(const Any& src, pugi::xml_node& node, String* error);
-	bool Plist_writeDictionary(const Plist::dict& src, pugi::xml_node& node, String* error);
-	template<typename VALUE_TYPE>
-	bool Plist_writeArray(const ArrayList<VALUE_TYPE>& src, pugi::xml_node& node, String* error);
-	
-	
+	bool Plist_parseDate(Plist::date* dst, const char* text, size_t length, String* error);
+	bool Plist_base64Decode(const char* text, size_t length, Data* dst);
 
-	bool Plist::loadFromFile(Dictionary* dst, FILE* file, String* error)
+	template<typename DICT_TYPE>
+	bool Plist_loadFromPointer(DICT_TYPE* dst, const void* pointer, size_t length, String* error);
+	template<typename DICT_TYPE>
+	bool Plist_saveToOutput(const DICT_TYPE& src, FILE* file, Data* data, Plist::Format format, String* error);
+
+
+
+	template<typename DICT_TYPE>
+	bool Plist_loadFromFile(DICT_TYPE* dst, FILE* file, String* error)
 	{
 		if(dst==nullptr)
 		{
@@ -143,30 +161,32 @@ namespace fgl
 		std::fseek(file, originalFileTell, SEEK_SET);
 
 		//parse the data
-		bool success = loadFromPointer(dst, (const void*)fileContent, (size_t)fileSize, error);
+		bool success = Plist::loadFromPointer(dst, (const void*)fileContent, (size_t)fileSize, error);
 		std::free(fileContent);
 		return success;
 	}
-	
-	bool Plist::loadFromPath(Dictionary* dst, const String& path, String* error)
+
+	template<typename DICT_TYPE>
+	bool Plist_loadFromPath(DICT_TYPE* dst, const String& path, String* error)
 	{
 		if(dst==nullptr)
 		{
 			throw IllegalArgumentException("dst", "cannot be null");
 		}
-		
+
 		//load the file into memory
 		FILE* file = fgl::FileTools::openFile(path, "rb", error);
 		if(file==nullptr)
 		{
 			return false;
 		}
-		bool success = loadFromFile(dst, file, error);
+		bool success = Plist::loadFromFile(dst, file, error);
 		fgl::FileTools::closeFile(file);
 		return success;
 	}
-	
-	bool Plist::loadFromData(Dictionary* dst, const Data& data, String* error)
+
+	template<typename DICT_TYPE>
+	bool Plist_loadFromData(DICT_TYPE* dst, const Data& data, String* error)
 	{
 		if(dst==nullptr)
 		{
@@ -176,10 +196,11 @@ namespace fgl
 		{
 			throw IllegalArgumentException("data", "cannot be empty");
 		}
-		return loadFromPointer(dst, data.getData(), data.size(), error);
+		return Plist::loadFromPointer(dst, data.getData(), data.size(), error);
 	}
-	
-	bool Plist::loadFromString(Dictionary* dst, const String& string, String* error)
+
+	template<typename DICT_TYPE>
+	bool Plist_loadFromString(DICT_TYPE* dst, const String& string, String* error)
 	{
 		if(dst==nullptr)
 		{
@@ -189,185 +210,116 @@ namespace fgl
 		{
 			throw IllegalArgumentException("string", "cannot be empty");
 		}
-		return loadFromPointer(dst, (const void*)string.getData(), string.length(), error);
+		return Plist::loadFromPointer(dst, (const void*)string.getData(), string.length(), error);
 	}
-	
-	bool Plist::loadFromPointer(Dictionary* dst, const void* pointer, size_t length, String* error)
+
+	template<typename DICT_TYPE>
+	bool Plist_saveToFile(const DICT_TYPE& src, const String& path, Plist::Format format, String* error)
 	{
-		if(dst==nullptr)
-		{
-			throw IllegalArgumentException("dst", "cannot be null");
-		}
-		else if(pointer==nullptr)
-		{
-			throw IllegalArgumentException("pointer", "cannot be null");
-		}
-		else if(length==0)
-		{
-			if(error!=nullptr)
-			{
-				*error = "pointer is empty";
-			}
-			return false;
-		}
-		// infer plist type from header.  If it has the bplist00 header as first 8
-		// bytes, then it's a binary plist.  Otherwise, assume it's XML
-		if(length>8 && String((const char*)pointer, 8).equals("bplist00"))
+		FILE* file = fgl::FileTools::openFile(path, "wb", error);
+		if(file==nullptr)
 		{
-			//binary plist
-			if(error!=nullptr)
-			{
-				*error = "Binary plists are not yet supported";
-			}
 			return false;
 		}
-		else
-		{
-			//XML plist
-			pugi::xml_document doc;
-			pugi::xml_parse_result result = doc.load_buffer(pointer, length, pugi::parse_default, pugi::xml_encoding::encoding_auto);
-			if(!result)
-			{
-				if(error!=nullptr)
-				{
-					*error = String("pugixml: ")+result.description();
-				}
-				return false;
-			}
-			pugi::xml_node plistNode = doc.child("plist");
-			if(plistNode.type()==pugi::node_null)
-			{
-				if(error!=nullptr)
-				{
-					*error = "root element is not \"plist\"";
-				}
-				return false;
-			}
-			dst->clear();
-			pugi::xml_node rootNode = plistNode.first_child();
-			if(rootNode.type()==pugi::node_null)
-			{
-				//plist node is empty
-				return true;
-			}
-			else if(String::streq(rootNode.name(), "dict"))
-			{
-				return Plist_parseDictionary(dst, pointer, rootNode, error);
-			}
-			else
-			{
-				if(error!=nullptr)
-				{
-					*error = "root of \"plist\" element is not a \"dict\" element";
-				}
-				return false;
-			}
-		}
+		bool success = Plist_saveToOutput(src, file, nullptr, format, error);
+		fgl::FileTools::closeFile(file);
+		return success;
 	}
-	
-	class Plist_writer : public pugi::xml_writer
+
+	template<typename DICT_TYPE>
+	bool Plist_saveToData(const DICT_TYPE& src, Data* dst, Plist::Format format, String* error)
 	{
-	public:
-		FILE* file;
-		String* error;
-		bool success;
-		
-		Plist_writer(String* error) : file(nullptr), error(error), success(true)
-		{
-			//
-		}
-		
-		bool open(const String& path, String* error)
-		{
-			file = std::fopen(path, "wb");
-			if(file==nullptr)
-			{
-				if(error != nullptr)
-				{
-					//TODO add checking of errno
-					*error = "Unable to open file for writing";
-				}
-				return false;
-			}
-			return true;
-		}
-		
-		void close()
+		if(dst==nullptr)
 		{
-			std::fclose(file);
+			throw IllegalArgumentException("dst", "cannot be null");
 		}
+		return Plist_saveToOutput(src, nullptr, dst, format, error);
+	}
+
+
+
+	bool Plist::loadFromPath(Dictionary* dst, const String& path, String* error)
+	{
+		return Plist_loadFromPath(dst, path, error);
+	}
+
+	bool Plist::loadFromFile(Dictionary* dst, FILE* file, String* error)
+	{
+		return Plist_loadFromFile(dst, file, error);
+	}
+
+	bool Plist::loadFromData(Dictionary* dst, const Data& data, String* error)
+	{
+		return Plist_loadFromData(dst, data, error);
+	}
+
+	bool Plist::loadFromString(Dictionary* dst, const String& string, String* error)
+	{
+		return Plist_loadFromString(dst, string, error);
+	}
+
+	bool Plist::loadFromPointer(Dictionary* dst, const void* pointer, size_t length, String* error)
+	{
+		return Plist_loadFromPointer(dst, pointer, length, error);
+	}
 
-		virtual void write(const void* data, size_t size) override
-		{
-			size_t bytesWritten = std::fwrite(data, 1, size, file);
-			if(bytesWritten < size)
-			{
-				if(success)
-				{
-					success = false;
-					if(error!=nullptr)
-					{
-						*error = "Unable to write all bytes to file stream";
-					}
-				}
-			}
-		}
-	};
-	
 	bool Plist::saveToFile(const Dictionary& src, const String& path, String* error)
 	{
-		pugi::xml_document doc;
-		pugi::xml_node decNode = doc.append_child(pugi::node_declaration);
-		decNode.append_attribute("version") = "1.0";
-		decNode.append_attribute("encoding") = "UTF-8";
-		
-		// doctype node
-		doc.append_child(pugi::node_doctype).set_value("plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\"");
+		return Plist_saveToFile(src, path, Format::XML, error);
+	}
 
-		// root node
-		pugi::xml_node plistNode = doc.append_child("plist");
-		plistNode.append_attribute("version") = "1.0";
+	bool Plist::saveToFile(const Dictionary& src, const String& path, Format format, String* error)
+	{
+		return Plist_saveToFile(src, path, format, error);
+	}
 
-		bool success = Plist_writeDictionary(src, plistNode, error);
-		if(success)
-		{
-			Plist_writer writer(error);
-			success = writer.open(path, error);
-			if(!success)
-			{
-				return false;
-			}
-			doc.save(writer);
-			writer.close();
-			return writer.success;
-		}
-		return false;
+	bool Plist::saveToData(const Dictionary& src, Data* dst, Format format, String* error)
+	{
+		return Plist_saveToData(src, dst, format, error);
 	}
-	
-	void Plist_base64Decode(const char* encodedData, std::vector<char>& data)
+
+	bool Plist::loadFromPath(HashDictionary* dst, const String& path, String* error)
 	{
-		std::insert_iterator<std::vector<char> > ii(data, data.begin());
-		base64<char> b64;
-		int state = 0;
-		b64.get(encodedData, encodedData + strlen(encodedData), ii, state);
+		return Plist_loadFromPath(dst, path, error);
 	}
 
-	void Plist_base64Encode(std::string& dataEncoded, const Data& data)
+	bool Plist::loadFromFile(HashDictionary* dst, FILE* file, String* error)
 	{
-		const char* str = (const char*)data.getData();
-		std::vector<char> data_vect(str, str+data.size());
-		dataEncoded.clear();
-		std::insert_iterator<std::string> ii(dataEncoded, dataEncoded.begin());
-		base64<char> b64;
-		int state = 0;
-		
-		#ifdef TARGETPLATFORM_WINDOWS
-			b64.put(data_vect.begin(), data_vect.end(), ii, state, base64<>::crlf());
-		#else
-			b64.put(data_vect.begin(), data_vect.end(), ii, state, base64<>::lf());
-		#endif
+		return Plist_loadFromFile(dst, file, error);
 	}
-	
+
+	bool Plist::loadFromData(HashDictionary* dst, const Data& data, String* error)
+	{
+		return Plist_loadFromData(dst, data, error);
+	}
+
+	bool Plist::loadFromString(HashDictionary* dst, const String& string, String* error)
+	{
+		return Plist_loadFromString(dst, string, error);
+	}
+
+	bool Plist::loadFromPointer(HashDictionary* dst, const void* pointer, size_t length, String* error)
+	{
+		return Plist_loadFromPointer(dst, pointer, length, error);
+	}
+
+	bool Plist::saveToFile(const HashDictionary& src, const String& path, String* error)
+	{
+		return Plist_saveToFile(src, path, Format::XML, error);
+	}
+
+	bool Plist::saveToFile(const HashDictionary& src, const String& path, Format format, String* error)
+	{
+		return Plist_saveToFile(src, path, format, error);
+	}
+
+	bool Plist::saveToData(const HashDictionary& src, Data* dst, Format format, String* error)
+	{
+		return Plist_saveToData(src, dst, format, error);
+	}
+
+
+
 	std::pair<size_t, size_t> Plist_getParsePosition(const void* ptr, size_t offset)
 	{
 		size_t currentLine = 1;
@@ -401,417 +353,2056 @@ namespace fgl
 		}
 		return std::pair<size_t, size_t>(currentLine, currentOffset);
 	}
-	
-	bool Plist_parse(Any* dst, const void* ptr, pugi::xml_node& node, String* error)
+
+	void Plist_reserve(Plist::dict*, size_t)
 	{
-		const char* nodeName = node.name();
-		if(String::streq(nodeName, "dict"))
-		{
-			*dst = Plist::dict();
-			return Plist_parseDictionary(&dst->as<Plist::dict>(), ptr, node, error);
-		}
-		else if(String::streq(nodeName, "array"))
-		{
-			*dst = Plist::array();
-			return Plist_parseArray(&dst->as<Plist::array>(), ptr, node, error);
-		}
-		else if(String::streq(nodeName, "string"))
+		//std::map has nothing to reserve
+	}
+
+	void Plist_reserve(Plist::hash_dict* dst, size_t count)
+	{
+		dst->reserve(count);
+	}
+
+	bool Plist_isSpace(char c)
+	{
+		return (c==' ' || c=='\t' || c=='\n' || c=='\r');
+	}
+
+	void Plist_trim(const char** text, size_t* length)
+	{
+		const char* start = *text;
+		const char* end = start + *length;
+		while(start < end && Plist_isSpace(*start))
 		{
-			*dst = Plist::string(node.first_child().value());
-			return true;
+			start++;
 		}
-		else if(String::streq(nodeName, "data"))
+		while(end > start && Plist_isSpace(*(end-1)))
 		{
-			const char* data_str = (const char*)node.first_child().value();
-			if(data_str==nullptr)
-			{
-				*dst = Plist::data();
-			}
-			else
-			{
-				std::vector<char> data_vect;
-				Plist_base64Decode(data_str, data_vect);
-				*dst = Plist::data((const void*)data_vect.data(), data_vect.size());
-			}
-			return true;
+			end--;
 		}
-		else if(String::streq(nodeName, "data"))
+		*text = start;
+		*length = (size_t)(end - start);
+	}
+
+	void Plist_appendUTF8(std::string& str, Uint32 codepoint)
+	{
+		if(codepoint < 0x80)
 		{
-			*dst = Plist::date();
-			return Plist_parseDate(&dst->as<Plist::date>(), ptr, node, error);
+			str.push_back((char)codepoint);
 		}
-		else if(String::streq(nodeName, "integer"))
+		else if(codepoint < 0x800)
 		{
-			try
-			{
-				const char* str = node.first_child().value();
-				if(str==nullptr || str[0]=='\0')
-				{
-					*dst = Plist::integer(0LL);
-				}
-				else
-				{
-					*dst = Plist::integer(String(str).toArithmeticValue<long long>());
-				}
-			}
-			catch(const NumberFormatException& e)
-			{
-				Plist_parse_error(ptr, node, e.message, error);
-				return false;
-			}
-			return true;
+			str.push_back((char)(0xC0 | (codepoint >> 6)));
+			str.push_back((char)(0x80 | (codepoint & 0x3F)));
 		}
-		else if(String::streq(nodeName, "real"))
+		else if(codepoint < 0x10000)
 		{
-			try
-			{
-				const char* str = node.first_child().value();
-				if(str==nullptr || str[0]=='\0')
-				{
-					*dst = Plist::real(0LL);
-				}
-				else
-				{
-					*dst = Plist::real(String(str).toArithmeticValue<long double>());
-				}
-			}
-			catch(const NumberFormatException& e)
-			{
-				Plist_parse_error(ptr, node, e.message, error);
-				return false;
-			}
-			return true;
+			str.push_back((char)(0xE0 | (codepoint >> 12)));
+			str.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+			str.push_back((char)(0x80 | (codepoint & 0x3F)));
 		}
-		else if(String::streq(nodeName, "boolean"))
+		else
 		{
-			bool val = false;
-			const char* str = node.first_child().value();
-			if(str==nullptr)
-			{
-				val = false;
-			}
-			else if(String::streq(str,"true") || String::streq(str,"TRUE") || String::streq(str,"yes") || String::streq(str,"YES") || String::streq(str,"1"))
-			{
-				val = true;
-			}
-			else if(String::streq(str,"false") || String::streq(str,"FALSE") || String::streq(str,"no") || String::streq(str,"NO") || String::streq(str,"0"))
-			{
-				val = false;
-			}
-			else
-			{
-				Plist_parse_error(ptr, node, "Invalid boolean value", error);
-				return false;
-			}
-			*dst = Plist::boolean(val);
-			return true;
+			str.push_back((char)(0xF0 | (codepoint >> 18)));
+			str.push_back((char)(0x80 | ((codepoint >> 12) & 0x3F)));
+			str.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+			str.push_back((char)(0x80 | (codepoint & 0x3F)));
 		}
-		else if(String::streq(nodeName,"true"))
+	}
+
+	bool Plist_parseDate(Plist::date* dst, const char* text, size_t length, String* error)
+	{
+		Plist_trim(&text, &length);
+		if(length==0)
 		{
-			*dst = Plist::boolean(true);
-			return true;
+			*error = "\"date\" element is empty";
+			return false;
 		}
-		else if(String::streq(nodeName,"false"))
+		char date_str[64];
+		if(length >= sizeof(date_str))
 		{
-			*dst = Plist::boolean(false);
-			return true;
+			*error = "Invalid datetime format";
+			return false;
 		}
-		else
+		std::memcpy(date_str, text, length);
+		date_str[length] = '\0';
+		int month=0, day=0, year=0, hour24=0, minute=0, second=0;
+		// parse date string.  E.g.  2011-09-25T02:31:04Z
+		int args = sscanf(date_str, "%4d-%2d-%2dT%2d:%2d:%2dZ", &year, &month, &day, &hour24, &minute, &second);
+		if(args < 6)
 		{
-			Plist_parse_error(ptr, node, (String)"Invalid tag name \""+ nodeName+"\"", error);
+			*error = "Invalid datetime format";
 			return false;
 		}
-	}
-	
-	bool Plist_parseDictionary(Plist::dict* dst, const void* ptr, pugi::xml_node&node, String* error)
-	{
-		char empty_key[1] = {'\0'};
-		for(pugi::xml_node_iterator it=node.begin(); it!=node.end(); it++)
-		{
-			if(!String::streq(it->name(), "key"))
-			{
-				Plist_parse_error(ptr, node, "plist \"key\" element expected but not found", error);
-				return false;
-			}
-			
-			const char* key_str = it->first_child().value();
-			if(key_str==nullptr)
-			{
-				key_str = empty_key;
-			}
-			Plist::key key(key_str);
-			pugi::xml_node& key_node = *it;
-			it++;
-
-			if(it == node.end())
-			{
-				Plist_parse_error(ptr, key_node, "element after \"key\" element expected but not found", error);
-				return false;
+		struct tm tmTime;
+		tmTime.tm_year = year - 1900;
+		tmTime.tm_mon = month - 1;
+		tmTime.tm_mday = day;
+		tmTime.tm_hour = hour24;
+		tmTime.tm_min = minute;
+		tmTime.tm_sec = second;
+		tmTime.tm_wday = 0;
+		tmTime.tm_yday = 0;
+		tmTime.tm_isdst = -1;
+		#ifdef _WIN32
+			time_t timeval = _mkgmtime(&tmTime);
+		#else
+			time_t timeval = timegm(&tmTime);
+		#endif
+		if(timeval==-1)
+		{
+			*error = "Invalid datetime values";
+			return false;
+		}
+		dst->assign(timeval);
+		return true;
+	}
+
+	int Plist_base64Value(char c)
+	{
+		if(c >= 'A' && c <= 'Z')
+		{
+			return c - 'A';
+		}
+		else if(c >= 'a' && c <= 'z')
+		{
+			return c - 'a' + 26;
+		}
+		else if(c >= '0' && c <= '9')
+		{
+			return c - '0' + 52;
+		}
+		else if(c == '+')
+		{
+			return 62;
+		}
+		else if(c == '/')
+		{
+			return 63;
+		}
+		return -1;
+	}
+
+	bool Plist_base64Decode(const char* text, size_t length, Data* dst)
+	{
+		// decode straight into the destination, then trim it to the decoded size
+		dst->resize((length / 4) * 3 + 3);
+		byte* output = (byte*)dst->getData();
+		size_t outputLength = 0;
+		Uint32 bits = 0;
+		size_t bitCount = 0;
+		for(size_t i=0; i<length; i++)
+		{
+			char c = text[i];
+			if(c == '=')
+			{
+				break;
+			}
+			int value = Plist_base64Value(c);
+			if(value < 0)
+			{
+				if(Plist_isSpace(c))
+				{
+					continue;
+				}
+				return false;
+			}
+			bits = (bits << 6) | (Uint32)value;
+			bitCount += 6;
+			if(bitCount >= 8)
+			{
+				bitCount -= 8;
+				output[outputLength] = (byte)((bits >> bitCount) & 0xFF);
+				outputLength++;
+			}
+		}
+		dst->resize(outputLength);
+		return true;
+	}
+
+
+
+	/*! Parses XML plists directly into a dictionary, without building a document tree first*/
+	class Plist_XMLReader
+	{
+	public:
+		enum TagType
+		{
+			TAG_OPEN,
+			TAG_CLOSE,
+			TAG_EMPTY
+		};
+
+		struct Tag
+		{
+			const char* start;
+			const char* name;
+			size_t nameLength;
+			TagType type;
+
+			bool is(const char* str) const
+			{
+				size_t length = std::strlen(str);
+				return (nameLength==length && std::memcmp(name, str, length)==0);
+			}
+		};
+
+		Plist_XMLReader(const char* data, size_t length, String* error)
+			: start(data), pos(data), end(data+length), error(error), depth(0)
+		{
+			//
+		}
+
+		template<typename DICT_TYPE>
+		bool parseDocument(DICT_TYPE* dst)
+		{
+			if(startsWith("\xEF\xBB\xBF"))
+			{
+				pos += 3;
+			}
+			else if(startsWith("\xFE\xFF") || startsWith("\xFF\xFE"))
+			{
+				return fail(pos, "UTF-16 encoded XML plists are not supported");
+			}
+			Tag plistTag;
+			if(!nextTag(&plistTag))
+			{
+				return false;
+			}
+			else if(plistTag.type==TAG_CLOSE || !plistTag.is("plist"))
+			{
+				return fail(plistTag.start, "root element is not \"plist\"");
+			}
+			dst->clear();
+			if(plistTag.type==TAG_EMPTY)
+			{
+				//plist node is empty
+				return true;
+			}
+			Tag rootTag;
+			if(!nextTag(&rootTag))
+			{
+				return false;
+			}
+			else if(rootTag.type==TAG_CLOSE)
+			{
+				//plist node is empty
+				return closes(rootTag, plistTag);
+			}
+			else if(!rootTag.is("dict"))
+			{
+				return fail(rootTag.start, "root of \"plist\" element is not a \"dict\" element");
+			}
+			if(!parseDictionary(rootTag, dst))
+			{
+				return false;
+			}
+			Tag closeTag;
+			if(!nextTag(&closeTag))
+			{
+				return false;
+			}
+			return closes(closeTag, plistTag);
+		}
+
+	private:
+		const char* start;
+		const char* pos;
+		const char* end;
+		String* error;
+		size_t depth;
+		std::string textBuffer;
+
+		bool fail(const char* location, const String& message)
+		{
+			if(error!=nullptr)
+			{
+				std::pair<size_t, size_t> doc_pos = Plist_getParsePosition(start, (size_t)(location - start));
+				*error = (String)"" + doc_pos.first + ":" + doc_pos.second + ": " + message;
+			}
+			return false;
+		}
+
+		bool startsWith(const char* str) const
+		{
+			size_t length = std::strlen(str);
+			return ((size_t)(end - pos) >= length && std::memcmp(pos, str, length)==0);
+		}
+
+		bool skipPast(const char* terminator)
+		{
+			size_t length = std::strlen(terminator);
+			while((size_t)(end - pos) >= length)
+			{
+				const char* found = (const char*)std::memchr(pos, terminator[0], (size_t)(end - pos) - length + 1);
+				if(found==nullptr)
+				{
+					break;
+				}
+				pos = found;
+				if(std::memcmp(pos, terminator, length)==0)
+				{
+					pos += length;
+					return true;
+				}
+				pos++;
+			}
+			pos = end;
+			return false;
+		}
+
+		bool closes(const Tag& closeTag, const Tag& openTag)
+		{
+			if(closeTag.type!=TAG_CLOSE || closeTag.nameLength!=openTag.nameLength || std::memcmp(closeTag.name, openTag.name, openTag.nameLength)!=0)
+			{
+				return fail(closeTag.start, "expected closing tag for \"" + String(openTag.name, openTag.nameLength) + "\" element");
+			}
+			return true;
+		}
+
+		/*! Reads the next tag, skipping comments, processing instructions, and declarations*/
+		bool nextTag(Tag* tag)
+		{
+			while(true)
+			{
+				while(pos < end && Plist_isSpace(*pos))
+				{
+					pos++;
+				}
+				if(pos >= end)
+				{
+					return fail(pos, "unexpected end of document");
+				}
+				else if(*pos != '<')
+				{
+					return fail(pos, "unexpected text outside of an element");
+				}
+				const char* tagStart = pos;
+				if(startsWith("<!--"))
+				{
+					if(!skipPast("-->"))
+					{
+						return fail(tagStart, "comment is not closed");
+					}
+					continue;
+				}
+				else if(startsWith("<?"))
+				{
+					if(!skipPast("?>"))
+					{
+						return fail(tagStart, "processing instruction is not closed");
+					}
+					continue;
+				}
+				else if(startsWith("<!"))
+				{
+					//doctype, which may have an internal subset in brackets
+					int bracketDepth = 0;
+					pos += 2;
+					while(pos < end && (*pos != '>' || bracketDepth > 0))
+					{
+						if(*pos=='[')
+						{
+							bracketDepth++;
+						}
+						else if(*pos==']')
+						{
+							bracketDepth--;
+						}
+						pos++;
+					}
+					if(pos >= end)
+					{
+						return fail(tagStart, "declaration is not closed");
+					}
+					pos++;
+					continue;
+				}
+
+				tag->start = tagStart;
+				tag->type = TAG_OPEN;
+				pos++;
+				if(pos < end && *pos=='/')
+				{
+					tag->type = TAG_CLOSE;
+					pos++;
+				}
+				tag->name = pos;
+				while(pos < end && !Plist_isSpace(*pos) && *pos!='>' && *pos!='/')
+				{
+					pos++;
+				}
+				tag->nameLength = (size_t)(pos - tag->name);
+				if(tag->nameLength==0)
+				{
+					return fail(tagStart, "element name expected");
+				}
+				//skip attributes
+				char quote = '\0';
+				while(pos < end && (quote!='\0' || *pos!='>'))
+				{
+					if(quote!='\0')
+					{
+						if(*pos==quote)
+						{
+							quote = '\0';
+						}
+					}
+					else if(*pos=='"' || *pos=='\'')
+					{
+						quote = *pos;
+					}
+					pos++;
+				}
+				if(pos >= end)
+				{
+					return fail(tagStart, "element is not closed");
+				}
+				if(*(pos-1)=='/' && tag->type==TAG_OPEN)
+				{
+					tag->type = TAG_EMPTY;
+				}
+				pos++;
+				return true;
+			}
+		}
+
+		/*! Appends text to the text buffer, decoding entities and normalizing line endings*/
+		bool appendText(const char* text, size_t length)
+		{
+			const char* textEnd = text + length;
+			while(text < textEnd)
+			{
+				const char* special = text;
+				while(special < textEnd && *special!='&' && *special!='\r')
+				{
+					special++;
+				}
+				textBuffer.append(text, (size_t)(special - text));
+				if(special >= textEnd)
+				{
+					break;
+				}
+				else if(*special=='\r')
+				{
+					textBuffer.push_back('\n');
+					text = special + 1;
+					if(text < textEnd && *text=='\n')
+					{
+						text++;
+					}
+					continue;
+				}
+				const char* entityEnd = (const char*)std::memchr(special, ';', (size_t)(textEnd - special));
+				if(entityEnd==nullptr)
+				{
+					return fail(special, "entity is not closed");
+				}
+				const char* entity = special + 1;
+				size_t entityLength = (size_t)(entityEnd - entity);
+				if(entityLength==2 && std::memcmp(entity, "lt", 2)==0)
+				{
+					textBuffer.push_back('<');
+				}
+				else if(entityLength==2 && std::memcmp(entity, "gt", 2)==0)
+				{
+					textBuffer.push_back('>');
+				}
+				else if(entityLength==3 && std::memcmp(entity, "amp", 3)==0)
+				{
+					textBuffer.push_back('&');
+				}
+				else if(entityLength==4 && std::memcmp(entity, "quot", 4)==0)
+				{
+					textBuffer.push_back('"');
+				}
+				else if(entityLength==4 && std::memcmp(entity, "apos", 4)==0)
+				{
+					textBuffer.push_back('\'');
+				}
+				else if(entityLength > 1 && entityLength < 12 && entity[0]=='#')
+				{
+					char number[16];
+					bool hex = (entity[1]=='x' || entity[1]=='X');
+					size_t digitsOffset = hex ? 2 : 1;
+					std::memcpy(number, entity + digitsOffset, entityLength - digitsOffset);
+					number[entityLength - digitsOffset] = '\0';
+					char* numberEnd = nullptr;
+					unsigned long codepoint = std::strtoul(number, &numberEnd, hex ? 16 : 10);
+					if(numberEnd==number || *numberEnd!='\0' || codepoint > 0x10FFFF)
+					{
+						return fail(special, "invalid character reference");
+					}
+					Plist_appendUTF8(textBuffer, (Uint32)codepoint);
+				}
+				else
+				{
+					return fail(special, "unknown entity");
+				}
+				text = entityEnd + 1;
+			}
+			return true;
+		}
+
+		/*! Reads the text content of an element, up to and including its closing tag.
+			The text points into the document when possible, otherwise into the text buffer, so it's only valid until the next call.*/
+		bool readText(const Tag& tag, const char** text, size_t* textLength)
+		{
+			*text = "";
+			*textLength = 0;
+			if(tag.type==TAG_EMPTY)
+			{
+				return true;
+			}
+			bool buffered = false;
+			while(true)
+			{
+				const char* segment = pos;
+				const char* segmentEnd = (const char*)std::memchr(pos, '<', (size_t)(end - pos));
+				if(segmentEnd==nullptr)
+				{
+					return fail(tag.start, "element is not closed");
+				}
+				size_t segmentLength = (size_t)(segmentEnd - segment);
+				pos = segmentEnd;
+				if(startsWith("</"))
+				{
+					if(!buffered && std::memchr(segment, '&', segmentLength)==nullptr && std::memchr(segment, '\r', segmentLength)==nullptr)
+					{
+						//plain text can be used in place
+						*text = segment;
+						*textLength = segmentLength;
+					}
+					else
+					{
+						if(!buffered)
+						{
+							textBuffer.clear();
+						}
+						if(!appendText(segment, segmentLength))
+						{
+							return false;
+						}
+						*text = textBuffer.data();
+						*textLength = textBuffer.length();
+					}
+					Tag closeTag;
+					if(!nextTag(&closeTag))
+					{
+						return false;
+					}
+					return closes(closeTag, tag);
+				}
+
+				if(!buffered)
+				{
+					textBuffer.clear();
+					buffered = true;
+				}
+				if(!appendText(segment, segmentLength))
+				{
+					return false;
+				}
+				const char* nodeStart = pos;
+				if(startsWith("<![CDATA["))
+				{
+					const char* cdata = pos + 9;
+					if(!skipPast("]]>"))
+					{
+						return fail(nodeStart, "CDATA section is not closed");
+					}
+					textBuffer.append(cdata, (size_t)(pos - 3 - cdata));
+				}
+				else if(startsWith("<!--"))
+				{
+					if(!skipPast("-->"))
+					{
+						return fail(nodeStart, "comment is not closed");
+					}
+				}
+				else if(startsWith("<?"))
+				{
+					if(!skipPast("?>"))
+					{
+						return fail(nodeStart, "processing instruction is not closed");
+					}
+				}
+				else
+				{
+					return fail(nodeStart, "unexpected element inside \"" + String(tag.name, tag.nameLength) + "\" element");
+				}
+			}
+		}
+
+		template<typename DICT_TYPE>
+		bool parseValue(const Tag& tag, Any* dst)
+		{
+			if(tag.type==TAG_CLOSE)
+			{
+				return fail(tag.start, "unexpected closing tag");
+			}
+			else if(tag.is("dict") || tag.is("array"))
+			{
+				if(depth >= Plist_maxDepth)
+				{
+					return fail(tag.start, "plist is nested too deeply");
+				}
+				depth++;
+				bool result;
+				if(tag.is("dict"))
+				{
+					*dst = DICT_TYPE();
+					result = parseDictionary(tag, &dst->as<DICT_TYPE>());
+				}
+				else
+				{
+					*dst = Plist::array();
+					result = parseArray<DICT_TYPE>(tag, &dst->as<Plist::array>());
+				}
+				depth--;
+				return result;
+			}
+
+			const char* text = nullptr;
+			size_t textLength = 0;
+			if(!readText(tag, &text, &textLength))
+			{
+				return false;
+			}
+			if(tag.is("string"))
+			{
+				*dst = Plist::string(text, textLength);
+				return true;
+			}
+			else if(tag.is("data"))
+			{
+				Plist::data data;
+				if(!Plist_base64Decode(text, textLength, &data))
+				{
+					return fail(tag.start, "Invalid base64 data");
+				}
+				*dst = std::move(data);
+				return true;
+			}
+			else if(tag.is("date"))
+			{
+				Plist::date date;
+				String message;
+				if(!Plist_parseDate(&date, text, textLength, &message))
+				{
+					return fail(tag.start, message);
+				}
+				*dst = date;
+				return true;
+			}
+			else if(tag.is("integer") || tag.is("real"))
+			{
+				Plist_trim(&text, &textLength);
+				char number[128];
+				if(textLength >= sizeof(number))
+				{
+					return fail(tag.start, "number is too long");
+				}
+				std::memcpy(number, text, textLength);
+				number[textLength] = '\0';
+				char* numberEnd = nullptr;
+				errno = 0;
+				if(tag.is("integer"))
+				{
+					long long value = (textLength==0) ? 0 : std::strtoll(number, &numberEnd, 10);
+					if(textLength!=0 && (numberEnd==number || errno==ERANGE))
+					{
+						return fail(tag.start, "Invalid integer value");
+					}
+					*dst = Plist::integer(value);
+				}
+				else
+				{
+					long double value = (textLength==0) ? 0 : std::strtold(number, &numberEnd);
+					if(textLength!=0 && numberEnd==number)
+					{
+						return fail(tag.start, "Invalid real value");
+					}
+					*dst = Plist::real(value);
+				}
+				return true;
+			}
+			else if(tag.is("boolean"))
+			{
+				Plist_trim(&text, &textLength);
+				String str(text, textLength);
+				if(str.equals("true") || str.equals("TRUE") || str.equals("yes") || str.equals("YES") || str.equals("1"))
+				{
+					*dst = Plist::boolean(true);
+				}
+				else if(textLength==0 || str.equals("false") || str.equals("FALSE") || str.equals("no") || str.equals("NO") || str.equals("0"))
+				{
+					*dst = Plist::boolean(false);
+				}
+				else
+				{
+					return fail(tag.start, "Invalid boolean value");
+				}
+				return true;
+			}
+			else if(tag.is("true"))
+			{
+				*dst = Plist::boolean(true);
+				return true;
+			}
+			else if(tag.is("false"))
+			{
+				*dst = Plist::boolean(false);
+				return true;
+			}
+			return fail(tag.start, "Invalid tag name \"" + String(tag.name, tag.nameLength) + "\"");
+		}
+
+		template<typename DICT_TYPE>
+		bool parseDictionary(const Tag& tag, DICT_TYPE* dst)
+		{
+			if(tag.type==TAG_EMPTY)
+			{
+				return true;
+			}
+			Tag keyTag;
+			Tag valueTag;
+			while(true)
+			{
+				if(!nextTag(&keyTag))
+				{
+					return false;
+				}
+				else if(keyTag.type==TAG_CLOSE)
+				{
+					return closes(keyTag, tag);
+				}
+				else if(!keyTag.is("key"))
+				{
+					return fail(keyTag.start, "plist \"key\" element expected but not found");
+				}
+				const char* key_str = nullptr;
+				size_t key_length = 0;
+				if(!readText(keyTag, &key_str, &key_length))
+				{
+					return false;
+				}
+				Plist::key key(key_str, key_length);
+
+				if(!nextTag(&valueTag))
+				{
+					return false;
+				}
+				else if(valueTag.type==TAG_CLOSE)
+				{
+					return fail(keyTag.start, "element after \"key\" element expected but not found");
+				}
+				else if(valueTag.is("key"))
+				{
+					return fail(valueTag.start, "\"key\" element after \"key\" element is not valid");
+				}
+				Any value;
+				bool result = parseValue<DICT_TYPE>(valueTag, &value);
+				if(!value.isEmpty())
+				{
+					dst->set(key, std::move(value));
+				}
+				if(!result)
+				{
+					return false;
+				}
+			}
+		}
+
+		template<typename DICT_TYPE>
+		bool parseArray(const Tag& tag, Plist::array* dst)
+		{
+			if(tag.type==TAG_EMPTY)
+			{
+				return true;
+			}
+			Tag itemTag;
+			while(true)
+			{
+				if(!nextTag(&itemTag))
+				{
+					return false;
+				}
+				else if(itemTag.type==TAG_CLOSE)
+				{
+					return closes(itemTag, tag);
+				}
+				Any value;
+				bool result = parseValue<DICT_TYPE>(itemTag, &value);
+				if(!value.isEmpty())
+				{
+					dst->add(std::move(value));
+				}
+				if(!result)
+				{
+					return false;
+				}
+			}
+		}
+	};
+
+
+
+	/*! Parses binary (bplist00) plists. Every offset and reference is bounds checked, so malformed files fail instead of reading out of bounds.*/
+	class Plist_BinaryReader
+	{
+	public:
+		Plist_BinaryReader(const void* data, size_t length, String* error)
+			: data((const byte*)data), length(length), error(error),
+			offsetIntSize(0), objectRefSize(0), objectCount(0), topObject(0), offsetTableOffset(0)
+		{
+			//
+		}
+
+		template<typename DICT_TYPE>
+		bool parseDocument(DICT_TYPE* dst)
+		{
+			if(!readTrailer())
+			{
+				return false;
+			}
+			size_t offset = 0;
+			if(!getObjectOffset(topObject, &offset))
+			{
+				return false;
+			}
+			else if((data[offset] >> 4) != 0xD)
+			{
+				return fail("root object is not a dictionary");
+			}
+			dst->clear();
+			visiting.assign((size_t)objectCount, false);
+			return parseDictionary(topObject, offset, dst, 0);
+		}
+
+	private:
+		const byte* data;
+		size_t length;
+		String* error;
+		size_t offsetIntSize;
+		size_t objectRefSize;
+		Uint64 objectCount;
+		Uint64 topObject;
+		Uint64 offsetTableOffset;
+		std::vector<bool> visiting;
+
+		bool fail(const String& message)
+		{
+			if(error!=nullptr)
+			{
+				*error = "binary plist: " + message;
+			}
+			return false;
+		}
+
+		Uint64 readInt(size_t offset, size_t size) const
+		{
+			Uint64 value = 0;
+			for(size_t i=0; i<size; i++)
+			{
+				value = (value << 8) | data[offset+i];
+			}
+			return value;
+		}
+
+		bool readTrailer()
+		{
+			if(length < 8 + 32)
+			{
+				return fail("file is too small");
+			}
+			size_t trailer = length - 32;
+			offsetIntSize = data[trailer+6];
+			objectRefSize = data[trailer+7];
+			objectCount = readInt(trailer+8, 8);
+			topObject = readInt(trailer+16, 8);
+			offsetTableOffset = readInt(trailer+24, 8);
+			if(offsetIntSize < 1 || offsetIntSize > 8 || objectRefSize < 1 || objectRefSize > 8)
+			{
+				return fail("invalid integer sizes in trailer");
+			}
+			else if(objectCount==0 || topObject >= objectCount)
+			{
+				return fail("invalid object count in trailer");
+			}
+			else if(offsetTableOffset < 8 || offsetTableOffset > trailer || (trailer - offsetTableOffset) / offsetIntSize < objectCount)
+			{
+				return fail("invalid offset table in trailer");
+			}
+			return true;
+		}
+
+		bool getObjectOffset(Uint64 objectIndex, size_t* offset)
+		{
+			if(objectIndex >= objectCount)
+			{
+				return fail("object reference out of range");
+			}
+			Uint64 objectOffset = readInt((size_t)(offsetTableOffset + objectIndex*offsetIntSize), offsetIntSize);
+			if(objectOffset < 8 || objectOffset >= offsetTableOffset)
+			{
+				return fail("object offset out of range");
+			}
+			*offset = (size_t)objectOffset;
+			return true;
+		}
+
+		/*! Reads the element count of an object, which follows the marker when the low nibble is 0xF*/
+		bool readCount(size_t offset, size_t* count, size_t* contentOffset)
+		{
+			size_t nibble = data[offset] & 0x0F;
+			if(nibble != 0x0F)
+			{
+				*count = nibble;
+				*contentOffset = offset + 1;
+				return true;
+			}
+			if(offset + 2 > offsetTableOffset || (data[offset+1] >> 4) != 0x1 || (data[offset+1] & 0x0F) > 3)
+			{
+				return fail("invalid object length");
+			}
+			size_t intSize = (size_t)1 << (data[offset+1] & 0x0F);
+			if(offset + 2 + intSize > offsetTableOffset)
+			{
+				return fail("invalid object length");
+			}
+			*count = (size_t)readInt(offset+2, intSize);
+			*contentOffset = offset + 2 + intSize;
+			return true;
+		}
+
+		/*! Checks that a number of items of the given size fit between an offset and the offset table*/
+		bool checkRange(size_t offset, size_t count, size_t itemSize)
+		{
+			if(offset > offsetTableOffset || count > ((size_t)offsetTableOffset - offset) / itemSize)
+			{
+				return fail("object extends past the end of the object table");
+			}
+			return true;
+		}
+
+		bool parseString(size_t offset, String* dst)
+		{
+			byte marker = data[offset] >> 4;
+			size_t count = 0;
+			size_t contentOffset = 0;
+			if(!readCount(offset, &count, &contentOffset))
+			{
+				return false;
+			}
+			if(marker==0x5)
+			{
+				if(!checkRange(contentOffset, count, 1))
+				{
+					return false;
+				}
+				*dst = String((const char*)data + contentOffset, count);
+				return true;
+			}
+			else if(marker==0x6)
+			{
+				if(!checkRange(contentOffset, count, 2))
+				{
+					return false;
+				}
+				std::string utf8;
+				utf8.reserve(count);
+				for(size_t i=0; i<count; i++)
+				{
+					Uint32 unit = (Uint32)readInt(contentOffset + i*2, 2);
+					if(unit >= 0xD800 && unit < 0xDC00 && (i+1) < count)
+					{
+						Uint32 low = (Uint32)readInt(contentOffset + (i+1)*2, 2);
+						if(low >= 0xDC00 && low < 0xE000)
+						{
+							unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+							i++;
+						}
+					}
+					Plist_appendUTF8(utf8, unit);
+				}
+				*dst = String(utf8.data(), utf8.length());
+				return true;
+			}
+			return fail("expected a string object");
+		}
+
+		template<typename DICT_TYPE>
+		bool parseObject(Uint64 objectIndex, Any* dst, size_t depth)
+		{
+			size_t offset = 0;
+			if(!getObjectOffset(objectIndex, &offset))
+			{
+				return false;
+			}
+			byte marker = data[offset] >> 4;
+			byte nibble = data[offset] & 0x0F;
+			switch(marker)
+			{
+				case 0x0:
+				if(nibble==0x8 || nibble==0x9)
+				{
+					*dst = Plist::boolean(nibble==0x9);
+					return true;
+				}
+				return fail("unsupported object type");
+
+				case 0x1:
+				{
+					if(nibble > 4 || !checkRange(offset+1, (size_t)1 << nibble, 1))
+					{
+						return fail("invalid integer object");
+					}
+					size_t intSize = (size_t)1 << nibble;
+					if(intSize==16)
+					{
+						//128 bit integers are only written for unsigned values that don't fit in 64 bits
+						*dst = Plist::integer((unsigned long long)readInt(offset+9, 8));
+					}
+					else if(intSize==8)
+					{
+						*dst = Plist::integer((long long)readInt(offset+1, 8));
+					}
+					else
+					{
+						*dst = Plist::integer((long long)readInt(offset+1, intSize));
+					}
+					return true;
+				}
+
+				case 0x2:
+				{
+					if((nibble!=2 && nibble!=3) || !checkRange(offset+1, (size_t)1 << nibble, 1))
+					{
+						return fail("invalid real object");
+					}
+					*dst = Plist::real((long double)readReal(offset+1, (size_t)1 << nibble));
+					return true;
+				}
+
+				case 0x3:
+				{
+					if(nibble!=3 || !checkRange(offset+1, 8, 1))
+					{
+						return fail("invalid date object");
+					}
+					double seconds = readReal(offset+1, 8);
+					if(!(seconds > -1e11 && seconds < 1e11))
+					{
+						return fail("invalid date object");
+					}
+					*dst = Plist::date((time_t)(seconds + Plist_binaryEpochOffset));
+					return true;
+				}
+
+				case 0x4:
+				{
+					size_t count = 0;
+					size_t contentOffset = 0;
+					if(!readCount(offset, &count, &contentOffset) || !checkRange(contentOffset, count, 1))
+					{
+						return false;
+					}
+					*dst = Plist::data((const void*)(data + contentOffset), count);
+					return true;
+				}
+
+				case 0x5:
+				case 0x6:
+				{
+					Plist::string str;
+					if(!parseString(offset, &str))
+					{
+						return false;
+					}
+					*dst = std::move(str);
+					return true;
+				}
+
+				case 0x8:
+				{
+					//UIDs are only used by keyed archives, so they're loaded as plain integers
+					if(!checkRange(offset+1, (size_t)nibble + 1, 1))
+					{
+						return false;
+					}
+					*dst = Plist::integer((long long)readInt(offset+1, (size_t)nibble + 1));
+					return true;
+				}
+
+				case 0xA:
+				case 0xD:
+				{
+					if(depth >= Plist_maxDepth)
+					{
+						return fail("plist is nested too deeply");
+					}
+					else if(visiting[(size_t)objectIndex])
+					{
+						return fail("object references itself");
+					}
+					visiting[(size_t)objectIndex] = true;
+					bool result;
+					if(marker==0xD)
+					{
+						*dst = DICT_TYPE();
+						result = parseDictionary(objectIndex, offset, &dst->as<DICT_TYPE>(), depth+1);
+					}
+					else
+					{
+						*dst = Plist::array();
+						result = parseArray<DICT_TYPE>(offset, &dst->as<Plist::array>(), depth+1);
+					}
+					visiting[(size_t)objectIndex] = false;
+					return result;
+				}
+			}
+			return fail("unsupported object type");
+		}
+
+		double readReal(size_t offset, size_t size) const
+		{
+			if(size==4)
+			{
+				Uint32 bits = (Uint32)readInt(offset, 4);
+				float value;
+				std::memcpy(&value, &bits, 4);
+				return value;
+			}
+			Uint64 bits = readInt(offset, 8);
+			double value;
+			std::memcpy(&value, &bits, 8);
+			return value;
+		}
+
+		template<typename DICT_TYPE>
+		bool parseDictionary(Uint64 objectIndex, size_t offset, DICT_TYPE* dst, size_t depth)
+		{
+			size_t count = 0;
+			size_t contentOffset = 0;
+			if(!readCount(offset, &count, &contentOffset) || !checkRange(contentOffset, count, objectRefSize*2))
+			{
+				return false;
+			}
+			visiting[(size_t)objectIndex] = true;
+			Plist_reserve(dst, count);
+			size_t valuesOffset = contentOffset + count*objectRefSize;
+			for(size_t i=0; i<count; i++)
+			{
+				size_t keyOffset = 0;
+				Plist::key key;
+				if(!getObjectOffset(readInt(contentOffset + i*objectRefSize, objectRefSize), &keyOffset) || !parseString(keyOffset, &key))
+				{
+					return false;
+				}
+				Any value;
+				if(!parseObject<DICT_TYPE>(readInt(valuesOffset + i*objectRefSize, objectRefSize), &value, depth))
+				{
+					return false;
+				}
+				dst->set(key, std::move(value));
+			}
+			visiting[(size_t)objectIndex] = false;
+			return true;
+		}
+
+		template<typename DICT_TYPE>
+		bool parseArray(size_t offset, Plist::array* dst, size_t depth)
+		{
+			size_t count = 0;
+			size_t contentOffset = 0;
+			if(!readCount(offset, &count, &contentOffset) || !checkRange(contentOffset, count, objectRefSize))
+			{
+				return false;
+			}
+			dst->reserve(count);
+			for(size_t i=0; i<count; i++)
+			{
+				Any value;
+				if(!parseObject<DICT_TYPE>(readInt(contentOffset + i*objectRefSize, objectRefSize), &value, depth))
+				{
+					return false;
+				}
+				dst->add(std::move(value));
+			}
+			return true;
+		}
+	};
+
+
+
+	template<typename DICT_TYPE>
+	bool Plist_loadFromPointer(DICT_TYPE* dst, const void* pointer, size_t length, String* error)
+	{
+		if(dst==nullptr)
+		{
+			throw IllegalArgumentException("dst", "cannot be null");
+		}
+		else if(pointer==nullptr)
+		{
+			throw IllegalArgumentException("pointer", "cannot be null");
+		}
+		else if(length==0)
+		{
+			if(error!=nullptr)
+			{
+				*error = "pointer is empty";
+			}
+			return false;
+		}
+		// infer plist type from header.  If it has the bplist00 header as first 8
+		// bytes, then it's a binary plist.  Otherwise, assume it's XML
+		if(length>8 && std::memcmp(pointer, "bplist00", 8)==0)
+		{
+			Plist_BinaryReader reader(pointer, length, error);
+			return reader.parseDocument(dst);
+		}
+		else
+		{
+			Plist_XMLReader reader((const char*)pointer, length, error);
+			return reader.parseDocument(dst);
+		}
+	}
+
+
+
+	/*! Buffers output, and writes it to a file in large chunks if a file is given*/
+	class Plist_Output
+	{
+	public:
+		FILE* file;
+		String* error;
+		std::string buffer;
+		size_t offset;
+		bool success;
+
+		Plist_Output(FILE* file, String* error) : file(file), error(error), offset(0), success(true)
+		{
+			if(file!=nullptr)
+			{
+				buffer.reserve(Plist_outputBufferSize);
+			}
+		}
+
+		void write(const void* data, size_t size)
+		{
+			buffer.append((const char*)data, size);
+			offset += size;
+			if(file!=nullptr && buffer.length() >= Plist_outputBufferSize)
+			{
+				flush();
+			}
+		}
+
+		void write(const char* str)
+		{
+			write(str, std::strlen(str));
+		}
+
+		void write(char c)
+		{
+			write(&c, 1);
+		}
+
+		bool flush()
+		{
+			if(file==nullptr || buffer.length()==0)
+			{
+				return success;
+			}
+			size_t bytesWritten = std::fwrite(buffer.data(), 1, buffer.length(), file);
+			if(bytesWritten < buffer.length())
+			{
+				if(success)
+				{
+					success = false;
+					if(error!=nullptr)
+					{
+						*error = "Unable to write all bytes to file stream";
+					}
+				}
+			}
+			buffer.clear();
+			return success;
+		}
+	};
+
+
+
+	/*! Writes XML plists straight to the output, without building a document tree first*/
+	class Plist_XMLWriter
+	{
+	public:
+		Plist_XMLWriter(Plist_Output& output) : output(output)
+		{
+			//
+		}
+
+		template<typename DICT_TYPE>
+		void writeDocument(const DICT_TYPE& src)
+		{
+			output.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+			output.write("<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n");
+			output.write("<plist version=\"1.0\">\n");
+			writeDictionary(src, 1);
+			output.write("</plist>\n");
+		}
+
+	private:
+		Plist_Output& output;
+
+		void writeIndent(size_t depth)
+		{
+			for(size_t i=0; i<depth; i++)
+			{
+				output.write('\t');
+			}
+		}
+
+		void writeEscaped(const char* text, size_t length)
+		{
+			const char* textEnd = text + length;
+			while(text < textEnd)
+			{
+				const char* special = text;
+				while(special < textEnd && *special!='&' && *special!='<' && *special!='>')
+				{
+					special++;
+				}
+				output.write(text, (size_t)(special - text));
+				if(special >= textEnd)
+				{
+					break;
+				}
+				switch(*special)
+				{
+					case '&':
+					output.write("&amp;");
+					break;
+
+					case '<':
+					output.write("&lt;");
+					break;
+
+					case '>':
+					output.write("&gt;");
+					break;
+				}
+				text = special + 1;
+			}
+		}
+
+		void writeElement(const char* name, const char* text, size_t length, size_t depth)
+		{
+			writeIndent(depth);
+			output.write('<');
+			output.write(name);
+			output.write('>');
+			writeEscaped(text, length);
+			output.write("</");
+			output.write(name);
+			output.write(">\n");
+		}
+
+		void writeElement(const char* name, const String& text, size_t depth)
+		{
+			writeElement(name, text.getData(), text.length(), depth);
+		}
+
+		void writeEmptyElement(const char* name, size_t depth)
+		{
+			writeIndent(depth);
+			output.write('<');
+			output.write(name);
+			output.write("/>\n");
+		}
+
+		void writeData(const Data& data, size_t depth)
+		{
+			static const char* base64Chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			writeIndent(depth);
+			output.write("<data>");
+			const byte* bytes = (const byte*)data.getData();
+			size_t size = data.size();
+			char encoded[4];
+			for(size_t i=0; i<size; i+=3)
+			{
+				Uint32 bits = (Uint32)bytes[i] << 16;
+				if((i+1) < size)
+				{
+					bits |= (Uint32)bytes[i+1] << 8;
+				}
+				if((i+2) < size)
+				{
+					bits |= (Uint32)bytes[i+2];
+				}
+				encoded[0] = base64Chars[(bits >> 18) & 0x3F];
+				encoded[1] = base64Chars[(bits >> 12) & 0x3F];
+				encoded[2] = ((i+1) < size) ? base64Chars[(bits >> 6) & 0x3F] : '=';
+				encoded[3] = ((i+2) < size) ? base64Chars[bits & 0x3F] : '=';
+				output.write(encoded, 4);
+			}
+			output.write("</data>\n");
+		}
+
+		template<typename DICT_TYPE>
+		void writeDictionary(const DICT_TYPE& src, size_t depth)
+		{
+			if(src.size()==0)
+			{
+				writeEmptyElement("dict", depth);
+				return;
+			}
+			writeIndent(depth);
+			output.write("<dict>\n");
+			for(auto& pair : src)
+			{
+				writeElement("key", pair.first, depth+1);
+				writeValue(pair.second, depth+1);
+			}
+			writeIndent(depth);
+			output.write("</dict>\n");
+		}
+
+		void writeArray(const Plist::array& src, size_t depth)
+		{
+			if(src.size()==0)
+			{
+				writeEmptyElement("array", depth);
+				return;
+			}
+			writeIndent(depth);
+			output.write("<array>\n");
+			for(size_t array_size=src.size(), i=0; i<array_size; i++)
+			{
+				writeValue(src[i], depth+1);
+			}
+			writeIndent(depth);
+			output.write("</array>\n");
+		}
+
+		void writeValue(const Any& src, size_t depth)
+		{
+			if(src.is<Plist::dict>())
+			{
+				writeDictionary(src.as<Plist::dict>(), depth);
+			}
+			else if(src.is<Plist::hash_dict>())
+			{
+				writeDictionary(src.as<Plist::hash_dict>(), depth);
+			}
+			else if(src.is<Plist::array>())
+			{
+				writeArray(src.as<Plist::array>(), depth);
+			}
+			else if(src.is<Plist::string>())
+			{
+				writeElement("string", src.as<Plist::string>(), depth);
+			}
+			else if(src.is<Plist::data>())
+			{
+				writeData(src.as<Plist::data>(), depth);
+			}
+			else if(src.is<Plist::date>())
+			{
+				writeElement("date", src.as<Plist::date>().toISO8601String(), depth);
+			}
+			else if(src.is<Number>()) //Plist::integer, Plist::real, Plist::boolean
+			{
+				const Number& number = src.as<Number>();
+				if(number.isBool())
+				{
+					writeEmptyElement(number.toArithmeticValue<bool>() ? "true" : "false", depth);
+				}
+				else if(number.isIntegral())
+				{
+					writeElement("integer", number.toString(), depth);
+				}
+				else //if(number.isFloatingPoint())
+				{
+					writeElement("real", number.toString(), depth);
+				}
+			}
+			else if(src.is<WideString>())
+			{
+				writeElement("string", src.as<WideString>().toBasicString<char>(), depth);
+			}
+			else if(src.is<std::string>())
+			{
+				const std::string& str = src.as<std::string>();
+				writeElement("string", str.c_str(), str.length(), depth);
+			}
+			else if(src.is<const char*>())
+			{
+				const char* str = src.as<const char*>();
+				writeElement("string", str, std::strlen(str), depth);
+			}
+			else if(src.is<fgl::Int64>())
+			{
+				writeElement("integer", (String)"" + src.as<fgl::Int64>(), depth);
+			}
+			else if(src.is<fgl::Int32>())
+			{
+				writeElement("integer", (String)"" + src.as<fgl::Int32>(), depth);
+			}
+			else if(src.is<fgl::Int16>())
+			{
+				writeElement("integer", (String)"" + src.as<fgl::Int16>(), depth);
+			}
+			else if(src.is<fgl::Int8>())
+			{
+				writeElement("integer", (String)"" + src.as<fgl::Int8>(), depth);
+			}
+			else if(src.is<long double>())
+			{
+				writeElement("real", (String)"" + src.as<long double>(), depth);
+			}
+			else if(src.is<double>())
+			{
+				writeElement("real", (String)"" + src.as<double>(), depth);
 			}
-			else if(String::streq(it->name(), "key"))
+			else if(src.is<float>())
 			{
-				Plist_parse_error(ptr, *it, "\"key\" element after \"key\" element is not valid", error);
-				return false;
+				writeElement("real", (String)"" + src.as<float>(), depth);
 			}
-			Any value;
-			bool result = Plist_parse(&value, ptr, *it, error);
-			if(!value.isEmpty())
+			else if(src.is<bool>())
 			{
-				dst->set(key, std::move(value));
+				writeEmptyElement(src.as<bool>() ? "true" : "false", depth);
 			}
-			if(!result)
+			else if(src.is<fgl::Uint64>())
 			{
-				return false;
+				writeElement("integer", (String)"" + src.as<fgl::Uint64>(), depth);
 			}
-		}
-		return true;
-	}
-	
-	bool Plist_parseArray(Plist::array* dst, const void* ptr, pugi::xml_node& node, String* error)
-	{
-		size_t size = std::distance(node.begin(), node.end());
-		dst->reserve(size);
-		for(pugi::xml_node_iterator it=node.begin(); it!=node.end(); it++)
-		{
-			Any value;
-			bool result = Plist_parse(&value, ptr, *it, error);
-			if(!value.isEmpty())
+			else if(src.is<fgl::Uint32>())
 			{
-				dst->add(std::move(value));
+				writeElement("integer", (String)"" + src.as<fgl::Uint32>(), depth);
 			}
-			if(!result)
+			else if(src.is<fgl::Uint16>())
 			{
-				return false;
+				writeElement("integer", (String)"" + src.as<fgl::Uint16>(), depth);
+			}
+			else if(src.is<fgl::Uint8>())
+			{
+				writeElement("integer", (String)"" + src.as<fgl::Uint8>(), depth);
+			}
+			else
+			{
+				writeElement("string", src.toString(), depth);
 			}
 		}
-		return true;
-	}
-	
-	bool Plist_parseDate(Plist::date* dst, const void* ptr, pugi::xml_node& node, String* error)
-	{
-		const char* date_str = node.first_child().value();
-		if(date_str==nullptr || date_str[0]=='\0')
-		{
-			Plist_parse_error(ptr, node, "\"date\" element is empty", error);
-			return false;
-		}
-		int month=0, day=0, year=0, hour24=0, minute=0, second=0;
-		// parse date string.  E.g.  2011-09-25T02:31:04Z
-		int args = sscanf(date_str, "%4d-%2d-%2dT%2d:%2d:%2dZ", &year, &month, &day, &hour24, &minute, &second);
-		if(args < 6)
-		{
-			Plist_parse_error(ptr, node, "Invalid datetime format", error);
-			return false;
-		}
-		struct tm tmTime;
-		tmTime.tm_year = year - 1900;
-		tmTime.tm_mon = month - 1;
-		tmTime.tm_mday = day;
-		tmTime.tm_hour = hour24;
-		tmTime.tm_min = minute;
-		tmTime.tm_sec = second;
-		tmTime.tm_wday = 0;
-		tmTime.tm_yday = 0;
-		tmTime.tm_isdst = -1;
-		#ifdef _WIN32
-			time_t timeval = _mkgmtime(&tmTime);
-		#else
-			time_t timeval = timegm(&tmTime);
-		#endif
-		if(timeval==-1)
-		{
-			Plist_parse_error(ptr, node, "Invalid datetime values", error);
-			return false;
-		}
-		dst->assign(timeval);
-		return true;
-	}
-	
-	void Plist_parse_error(const void* ptr, pugi::xml_node& node, const String& error_message, String* error)
-	{
-		size_t offset = node.offset_debug();
-		std::pair<size_t, size_t> doc_pos = Plist_getParsePosition(ptr, offset);
-		if(error!=nullptr)
-		{
-			*error = (String)"" + doc_pos.first + ":" + doc_pos.second + ": " + error_message;
-		}
-	}
-	
-	bool Plist_write(const Any& src, pugi::xml_node& node, String* error)
+	};
+
+
+
+	/*! Writes binary (bplist00) plists. Values are first flattened into a table of objects, with equal strings (usually keys) shared between all their uses.*/
+	class Plist_BinaryWriter
 	{
-		if(src.is<Plist::dict>())
+	public:
+		Plist_BinaryWriter(Plist_Output& output) : output(output)
 		{
-			const Plist::dict& dict = src.as<Plist::dict>();
-			return Plist_writeDictionary(dict, node, error);
+			//
 		}
-		else if(src.is<Plist::array>())
+
+		template<typename DICT_TYPE>
+		void writeDocument(const DICT_TYPE& src)
 		{
-			const Plist::array& array = src.as<Plist::array>();
-			return Plist_writeArray(array, node, error);
+			addDictionary(src);
+
+			size_t objectRefSize = getIntSize(objects.size());
+			std::vector<Uint64> offsets;
+			offsets.reserve(objects.size());
+			output.write("bplist00", 8);
+			for(auto& object : objects)
+			{
+				offsets.push_back(output.offset);
+				writeObject(object, objectRefSize);
+			}
+
+			Uint64 offsetTableOffset = output.offset;
+			size_t offsetIntSize = getIntSize(offsetTableOffset);
+			for(auto objectOffset : offsets)
+			{
+				writeInt(objectOffset, offsetIntSize);
+			}
+
+			byte trailer[32] = { 0 };
+			trailer[6] = (byte)offsetIntSize;
+			trailer[7] = (byte)objectRefSize;
+			for(size_t i=0; i<8; i++)
+			{
+				size_t shift = (7 - i) * 8;
+				trailer[8+i] = (byte)((Uint64)objects.size() >> shift);
+				trailer[16+i] = 0; //the top object is always the first object
+				trailer[24+i] = (byte)(offsetTableOffset >> shift);
+			}
+			output.write(trailer, 32);
 		}
-		else if(src.is<Plist::string>())
+
+	private:
+		enum ObjectType
+		{
+			OBJECT_BOOL,
+			OBJECT_INTEGER,
+			OBJECT_UNSIGNED_INTEGER,
+			OBJECT_REAL,
+			OBJECT_DATE,
+			OBJECT_DATA,
+			OBJECT_STRING,
+			OBJECT_ARRAY,
+			OBJECT_DICT
+		};
+
+		struct Object
 		{
-			node.append_child("string").append_child(pugi::node_pcdata).set_value(src.as<Plist::string>());
-			return true;
-		}
-		else if(src.is<Plist::data>())
+			ObjectType type;
+			union
+			{
+				bool boolean;
+				Int64 integer;
+				Uint64 unsignedInteger;
+				double real;
+			};
+			const void* pointer;
+			size_t refStart;
+			size_t refCount;
+		};
+
+		struct StringPointerHash
 		{
-			const Plist::data& data = src.as<Plist::data>();
-			std::string encoded_str;
-			Plist_base64Encode(encoded_str, data);
-			node.append_child("data").append_child(pugi::node_pcdata).set_value(encoded_str.c_str());
-			return true;
-		}
-		else if(src.is<Plist::date>())
+			size_t operator()(const String* str) const
+			{
+				return str->hash();
+			}
+		};
+
+		struct StringPointerEquals
 		{
-			node.append_child("date").append_child(pugi::node_pcdata).set_value(src.as<Plist::date>().toISO8601String());
-			return true;
-		}
-		else if(src.is<Number>()) //Plist::integer, Plist::real, Plist::boolean
+			bool operator()(const String* left, const String* right) const
+			{
+				return (*left == *right);
+			}
+		};
+
+		Plist_Output& output;
+		std::vector<Object> objects;
+		std::vector<Uint64> refs;
+		std::unordered_map<const String*, size_t, StringPointerHash, StringPointerEquals> stringObjects;
+		//strings made from other value types, kept alive until the document is written
+		std::list<String> ownedStrings;
+
+		size_t getIntSize(Uint64 value) const
 		{
-			const Number& number = src.as<Number>();
-			if(number.isBool())
+			if(value <= 0xFF)
 			{
-				bool val = number.toArithmeticValue<bool>();
-				if(val)
-				{
-					node.append_child("true");
-				}
-				else
-				{
-					node.append_child("false");
-				}
-				return true;
+				return 1;
 			}
-			else if(number.isIntegral())
+			else if(value <= 0xFFFF)
 			{
-				node.append_child("integer").append_child(pugi::node_pcdata).set_value(number.toString());
-				return true;
+				return 2;
 			}
-			else //if(number.isFloatingPoint())
+			else if(value <= 0xFFFFFFFFULL)
 			{
-				node.append_child("real").append_child(pugi::node_pcdata).set_value(number.toString());
-				return true;
+				return 4;
 			}
+			return 8;
 		}
-		else if(src.is<WideString>())
-		{
-			node.append_child("string").append_child(pugi::node_pcdata).set_value(src.as<WideString>().toBasicString<char>());
-			return true;
-		}
-		else if(src.is<std::string>())
+
+		size_t addObject(ObjectType type, const void* pointer=nullptr)
 		{
-			node.append_child("string").append_child(pugi::node_pcdata).set_value(src.as<std::string>().c_str());
-			return true;
+			Object object;
+			object.type = type;
+			object.unsignedInteger = 0;
+			object.pointer = pointer;
+			object.refStart = 0;
+			object.refCount = 0;
+			objects.push_back(object);
+			return objects.size() - 1;
 		}
-		else if(src.is<const char*>())
+
+		size_t addString(const String& str)
 		{
-			node.append_child("string").append_child(pugi::node_pcdata).set_value(src.as<const char*>());
-			return true;
+			auto it = stringObjects.find(&str);
+			if(it != stringObjects.end())
+			{
+				return it->second;
+			}
+			size_t index = addObject(OBJECT_STRING, &str);
+			stringObjects.insert(std::make_pair(&str, index));
+			return index;
 		}
-		else if(src.is<fgl::Int64>())
+
+		size_t addOwnedString(String str)
 		{
-			node.append_child("integer").append_child(pugi::node_pcdata).set_value((String)"" + src.as<fgl::Int64>());
-			return true;
+			ownedStrings.push_back(std::move(str));
+			return addString(ownedStrings.back());
 		}
-		else if(src.is<fgl::Int32>())
+
+		size_t addInteger(long long value)
 		{
-			node.append_child("integer").append_child(pugi::node_pcdata).set_value((String)"" + src.as<fgl::Int32>());
-			return true;
+			size_t index = addObject(OBJECT_INTEGER);
+			objects[index].integer = value;
+			return index;
 		}
-		else if(src.is<fgl::Int16>())
+
+		size_t addUnsignedInteger(unsigned long long value)
 		{
-			node.append_child("integer").append_child(pugi::node_pcdata).set_value((String)"" + src.as<fgl::Int16>());
-			return true;
+			if(value <= (unsigned long long)std::numeric_limits<long long>::max())
+			{
+				return addInteger((long long)value);
+			}
+			size_t index = addObject(OBJECT_UNSIGNED_INTEGER);
+			objects[index].unsignedInteger = value;
+			return index;
 		}
-		else if(src.is<fgl::Int8>())
+
+		size_t addReal(double value)
 		{
-			node.append_child("integer").append_child(pugi::node_pcdata).set_value((String)"" + src.as<fgl::Int8>());
-			return true;
+			size_t index = addObject(OBJECT_REAL);
+			objects[index].real = value;
+			return index;
 		}
-		else if(src.is<long double>())
+
+		size_t addBool(bool value)
 		{
-			node.append_child("real").append_child(pugi::node_pcdata).set_value((String)"" + src.as<long double>());
-			return true;
+			size_t index = addObject(OBJECT_BOOL);
+			objects[index].boolean = value;
+			return index;
 		}
-		else if(src.is<double>())
+
+		template<typename DICT_TYPE>
+		size_t addDictionary(const DICT_TYPE& src)
 		{
-			node.append_child("real").append_child(pugi::node_pcdata).set_value((String)"" + src.as<double>());
-			return true;
+			size_t index = addObject(OBJECT_DICT);
+			std::vector<Uint64> children;
+			children.reserve(src.size()*2);
+			for(auto& pair : src)
+			{
+				children.push_back(addString(pair.first));
+			}
+			for(auto& pair : src)
+			{
+				children.push_back(addValue(pair.second));
+			}
+			objects[index].refStart = refs.size();
+			objects[index].refCount = src.size();
+			refs.insert(refs.end(), children.begin(), children.end());
+			return index;
 		}
-		else if(src.is<float>())
+
+		size_t addArray(const Plist::array& src)
 		{
-			node.append_child("real").append_child(pugi::node_pcdata).set_value((String)"" + src.as<float>());
-			return true;
+			size_t index = addObject(OBJECT_ARRAY);
+			std::vector<Uint64> children;
+			children.reserve(src.size());
+			for(size_t array_size=src.size(), i=0; i<array_size; i++)
+			{
+				children.push_back(addValue(src[i]));
+			}
+			objects[index].refStart = refs.size();
+			objects[index].refCount = src.size();
+			refs.insert(refs.end(), children.begin(), children.end());
+			return index;
 		}
-		else if(src.is<bool>())
+
+		size_t addValue(const Any& src)
 		{
-			bool val = src.as<bool>();
-			if(val)
+			if(src.is<Plist::dict>())
 			{
-				node.append_child("true");
+				return addDictionary(src.as<Plist::dict>());
 			}
-			else
+			else if(src.is<Plist::hash_dict>())
 			{
-				node.append_child("false");
+				return addDictionary(src.as<Plist::hash_dict>());
 			}
-			return true;
-		}
-		else if(src.is<fgl::Uint64>())
-		{
-			node.append_child("integer").append_child(pugi::node_pcdata).set_value((String)"" + src.as<fgl::Uint64>());
-			return true;
+			else if(src.is<Plist::array>())
+			{
+				return addArray(src.as<Plist::array>());
+			}
+			else if(src.is<Plist::string>())
+			{
+				return addString(src.as<Plist::string>());
+			}
+			else if(src.is<Plist::data>())
+			{
+				return addObject(OBJECT_DATA, &src.as<Plist::data>());
+			}
+			else if(src.is<Plist::date>())
+			{
+				size_t index = addObject(OBJECT_DATE);
+				objects[index].real = (double)src.as<Plist::date>().toTimeType() - Plist_binaryEpochOffset;
+				return index;
+			}
+			else if(src.is<Number>()) //Plist::integer, Plist::real, Plist::boolean
+			{
+				const Number& number = src.as<Number>();
+				if(number.isBool())
+				{
+					return addBool(number.toArithmeticValue<bool>());
+				}
+				else if(number.isIntegral())
+				{
+					if(number.isSigned())
+					{
+						return addInteger(number.toArithmeticValue<long long>());
+					}
+					return addUnsignedInteger(number.toArithmeticValue<unsigned long long>());
+				}
+				return addReal(number.toArithmeticValue<double>());
+			}
+			else if(src.is<WideString>())
+			{
+				return addOwnedString(src.as<WideString>().toBasicString<char>());
+			}
+			else if(src.is<std::string>())
+			{
+				const std::string& str = src.as<std::string>();
+				return addOwnedString(String(str.c_str(), str.length()));
+			}
+			else if(src.is<const char*>())
+			{
+				return addOwnedString(src.as<const char*>());
+			}
+			else if(src.is<fgl::Int64>())
+			{
+				return addInteger(src.as<fgl::Int64>());
+			}
+			else if(src.is<fgl::Int32>())
+			{
+				return addInteger(src.as<fgl::Int32>());
+			}
+			else if(src.is<fgl::Int16>())
+			{
+				return addInteger(src.as<fgl::Int16>());
+			}
+			else if(src.is<fgl::Int8>())
+			{
+				return addInteger(src.as<fgl::Int8>());
+			}
+			else if(src.is<long double>())
+			{
+				return addReal((double)src.as<long double>());
+			}
+			else if(src.is<double>())
+			{
+				return addReal(src.as<double>());
+			}
+			else if(src.is<float>())
+			{
+				return addReal(src.as<float>());
+			}
+			else if(src.is<bool>())
+			{
+				return addBool(src.as<bool>());
+			}
+			else if(src.is<fgl::Uint64>())
+			{
+				return addUnsignedInteger(src.as<fgl::Uint64>());
+			}
+			else if(src.is<fgl::Uint32>())
+			{
+				return addInteger(src.as<fgl::Uint32>());
+			}
+			else if(src.is<fgl::Uint16>())
+			{
+				return addInteger(src.as<fgl::Uint16>());
+			}
+			else if(src.is<fgl::Uint8>())
+			{
+				return addInteger(src.as<fgl::Uint8>());
+			}
+			return addOwnedString(src.toString());
 		}
-		else if(src.is<fgl::Uint32>())
+
+		void writeInt(Uint64 value, size_t size)
 		{
-			node.append_child("integer").append_child(pugi::node_pcdata).set_value((String)"" + src.as<fgl::Uint32>());
-			return true;
+			byte bytes[8];
+			for(size_t i=0; i<size; i++)
+			{
+				bytes[i] = (byte)(value >> ((size - 1 - i) * 8));
+			}
+			output.write(bytes, size);
 		}
-		else if(src.is<fgl::Uint16>())
+
+		/*! Writes an object marker, with the count in the low nibble, or in a following integer object if it doesn't fit*/
+		void writeMarker(byte marker, size_t count)
 		{
-			node.append_child("integer").append_child(pugi::node_pcdata).set_value((String)"" + src.as<fgl::Uint16>());
-			return true;
+			if(count < 0xF)
+			{
+				output.write((char)(marker | count));
+				return;
+			}
+			output.write((char)(marker | 0xF));
+			size_t intSize = getIntSize(count);
+			output.write((char)(0x10 | (intSize==1 ? 0 : intSize==2 ? 1 : intSize==4 ? 2 : 3)));
+			writeInt(count, intSize);
 		}
-		else if(src.is<fgl::Uint8>())
+
+		void writeDouble(byte marker, double value)
 		{
-			node.append_child("integer").append_child(pugi::node_pcdata).set_value((String)"" + src.as<fgl::Uint8>());
-			return true;
+			Uint64 bits;
+			std::memcpy(&bits, &value, 8);
+			output.write((char)marker);
+			writeInt(bits, 8);
 		}
-		else
+
+		void writeString(const String& str)
 		{
-			node.append_child("string").append_child(pugi::node_pcdata).set_value(src.toString());
-			return true;
+			const char* chars = str.getData();
+			size_t length = str.length();
+			bool ascii = true;
+			for(size_t i=0; i<length; i++)
+			{
+				if((byte)chars[i] >= 0x80)
+				{
+					ascii = false;
+					break;
+				}
+			}
+			if(ascii)
+			{
+				writeMarker(0x50, length);
+				output.write(chars, length);
+				return;
+			}
+			//non ASCII strings are stored as big endian UTF-16
+			std::vector<Uint16> units;
+			units.reserve(length);
+			for(size_t i=0; i<length;)
+			{
+				byte c = (byte)chars[i];
+				Uint32 codepoint = 0xFFFD;
+				size_t sequenceLength = (c < 0x80) ? 1 : (c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : (c >= 0xC0) ? 2 : 0;
+				if(sequenceLength==0 || (i + sequenceLength) > length)
+				{
+					i++;
+				}
+				else
+				{
+					codepoint = (sequenceLength==1) ? c : (c & (0xFF >> (sequenceLength + 1)));
+					for(size_t j=1; j<sequenceLength; j++)
+					{
+						codepoint = (codepoint << 6) | ((byte)chars[i+j] & 0x3F);
+					}
+					i += sequenceLength;
+				}
+				if(codepoint >= 0x10000)
+				{
+					codepoint -= 0x10000;
+					units.push_back((Uint16)(0xD800 + (codepoint >> 10)));
+					units.push_back((Uint16)(0xDC00 + (codepoint & 0x3FF)));
+				}
+				else
+				{
+					units.push_back((Uint16)codepoint);
+				}
+			}
+			writeMarker(0x60, units.size());
+			for(auto unit : units)
+			{
+				writeInt(unit, 2);
+			}
 		}
-	}
-	
-	bool Plist_writeDictionary(const Plist::dict& src, pugi::xml_node& node, String* error)
-	{
-		pugi::xml_node dict_node = node.append_child("dict");
-		for(auto& pair : src)
+
+		void writeObject(const Object& object, size_t objectRefSize)
 		{
-			pugi::xml_node key_node = dict_node.append_child("key");
-			key_node.append_child(pugi::node_pcdata).set_value(pair.first);
-			bool result = Plist_write(pair.second, dict_node, error);
-			if(!result)
+			switch(object.type)
 			{
-				return false;
+				case OBJECT_BOOL:
+				output.write((char)(object.boolean ? 0x09 : 0x08));
+				break;
+
+				case OBJECT_INTEGER:
+				if(object.integer < 0)
+				{
+					output.write((char)0x13);
+					writeInt((Uint64)object.integer, 8);
+				}
+				else
+				{
+					size_t intSize = getIntSize((Uint64)object.integer);
+					output.write((char)(0x10 | (intSize==1 ? 0 : intSize==2 ? 1 : intSize==4 ? 2 : 3)));
+					writeInt((Uint64)object.integer, intSize);
+				}
+				break;
+
+				case OBJECT_UNSIGNED_INTEGER:
+				output.write((char)0x14);
+				writeInt(0, 8);
+				writeInt(object.unsignedInteger, 8);
+				break;
+
+				case OBJECT_REAL:
+				writeDouble(0x23, object.real);
+				break;
+
+				case OBJECT_DATE:
+				writeDouble(0x33, object.real);
+				break;
+
+				case OBJECT_DATA:
+				{
+					const Data& data = *((const Data*)object.pointer);
+					writeMarker(0x40, data.size());
+					output.write(data.getData(), data.size());
+				}
+				break;
+
+				case OBJECT_STRING:
+				writeString(*((const String*)object.pointer));
+				break;
+
+				case OBJECT_ARRAY:
+				writeMarker(0xA0, object.refCount);
+				for(size_t i=0; i<object.refCount; i++)
+				{
+					writeInt(refs[object.refStart+i], objectRefSize);
+				}
+				break;
+
+				case OBJECT_DICT:
+				writeMarker(0xD0, object.refCount);
+				for(size_t i=0; i<(object.refCount*2); i++)
+				{
+					writeInt(refs[object.refStart+i], objectRefSize);
+				}
+				break;
 			}
 		}
-		return true;
-	}
-	
-	template<typename VALUE_TYPE>
-	bool Plist_writeArray(const ArrayList<VALUE_TYPE>& src, pugi::xml_node& node, String* error)
+	};
+
+
+
+	template<typename DICT_TYPE>
+	bool Plist_saveToOutput(const DICT_TYPE& src, FILE* file, Data* data, Plist::Format format, String* error)
 	{
-		pugi::xml_node array_node = node.append_child("array");
-		for(size_t array_size=src.size(), i=0; i<array_size; i++)
+		Plist_Output output(file, error);
+		switch(format)
 		{
-			bool result = Plist_write(src[i], array_node, error);
-			if(!result)
+			case Plist::Format::XML:
 			{
-				return false;
+				Plist_XMLWriter writer(output);
+				writer.writeDocument(src);
+			}
+			break;
+
+			case Plist::Format::BINARY:
+			{
+				Plist_BinaryWriter writer(output);
+				writer.writeDocument(src);
 			}
+			break;
 		}
-		return true;
+		if(data!=nullptr)
+		{
+			data->assign(output.buffer.data(), output.buffer.length());
+			return true;
+		}
+		return output.flush();
 	}
 }
@@ -0,0 +1,499 @@
+
+#include <GameLibrary/Utilities/Profiler.hpp>
+#include <GameLibrary/IO/FileTools.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace fgl
+{
+	constexpr size_t Profiler::HISTORY_SIZE;
+	constexpr size_t Profiler::THREAD_BUFFER_SIZE;
+
+	std::atomic<bool> Profiler::enabled(false);
+
+	static const Uint32 Profiler_noZone = (Uint32)-1;
+
+	struct ProfilerEvent
+	{
+		Uint32 zone;
+		Uint32 parentZone;
+		Int64 startTime;
+		Int64 duration;
+		Int64 selfDuration;
+	};
+
+	// a single producer, single consumer ring of the zones recorded by one thread
+	struct ProfilerThreadBuffer
+	{
+		ProfilerEvent events[Profiler::THREAD_BUFFER_SIZE];
+		// written by the owning thread
+		std::atomic<size_t> head;
+		// written by endFrame
+		std::atomic<size_t> tail;
+		// set once the owning thread exits, so the buffer can be freed after it's drained
+		std::atomic<bool> finished;
+		size_t threadIndex;
+		Profiler::Scope* currentScope;
+
+		ProfilerThreadBuffer()
+			: head(0),
+			tail(0),
+			finished(false),
+			threadIndex(0),
+			currentScope(nullptr) {
+			//
+		}
+	};
+
+	struct ProfilerTraceEvent
+	{
+		ProfilerEvent event;
+		size_t threadIndex;
+	};
+
+	struct ProfilerZoneData
+	{
+		const char* name;
+		Uint32 parentZone;
+		// totals of the current frame
+		Int64 frameDuration;
+		Int64 frameSelfDuration;
+		size_t frameCalls;
+		// totals of the last HISTORY_SIZE frames that the zone ran in
+		std::vector<Int64> durations;
+		std::vector<Int64> selfDurations;
+		std::vector<size_t> calls;
+		size_t historyIndex;
+	};
+
+	struct ProfilerRegistry
+	{
+		std::mutex mutex;
+		std::vector<ProfilerZoneData> zones;
+		std::vector<std::unique_ptr<ProfilerThreadBuffer>> buffers;
+		std::vector<String> threadNames;
+		size_t frameCount = 0;
+		std::atomic<size_t> droppedCount;
+		bool tracing = false;
+		size_t maxTraceEvents = 0;
+		Int64 traceStartTime = 0;
+		std::vector<ProfilerTraceEvent> traceEvents;
+
+		ProfilerRegistry()
+			: droppedCount(0) {
+			//
+		}
+	};
+
+	ProfilerRegistry& Profiler_getRegistry()
+	{
+		// never destroyed, since threads can still be finishing zones while the program exits
+		static ProfilerRegistry* registry = new ProfilerRegistry();
+		return *registry;
+	}
+
+	// marks the thread's buffer as finished when the thread exits
+	struct ProfilerThreadHandle
+	{
+		ProfilerThreadBuffer* buffer = nullptr;
+		String name;
+
+		~ProfilerThreadHandle()
+		{
+			if(buffer != nullptr)
+			{
+				buffer->finished.store(true, std::memory_order_release);
+			}
+		}
+	};
+
+	static thread_local ProfilerThreadHandle Profiler_threadHandle;
+
+	Int64 Profiler_now()
+	{
+		return (Int64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	ProfilerThreadBuffer* Profiler_getThreadBuffer()
+	{
+		ProfilerThreadHandle& handle = Profiler_threadHandle;
+		if(handle.buffer == nullptr)
+		{
+			ProfilerRegistry& registry = Profiler_getRegistry();
+			std::unique_ptr<ProfilerThreadBuffer> buffer(new ProfilerThreadBuffer());
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			buffer->threadIndex = registry.threadNames.size();
+			if(handle.name.length() > 0)
+			{
+				registry.threadNames.push_back(handle.name);
+			}
+			else
+			{
+				registry.threadNames.push_back((String)"thread " + buffer->threadIndex);
+			}
+			handle.buffer = buffer.get();
+			registry.buffers.push_back(std::move(buffer));
+		}
+		return handle.buffer;
+	}
+
+
+
+	Profiler::Zone::Zone(const char* name_arg)
+		: name(name_arg)
+	{
+		ProfilerRegistry& registry = Profiler_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		for(size_t i=0; i<registry.zones.size(); i++)
+		{
+			if(std::strcmp(registry.zones[i].name, name) == 0)
+			{
+				index = (Uint32)i;
+				return;
+			}
+		}
+		ProfilerZoneData zoneData;
+		zoneData.name = name;
+		zoneData.parentZone = Profiler_noZone;
+		zoneData.frameDuration = 0;
+		zoneData.frameSelfDuration = 0;
+		zoneData.frameCalls = 0;
+		zoneData.historyIndex = 0;
+		index = (Uint32)registry.zones.size();
+		registry.zones.push_back(zoneData);
+	}
+
+	const char* Profiler::Zone::getName() const
+	{
+		return name;
+	}
+
+
+
+	void Profiler::Scope::begin(Zone& zone_arg)
+	{
+		buffer = Profiler_getThreadBuffer();
+		zone = &zone_arg;
+		parent = buffer->currentScope;
+		buffer->currentScope = this;
+		childTime = 0;
+		startTime = Profiler_now();
+	}
+
+	void Profiler::Scope::end()
+	{
+		Int64 duration = Profiler_now() - startTime;
+		buffer->currentScope = parent;
+		if(parent != nullptr)
+		{
+			parent->childTime += duration;
+		}
+		size_t head = buffer->head.load(std::memory_order_relaxed);
+		if((head - buffer->tail.load(std::memory_order_acquire)) >= THREAD_BUFFER_SIZE)
+		{
+			Profiler_getRegistry().droppedCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		ProfilerEvent& event = buffer->events[head % THREAD_BUFFER_SIZE];
+		event.zone = zone->index;
+		event.parentZone = (parent != nullptr) ? parent->zone->index : Profiler_noZone;
+		event.startTime = startTime;
+		event.duration = duration;
+		event.selfDuration = duration - childTime;
+		buffer->head.store(head+1, std::memory_order_release);
+	}
+
+
+
+	void Profiler::setEnabled(bool enabled_arg)
+	{
+		enabled.store(enabled_arg, std::memory_order_relaxed);
+	}
+
+	bool Profiler::isEnabled()
+	{
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	void Profiler::setThreadName(const String& name)
+	{
+		ProfilerThreadHandle& handle = Profiler_threadHandle;
+		handle.name = name;
+		if(handle.buffer != nullptr)
+		{
+			ProfilerRegistry& registry = Profiler_getRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			registry.threadNames[handle.buffer->threadIndex] = name;
+		}
+	}
+
+	void Profiler::endFrame()
+	{
+		if(!isEnabled())
+		{
+			return;
+		}
+		ProfilerRegistry& registry = Profiler_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		for(size_t i=0; i<registry.buffers.size(); i++)
+		{
+			ProfilerThreadBuffer* buffer = registry.buffers[i].get();
+			// check if the thread has finished before draining, so that none of its zones are missed
+			bool finished = buffer->finished.load(std::memory_order_acquire);
+			size_t tail = buffer->tail.load(std::memory_order_relaxed);
+			size_t head = buffer->head.load(std::memory_order_acquire);
+			for(size_t j=tail; j<head; j++)
+			{
+				const ProfilerEvent& event = buffer->events[j % THREAD_BUFFER_SIZE];
+				ProfilerZoneData& zoneData = registry.zones[event.zone];
+				zoneData.parentZone = event.parentZone;
+				zoneData.frameDuration += event.duration;
+				zoneData.frameSelfDuration += event.selfDuration;
+				zoneData.frameCalls++;
+				if(registry.tracing && registry.traceEvents.size() < registry.maxTraceEvents)
+				{
+					registry.traceEvents.push_back(ProfilerTraceEvent{ event, buffer->threadIndex });
+				}
+			}
+			buffer->tail.store(head, std::memory_order_release);
+			if(finished)
+			{
+				registry.buffers.erase(registry.buffers.begin()+i);
+				i--;
+			}
+		}
+		for(ProfilerZoneData& zoneData : registry.zones)
+		{
+			if(zoneData.frameCalls == 0)
+			{
+				continue;
+			}
+			if(zoneData.durations.size() < HISTORY_SIZE)
+			{
+				zoneData.durations.push_back(zoneData.frameDuration);
+				zoneData.selfDurations.push_back(zoneData.frameSelfDuration);
+				zoneData.calls.push_back(zoneData.frameCalls);
+			}
+			else
+			{
+				zoneData.durations[zoneData.historyIndex] = zoneData.frameDuration;
+				zoneData.selfDurations[zoneData.historyIndex] = zoneData.frameSelfDuration;
+				zoneData.calls[zoneData.historyIndex] = zoneData.frameCalls;
+			}
+			zoneData.historyIndex = (zoneData.historyIndex + 1) % HISTORY_SIZE;
+			zoneData.frameDuration = 0;
+			zoneData.frameSelfDuration = 0;
+			zoneData.frameCalls = 0;
+		}
+		registry.frameCount++;
+	}
+
+	size_t Profiler::getFrameCount()
+	{
+		ProfilerRegistry& registry = Profiler_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		return registry.frameCount;
+	}
+
+	ArrayList<Profiler::ZoneStats> Profiler::getZoneStats()
+	{
+		ProfilerRegistry& registry = Profiler_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		ArrayList<ZoneStats> stats;
+		std::vector<Int64> sortedDurations;
+		for(const ProfilerZoneData& zoneData : registry.zones)
+		{
+			size_t frames = zoneData.durations.size();
+			if(frames == 0)
+			{
+				continue;
+			}
+			sortedDurations = zoneData.durations;
+			std::sort(sortedDurations.begin(), sortedDurations.end());
+			Int64 totalDuration = 0;
+			Int64 totalSelfDuration = 0;
+			size_t totalCalls = 0;
+			for(size_t i=0; i<frames; i++)
+			{
+				totalDuration += zoneData.durations[i];
+				totalSelfDuration += zoneData.selfDurations[i];
+				totalCalls += zoneData.calls[i];
+			}
+			size_t p99Index = ((frames*99) + 99)/100;
+			ZoneStats zoneStats;
+			zoneStats.name = zoneData.name;
+			if(zoneData.parentZone != Profiler_noZone)
+			{
+				zoneStats.parentName = registry.zones[zoneData.parentZone].name;
+			}
+			zoneStats.frames = frames;
+			zoneStats.averageCalls = (double)totalCalls / (double)frames;
+			zoneStats.minMilliseconds = (double)sortedDurations[0] / 1000000.0;
+			zoneStats.averageMilliseconds = ((double)totalDuration / (double)frames) / 1000000.0;
+			zoneStats.p99Milliseconds = (double)sortedDurations[p99Index-1] / 1000000.0;
+			zoneStats.maxMilliseconds = (double)sortedDurations[frames-1] / 1000000.0;
+			zoneStats.averageSelfMilliseconds = ((double)totalSelfDuration / (double)frames) / 1000000.0;
+			stats.add(zoneStats);
+		}
+		return stats;
+	}
+
+	String Profiler::getStatsReport()
+	{
+		ArrayList<ZoneStats> stats = getZoneStats();
+		String report;
+		char line[256];
+		std::snprintf(line, sizeof(line), "%-32s %8s %8s %8s %8s %8s %8s\n", "zone", "calls", "min ms", "avg ms", "p99 ms", "max ms", "self ms");
+		report += line;
+		for(const ZoneStats& zoneStats : stats)
+		{
+			// indent zones under their parent zones
+			String name = zoneStats.name;
+			String parentName = zoneStats.parentName;
+			for(size_t depth=0; depth<8 && parentName.length()>0; depth++)
+			{
+				name = "  " + name;
+				String nextParentName;
+				for(const ZoneStats& parentStats : stats)
+				{
+					if(parentStats.name == parentName)
+					{
+						nextParentName = parentStats.parentName;
+						break;
+					}
+				}
+				parentName = nextParentName;
+			}
+			std::snprintf(line, sizeof(line), "%-32s %8.1f %8.3f %8.3f %8.3f %8.3f %8.3f\n", (const char*)name, zoneStats.averageCalls, zoneStats.minMilliseconds,
+				zoneStats.averageMilliseconds, zoneStats.p99Milliseconds, zoneStats.maxMilliseconds, zoneStats.averageSelfMilliseconds);
+			report += line;
+		}
+		return report;
+	}
+
+	void Profiler::resetStats()
+	{
+		ProfilerRegistry& registry = Profiler_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		for(ProfilerZoneData& zoneData : registry.zones)
+		{
+			zoneData.parentZone = Profiler_noZone;
+			zoneData.frameDuration = 0;
+			zoneData.frameSelfDuration = 0;
+			zoneData.frameCalls = 0;
+			zoneData.durations.clear();
+			zoneData.selfDurations.clear();
+			zoneData.calls.clear();
+			zoneData.historyIndex = 0;
+		}
+		registry.frameCount = 0;
+		registry.droppedCount.store(0, std::memory_order_relaxed);
+	}
+
+	size_t Profiler::getDroppedZoneCount()
+	{
+		return Profiler_getRegistry().droppedCount.load(std::memory_order_relaxed);
+	}
+
+	void Profiler::startTrace(size_t maxZones)
+	{
+		ProfilerRegistry& registry = Profiler_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.traceEvents.clear();
+		registry.traceEvents.reserve(std::min(maxZones, (size_t)65536));
+		registry.maxTraceEvents = maxZones;
+		registry.traceStartTime = Profiler_now();
+		registry.tracing = true;
+	}
+
+	void Profiler::stopTrace()
+	{
+		ProfilerRegistry& registry = Profiler_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.tracing = false;
+	}
+
+	bool Profiler::isTracing()
+	{
+		ProfilerRegistry& registry = Profiler_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		return registry.tracing;
+	}
+
+	void Profiler_writeJSONString(FILE* file, const char* str)
+	{
+		std::fputc('"', file);
+		for(const char* c=str; *c!='\0'; c++)
+		{
+			switch(*c)
+			{
+				case '"':
+				std::fputs("\\\"", file);
+				break;
+
+				case '\\':
+				std::fputs("\\\\", file);
+				break;
+
+				default:
+				if((unsigned char)*c < 0x20)
+				{
+					std::fprintf(file, "\\u%04x", (unsigned int)(unsigned char)*c);
+				}
+				else
+				{
+					std::fputc(*c, file);
+				}
+				break;
+			}
+		}
+		std::fputc('"', file);
+	}
+
+	bool Profiler::writeTrace(const String& path, String* error)
+	{
+		FILE* file = FileTools::openFile(path, "wb", error);
+		if(file == nullptr)
+		{
+			return false;
+		}
+		ProfilerRegistry& registry = Profiler_getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+		bool first = true;
+		for(size_t i=0; i<registry.threadNames.size(); i++)
+		{
+			std::fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",", (unsigned int)i);
+			Profiler_writeJSONString(file, registry.threadNames[i]);
+			std::fputs("}}", file);
+			first = false;
+		}
+		for(const ProfilerTraceEvent& traceEvent : registry.traceEvents)
+		{
+			const ProfilerEvent& event = traceEvent.event;
+			double startTime = (double)(event.startTime - registry.traceStartTime) / 1000.0;
+			double duration = (double)event.duration / 1000.0;
+			std::fputs(first ? "\n{\"name\":" : ",\n{\"name\":", file);
+			Profiler_writeJSONString(file, registry.zones[event.zone].name);
+			std::fprintf(file, ",\"cat\":\"fgl\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}", startTime, duration, (unsigned int)traceEvent.threadIndex);
+			first = false;
+		}
+		std::fputs("\n]}\n", file);
+		bool failed = (std::ferror(file) != 0);
+		FileTools::closeFile(file);
+		if(failed)
+		{
+			if(error != nullptr)
+			{
+				*error = "unable to write trace to file";
+			}
+			return false;
+		}
+		return true;
+	}
+}
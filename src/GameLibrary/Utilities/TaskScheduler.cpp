@@ -0,0 +1,413 @@
+
+#include <GameLibrary/Utilities/TaskScheduler.hpp>
+#include <GameLibrary/Utilities/MPSCQueue.hpp>
+#include <GameLibrary/Utilities/Profiler.hpp>
+#include <GameLibrary/Utilities/Thread.hpp>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+
+namespace fgl
+{
+	constexpr size_t TaskScheduler::PRIORITY_COUNT;
+
+	// the scheduler and worker index of the current thread, if it's a worker thread
+	static thread_local TaskScheduler* TaskScheduler_currentScheduler = nullptr;
+	static thread_local size_t TaskScheduler_currentWorkerIndex = 0;
+
+	// signals a thread waiting on a main thread task. Each waiting thread reuses its own, so waiting doesn't allocate
+	struct MainThreadCompletion
+	{
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool finished = false;
+	};
+
+	struct MainThreadTask : public MPSCQueueNode
+	{
+		// the function to run, when the task owns it
+		std::function<void()> func;
+		// the function to run, when a waiting caller owns it
+		const std::function<void()>* funcRef = nullptr;
+		// the completion to signal after running, if a caller is waiting. Waited tasks live on the waiting caller's stack
+		MainThreadCompletion* completion = nullptr;
+	};
+
+	static MPSCQueue<MainThreadTask> TaskScheduler_mainThreadTasks[3];
+	static std::atomic<size_t> TaskScheduler_mainThreadTaskCount(0);
+	static double TaskScheduler_mainThreadTimeBudget = -1;
+	static bool TaskScheduler_mainThread_running = false;
+	static std::atomic<void(*)()> TaskScheduler_mainThreadWakeFunction(nullptr);
+	static thread_local MainThreadCompletion TaskScheduler_mainThreadCompletion;
+
+	TaskScheduler::TaskScheduler(size_t workerCount)
+		: pendingCount(0),
+		nextWorker(0),
+		stopping(false)
+	{
+		if(workerCount == 0)
+		{
+			unsigned int hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = (hardwareThreads > 1) ? (size_t)(hardwareThreads - 1) : 1;
+		}
+		workers.reserve(workerCount);
+		for(size_t i=0; i<workerCount; i++)
+		{
+			workers.push_back(std::unique_ptr<Worker>(new Worker()));
+		}
+		// start the threads once every worker exists, since workers steal from each other
+		for(size_t i=0; i<workerCount; i++)
+		{
+			workers[i]->thread = std::thread([=]() {
+				runWorker(i);
+			});
+		}
+	}
+
+	TaskScheduler::~TaskScheduler()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			stopping = true;
+		}
+		sleepCondition.notify_all();
+		for(auto& worker : workers)
+		{
+			if(worker->thread.joinable())
+			{
+				worker->thread.join();
+			}
+		}
+	}
+
+	TaskScheduler& TaskScheduler::getDefault()
+	{
+		static TaskScheduler scheduler;
+		return scheduler;
+	}
+
+	void TaskScheduler::schedule(std::function<void()> task, Priority priority)
+	{
+		size_t workerIndex;
+		if(TaskScheduler_currentScheduler == this)
+		{
+			// keep tasks scheduled from a worker on the same worker, while its caches are warm
+			workerIndex = TaskScheduler_currentWorkerIndex;
+		}
+		else
+		{
+			workerIndex = nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+		}
+		Worker& worker = *workers[workerIndex];
+		{
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			worker.tasks[(size_t)priority].push_back(std::move(task));
+		}
+		pendingCount.fetch_add(1);
+		{
+			// lock the sleep mutex so that a worker can't miss the notification between checking for tasks and waiting
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		sleepCondition.notify_one();
+	}
+
+	// the wake function is called after the task is pushed, so a main thread that checked for tasks before waiting will still be woken
+	static void TaskScheduler_wakeMainThread()
+	{
+		void(*wakeFunction)() = TaskScheduler_mainThreadWakeFunction.load(std::memory_order_acquire);
+		if(wakeFunction != nullptr)
+		{
+			wakeFunction();
+		}
+	}
+
+	void TaskScheduler::scheduleOnMainThread(std::function<void()> task, Priority priority)
+	{
+		auto mainThreadTask = new MainThreadTask();
+		mainThreadTask->func = std::move(task);
+		TaskScheduler_mainThreadTaskCount.fetch_add(1, std::memory_order_relaxed);
+		TaskScheduler_mainThreadTasks[(size_t)priority].push(mainThreadTask);
+		TaskScheduler_wakeMainThread();
+	}
+
+	void TaskScheduler::runOnMainThreadAndWait(const std::function<void()>& task, Priority priority)
+	{
+		if(Thread::isMainThread())
+		{
+			task();
+			return;
+		}
+		MainThreadCompletion& completion = TaskScheduler_mainThreadCompletion;
+		completion.finished = false;
+		MainThreadTask mainThreadTask;
+		mainThreadTask.funcRef = &task;
+		mainThreadTask.completion = &completion;
+		TaskScheduler_mainThreadTaskCount.fetch_add(1, std::memory_order_relaxed);
+		TaskScheduler_mainThreadTasks[(size_t)priority].push(&mainThreadTask);
+		TaskScheduler_wakeMainThread();
+		std::unique_lock<std::mutex> lock(completion.mutex);
+		completion.condition.wait(lock, [&]() {
+			return completion.finished;
+		});
+	}
+
+	void TaskScheduler::setMainThreadTimeBudget(double milliseconds)
+	{
+		TaskScheduler_mainThreadTimeBudget = milliseconds;
+	}
+
+	double TaskScheduler::getMainThreadTimeBudget()
+	{
+		return TaskScheduler_mainThreadTimeBudget;
+	}
+
+	bool TaskScheduler::hasMainThreadTasks()
+	{
+		return (TaskScheduler_mainThreadTaskCount.load(std::memory_order_acquire) > 0);
+	}
+
+	void TaskScheduler::setMainThreadWakeFunction(void(*wakeFunction)())
+	{
+		TaskScheduler_mainThreadWakeFunction.store(wakeFunction, std::memory_order_release);
+	}
+
+	void TaskScheduler::parallelForRange(size_t begin, size_t end, const std::function<void(size_t,size_t)>& func, size_t grainSize)
+	{
+		if(end <= begin)
+		{
+			return;
+		}
+		size_t count = end - begin;
+		if(grainSize == 0)
+		{
+			// aim for a few chunks per thread, so that stealing can even out uneven chunks
+			size_t targetChunkCount = (workers.size() + 1) * 4;
+			grainSize = std::max<size_t>(1, (count + targetChunkCount - 1) / targetChunkCount);
+		}
+		size_t chunkCount = (count + grainSize - 1) / grainSize;
+		if(chunkCount <= 1)
+		{
+			func(begin, end);
+			return;
+		}
+
+		// the calling thread waits for every chunk, so the shared state can live on its stack
+		std::atomic<size_t> remaining(chunkCount);
+		std::mutex errorMutex;
+		std::exception_ptr error = nullptr;
+		auto runChunk = [&](size_t chunkBegin, size_t chunkEnd) {
+			try
+			{
+				func(chunkBegin, chunkEnd);
+			}
+			catch(...)
+			{
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if(!error)
+				{
+					error = std::current_exception();
+				}
+			}
+			remaining.fetch_sub(1, std::memory_order_acq_rel);
+		};
+		for(size_t i=1; i<chunkCount; i++)
+		{
+			size_t chunkBegin = begin + (i * grainSize);
+			size_t chunkEnd = std::min(chunkBegin + grainSize, end);
+			schedule([=, &runChunk]() {
+				runChunk(chunkBegin, chunkEnd);
+			});
+		}
+		runChunk(begin, std::min(begin + grainSize, end));
+		while(remaining.load(std::memory_order_acquire) > 0)
+		{
+			if(!runPendingTask())
+			{
+				std::this_thread::yield();
+			}
+		}
+		if(error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+
+	bool TaskScheduler::runPendingTask()
+	{
+		Task task;
+		size_t workerIndex = (TaskScheduler_currentScheduler == this) ? TaskScheduler_currentWorkerIndex : workers.size();
+		if(!takeTask(workerIndex, task))
+		{
+			return false;
+		}
+		runTask(task);
+		return true;
+	}
+
+	size_t TaskScheduler::getWorkerCount() const
+	{
+		return workers.size();
+	}
+
+	bool TaskScheduler::isWorkerThread() const
+	{
+		return (TaskScheduler_currentScheduler == this);
+	}
+
+	void TaskScheduler::runMainThreadTasks()
+	{
+		if(!Thread::isMainThread() || TaskScheduler_mainThread_running)
+		{
+			return;
+		}
+		TaskScheduler_mainThread_running = true;
+		typedef std::chrono::steady_clock Clock;
+		auto startTime = Clock::now();
+		double timeBudget = TaskScheduler_mainThreadTimeBudget;
+		// only run the tasks that were already scheduled, so a task that schedules itself can't keep the drain going forever
+		size_t remainingTasks = TaskScheduler_mainThreadTaskCount.load(std::memory_order_relaxed);
+		size_t priority = 0;
+		while(remainingTasks > 0 && priority < PRIORITY_COUNT)
+		{
+			MainThreadTask* task = TaskScheduler_mainThreadTasks[priority].pop();
+			if(task == nullptr)
+			{
+				priority++;
+				continue;
+			}
+			TaskScheduler_mainThreadTaskCount.fetch_sub(1, std::memory_order_relaxed);
+			remainingTasks--;
+			if(task->completion != nullptr)
+			{
+				MainThreadCompletion* completion = task->completion;
+				(*task->funcRef)();
+				// the task lives on the waiting thread's stack, so it can't be touched once the waiting thread is released
+				std::lock_guard<std::mutex> lock(completion->mutex);
+				completion->finished = true;
+				completion->condition.notify_one();
+			}
+			else
+			{
+				task->func();
+				delete task;
+			}
+			if(timeBudget >= 0 && std::chrono::duration<double, std::milli>(Clock::now() - startTime).count() >= timeBudget)
+			{
+				// leave the rest of the tasks for the next update
+				break;
+			}
+			// higher priority tasks may have been scheduled by the task that just ran
+			priority = 0;
+		}
+		TaskScheduler_mainThread_running = false;
+	}
+
+	void TaskScheduler::runWorker(size_t workerIndex)
+	{
+		TaskScheduler_currentScheduler = this;
+		TaskScheduler_currentWorkerIndex = workerIndex;
+		Profiler::setThreadName((String)"worker " + workerIndex);
+		Task task;
+		while(true)
+		{
+			if(takeTask(workerIndex, task))
+			{
+				runTask(task);
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			sleepCondition.wait(lock, [&]() {
+				return stopping || pendingCount.load() > 0;
+			});
+			if(stopping && pendingCount.load() == 0)
+			{
+				break;
+			}
+		}
+		TaskScheduler_currentScheduler = nullptr;
+	}
+
+	bool TaskScheduler::takeTask(size_t workerIndex, Task& task)
+	{
+		if(pendingCount.load() == 0)
+		{
+			return false;
+		}
+		for(size_t priority=0; priority<PRIORITY_COUNT; priority++)
+		{
+			if(workerIndex < workers.size() && popTask(workerIndex, priority, task))
+			{
+				return true;
+			}
+			if(stealTask(workerIndex, priority, task))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool TaskScheduler::popTask(size_t workerIndex, size_t priority, Task& task)
+	{
+		Worker& worker = *workers[workerIndex];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		auto& tasks = worker.tasks[priority];
+		if(tasks.empty())
+		{
+			return false;
+		}
+		task = std::move(tasks.back());
+		tasks.pop_back();
+		pendingCount.fetch_sub(1);
+		return true;
+	}
+
+	bool TaskScheduler::stealTask(size_t thiefIndex, size_t priority, Task& task)
+	{
+		size_t workerCount = workers.size();
+		// start with the worker after the thief, so that thieves don't all pick on the same worker
+		size_t startIndex = (thiefIndex < workerCount) ? (thiefIndex + 1) : 0;
+		for(size_t i=0; i<workerCount; i++)
+		{
+			size_t victimIndex = (startIndex + i) % workerCount;
+			if(victimIndex == thiefIndex)
+			{
+				continue;
+			}
+			Worker& victim = *workers[victimIndex];
+			std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+			if(!lock.owns_lock())
+			{
+				continue;
+			}
+			auto& tasks = victim.tasks[priority];
+			if(tasks.empty())
+			{
+				continue;
+			}
+			task = std::move(tasks.front());
+			tasks.pop_front();
+			pendingCount.fetch_sub(1);
+			return true;
+		}
+		return false;
+	}
+
+	void TaskScheduler::runTask(Task& task)
+	{
+		try
+		{
+			task();
+		}
+		catch(const std::exception& e)
+		{
+			std::cerr << "uncaught exception in scheduled task: " << e.what() << std::endl;
+		}
+		catch(...)
+		{
+			std::cerr << "uncaught exception in scheduled task" << std::endl;
+		}
+		task = nullptr;
+	}
+}
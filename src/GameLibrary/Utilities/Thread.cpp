@@ -1,5 +1,6 @@
 
 #include <GameLibrary/Utilities/Thread.hpp>
+#include <GameLibrary/Utilities/TaskScheduler.hpp>
 #include <GameLibrary/Utilities/PlatformChecks.hpp>
 #include <GameLibrary/Types.hpp>
 #include <condition_variable>
@@ -12,17 +13,6 @@ namespace fgl
 {
 	std::thread::id main_thread_id = std::this_thread::get_id();
 	
-	struct MainThreadFunction
-	{
-		std::function<void()> func;
-		std::condition_variable* waitCondition;
-	};
-	
-	static ArrayList<MainThreadFunction> Thread_mainThreadFunctions;
-	static std::mutex Thread_mainThreadFunctions_mutex;
-	
-	static bool Thread_mainthread_updating = false;
-	
 	typedef struct
 	{
 		std::thread*thread;
@@ -174,43 +164,17 @@ namespace fgl
 	{
 		if(wait)
 		{
-			if(isMainThread())
-			{
-				func();
-			}
-			else
-			{
-				std::mutex mtx;
-				std::unique_lock<std::mutex> lck(mtx);
-				std::condition_variable cv;
-				
-				MainThreadFunction functionData;
-				functionData.func = func;
-				functionData.waitCondition = &cv;
-				
-				Thread_mainThreadFunctions_mutex.lock();
-				Thread_mainThreadFunctions.add(functionData);
-				Thread_mainThreadFunctions_mutex.unlock();
-				
-				cv.wait(lck);
-			}
+			TaskScheduler::runOnMainThreadAndWait(func);
 		}
 		else
 		{
-			MainThreadFunction functionData;
-			functionData.func = func;
-			functionData.waitCondition = nullptr;
-			
-			Thread_mainThreadFunctions_mutex.lock();
-			Thread_mainThreadFunctions.add(functionData);
-			Thread_mainThreadFunctions_mutex.unlock();
+			TaskScheduler::scheduleOnMainThread(func);
 		}
 	}
 	
 	void Thread::runOnThread(const std::function<void()>& func)
 	{
-		std::thread th(func);
-		th.detach();
+		TaskScheduler::getDefault().schedule(func);
 	}
 	
 	bool Thread::isMainThread()
@@ -231,26 +195,6 @@ namespace fgl
 	
 	void Thread::update()
 	{
-		if(isMainThread() && !Thread_mainthread_updating)
-		{
-			Thread_mainthread_updating = true;
-			
-			Thread_mainThreadFunctions_mutex.lock();
-			ArrayList<MainThreadFunction> mainthread_functions = Thread_mainThreadFunctions;
-			Thread_mainThreadFunctions.clear();
-			Thread_mainThreadFunctions_mutex.unlock();
-			
-			for(size_t i=0; i < mainthread_functions.size(); i++)
-			{
-				MainThreadFunction& functionData = mainthread_functions[i];
-				functionData.func();
-				if(functionData.waitCondition != nullptr)
-				{
-					functionData.waitCondition->notify_all();
-				}
-			}
-			
-			Thread_mainthread_updating = false;
-		}
+		TaskScheduler::runMainThreadTasks();
 	}
 }
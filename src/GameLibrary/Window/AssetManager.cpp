@@ -7,6 +7,7 @@
 #include <GameLibrary/IO/FileTools.hpp>
 #include <GameLibrary/Window/Window.hpp>
 #include <GameLibrary/Exception/IllegalArgumentException.hpp>
+#include <atomic>
 
 namespace fgl
 {
@@ -19,7 +20,9 @@ namespace fgl
 	
 	AssetManager::AssetManager(Window* window, const String& rootdir)
 		: window(window),
-		rootdir(rootdir) {
+		rootdir(rootdir),
+		memoryUsage(0),
+		memoryBudget(0) {
 		if(window==nullptr) {
 			throw fgl::IllegalArgumentException("window", "cannot be null");
 		}
@@ -28,43 +31,80 @@ namespace fgl
 		addAssetType<Image>([=](auto info) {
 			String error;
 			auto image = new Image();
-			bool success = image->loadFromPath(info.getFullPath(), &error);
+			AssetPack::Entry packEntry;
+			bool success = false;
+			if(info.assetManager->findPackedFile(info.path, &packEntry)) {
+				success = image->loadFromPointer(packEntry.data, packEntry.size, &error);
+			}
+			else {
+				success = image->loadFromPath(info.getFullPath(), &error);
+			}
 			if(!success) {
 				delete image;
 				throw Exception(error);
 			}
 			return image;
+		}, nullptr, [](const Image* image) -> size_t {
+			return image->getWidth() * image->getHeight() * sizeof(Color);
 		});
 		
 		// TextureImage
 		addAssetType<TextureImage>([=](auto info) {
 			String error;
 			auto texture = new TextureImage();
-			bool success = texture->loadFromPath(info.getFullPath(), *window->getGraphics(), &error);
+			AssetPack::Entry packEntry;
+			bool success = false;
+			if(info.assetManager->findPackedFile(info.path, &packEntry)) {
+				success = texture->loadFromPointer(packEntry.data, packEntry.size, *window->getGraphics(), &error);
+			}
+			else {
+				success = texture->loadFromPath(info.getFullPath(), *window->getGraphics(), &error);
+			}
 			if(!success) {
 				delete texture;
 				throw Exception(error);
 			}
 			return texture;
+		}, nullptr, [](const TextureImage* texture) -> size_t {
+			// 4 bytes per pixel on the GPU, plus the pixel mask
+			size_t pixelCount = texture->getWidth() * texture->getHeight();
+			return (pixelCount * 4) + (pixelCount / 8);
 		});
 		
 		// Font
 		addAssetType<Font>([=](auto info) {
 			String error;
 			auto font = new Font();
-			bool success = font->loadFromPath(info.getFullPath(), &error);
+			AssetPack::Entry packEntry;
+			bool success = false;
+			if(info.assetManager->findPackedFile(info.path, &packEntry)) {
+				// SDL_ttf reads from the font data after it's opened, so the font keeps its own copy in case the pack is unmounted
+				success = font->loadFromData(Data(packEntry.data, packEntry.size), &error);
+			}
+			else {
+				success = font->loadFromPath(info.getFullPath(), &error);
+			}
 			if(!success) {
 				delete font;
 				throw Exception(error);
 			}
 			return font;
+		}, nullptr, [](const Font* font) -> size_t {
+			return font->getDataSize();
 		});
 	}
 
 	AssetManager::~AssetManager() {
+		unreferencedAssets.clear();
 		for(auto assetList : assetLists) {
 			delete assetList;
 		}
+		unmountPacks();
+	}
+	
+	size_t AssetManager::nextAssetTypeSlot() {
+		static std::atomic<size_t> slotCounter(0);
+		return slotCounter++;
 	}
 	
 	
@@ -82,8 +122,70 @@ namespace fgl
 	
 	
 	
+	void AssetManager::retainAsset(AssetEntry* entry) {
+		entry->refCount++;
+		if(entry->unreferenced) {
+			entry->owner->manager->unreferencedAssets.erase(entry->unreferencedIterator);
+			entry->unreferenced = false;
+		}
+	}
+	
+	void AssetManager::releaseAsset(AssetEntry* entry) {
+		entry->refCount--;
+		if(entry->refCount == 0 && entry->owner != nullptr && entry->reloadable) {
+			auto manager = entry->owner->manager;
+			entry->unreferencedIterator = manager->unreferencedAssets.insert(manager->unreferencedAssets.end(), entry);
+			entry->unreferenced = true;
+			manager->enforceMemoryBudget();
+		}
+	}
+	
+	void AssetManager::onAssetAdded(AssetEntry* entry) {
+		memoryUsage += entry->size;
+		if(entry->refCount == 0 && entry->reloadable) {
+			entry->unreferencedIterator = unreferencedAssets.insert(unreferencedAssets.end(), entry);
+			entry->unreferenced = true;
+		}
+	}
+	
+	void AssetManager::onAssetRemoved(AssetEntry* entry) {
+		memoryUsage -= entry->size;
+		if(entry->unreferenced) {
+			unreferencedAssets.erase(entry->unreferencedIterator);
+			entry->unreferenced = false;
+		}
+	}
+	
+	void AssetManager::touchAsset(AssetEntry* entry) const {
+		if(entry->unreferenced) {
+			unreferencedAssets.splice(unreferencedAssets.end(), unreferencedAssets, entry->unreferencedIterator);
+		}
+	}
+	
+	void AssetManager::enforceMemoryBudget(const AssetEntry* keepEntry) {
+		if(memoryBudget == 0) {
+			return;
+		}
+		while(memoryUsage > memoryBudget && unreferencedAssets.size() > 0) {
+			auto entry = unreferencedAssets.front();
+			if(entry == keepEntry) {
+				// the asset being kept is the most recently used, so nothing else can be evicted
+				break;
+			}
+			entry->owner->unload(entry->path);
+		}
+	}
+	
+	
+	
+	
 	void AssetManager::setRootDirectory(const String& root) {
 		rootdir = root;
+		for(auto assetList : assetLists) {
+			if(assetList != nullptr) {
+				assetList->clearAliases();
+			}
+		}
 	}
 	
 	const String& AssetManager::getRootDirectory() const {
@@ -111,6 +213,53 @@ namespace fgl
 	
 	
 	
+	bool AssetManager::mountPack(const String& path, String* error) {
+		auto pack = new AssetPack();
+		if(!pack->loadFromPath(getValidAssetPath(path), error)) {
+			delete pack;
+			return false;
+		}
+		packs.add(pack);
+		return true;
+	}
+	
+	void AssetManager::unmountPacks() {
+		for(auto pack : packs) {
+			delete pack;
+		}
+		packs.clear();
+	}
+	
+	const ArrayList<AssetPack*>& AssetManager::getPacks() const {
+		return packs;
+	}
+	
+	bool AssetManager::findPackedFile(const String& path, AssetPack::Entry* entry) const {
+		if(packs.size() == 0) {
+			return false;
+		}
+		String packPath;
+		if(FileTools::isPathAbsolute(path)) {
+			// absolute paths can only be found in a pack if they're inside the root directory
+			if(rootdir.length() == 0 || !path.startsWith(rootdir) || path.length() <= rootdir.length()) {
+				return false;
+			}
+			packPath = AssetPack::normalizePath(path.substring(rootdir.length()));
+		}
+		else {
+			packPath = AssetPack::normalizePath(path);
+		}
+		for(auto pack : packs) {
+			if(pack->find(packPath, entry)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	
+	
+	
+	
 	TextureImage* AssetManager::loadTexture(const String& path) {
 		return load<TextureImage>(path);
 	}
@@ -146,17 +295,24 @@ namespace fgl
 		if(auto texture = getTexture(path)) {
 			return texture;
 		}
-		// open the file
-		FILE* file = openFile(path, "rb");
-		if(file==nullptr) {
-			throw Exception("unable to load file");
-		}
-
+		FGL_PROFILE_ZONE("AssetManager::loadMaskedTexture")
 		//load the image first
 		Image image;
 		String error;
-		bool success = image.loadFromFile(file, &error);
-		FileTools::closeFile(file);
+		bool success = false;
+		AssetPack::Entry packEntry;
+		if(findPackedFile(path, &packEntry)) {
+			success = image.loadFromPointer(packEntry.data, packEntry.size, &error);
+		}
+		else {
+			// open the file
+			FILE* file = openFile(path, "rb");
+			if(file==nullptr) {
+				throw Exception("unable to load file");
+			}
+			success = image.loadFromFile(file, &error);
+			FileTools::closeFile(file);
+		}
 		if(!success) {
 			throw Exception(error);
 		}
@@ -243,16 +399,33 @@ namespace fgl
 	size_t AssetManager::getAssetCount() const {
 		size_t assetCount = 0;
 		for(auto assetList : assetLists) {
-			assetCount += assetList->getAssetCount();
+			if(assetList != nullptr) {
+				assetCount += assetList->getAssetCount();
+			}
 		}
 		return assetCount;
 	}
 	
 	void AssetManager::unloadAllAssets() {
 		for(auto assetList : assetLists) {
-			assetList->unloadAll();
+			if(assetList != nullptr) {
+				assetList->unloadAll();
+			}
 		}
 	}
+	
+	size_t AssetManager::getMemoryUsage() const {
+		return memoryUsage;
+	}
+	
+	void AssetManager::setMemoryBudget(size_t budget) {
+		memoryBudget = budget;
+		enforceMemoryBudget();
+	}
+	
+	size_t AssetManager::getMemoryBudget() const {
+		return memoryBudget;
+	}
 
 
 
@@ -281,5 +454,30 @@ namespace fgl
 
 	void AssetManager::swapAssets(AssetManager* assetManager) {
 		assetLists.swap(assetManager->assetLists);
+		unreferencedAssets.swap(assetManager->unreferencedAssets);
+		std::swap(memoryUsage, assetManager->memoryUsage);
+		for(auto assetList : assetLists) {
+			if(assetList != nullptr) {
+				assetList->manager = this;
+			}
+		}
+		for(auto assetList : assetManager->assetLists) {
+			if(assetList != nullptr) {
+				assetList->manager = assetManager;
+			}
+		}
+		// cached aliases were resolved against the previous asset manager's root directory
+		for(auto assetList : assetLists) {
+			if(assetList != nullptr) {
+				assetList->clearAliases();
+			}
+		}
+		for(auto assetList : assetManager->assetLists) {
+			if(assetList != nullptr) {
+				assetList->clearAliases();
+			}
+		}
+		enforceMemoryBudget();
+		assetManager->enforceMemoryBudget();
 	}
 }
@@ -208,8 +208,13 @@ namespace fgl
 		{
 			flags = flags | SDL_WINDOW_SHOWN;
 		}
+		//software windows are drawn by SDL's software renderer, so they can be created without a GPU
+		if((style & Window::STYLE_SOFTWARE) != Window::STYLE_SOFTWARE)
+		{
+			flags = flags | SDL_WINDOW_OPENGL;
+		}
 		
-		sdlWindow = SDL_CreateWindow(windowSettings.title,positionx,positiony,windowSettings.size.x,windowSettings.size.y, flags | SDL_WINDOW_OPENGL);
+		sdlWindow = SDL_CreateWindow(windowSettings.title,positionx,positiony,windowSettings.size.x,windowSettings.size.y, flags);
 		if(sdlWindow == nullptr)
 		{
 			//TODO replace with more specific exception type
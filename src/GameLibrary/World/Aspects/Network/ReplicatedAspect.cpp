@@ -0,0 +1,18 @@
+
+#include <GameLibrary/World/Aspects/Network/ReplicatedAspect.hpp>
+
+namespace fgl
+{
+	ReplicatedAspect::ReplicatedAspect(Uint32 networkID)
+		: networkID(networkID) {
+		//
+	}
+	
+	void ReplicatedAspect::setNetworkID(Uint32 networkID_arg) {
+		networkID = networkID_arg;
+	}
+	
+	Uint32 ReplicatedAspect::getNetworkID() const {
+		return networkID;
+	}
+}
@@ -1,13 +1,11 @@
 
 #include <GameLibrary/World/World.hpp>
 #include <GameLibrary/Screen/Screen.hpp>
-#include <GameLibrary/Utilities/PerformanceMacros.hpp>
-#include <chrono>
+#include <GameLibrary/Utilities/Profiler.hpp>
 
 namespace fgl
 {
 	//#define DEBUG_DEPTH
-	//#define DEBUG_TIME
 	
 	World::World(AssetManager* assetManager, const ArrayList<WorldCamera*>& cameras)
 		: World(nullptr, nullptr, assetManager, cameras) {
@@ -51,7 +49,8 @@ namespace fgl
 		time.stop();
 	}
 	
-	void World::update(ApplicationData appData) {
+	void World::update(const ApplicationData& appData) {
+		FGL_PROFILE_ZONE("World::update")
 		auto nextPreUpdateQueue = std::list<std::function<void()>>();
 		nextPreUpdateQueue.swap(preUpdateQueue);
 		preUpdateQueue.clear();
@@ -74,47 +73,28 @@ namespace fgl
 		}
 		
 		
-		#ifdef DEBUG_TIME
-		START_PERFORMANCE_LOG(objectUpdates)
-		#endif
-		
 		// set extra appData
-		appData.additionalData["world"] = this;
+		ApplicationData worldAppData = appData;
+		worldAppData.setAdditionalData("world", this);
 		// update objects
-		for(auto object : objects) {
-			object->update(appData);
+		{
+			FGL_PROFILE_ZONE("World::updateObjects")
+			for(auto object : objects) {
+				object->update(worldAppData);
+			}
 		}
 		
-		#ifdef DEBUG_TIME
-		FINISH_PERFORMANCE_LOG_ROUNDED(objectUpdates, "object updates")
-		#endif
-		
-		
 		// update collision manager
-		#ifdef DEBUG_TIME
-		START_PERFORMANCE_LOG(collisions)
-		#endif
-		
-		collisionManager->update(appData);
-		
-		#ifdef DEBUG_TIME
-		FINISH_PERFORMANCE_LOG_ROUNDED(collisions, "collision updates")
-		#endif
-		
+		collisionManager->update(worldAppData);
 		
 		// update draw manager
-		#ifdef DEBUG_TIME
-		START_PERFORMANCE_LOG(drawOrdering)
-		#endif
-		
-		drawManager->update(appData);
-		
-		#ifdef DEBUG_TIME
-		FINISH_PERFORMANCE_LOG_ROUNDED(drawOrdering, "draw ordering")
-		#endif
+		drawManager->update(worldAppData);
 		
 		// update overlay screen
-		screen->update(appData);
+		{
+			FGL_PROFILE_ZONE("World::updateScreen")
+			screen->update(worldAppData);
+		}
 		
 		auto nextPostUpdateQueue = std::list<std::function<void()>>();
 		nextPostUpdateQueue.swap(postUpdateQueue);
@@ -132,26 +112,34 @@ namespace fgl
 		}
 	}
 	
-	void World::draw(ApplicationData appData, Graphics graphics) const {
-		#ifdef DEBUG_TIME
-		START_PERFORMANCE_LOG(drawing)
-		#endif
+	bool World::isAnimating() const {
+		if(firstUpdate || !objects.empty()) {
+			return true;
+		}
+		if(!preUpdateQueue.empty() || !postUpdateQueue.empty() || !queuedDeletions.empty() || !nextQueuedDeletions.empty()) {
+			return true;
+		}
+		if(screen != nullptr && screen->isAnimating()) {
+			return true;
+		}
+		return false;
+	}
+	
+	void World::draw(const ApplicationData& appData, Graphics graphics) const {
+		FGL_PROFILE_ZONE("World::draw")
 		
 		// set extra appData
-		appData.additionalData["world"] = this;
+		ApplicationData worldAppData = appData;
+		worldAppData.setAdditionalData("world", this);
 		// draw
 		if(cameras.size() == 0) {
 			auto viewSize = appData.getWindow()->getViewport()->getSize();
 			graphics.translate(viewSize / 2.0);
-			drawManager->draw(DrawContext(&appData, nullptr, drawManager), graphics);
+			drawManager->draw(DrawContext(&worldAppData, nullptr, drawManager), graphics);
 		}
 		else if(screen != nullptr) {
-			screen->draw(appData, graphics);
+			screen->draw(worldAppData, graphics);
 		}
-		
-		#ifdef DEBUG_TIME
-		FINISH_PERFORMANCE_LOG_ROUNDED(drawing, "draw")
-		#endif
 	}
 	
 	DrawManager* World::getDrawManager() {
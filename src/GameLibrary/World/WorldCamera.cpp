@@ -79,11 +79,11 @@ namespace fgl
 		setClippedToFrame(true);
 	}
 	
-	void WorldCamera::WorldElement::drawMain(ApplicationData appData, Graphics graphics) const {
+	void WorldCamera::WorldElement::drawMain(const ApplicationData& appData, Graphics graphics) const {
 		camera->drawWorld(camera->world, appData, graphics);
 	}
 	
-	void WorldCamera::drawWorld(const World* world, ApplicationData appData, Graphics graphics) const {
+	void WorldCamera::drawWorld(const World* world, const ApplicationData& appData, Graphics graphics) const {
 		auto drawManager = world->getDrawManager();
 		
 		auto frame = getFrame();
@@ -26,12 +26,12 @@ void Game::unloadContent(fgl::AssetManager* assetManager)
 	//
 }
 
-void Game::update(fgl::ApplicationData appData)
+void Game::update(const fgl::ApplicationData& appData)
 {
 	//
 }
 
-void Game::draw(fgl::ApplicationData appData, fgl::Graphics graphics) const
+void Game::draw(const fgl::ApplicationData& appData, fgl::Graphics graphics) const
 {
 	//
 }
@@ -12,6 +12,6 @@ public:
 	virtual void initialize() override;
 	virtual void loadContent(fgl::AssetManager* assetManager) override;
 	virtual void unloadContent(fgl::AssetManager* assetManager) override;
-	virtual void update(fgl::ApplicationData appData) override;
-	virtual void draw(fgl::ApplicationData appData, fgl::Graphics graphics) const override;
+	virtual void update(const fgl::ApplicationData& appData) override;
+	virtual void draw(const fgl::ApplicationData& appData, fgl::Graphics graphics) const override;
 };
@@ -0,0 +1,69 @@
+
+#include <GameLibrary/IO/AssetPack.hpp>
+#include <GameLibrary/IO/FileTools.hpp>
+#include <GameLibrary/Exception/Exception.hpp>
+#include <cstdio>
+
+using namespace fgl;
+
+// adds every file inside a directory (and its subdirectories) to the list of files to pack
+void addDirectoryFiles(const String& directory, const String& packDirectory, ArrayList<std::pair<String, String>>& files)
+{
+	auto entries = FileTools::readEntriesFromDirectory(directory);
+	for(auto& entry : entries)
+	{
+		// skip hidden files, as well as the current and parent directory entries
+		if(entry.name.length() == 0 || entry.name.charAt(0) == '.')
+		{
+			continue;
+		}
+		String sourcePath = FileTools::combinePathStrings(directory, entry.name);
+		String packPath = (packDirectory.length() > 0) ? (packDirectory + '/' + entry.name) : entry.name;
+		switch(entry.type)
+		{
+			case FileTools::ENTRYTYPE_FILE:
+			case FileTools::ENTRYTYPE_LINK_FILE:
+			files.add(std::pair<String, String>(packPath, sourcePath));
+			break;
+
+			case FileTools::ENTRYTYPE_FOLDER:
+			case FileTools::ENTRYTYPE_LINK_FOLDER:
+			addDirectoryFiles(sourcePath, packPath, files);
+			break;
+
+			default:
+			break;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if(argc != 3)
+	{
+		std::fprintf(stderr, "usage: %s <output pack file> <asset directory>\n", argv[0]);
+		return 1;
+	}
+	String packPath = argv[1];
+	String assetDirectory = argv[2];
+
+	ArrayList<std::pair<String, String>> files;
+	try
+	{
+		addDirectoryFiles(assetDirectory, "", files);
+	}
+	catch(const Exception& e)
+	{
+		std::fprintf(stderr, "unable to read %s: %s\n", (const char*)assetDirectory, e.what());
+		return 1;
+	}
+
+	String error;
+	if(!AssetPack::build(packPath, files, &error))
+	{
+		std::fprintf(stderr, "unable to build %s: %s\n", (const char*)packPath, (const char*)error);
+		return 1;
+	}
+	std::printf("packed %u files into %s\n", (unsigned int)files.size(), (const char*)packPath);
+	return 0;
+}